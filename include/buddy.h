@@ -0,0 +1,52 @@
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include <stdbool.h>
+
+#define BUDDY_MAX_ORDER 18 // Bloque máximo: 2^18 marcos (1 GiB con 4 KiB)
+
+// Asignador buddy sobre un rango contiguo de marcos físicos
+typedef struct {
+  int baseFrame;                         // Primer marco gestionado
+  int numFrames;                         // Marcos gestionados
+  int maxOrder;                          // Orden máximo utilizable
+  int freeFrames;                        // Marcos libres
+  int freeHead[BUDDY_MAX_ORDER + 1];     // Listas libres por orden
+  int freeBlocks[BUDDY_MAX_ORDER + 1];   // Bloques libres por orden
+  int *nextFree;                         // Siguiente bloque libre (por marco)
+  int *prevFree;                         // Anterior bloque libre (por marco)
+  signed char *freeOrder;                // Orden del bloque libre (-1 si no)
+  long allocations[BUDDY_MAX_ORDER + 1]; // Reservas atendidas por orden
+  long frees[BUDDY_MAX_ORDER + 1];       // Liberaciones por orden
+  long failures[BUDDY_MAX_ORDER + 1];    // Reservas fallidas por orden
+  long splits;                           // Divisiones de bloques
+  long merges;                           // Fusiones con el compañero
+} BuddyAllocator;
+
+// Inicializar el asignador con todos los marcos libres
+bool buddyInit(BuddyAllocator *buddy, int baseFrame, int numFrames);
+
+// Liberar las estructuras del asignador
+void buddyDestroy(BuddyAllocator *buddy);
+
+// Reservar un bloque de 2^order marcos en O(log n); devuelve el primer
+// marco o -1
+int buddyAlloc(BuddyAllocator *buddy, int order);
+
+// Reservar el bloque de 2^order marcos que empieza en un marco concreto
+// (debe estar libre y alineado); devuelve false si no es posible
+bool buddyReserve(BuddyAllocator *buddy, int frame, int order);
+
+// Liberar un bloque de 2^order marcos fusionándolo con sus compañeros en
+// O(log n)
+void buddyFree(BuddyAllocator *buddy, int frame, int order);
+
+// Orden del mayor bloque libre (-1 si no hay marcos libres)
+int buddyLargestFreeOrder(const BuddyAllocator *buddy);
+
+// Índice de espacio libre inutilizable para reservas del orden indicado:
+// fracción de marcos libres en bloques menores que 2^order (0 = sin
+// fragmentación externa, 1 = ningún bloque utilizable)
+double buddyUnusableIndex(const BuddyAllocator *buddy, int order);
+
+#endif // BUDDY_H
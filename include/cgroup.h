@@ -0,0 +1,91 @@
+#ifndef CGROUP_H
+#define CGROUP_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define MAX_RESOURCE_GROUPS 16      // Grupos de recursos a la vez
+#define RESOURCE_GROUP_NAME 16      // Longitud máxima del nombre
+#define GROUP_DEFAULT_WEIGHT 100    // Peso de CPU de referencia
+#define GROUP_MAX_WEIGHT 10000      // Peso de CPU máximo
+#define GROUP_NO_QUOTA -1           // Grupo sin límite de CPU por periodo
+#define GROUP_DEFAULT_PERIOD 100    // Periodo del límite de CPU por defecto
+#define GROUP_NO_MEMORY_LIMIT 0     // Grupo sin límite de marcos
+
+// Grupo de recursos jerárquico (al estilo de los cgroups): reparte la CPU
+// por peso entre hermanos, limita la CPU de cada periodo y los marcos
+// residentes de todo su subárbol. Los contadores de uso se agregan al
+// cargarlos en el grupo y sus ancestros, sin recorrer la cola de procesos
+typedef struct ResourceGroup {
+  struct ResourceGroup *parent; // Grupo padre (NULL: cuelga de la raíz)
+  char name[RESOURCE_GROUP_NAME]; // Nombre dentro de su padre
+  int cpuWeight;                // Peso de CPU frente a sus hermanos
+  SimTime cpuQuota;             // CPU por periodo (GROUP_NO_QUOTA: libre)
+  SimTime cpuPeriod;            // Periodo del límite de CPU
+  int memoryLimit;              // Marcos del subárbol (0: sin límite)
+  SimTime periodStart;          // Inicio del periodo actual
+  SimTime periodUsage;          // CPU consumida en el periodo actual
+  SimTime throttledPeriod;      // Último periodo en que agotó su cuota
+
+  // Estadísticas: el uso es el de todo el subárbol y las limitaciones
+  // las del propio grupo
+  SimTime cpuUsage;             // CPU consumida
+  SimTime throttledTime;        // Tiempo sin CPU por agotar la cuota
+  long throttledPeriods;        // Periodos en que agotó la cuota
+  long limitReclaims;           // Marcos desalojados por su límite
+  int processes;                // Procesos activos
+  int residentFrames;           // Marcos residentes
+  int maxResidentFrames;        // Máximo de marcos residentes
+} ResourceGroup;
+
+// Vaciar la jerarquía de grupos (los procesos que sigan apuntando a un
+// grupo deben desadjuntarse antes)
+void resetResourceGroups();
+
+// Crear un grupo bajo parent (NULL: en la raíz) con su peso de CPU, su
+// límite de CPU (quota ticks cada period; GROUP_NO_QUOTA sin límite) y
+// su límite de marcos; NULL si los parámetros no son válidos o no caben
+// más grupos
+ResourceGroup *createResourceGroup(const char *name, ResourceGroup *parent,
+                                   int weight, SimTime quota, SimTime period,
+                                   int memoryLimit);
+
+// Adjuntar un proceso a un grupo; debe hacerse antes de que tenga marcos
+// residentes, que se cargan al grupo al ocuparlos
+void attachProcessToGroup(Process *process, ResourceGroup *group);
+
+// Retirar un proceso terminado de la cuenta de procesos de su grupo (sus
+// estadísticas se conservan)
+void detachProcessFromGroup(Process *process);
+
+// Indica si member es group o uno de sus descendientes
+bool groupContains(const ResourceGroup *group, const ResourceGroup *member);
+
+// Quantum de un proceso: el de Round Robin escalado por el peso de su
+// grupo y de sus ancestros y recortado a la cuota que les queda
+SimTime groupQuantum(const Process *process, SimTime quantum,
+                     SimTime currentTime);
+
+// Tiempo hasta el que el grupo del proceso (o un ancestro) agotó su cuota
+// de CPU; currentTime si puede ejecutarse
+SimTime groupThrottledUntil(const Process *process, SimTime currentTime);
+
+// Cargar la CPU que consumió un proceso a su grupo y sus ancestros
+void groupChargeCpu(const Process *process, SimTime time,
+                    SimTime currentTime);
+
+// Cargar (o descargar, con frames negativo) marcos residentes a un grupo y
+// sus ancestros
+void groupChargeFrames(ResourceGroup *group, int frames);
+
+// Grupo más cercano entre group y sus ancestros que superaría su límite
+// de marcos con frames más; NULL si caben
+ResourceGroup *groupOverMemoryLimit(ResourceGroup *group, int frames);
+
+// Contabilizar un marco desalojado para respetar el límite de un grupo
+void groupRecordReclaim(ResourceGroup *group);
+
+// Mostrar el uso y las limitaciones de cada grupo (solo si hay alguno)
+void displayResourceGroupStatistics();
+
+#endif // CGROUP_H
@@ -0,0 +1,171 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define CHECKPOINT_MAGIC "SIMCKPT" // Firma del archivo (con su terminador)
+#define CHECKPOINT_VERSION 3       // Versión del formato (2: tiempos de
+                                   // 64 bits; 3: ajuste OOM)
+#define CHECKPOINT_NONE -1         // Índice nulo dentro del checkpoint
+
+// Indicadores de una página guardada
+#define CHECKPOINT_PAGE_ACTIVE 0x01
+#define CHECKPOINT_PAGE_IN_MEMORY 0x02
+#define CHECKPOINT_PAGE_DIRTY 0x04
+#define CHECKPOINT_PAGE_READ_AHEAD 0x08
+#define CHECKPOINT_PAGE_COPY_ON_WRITE 0x10
+
+// El archivo es una cabecera seguida de secciones de registros de tamaño
+// fijo alineadas a 8 bytes, sin punteros: las páginas, procesos y marcos
+// se referencian por su índice en la sección correspondiente, así que el
+// archivo se puede proyectar con mmap y leer en su sitio
+
+// Página guardada (las privadas de cada proceso, después las que mapean su
+// segmento compartido y al final las anclas de los segmentos)
+typedef struct {
+  unsigned long virtualAddress; // Dirección virtual
+  SimTime lastAccessTime;       // Último acceso
+  SimTime readyTime;            // Fin de su lectura desde swap
+  int id;                       // Identificador global
+  int processId;                // Proceso (o SHARED_REGION_OWNER)
+  int frameIndex;               // Marco inicial (NO_FRAME si no reside)
+  int swapSlot;                 // Slot de swap (NO_SWAP_SLOT si no tiene)
+  int nextSharer;               // Siguiente página del mapa inverso
+  int sharedAnchor;             // Ancla de su segmento compartido
+  int accessNode;               // Nodo NUMA del último acceso
+  int remoteAccesses;           // Accesos remotos seguidos
+  unsigned char sizeClass;      // Tamaño de la página
+  unsigned char flags;          // CHECKPOINT_PAGE_*
+} CheckpointPage;
+
+// Proceso guardado, en el orden de la cola del planificador
+typedef struct {
+  SimTime startTime;      // Tiempo de inicio
+  SimTime blockedUntil;   // Bloqueado hasta este tiempo
+  SimTime waitTime;       // Métricas de rendimiento
+  SimTime turnaroundTime;
+  SimTime responseTime;
+  int id;              // Identificador del proceso
+  int priority;        // Prioridad
+  int memorySize;      // Tamaño total de memoria
+  int totalPages;      // Páginas privadas
+  int firstPage;       // Primera página privada
+  int sharedRegion;    // Segmento adjunto (CHECKPOINT_NONE si no tiene)
+  int firstSharedPage; // Primera página que mapea el segmento
+  int totalBursts;     // Ráfagas de CPU
+  int burstIndex;      // Ráfaga actual
+  int firstBurst;      // Primera ráfaga en la sección de ráfagas
+  int firstRequest;    // Primera petición de archivo (CHECKPOINT_NONE si
+                       // sus esperas de E/S son opacas)
+  int writtenPages;    // Páginas escritas en cada quantum
+  int state;           // Estado del proceso
+  int numaPolicy;      // Política de ubicación NUMA
+  int numaNode;        // Nodo de la política bind
+  int cpu;             // CPU asignada
+  int pagesLoaded;     // Páginas del quantum bloqueado ya cargadas
+  int oomScoreAdj;     // Ajuste de la puntuación OOM
+} CheckpointProcess;
+
+// Ráfaga guardada (tiempo restante de CPU y espera de E/S posterior)
+typedef struct {
+  SimTime cpuTime;
+  SimTime ioTime;
+} CheckpointBurst;
+
+// Petición de archivo de una ráfaga de E/S
+typedef struct {
+  long offset;
+  long length;
+  int fileId;
+  int write;
+} CheckpointRequest;
+
+// Segmento compartido guardado
+typedef struct {
+  int id;          // Identificador del segmento
+  int totalPages;  // Páginas del segmento
+  int firstAnchor; // Primera página ancla
+  int padding;
+} CheckpointRegion;
+
+// Marco físico guardado (los campos de MemoryFrame con índices)
+typedef struct {
+  SimTime lastUsedTime;
+  int occupyingPage; // Página cabeza del mapa inverso (CHECKPOINT_NONE)
+  int mapCount;
+  int prefetchSource;
+  int headFrame;
+  int order;
+  int use;
+  int ownerSet;
+  int prevFrame;
+  int nextFrame;
+  int prevGlobal;
+  int nextGlobal;
+} CheckpointFrame;
+
+// Conjunto de marcos de un proceso guardado
+typedef struct {
+  int process; // Proceso propietario (CHECKPOINT_NONE si está libre)
+  int quota;
+  int residentFrames;
+  int lruHead;
+  int lruTail;
+} CheckpointFrameSet;
+
+// Estado global del sistema de memoria y de su política de reemplazo
+typedef struct {
+  int allocationMode; // Modo de asignación de marcos
+  int globalLruHead;  // Lista LRU global
+  int globalLruTail;
+  int padding;
+  long pageFaults[NUM_PAGE_SIZES];
+  long allocationFailures[NUM_PAGE_SIZES];
+  long compactions;
+  long migratedPages;
+  long copyOnWriteFaults;
+  long sharedFaults;
+} CheckpointMemory;
+
+// Cabecera del archivo
+typedef struct {
+  char magic[8];        // CHECKPOINT_MAGIC
+  int version;          // CHECKPOINT_VERSION
+  int numFrames;        // NUM_FRAMES con que se guardó
+  int maxProcesses;     // MAX_PROCESSES con que se guardó
+  int numaNodes;        // Nodos NUMA configurados
+  int nextPageId;       // Siguiente identificador global de página
+  int processCount;     // Registros de cada sección
+  int pageCount;
+  int burstCount;
+  int requestCount;
+  int regionCount;
+  SimTime clock;       // Reloj del planificador
+  long processOffset;  // Desplazamiento de cada sección en el archivo
+  long pageOffset;
+  long burstOffset;
+  long requestOffset;
+  long regionOffset;
+  long frameOffset;    // NUM_FRAMES registros
+  long frameSetOffset; // MAX_PROCESSES registros
+  CheckpointMemory memory;
+} CheckpointHeader;
+
+// Guardar el estado completo de la simulación (cola de procesos con su
+// progreso, páginas, tabla de marcos, listas LRU y reloj); la caché de
+// páginas, las colas de los dispositivos, el TLB y el historial de los
+// predictores de precarga no se guardan. Las tareas de tiempo real y los
+// grupos de recursos tampoco: si algún proceso los usa no se guarda
+bool saveCheckpoint(const char *path);
+
+// Restaurar un checkpoint sobre un simulador recién configurado y sin
+// procesos; la caché de páginas empieza vacía y las E/S que estaban en cola
+// se dan por terminadas. Los procesos terminados se encolan sin comprometer
+// memoria
+bool restoreCheckpoint(const char *path);
+
+// Liberar los segmentos compartidos creados al restaurar
+void releaseCheckpointRegions();
+
+#endif // CHECKPOINT_H
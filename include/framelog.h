@@ -0,0 +1,110 @@
+#ifndef FRAMELOG_H
+#define FRAMELOG_H
+
+#include "memory.h"
+#include "simtime.h"
+#include <stdbool.h>
+
+#define FRAMELOG_MAGIC "SIMFRML" // Firma del archivo (con su terminador)
+#define FRAMELOG_VERSION 1       // Versión del formato
+#define FRAMELOG_KEYFRAME_INTERVAL 32 // Instantáneas por instantánea completa
+
+// Tipos de registro del flujo
+#define FRAMELOG_KEYFRAME 0 // Completa: cambios desde la tabla vacía
+#define FRAMELOG_DELTA 1    // Solo los marcos que cambiaron
+
+// Campos de FrameState (bits de la máscara de cada marco cambiado)
+#define FRAMELOG_FIELD_LAST_USED 0x01
+#define FRAMELOG_FIELD_HEAD 0x02
+#define FRAMELOG_FIELD_USE 0x04
+#define FRAMELOG_FIELD_PAGE 0x08
+#define FRAMELOG_FIELD_PROCESS 0x10
+#define FRAMELOG_FIELD_MAP_COUNT 0x20
+
+// Cada instantánea de la tabla de marcos es un registro del flujo: su tipo,
+// el avance del tiempo desde la anterior y los marcos cambiados, cada uno
+// con la distancia al anterior cambiado, la máscara de campos y la
+// diferencia de cada campo marcado. Los enteros van como varint (los que
+// pueden ser negativos, en zigzag). Cada FRAMELOG_KEYFRAME_INTERVAL
+// instantáneas va una completa, que el índice localiza para no tener que
+// decodificar el flujo desde el principio
+
+// Entrada del índice de instantáneas completas
+typedef struct {
+  SimTime time;  // Tiempo de la instantánea
+  long offset;   // Posición de su registro en el flujo
+  long snapshot; // Número de instantánea
+} FrameLogKeyframe;
+
+// Cabecera del archivo (las secciones van alineadas a 8 bytes)
+typedef struct {
+  char magic[8];  // FRAMELOG_MAGIC
+  int version;    // FRAMELOG_VERSION
+  int numFrames;  // Marcos de cada instantánea
+  long snapshotCount;
+  long keyframeCount;
+  long streamBytes;
+  SimTime endTime; // Tiempo de la última instantánea
+  long keyframeOffset;
+  long streamOffset;
+} FrameLogHeader;
+
+// Registro de marcos abierto para reconstruir instantáneas
+typedef struct {
+  const FrameLogHeader *header;
+  const FrameLogKeyframe *keyframes;
+  const unsigned char *stream;
+  void *data; // Proyección del archivo
+  long size;
+} FrameLogView;
+
+// Estadísticas de la codificación
+typedef struct {
+  long snapshots;     // Instantáneas registradas
+  long keyframes;     // De ellas, completas
+  long changedFrames; // Marcos cambiados en las instantáneas parciales
+  long encodedBytes;  // Bytes del flujo
+  long fullBytes;     // Bytes de guardar cada tabla completa
+} FrameLogStatistics;
+
+// Vaciar el registro (la siguiente instantánea será completa); si se está
+// registrando se sigue registrando
+void resetFrameLog();
+
+// Empezar a codificar las instantáneas para guardarlas con saveFrameLog;
+// sin llamarla solo se sigue la última tabla para mostrar los cambios
+void startFrameLog();
+
+// Registrar una instantánea de NUM_FRAMES marcos (codificada si se está
+// registrando); los tiempos anteriores al último registrado se adelantan a
+// él. Devuelve si fue completa
+bool frameLogRecord(SimTime time, const FrameState *states);
+
+// Registrar el estado actual de los marcos y mostrarlo: completo en las
+// instantáneas completas y solo los marcos cambiados en las demás
+void recordFrameSnapshot(SimTime currentTime);
+
+// Escribir el registro en path; false si no se estaba registrando
+bool saveFrameLog(const char *path);
+
+// Abrir un registro guardado; false si el archivo no es válido
+bool openFrameLog(const char *path, FrameLogView *view);
+
+// Cerrar un registro abierto
+void closeFrameLog(FrameLogView *view);
+
+// Reconstruir en states (header->numFrames marcos) la tabla tras la última
+// instantánea no posterior a time; devuelve su número, o -1 si no hay
+// ninguna o el flujo está dañado
+long frameLogStateAt(const FrameLogView *view, SimTime time,
+                     FrameState *states);
+
+// Subcomando "ARCHIVO T": mostrar la tabla de marcos en el tiempo T;
+// devuelve el código de salida
+int runFrameLogQuery(int argc, char *argv[]);
+
+FrameLogStatistics getFrameLogStatistics();
+
+void displayFrameLogStatistics();
+
+#endif // FRAMELOG_H
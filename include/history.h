@@ -0,0 +1,131 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "simtime.h"
+#include <stdbool.h>
+
+#define HISTORY_MAGIC "SIMHIST" // Firma del archivo (con su terminador)
+#define HISTORY_VERSION 1       // Versión del formato
+#define HISTORY_PARTITION_ROWS 1024 // Cambios por partición de tiempo
+#define HISTORY_NONE -1         // Valor vacío (marco sin página)
+#define HISTORY_OPEN_END -1     // Fin de un intervalo que llega al final
+
+// Series del historial: cada una guarda, por clave, el valor que tuvo
+// desde cada cambio hasta el siguiente
+typedef enum {
+  HISTORY_FRAME = 0,   // Clave: marco; valor: página (o HISTORY_NONE);
+                       // detalle: su proceso
+  HISTORY_PROCESS = 1, // Clave: proceso; valor: estado (READY...);
+                       // detalle: CPU
+  HISTORY_QUEUE = 2    // Clave: 0; valor: procesos listos sin CPU
+} HistorySeries;
+
+#define HISTORY_SERIES 3
+
+// El archivo es una cabecera seguida de secciones alineadas a 8 bytes
+// (como los checkpoints, se proyecta con mmap y se consulta en su sitio):
+// una columna por campo de los cambios, en orden de tiempo; el directorio
+// de particiones con el rango de tiempo de cada bloque de
+// HISTORY_PARTITION_ROWS cambios; y el índice de intervalos, con las
+// claves ordenadas y los intervalos de cada clave contiguos y ordenados
+// por inicio, de modo que una consulta es una búsqueda binaria
+
+// Partición de tiempo (filas [firstRow, firstRow + rows))
+typedef struct {
+  SimTime firstTime;
+  SimTime lastTime;
+  long firstRow;
+  long rows;
+} HistoryPartition;
+
+// Entrada del índice: intervalos de una clave de una serie
+typedef struct {
+  int series;
+  int key;
+  long firstInterval;
+  long intervalCount;
+} HistoryKey;
+
+// Intervalo [start, end) en que una clave conservó el valor de la fila row
+typedef struct {
+  SimTime start;
+  SimTime end; // HISTORY_OPEN_END si dura hasta el final del historial
+  long row;
+} HistoryInterval;
+
+// Cabecera del archivo
+typedef struct {
+  char magic[8];  // HISTORY_MAGIC
+  int version;    // HISTORY_VERSION
+  int partitionRows;
+  SimTime endTime; // Último tiempo registrado
+  long rowCount;
+  long partitionCount;
+  long keyCount;
+  long timeOffset;   // Columnas: SimTime, luego int
+  long seriesOffset;
+  long keyOffset;
+  long valueOffset;
+  long detailOffset;
+  long partitionOffset;
+  long keyIndexOffset;
+  long intervalOffset;
+} HistoryHeader;
+
+// Historial abierto para consultas
+typedef struct {
+  const HistoryHeader *header;
+  const SimTime *times; // Columnas de los cambios
+  const int *series;
+  const int *keys;
+  const int *values;
+  const int *details;
+  const HistoryPartition *partitions;
+  const HistoryKey *keyIndex;
+  const HistoryInterval *intervals;
+  void *data;  // Proyección del archivo
+  long size;
+} HistoryStore;
+
+// Empezar a registrar el historial (vacía el que hubiera)
+bool startHistory();
+
+// Indica si se está registrando el historial
+bool historyEnabled();
+
+// Registrar el valor de una clave en un tiempo; solo se guarda si cambia.
+// Los tiempos anteriores al último registrado se adelantan a él
+void historyRecord(HistorySeries series, SimTime time, int key, int value,
+                   int detail);
+
+// Construir el índice, escribir el historial en path y dejar de registrar
+bool saveHistory(const char *path);
+
+// Abrir un historial guardado; false si el archivo no es válido
+bool openHistory(const char *path, HistoryStore *store);
+
+// Cerrar un historial abierto
+void closeHistory(HistoryStore *store);
+
+// Intervalo en que una clave tenía su valor en el tiempo time (el último
+// cambio no posterior); NULL si aún no tenía ninguno
+const HistoryInterval *historyValueAt(const HistoryStore *store,
+                                      HistorySeries series, int key,
+                                      SimTime time);
+
+// Intervalos contiguos de una clave que se solapan con [from, to]; count
+// recibe cuántos son (puede ser 0)
+const HistoryInterval *historyIntervals(const HistoryStore *store,
+                                        HistorySeries series, int key,
+                                        SimTime from, SimTime to,
+                                        long *count);
+
+// Primera fila con tiempo no anterior a time (rowCount si no hay)
+long historyFirstRow(const HistoryStore *store, SimTime time);
+
+// Subcomando de consulta: "ARCHIVO marco N T [HASTA]", "ARCHIVO marcos T",
+// "ARCHIVO proceso ID T [HASTA]", "ARCHIVO cola T [HASTA]" o "ARCHIVO
+// eventos DESDE HASTA"; devuelve el código de salida
+int runHistoryQuery(int argc, char *argv[]);
+
+#endif // HISTORY_H
@@ -0,0 +1,138 @@
+#ifndef IODEVICE_H
+#define IODEVICE_H
+
+#include "memory.h"
+#include "rng.h"
+
+#define MAX_IO_DEVICES 4          // Dispositivos de bloques simulados
+#define IO_NAME_LENGTH 16         // Longitud máxima del nombre
+#define IO_PENDING SIM_TIME_MAX   // blockedUntil de una petición sin despachar
+#define IO_FILE_SPAN (1L << 20)   // Sectores (páginas) reservados por archivo
+#define IO_PAGE_WRITE_TIME 2      // Servicio nominal de una escritura diferida
+#define IO_READ_EXPIRE 100        // Plazo de una lectura (deadline)
+#define IO_WRITE_EXPIRE 500       // Plazo de una escritura (deadline)
+#define IO_FIFO_BATCH 16          // Peticiones por lote (mq-deadline)
+#define IO_WRITES_STARVED 2       // Lotes de lectura antes de servir escrituras
+#define IO_WEIGHT_SCALE 100       // Escala del tiempo virtual (BFQ)
+#define IO_MAX_FLOWS (MAX_PROCESSES + 1) // Flujos BFQ (procesos y write-back)
+
+// Valores por defecto de un dispositivo
+#define IO_DEFAULT_QUEUE_DEPTH 1
+#define IO_DEFAULT_LATENCY 0
+#define IO_DEFAULT_SPEED 100 // Porcentaje del tiempo de servicio nominal
+
+// Planificadores de E/S
+typedef enum {
+  IO_SCHED_FIFO = 0,       // Orden de llegada
+  IO_SCHED_DEADLINE = 1,   // Elevador por sector con plazos de vencimiento
+  IO_SCHED_BFQ = 2,        // Reparto justo ponderado entre procesos
+  IO_SCHED_MQ_DEADLINE = 3 // Lotes de lectura/escritura con plazos
+} IoSchedulerKind;
+
+#define IO_DEFAULT_SCHEDULER IO_SCHED_FIFO
+
+// Distribución del tiempo de servicio alrededor de la demanda nominal
+typedef enum {
+  IO_SERVICE_FIXED = 0,      // Exactamente la demanda
+  IO_SERVICE_UNIFORM = 1,    // Uniforme entre 0.5 y 1.5 veces la demanda
+  IO_SERVICE_EXPONENTIAL = 2 // Exponencial con media igual a la demanda
+} IoServiceDistribution;
+
+// Petición de E/S de bloques
+typedef struct IoRequest {
+  Process *process;       // Proceso bloqueado (NULL en escrituras diferidas)
+  long sector;            // Posición en el dispositivo
+  SimTime demand;         // Tiempo de servicio nominal
+  SimTime submitTime;     // Llegada a la cola
+  SimTime deadline;       // Vencimiento (planificadores deadline)
+  SimTime dispatchTime;   // Inicio del servicio
+  SimTime completeTime;   // Fin del servicio
+  struct IoRequest *next; // Siguiente en la cola o en servicio
+  bool write;             // Escritura o lectura
+} IoRequest;
+
+// Tiempo virtual de un flujo en el reparto justo
+typedef struct {
+  int flowId;   // Proceso del flujo (-1 para la escritura diferida)
+  long vtime;   // Servicio recibido ponderado
+} IoFlow;
+
+// Estadísticas de un dispositivo
+typedef struct {
+  long submitted;          // Peticiones recibidas
+  long completed;          // Peticiones terminadas
+  long reads;              // Lecturas despachadas
+  long writes;             // Escrituras despachadas
+  long expired;            // Peticiones despachadas tras su vencimiento
+  TimeAccumulator wait;    // Espera en cola
+  TimeAccumulator service; // Tiempo de servicio
+  SimTime maxWait;         // Espera máxima en cola
+  SimTime lastComplete;    // Última finalización (para la utilización)
+  int maxQueued;           // Longitud máxima de la cola
+} IoDeviceStatistics;
+
+// Dispositivo de bloques con cola de hardware acotada
+typedef struct {
+  char name[IO_NAME_LENGTH];          // Nombre del dispositivo
+  IoSchedulerKind scheduler;          // Planificador de E/S
+  int queueDepth;                     // Peticiones en servicio a la vez
+  int latency;                        // Coste fijo por petición
+  int speed;                          // Porcentaje del servicio nominal
+  IoServiceDistribution distribution; // Variabilidad del servicio
+  RngStream rng;                      // Flujo de la distribución
+  IoRequest *queue;                   // Peticiones pendientes
+  int queued;                         // Longitud de la cola
+  IoRequest *inFlight;                // Peticiones en servicio
+  int busySlots;                      // Posiciones de hardware ocupadas
+  long headSector;                    // Último sector despachado
+  bool servingWrites;                 // Dirección del lote (mq-deadline)
+  int batchRemaining;                 // Peticiones restantes del lote
+  int writesStarved;                  // Lotes de lectura seguidos
+  IoFlow flows[IO_MAX_FLOWS];         // Tiempos virtuales (BFQ)
+  long virtualTime;                   // Tiempo virtual del dispositivo
+  IoDeviceStatistics stats;           // Estadísticas acumuladas
+} IoDevice;
+
+// Añadir un dispositivo; su flujo aleatorio deriva de la semilla global y
+// de seed, así que la semilla global debe fijarse antes. Devuelve su
+// índice o -1
+int addIoDevice(const char *name, IoSchedulerKind scheduler, int queueDepth,
+                int latency, int speed, IoServiceDistribution distribution,
+                unsigned int seed);
+
+// Eliminar todos los dispositivos y sus peticiones
+void resetIoDevices();
+
+// Número de dispositivos configurados
+int ioDeviceCount();
+
+// Dispositivo que almacena un archivo
+int ioDeviceForFile(int fileId);
+
+// Sector de una página de un archivo
+long ioSector(int fileId, long pageIndex);
+
+// Encolar una petición; si process no es NULL queda bloqueado
+// (blockedUntil) hasta que termine. Si no hay dispositivos se crea uno por
+// defecto
+bool submitIoRequest(int device, Process *process, long sector, SimTime demand,
+                     bool write, SimTime currentTime);
+
+// Desligar un proceso eliminado de sus peticiones pendientes, que terminan
+// sin despertarlo
+void ioForgetProcess(const Process *process);
+
+// Completar las peticiones terminadas y despachar las pendientes hasta el
+// tiempo indicado
+void ioAdvance(SimTime currentTime);
+
+// Próxima finalización en algún dispositivo (-1 si todos están libres)
+SimTime ioNextCompletion();
+
+// Obtener las estadísticas de un dispositivo
+IoDeviceStatistics getIoDeviceStatistics(int device);
+
+// Mostrar espera, servicio y utilización de cada dispositivo
+void displayIoStatistics();
+
+#endif // IODEVICE_H
@@ -1,34 +1,222 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include "checkpoint.h"
+#include "prefetch.h"
 #include "process.h"
 
+#ifndef NUM_FRAMES
 #define NUM_FRAMES 8     // Número de marcos de memoria física
+#endif
 #define FRAME_SIZE 4096  // Tamaño de cada marco de memoria
 #define PAGE_SIZE 4096   // Tamaño de cada página
+#ifndef MAX_PROCESSES
 #define MAX_PROCESSES 10 // Número máximo de procesos soportados
+#endif
+#define NO_FRAME -1      // Índice nulo para listas de marcos
+
+// Parámetros FNV-1a de 64 bits del digest del registro de eventos
+#define EVENT_LOG_FNV_OFFSET 0xcbf29ce484222325ULL
+#define EVENT_LOG_FNV_PRIME 0x100000001b3ULL
+
+// Orden (log2 de marcos) y tamaño en bytes de cada clase de página
+#define PAGE_SIZE_ORDER(sizeClass) (9 * (int)(sizeClass))
+#define PAGE_SIZE_BYTES(sizeClass)                                             \
+  ((unsigned long)PAGE_SIZE << PAGE_SIZE_ORDER(sizeClass))
+
+// Modos de asignación de marcos entre procesos
+typedef enum {
+  FRAME_ALLOCATION_GLOBAL = 0,       // Reemplazo global sobre todos los marcos
+  FRAME_ALLOCATION_EQUAL = 1,        // Cuota igual para cada proceso
+  FRAME_ALLOCATION_PROPORTIONAL = 2, // Cuota proporcional a memorySize
+  FRAME_ALLOCATION_PRIORITY = 3      // Cuota ponderada por prioridad
+} FrameAllocationMode;
+
+#define DEFAULT_FRAME_ALLOCATION_MODE FRAME_ALLOCATION_GLOBAL
+
+// Uso de un bloque de marcos ocupado
+typedef enum {
+  FRAME_USER = 0,   // Página de usuario (desalojable y migrable)
+  FRAME_KERNEL = 1, // Reserva del núcleo (fija)
+  FRAME_DMA = 2,    // Búfer DMA contiguo (fijo)
+  FRAME_CACHE = 3,  // Página de la caché de archivos (recuperable)
+  FRAME_ZSWAP = 4   // Almacén de páginas comprimidas (fijo)
+} FrameUse;
+
+#define FRAGMENTATION_HISTORY 64 // Muestras de fragmentación conservadas
+
+// Muestra de fragmentación externa en un instante
+typedef struct {
+  SimTime time;         // Tiempo de la muestra
+  int freeFrames;       // Marcos libres
+  int largestFreeOrder; // Orden del mayor bloque libre
+  double unusableIndex; // Índice de espacio inutilizable para páginas de 2 MiB
+                        // (o el mayor orden disponible)
+} FragmentationSample;
 
 // Estructura de marcos de memoria
 typedef struct {
-  Page *occupyingPage; // Página que ocupa el marco
-  int lastUsedTime;    // Último tiempo de uso del marco
+  Page *occupyingPage; // Página que ocupa el marco (cabeza del mapa inverso)
+  int mapCount;        // Páginas que mapean el bloque (solo en el marco
+                       // inicial); el resto se enlaza por nextSharer
+  int prefetchSource;  // Predictor que precargó el bloque y aún no se usa
+                       // (NO_PREFETCH si no)
+  SimTime lastUsedTime; // Último tiempo de uso del marco
+  int headFrame;       // Marco inicial del bloque (NO_FRAME si está libre)
+  int order;           // Orden del bloque (solo en el marco inicial)
+  FrameUse use;        // Uso del bloque (solo en el marco inicial)
+  int ownerSet;        // Conjunto de marcos del proceso propietario
+  int prevFrame;       // Anterior en la lista LRU del proceso
+  int nextFrame;       // Siguiente en la lista LRU del proceso
+  int prevGlobal;      // Anterior en la lista LRU global
+  int nextGlobal;      // Siguiente en la lista LRU global
+  long lruSequence;    // Orden de enlace en la lista LRU global (crece
+                       // hacia la cola)
 } MemoryFrame;
 
+// Estado visible de un marco (lo que muestra displayMemoryFrames)
+typedef struct {
+  SimTime lastUsedTime; // Último uso (-1 si está libre)
+  int headFrame;        // Marco inicial de su bloque (NO_FRAME si libre)
+  int use;              // Uso del bloque (FrameUse)
+  int pageId;           // Página del bloque (-1 si no tiene)
+  int processId;        // Proceso de la página (0 si no tiene)
+  int mapCount;         // Páginas que mapean el marco
+} FrameState;
+
+// Conjunto de marcos residentes de un proceso
+typedef struct {
+  Process *process;   // Proceso propietario (NULL si el conjunto está libre)
+  int quota;          // Cuota de marcos asignada
+  int residentFrames; // Marcos ocupados actualmente
+  int lruHead;        // Marco menos recientemente usado
+  int lruTail;        // Marco más recientemente usado
+} ProcessFrameSet;
+
 // Función de inicialización del sistema de memoria
 void initializeMemorySystem();
 
-// Función para manejar fallos de página
-bool handlePageFault(Page *page, int currentTime);
+// Función para manejar fallos de página; si la página está en swap su
+// lectura es asíncrona y page->readyTime indica cuándo estará disponible
+bool handlePageFault(Page *page, SimTime currentTime);
 
 // Función para mostrar marcos de memoria
-void displayMemoryFrames(int currentTime);
+void displayMemoryFrames(SimTime currentTime);
+
+// Copiar el estado visible de los NUM_FRAMES marcos
+void captureFrameStates(FrameState *states);
 
-// Función para seleccionar página para reemplazo
+// Describir el estado de un marco con el formato de displayMemoryFrames
+void formatFrameState(int frame, const FrameState *state, char *text,
+                      size_t size);
+
+// Función para seleccionar página para reemplazo (recorrido lineal de
+// referencia, sin considerar cuotas)
 int selectPageForReplacement();
 
 // Obtener acceso a los marcos de memoria físicos
 MemoryFrame *getPhysicalMemory();
 
+// Traducir una dirección virtual mediante el TLB y la tabla de páginas del
+// proceso (marcando la página como sucia si es una escritura); devuelve la
+// página (posiblemente no residente) o NULL si no está mapeada
+Page *translateAddress(Process *process, unsigned long virtualAddress,
+                       bool write, SimTime currentTime);
+
+// Seleccionar el modo de asignación de marcos y recalcular las cuotas
+void setFrameAllocationMode(FrameAllocationMode mode);
+
+// Registrar un proceso en el sistema de memoria (recalcula las cuotas);
+// devuelve su conjunto de marcos o NO_FRAME si la política de compromiso
+// de memoria rechaza su tamaño
+int registerProcessMemory(Process *process);
+
+// Liberar los marcos de un proceso terminado (recalcula las cuotas); los
+// marcos que comparte con otros procesos pasan a uno de ellos
+void releaseProcessMemory(Process *process, SimTime currentTime);
+
+// Compartir con el hijo de un fork los marcos y slots de swap del padre,
+// marcando las páginas privadas como copia en escritura
+void shareForkedPages(Process *parent, Process *child);
+
+// Mostrar la memoria residente (RSS) y proporcional (PSS) de cada proceso
+// y los fallos por compartición
+void displayProcessMemoryUsage();
+
+// Mostrar las cuotas y marcos residentes por proceso
+void displayFrameQuotas();
+
+// Compactar la memoria física para formar bloques contiguos libres;
+// devuelve el número de páginas migradas
+int compactMemory(SimTime currentTime);
+
+// Recuperar en segundo plano el bloque más antiguo (de la caché de
+// archivos o de la memoria anónima); false si no queda nada desalojable
+bool reclaimLruBlock(SimTime currentTime);
+
+// Mostrar fallos por tamaño de página, fragmentación y alcance del TLB
+void displayPageSizeStatistics();
+
+// Copiar a un checkpoint la tabla de marcos, los conjuntos de marcos y el
+// estado de reemplazo; pageIndex y processIndex traducen los punteros a
+// índices del checkpoint (false si alguno no tiene índice). Los marcos de
+// la caché de archivos se guardan como libres
+bool saveMemoryState(CheckpointFrame *frames, CheckpointFrameSet *sets,
+                     CheckpointMemory *state,
+                     int (*pageIndex)(const Page *),
+                     int (*processIndex)(const Process *));
+
+// Cargar sobre la memoria recién inicializada el estado guardado con
+// saveMemoryState, reconstruyendo los asignadores buddy; pageAt y
+// processAt traducen los índices a punteros (NULL si no son válidos, y
+// pageAt a partir de la última página). Si el estado no es coherente con
+// las páginas restauradas devuelve false sin cambiar la memoria
+bool restoreMemoryState(const CheckpointFrame *frames,
+                        const CheckpointFrameSet *sets,
+                        const CheckpointMemory *state, Page *(*pageAt)(int),
+                        Process *(*processAt)(int));
+
+// Marcos libres de un nodo NUMA
+int freeFramesOnNode(int node);
+
+// Marcos residentes de un proceso en cada nodo NUMA
+void processNodeFrames(const Process *process, int *frames);
+
+// Reservar un bloque contiguo fijo de 2^order marcos para el núcleo o DMA,
+// desalojando páginas de usuario si hace falta; devuelve el primer marco o
+// NO_FRAME
+int allocateKernelBlock(int order, FrameUse use, SimTime currentTime);
+
+// Liberar un bloque reservado con allocateKernelBlock
+void freeKernelBlock(int frame);
+
+// Ubicar una página de la caché de archivos en un marco, recuperando
+// memoria si hace falta; devuelve el marco o NO_FRAME
+int allocateCacheFrame(Page *page, SimTime currentTime);
+
+// Registrar un acceso a un marco de la caché de archivos
+void touchCacheFrame(int frame, SimTime currentTime);
+
+// Liberar el marco de una página de la caché de archivos
+void freeCacheFrame(int frame);
+
+// Registrar una muestra del índice de fragmentación externa
+void recordFragmentationSample(SimTime currentTime);
+
+// Mostrar las listas libres por orden y la evolución de la fragmentación
+void displayBuddyStatistics();
+
+// Registrar un mensaje del simulador
 void logMessage(const char *message);
 
+// Digest FNV-1a de 64 bits de todos los mensajes registrados, en orden: dos
+// ejecuciones con la misma carga y la misma semilla dan el mismo digest
+unsigned long long eventLogDigest();
+
+// Mensajes registrados
+long eventLogLength();
+
+// Mostrar el digest, los mensajes registrados y la semilla global
+void displayEventLogDigest();
+
 #endif // MEMORY_H
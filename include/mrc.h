@@ -0,0 +1,46 @@
+#ifndef MRC_H
+#define MRC_H
+
+#include "process.h"
+
+#define MRC_EXACT_RATE 1.0           // Muestreo que sigue todas las páginas
+#define MRC_CURVE_FRAMES 16          // Tamaños de memoria de la curva
+#define MRC_DISTANCE_BUCKETS 24      // Intervalos del histograma de distancias
+#define MRC_MAX_PROCESSES 16         // Procesos con curva propia
+#define MRC_SHARDS_MODULUS (1 << 24) // Espacio del hash de muestreo SHARDS
+
+// Distancias de reuso de un flujo de referencias (global o de un proceso)
+typedef struct {
+  int processId;    // Proceso (-1 para el flujo global)
+  long references;  // Referencias vistas
+  long sampled;     // Referencias de páginas muestreadas
+  long coldMisses;  // Primeras referencias de páginas muestreadas
+  // Referencias muestreadas por distancia de pila (escalada por la tasa):
+  // el intervalo k cubre [2^k, 2^(k+1)) y el último recoge el resto
+  long histogram[MRC_DISTANCE_BUCKETS];
+  // Referencias con distancia d <= MRC_CURVE_FRAMES (índice d - 1); una
+  // memoria LRU de c marcos acierta las de distancia <= c
+  long shortDistances[MRC_CURVE_FRAMES];
+} MrcStatistics;
+
+// Activar el análisis de la curva de fallos con la tasa de muestreo
+// indicada: 1 sigue todas las páginas (pila de Mattson exacta) y una tasa
+// menor solo las que elige el hash espacial de SHARDS. Vacía los flujos
+bool configureMrc(double samplingRate);
+
+// Contabilizar una referencia de un proceso a una página (las del segmento
+// compartido cuentan como su página ancla)
+void mrcRecordReference(int processId, const Page *page);
+
+// Tasa de fallos de una memoria LRU de frames marcos (1..MRC_CURVE_FRAMES)
+// para un proceso (-1: el flujo global); -1 si no hay referencias
+double mrcMissRatio(int processId, int frames);
+
+// Obtener las estadísticas de un flujo (-1: el global)
+MrcStatistics getMrcStatistics(int processId);
+
+// Mostrar los histogramas de distancias y las curvas de fallos global y
+// por proceso (solo si está activo)
+void displayMrcStatistics();
+
+#endif // MRC_H
@@ -0,0 +1,123 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define MAX_NUMA_NODES 4         // Nodos (sockets) máximos
+#define MAX_NUMA_CPUS 16         // CPUs máximas entre todos los nodos
+#define NUMA_NODES 1             // Nodos por defecto (un único banco)
+#define NUMA_CPUS_PER_NODE 1     // CPUs por nodo por defecto
+#define NUMA_LOCAL_LATENCY 80    // Latencia de un acceso local (ns)
+#define NUMA_REMOTE_LATENCY 140  // Latencia de un acceso a otro nodo (ns)
+#define NUMA_MIGRATION_COST 2    // Tiempo perdido al mover un proceso de nodo
+#define NUMA_BALANCING true      // Migrar páginas hacia el nodo que las usa
+#define NUMA_BALANCE_THRESHOLD 2 // Accesos remotos seguidos desde un mismo
+                                 // nodo antes de migrar la página
+#define NUMA_ANY_NODE -1         // Sin restricción de nodo
+#define NUMA_SLOW_LATENCY 300    // Latencia de la memoria lenta (CXL, ns)
+
+// Nivel de memoria de un nodo
+typedef enum {
+  MEMORY_TIER_FAST = 0, // DRAM con CPUs propias
+  MEMORY_TIER_SLOW = 1  // Memoria lenta sin CPUs (por ejemplo CXL)
+} MemoryTier;
+
+// Nodo NUMA: un rango contiguo de marcos físicos y un grupo de CPUs
+typedef struct {
+  int firstFrame;          // Primer marco del nodo
+  int numFrames;           // Marcos del nodo
+  int firstCpu;            // Primera CPU del nodo
+  int numCpus;             // CPUs del nodo (0 en un nodo de memoria lenta)
+  MemoryTier tier;         // Nivel de memoria del nodo
+  long localAccesses;      // Accesos desde sus CPUs a su propia memoria
+  long remoteAccesses;     // Accesos desde sus CPUs a memoria de otro nodo
+  long localAllocations;   // Bloques ubicados en el nodo pedido
+  long foreignAllocations; // Bloques que se pidieron aquí y acabaron en
+                           // otro nodo por falta de marcos libres
+  long pagesMigratedIn;    // Páginas traídas por el balanceo automático
+  long pagesMigratedOut;   // Páginas que el balanceo se llevó a otro nodo
+} NumaNode;
+
+// Estadísticas globales de la topología
+typedef struct {
+  long accessLatency;    // Latencia acumulada de todos los accesos (ns)
+  long accesses;         // Accesos contabilizados
+  long pageMigrations;   // Páginas movidas por el balanceo automático
+  long taskMigrations;   // Cambios de nodo de un proceso
+  SimTime migrationTime; // Tiempo total perdido en esos cambios
+} NumaStatistics;
+
+// Configurar la topología (nodos, CPUs por nodo, latencias local y remota,
+// coste de mover un proceso de nodo y balanceo automático); debe llamarse
+// antes de initializeMemorySystem, que reparte los marcos entre los nodos
+bool configureNumaTopology(int nodes, int cpusPerNode, int localLatency,
+                           int remoteLatency, int migrationCost,
+                           bool balancing);
+
+// Separar los últimos frames marcos del último nodo en un nodo de memoria
+// lenta sin CPUs con la latencia indicada; debe llamarse después de
+// configureNumaTopology y antes de initializeMemorySystem
+bool configureSlowTier(int frames, int latency);
+
+// Número de nodos configurados
+int numaNodeCount();
+
+// Número de CPUs de todos los nodos
+int numaCpuCount();
+
+// Nivel de memoria de un nodo
+MemoryTier numaNodeTier(int node);
+
+// Nodo i-ésimo en el orden de reserva desde node: primero los de su mismo
+// nivel (rotando desde node) y después los del otro
+int numaFallbackNode(int node, int i);
+
+// Rango de marcos de un nodo
+void numaNodeFrames(int node, int *firstFrame, int *numFrames);
+
+// Nodo que contiene un marco
+int numaNodeOfFrame(int frame);
+
+// Nodo de la CPU en la que se ejecuta un proceso (o de la CPU activa si
+// el proceso aún no tiene CPU o es NULL)
+int numaProcessNode(const Process *process);
+
+// Nodo preferido para una página según la política del proceso (la página
+// pageNumber en unidades de su tamaño); fallback indica si puede ubicarse
+// en otro nodo cuando el preferido no tiene marcos libres
+int numaPlacementNode(const Process *process, unsigned long pageNumber,
+                      bool *fallback);
+
+// Indica si el balanceo automático puede mover las páginas del proceso
+bool numaBalancingAllowed(const Process *process);
+
+// Contabilizar un acceso desde una CPU del nodo cpuNode a memoria del
+// nodo memoryNode
+void numaRecordAccess(int cpuNode, int memoryNode);
+
+// Contabilizar un bloque ubicado en actualNode cuando se pidió en
+// preferredNode
+void numaRecordAllocation(int preferredNode, int actualNode);
+
+// Contabilizar una página migrada entre nodos
+void numaRecordMigration(int fromNode, int toNode);
+
+// Elegir la CPU del proceso para su siguiente quantum (afinidad con la
+// CPU anterior, nodo de la política bind o nodo donde reside la mayor
+// parte de su memoria); devuelve el tiempo perdido si cambia de nodo
+int numaScheduleProcess(Process *process, SimTime currentTime);
+
+// Liberar la CPU de un proceso terminado
+void numaReleaseProcess(Process *process);
+
+// Asignar de nuevo a un proceso restaurado la CPU que tenía
+void numaRestoreCpu(Process *process, int cpu);
+
+// Obtener las estadísticas acumuladas
+NumaStatistics getNumaStatistics();
+
+// Mostrar la topología y la localidad de los accesos por nodo
+void displayNumaStatistics();
+
+#endif // NUMA_H
@@ -0,0 +1,69 @@
+#ifndef ONLINE_H
+#define ONLINE_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define ONLINE_LINE_LENGTH 512  // Longitud máxima de un mensaje JSON
+#define ONLINE_MAX_CLIENTS 8    // Conexiones simultáneas al socket
+#define ONLINE_MAX_BURSTS 32    // Ráfagas de CPU máximas por llegada
+#define ONLINE_POLL_MS 50       // Espera de los hilos de lectura antes de
+                                // comprobar si deben terminar
+#define ONLINE_IDLE_WAIT_US 1000 // Espera del bucle de eventos sin procesos
+
+// Modo en línea: uno o varios hilos de lectura reciben mensajes JSON (uno
+// por línea) por la entrada estándar o por un socket Unix y los dejan en una
+// cola MPSC sin bloqueos; el bucle de eventos del planificador los consume
+// entre dos pasadas por la cola de procesos, así que todo el estado de la
+// simulación sigue siendo de un solo hilo. Mensajes:
+//   {"type":"arrival","id":7,"start":120,"priority":2,"pages":4,
+//    "written":1,"cpu":[30,20],"io":[10]}
+//   {"type":"query"}              proyección para una llegada nueva
+//   {"type":"query","cpu":[40]}   ... con su demanda de CPU
+//   {"type":"query","id":7}       proyección de un proceso admitido
+//   {"type":"end"}                terminar cuando acaben los procesos
+// Las respuestas y las métricas de cada proceso completado se emiten como
+// líneas JSON al cliente que lo envió
+
+// Estadísticas del modo en línea
+typedef struct {
+  long messages;              // Mensajes recibidos
+  long arrivals;              // Procesos admitidos
+  long rejected;              // Llegadas rechazadas (cola llena o mensaje
+                              // inválido)
+  long queries;               // Consultas atendidas
+  long completed;             // Procesos admitidos que terminaron
+  TimeAccumulator turnaround; // Sus tiempos de retorno
+  TimeAccumulator wait;       // Sus tiempos de espera
+} OnlineStatistics;
+
+// Empezar a recibir mensajes por la entrada estándar (socketPath NULL) o
+// por un socket Unix en socketPath; devuelve false si no se pudo abrir
+bool startOnlineIngest(const char *socketPath);
+
+// Detener los hilos de lectura y descartar los mensajes pendientes
+void stopOnlineIngest();
+
+// Indica si el modo en línea sigue recibiendo llegadas
+bool onlineStreamOpen();
+
+// Consumir los mensajes pendientes en el tiempo indicado: admitir las
+// llegadas y responder las consultas; con wait, esperar hasta recibir
+// alguna llegada o hasta que se cierre el flujo. Devuelve los procesos
+// admitidos
+int onlineIngest(SimTime currentTime, bool wait);
+
+// Emitir las métricas de un proceso terminado admitido en línea
+void onlineProcessCompleted(Process *process, SimTime currentTime);
+
+// Liberar un proceso terminado si fue admitido en línea (deja su hueco en
+// la cola); devuelve false si no es suyo
+bool onlineReleaseProcess(Process *process);
+
+// Obtener las estadísticas acumuladas
+OnlineStatistics getOnlineStatistics();
+
+// Mostrar las estadísticas del modo en línea
+void displayOnlineStatistics();
+
+#endif // ONLINE_H
@@ -0,0 +1,75 @@
+#ifndef OOM_H
+#define OOM_H
+
+#include "process.h"
+#include <stdbool.h>
+
+// Políticas de compromiso de memoria (como vm.overcommit_memory)
+typedef enum {
+  OVERCOMMIT_HEURISTIC = 0, // Rechaza solo lo que no cabe ni en RAM + swap
+  OVERCOMMIT_ALWAYS = 1,    // Nunca rechaza
+  OVERCOMMIT_NEVER = 2      // Límite: swap + ratio% de la RAM
+} OvercommitPolicy;
+
+#define OOM_DEFAULT_POLICY OVERCOMMIT_HEURISTIC
+#define OOM_DEFAULT_RATIO 50      // Porcentaje de la RAM con OVERCOMMIT_NEVER
+#define OOM_SCORE_ADJ_MIN -1000   // oomScoreAdj de un proceso inmune
+#define OOM_SCORE_ADJ_MAX 1000    // oomScoreAdj máximo
+#define OOM_SCORE_SCALE 1000      // Puntos de un proceso que ocupa toda la RAM
+#define OOM_PRIORITY_POINTS 50    // Puntos por nivel de prioridad (los de
+                                  // segundo plano se eligen antes)
+
+// Estadísticas del compromiso de memoria y del OOM killer
+typedef struct {
+  long committedPages;    // Páginas comprometidas ahora
+  long maxCommittedPages; // Máximo de páginas comprometidas
+  long refused;           // Procesos rechazados por el límite
+  long kills;             // Procesos eliminados por el OOM killer
+  long killedFrames;      // Marcos que liberaron
+} OomStatistics;
+
+// Elegir la política de compromiso (ratio: porcentaje de la RAM que cuenta
+// con OVERCOMMIT_NEVER) y activar o no el OOM killer. Vacía las
+// estadísticas; debe llamarse sin procesos registrados
+bool configureOom(OvercommitPolicy policy, int ratio, bool killer);
+
+// Indica si el OOM killer está activo
+bool oomKillerEnabled();
+
+// Comprometer la memoria de un proceso (memorySize) al registrarlo en el
+// conjunto de marcos set; false si la política lo rechaza
+bool oomCommitProcess(int set, Process *process);
+
+// Liberar el compromiso de un proceso y retirarlo del índice de víctimas
+void oomReleaseProcess(int set);
+
+// Vaciar el índice de víctimas y el compromiso para registrar de nuevo con
+// oomRestoreProcess los conjuntos de marcos de un checkpoint
+void oomResetIndex();
+
+// Registrar el proceso restaurado en el conjunto set comprometiendo su
+// memoria sin aplicar la política, que ya la admitió al encolarlo
+void oomRestoreProcess(int set, Process *process);
+
+// Actualizar los marcos residentes de un proceso en el índice de víctimas
+void oomUpdateResident(int set, int residentFrames);
+
+// Conjunto de marcos del proceso con mayor puntuación OOM (NO_FRAME si
+// ninguno es elegible: inmunes, de tiempo real o sin marcos) y su
+// puntuación en *score
+int oomSelectVictim(long *score);
+
+// Contabilizar un proceso eliminado que liberó frames marcos; queda
+// pendiente de que el planificador lo retire
+void oomRecordKill(Process *victim, int frames);
+
+// Siguiente proceso eliminado pendiente de retirar (NULL si no hay)
+Process *oomTakeVictim();
+
+// Obtener las estadísticas acumuladas
+OomStatistics getOomStatistics();
+
+// Mostrar el compromiso de memoria y las víctimas (solo si se configuró)
+void displayOomStatistics();
+
+#endif // OOM_H
@@ -0,0 +1,69 @@
+#ifndef PAGECACHE_H
+#define PAGECACHE_H
+
+#include "process.h"
+
+#define PAGE_CACHE_OWNER -2        // processId de las páginas de la caché
+#define PAGE_CACHE_BUCKETS 64      // Cubetas del índice (archivo, página)
+#define PAGE_CACHE_HIT_COST 1      // E/S mínima aunque todo acierte
+#define PAGE_CACHE_DIRTY_EXPIRE 30 // Antigüedad de una página sucia antes
+                                   // de su escritura diferida
+#define PAGE_CACHE_ACTIVE_RATIO 1  // Máximo de activas por cada inactiva
+
+// Página de archivo en la caché (la Page va primero para poder ubicarla
+// en un marco como cualquier otra página)
+typedef struct CachePage {
+  Page page;                   // Página ubicada en memoria física
+  int fileId;                  // Archivo al que pertenece
+  long index;                  // Número de página dentro del archivo
+  bool active;                 // En la lista activa (o en la inactiva)
+  SimTime dirtyTime;           // Tiempo en que se ensució
+  struct CachePage *prev;      // Anterior en su lista (hacia la más reciente)
+  struct CachePage *next;      // Siguiente en su lista (hacia la más antigua)
+  struct CachePage *hashNext;  // Siguiente en la cubeta del índice
+} CachePage;
+
+// Estadísticas de la caché de páginas
+typedef struct {
+  long hits;            // Páginas encontradas en la caché
+  long misses;          // Páginas leídas del archivo
+  long writes;          // Páginas escritas (absorbidas por la caché)
+  long promotions;      // Paso de inactiva a activa (segundo acceso)
+  long demotions;       // Paso de activa a inactiva (equilibrio de listas)
+  long evictions;       // Páginas recuperadas por presión de memoria
+  long flushedPages;    // Páginas escritas por expiración
+  long reclaimWrites;   // Páginas sucias escritas al recuperarlas
+  long allocationFails; // Fallos sin marco disponible
+  SimTime savedIoTime;  // Tiempo de E/S ahorrado por los aciertos
+} PageCacheStatistics;
+
+// Atender la petición de archivo de una ráfaga de E/S a través de la caché;
+// ioTime es la duración sin ningún acierto. Devuelve la duración efectiva
+// y en *devicePages las páginas que hay que leer del dispositivo
+SimTime pageCacheAccess(const FileRequest *request, int processId,
+                        SimTime ioTime, SimTime currentTime,
+                        int *devicePages);
+
+// Escribir en su dispositivo las páginas sucias que superaron
+// PAGE_CACHE_DIRTY_EXPIRE
+void pageCacheWriteBack(SimTime currentTime);
+
+// Página inactiva más antigua (o activa si no hay inactivas) para competir
+// por edad con la memoria anónima; NULL si la caché está vacía
+Page *pageCacheReclaimCandidate();
+
+// Notificar que la memoria recuperó el marco de una página de la caché
+// (ya liberado); la escribe en su dispositivo si está sucia y la retira de
+// la caché
+void pageCacheEvicted(Page *page, SimTime currentTime);
+
+// Escribir las páginas sucias y vaciar toda la caché
+void dropPageCache();
+
+// Obtener las estadísticas acumuladas
+PageCacheStatistics getPageCacheStatistics();
+
+// Mostrar aciertos, tamaño de las listas y escrituras diferidas
+void displayPageCacheStatistics();
+
+#endif // PAGECACHE_H
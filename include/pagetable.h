@@ -0,0 +1,46 @@
+#ifndef PAGETABLE_H
+#define PAGETABLE_H
+
+#include "process.h"
+#include <stdint.h>
+
+#define PAGE_OFFSET_BITS 12  // log2(PAGE_SIZE)
+#define PAGE_TABLE_BITS 9    // Bits de índice por nivel
+#define PAGE_TABLE_ENTRIES (1 << PAGE_TABLE_BITS)
+#define PAGE_TABLE_LEVELS 4  // Niveles por defecto (2 a 4)
+#define MIN_PAGE_TABLE_LEVELS 2
+#define MAX_PAGE_TABLE_LEVELS 4
+
+// Nodo de la tabla de páginas radix: apunta a nodos hijos o a páginas
+// mapeadas; las páginas grandes son hojas en niveles intermedios
+typedef struct PageTableNode {
+  void *entries[PAGE_TABLE_ENTRIES];
+  uint64_t leafMask[PAGE_TABLE_ENTRIES / 64]; // Entradas que son hojas
+} PageTableNode;
+
+// Tabla de páginas multinivel de un proceso
+typedef struct PageTable {
+  PageTableNode *root; // Nodo raíz
+  int levels;          // Número de niveles
+  int tableNodes;      // Nodos reservados (sobrecoste de la tabla)
+  int mappedPages;     // Páginas mapeadas
+} PageTable;
+
+// Crear una tabla de páginas con el número de niveles indicado
+PageTable *createPageTable(int levels);
+
+// Liberar una tabla de páginas y todos sus nodos
+void destroyPageTable(PageTable *table);
+
+// Mapear una página (de cualquier tamaño) en la dirección virtual indicada
+bool mapPage(PageTable *table, unsigned long virtualAddress, Page *page);
+
+// Recorrer la tabla; devuelve la página y los niveles visitados
+Page *walkPageTable(PageTable *table, unsigned long virtualAddress,
+                    int *levelsVisited);
+
+// Número de página virtual de una dirección para un tamaño de página
+unsigned long virtualPageNumber(unsigned long virtualAddress,
+                                PageSizeClass sizeClass);
+
+#endif // PAGETABLE_H
@@ -0,0 +1,80 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <stdbool.h>
+
+#define PREFETCH_ENABLED true       // Activar la precarga tras cada fallo
+#define PREFETCH_MIN_WINDOW 1       // Ventana secuencial inicial
+#define PREFETCH_MAX_WINDOW 8       // Ventana secuencial máxima
+#define PREFETCH_STRIDE_CONFIRM 2   // Repeticiones para confirmar un salto
+#define PREFETCH_MARKOV false       // Activar el predictor de Markov
+#define PREFETCH_MARKOV_ENTRIES 256 // Entradas de la tabla de transiciones
+#define PREFETCH_MAX_CANDIDATES (PREFETCH_MAX_WINDOW + 1)
+#define NO_PREFETCH -1 // Marco no cargado por precarga (o ya usado)
+
+// Predictor que propuso una página precargada
+typedef enum {
+  PREFETCH_SEQUENTIAL = 0, // Lectura anticipada secuencial
+  PREFETCH_STRIDE = 1,     // Salto constante entre fallos
+  PREFETCH_MARKOV_NEXT = 2 // Sucesor aprendido del flujo de fallos
+} PrefetchSource;
+
+#define NUM_PREFETCH_SOURCES 3
+
+// Página propuesta para precarga
+typedef struct {
+  unsigned long virtualAddress; // Dirección virtual de la página
+  PrefetchSource source;        // Predictor que la propuso
+} PrefetchCandidate;
+
+// Estado del flujo de fallos de un proceso
+typedef struct {
+  int processId;         // Proceso del flujo (-1 si está libre)
+  bool valid;            // Ya se registró un fallo previo
+  unsigned long lastVpn; // Página del último fallo (en unidades de su tamaño)
+  long lastStride;       // Salto entre los dos últimos fallos
+  int strideHits;        // Repeticiones consecutivas del salto
+  int window;            // Ventana secuencial actual
+} PrefetchStream;
+
+// Estadísticas por predictor
+typedef struct {
+  long issued[NUM_PREFETCH_SOURCES];     // Páginas precargadas
+  long hits[NUM_PREFETCH_SOURCES];       // Precargadas que se usaron
+  long wasted[NUM_PREFETCH_SOURCES];     // Liberadas sin usarse
+  long wastedCost[NUM_PREFETCH_SOURCES]; // Marcos x tiempo ocupados en vano
+  long faults;                           // Fallos observados
+  int maxWindow;                         // Mayor ventana secuencial alcanzada
+} PrefetchStatistics;
+
+// Configurar la precarga (activación, ventana máxima y predictor de
+// Markov) y vaciar su estado
+bool configurePrefetcher(bool enabled, int maxWindow, bool markov);
+
+// Registrar un fallo del proceso en la dirección indicada (página de size
+// bytes), entrenar los predictores y proponer hasta max páginas a precargar
+int prefetchPredict(int processId, unsigned long virtualAddress,
+                    unsigned long size, PrefetchCandidate *candidates,
+                    int max);
+
+// Contabilizar una página precargada
+void prefetchRecordIssued(PrefetchSource source);
+
+// Contabilizar el primer uso de una página precargada
+void prefetchRecordHit(PrefetchSource source);
+
+// Contabilizar una página precargada liberada sin usarse tras ocupar
+// frameTicks marcos x tiempo; reduce la ventana del proceso
+void prefetchRecordWaste(int processId, PrefetchSource source,
+                         long frameTicks);
+
+// Olvidar el flujo de un proceso terminado
+void prefetchForgetProcess(int processId);
+
+// Obtener las estadísticas acumuladas
+PrefetchStatistics getPrefetchStatistics();
+
+// Mostrar precisión y coste de cada predictor
+void displayPrefetchStatistics();
+
+#endif // PREFETCH_H
@@ -1,6 +1,7 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include "simtime.h"
 #include <pthread.h>
 #include <stdbool.h>
 
@@ -12,29 +13,102 @@ typedef enum {
   BACKGROUND_PRIORITY = 3   // Procesos en segundo plano
 } ProcessPriority;
 
-// Estructura de página
-typedef struct {
-  int id;             // Identificador de página
-  bool active;        // Indica si la página está activa
-  int processId;      // Identificador del proceso padre
-  int lastAccessTime; // Último timestamp de acceso
-  bool inMemory;      // Indica si la página está en memoria física
+// Tamaños de página soportados
+typedef enum {
+  PAGE_SIZE_4K = 0, // Página base
+  PAGE_SIZE_2M = 1, // Página grande de 2 MiB
+  PAGE_SIZE_1G = 2  // Página gigante de 1 GiB
+} PageSizeClass;
+
+#define NUM_PAGE_SIZES 3
+
+// Políticas de ubicación NUMA de la memoria de un proceso
+typedef enum {
+  NUMA_POLICY_FIRST_TOUCH = 0, // En el nodo de la CPU que provoca el fallo
+  NUMA_POLICY_INTERLEAVE = 1,  // Repartida página a página entre los nodos
+  NUMA_POLICY_BIND = 2         // Solo en el nodo numaNode
+} NumaPolicy;
+
+#define NO_CPU -1 // Proceso aún sin CPU asignada
+#define NO_ZSWAP_ENTRY -1 // Página sin copia en el almacén comprimido
+
+// Estructura de página (los campos de 8 bytes primero, para que los
+// tiempos de 64 bits no añadan relleno)
+typedef struct Page {
+  unsigned long virtualAddress; // Dirección virtual de la página
+  SimTime lastAccessTime;       // Último timestamp de acceso
+  SimTime readyTime;            // Fin de su lectura desde swap
+  struct Page *nextSharer;      // Siguiente página que mapea el mismo marco
+  struct Page *sharedAnchor;    // Página del segmento compartido (o NULL)
+  int id;                       // Identificador de página
+  int processId;                // Identificador del proceso padre
+  int frameIndex;               // Marco que ocupa (-1 si no está en memoria)
+  PageSizeClass sizeClass;      // Tamaño de la página
+  int swapSlot;                 // Slot de swap con su copia (-1 si no tiene)
+  int zswapEntry;               // Entrada en el almacén comprimido (o -1)
+  int accessNode;               // Nodo NUMA de la CPU del último acceso
+  int remoteAccesses;           // Accesos remotos seguidos desde accessNode
+  bool active;                  // Indica si la página está activa
+  bool inMemory;                // Indica si la página está en memoria física
+  bool dirty;                   // Modificada desde su última copia en swap
+  bool readAhead;               // Cargada por lectura anticipada, sin usar
+  bool copyOnWrite;             // Compartida tras fork; escribirla la copia
 } Page;
 
+#define SHARED_REGION_OWNER -1 // processId de las páginas de un segmento
+
+// Segmento de memoria compartida (mapeo compartido entre procesos): sus
+// páginas ancla guardan el estado común (marco, slot de swap, suciedad)
+typedef struct {
+  int id;         // Identificador del segmento
+  int totalPages; // Páginas de 4 KiB del segmento
+  Page *pages;    // Páginas ancla del segmento
+} SharedRegion;
+
+struct PageTable;    // Tabla de páginas multinivel (pagetable.h)
+struct RealTimeTask; // Tarea de la clase de tiempo real (realtime.h)
+struct ResourceGroup; // Grupo de recursos (cgroup.h)
+
+// Petición de archivo asociada a una ráfaga de E/S
+typedef struct {
+  int fileId;  // Archivo accedido
+  long offset; // Desplazamiento inicial en bytes
+  long length; // Bytes transferidos
+  bool write;  // Escritura (absorbida por la caché) o lectura
+} FileRequest;
+
 // Estructura de proceso
 typedef struct {
   int id;                   // Identificador del proceso
-  int startTime;            // Tiempo de inicio del proceso
   ProcessPriority priority; // Prioridad del proceso
   int memorySize;           // Tamaño total de memoria
   int totalPages;           // Número total de páginas
+  SimTime startTime;        // Tiempo de inicio del proceso
   Page *pages;              // Arreglo de páginas del proceso
+  struct PageTable *pageTable; // Tabla de páginas del proceso
+  const PageSizeClass *pageSizeClasses; // Tamaño de cada página (NULL = 4K)
+  SharedRegion *sharedRegion;  // Segmento compartido adjunto (o NULL)
+  Page *sharedPages;           // Páginas del proceso que mapean el segmento
+  NumaPolicy numaPolicy;       // Política de ubicación NUMA
+  int numaNode;                // Nodo de la política bind
+  int cpu;                     // CPU asignada (NO_CPU antes de ejecutarse)
+  struct RealTimeTask *realTime; // Tarea de tiempo real (NULL: Round Robin)
+  struct ResourceGroup *group;   // Grupo de recursos (NULL: sin grupo)
+  int oomScoreAdj;             // Ajuste de la puntuación OOM (-1000: inmune)
 
   // Gestión de ciclos de CPU
-  int *cpuBurstTimes; // Tiempos de ráfagas de CPU
-  int *ioBurstTimes;  // Tiempos de espera de E/S
-  int burstIndex;     // Índice de la ráfaga actual
-  int totalBursts;    // Número total de ráfagas
+  SimTime *cpuBurstTimes; // Tiempos de ráfagas de CPU
+  SimTime *ioBurstTimes;  // Tiempos de espera de E/S
+  const FileRequest *ioRequests; // Archivo de cada ráfaga de E/S (NULL si
+                                 // la espera es opaca)
+  SimTime blockedUntil;   // Bloqueado por E/S de swap hasta este tiempo
+  int burstIndex;         // Índice de la ráfaga actual
+  int totalBursts;        // Número total de ráfagas
+  int writtenPages;       // Páginas (las primeras) escritas en cada quantum
+  bool pagesLoaded;       // Las páginas del quantum bloqueado ya están cargadas
+  bool ownsBursts;        // Ráfagas reservadas dinámicamente (procesos hijos)
+  bool ownsLayout;        // Tamaños de página y peticiones de archivo
+                          // reservados dinámicamente (procesos restaurados)
 
   // Estados del proceso
   enum { READY, RUNNING, WAITING, TERMINATED } state;
@@ -42,9 +116,43 @@ typedef struct {
   pthread_mutex_t processMutex; // Mutex para sincronización
 
   // Métricas de rendimiento
-  int waitTime;       // Tiempo de espera
-  int turnaroundTime; // Tiempo total de ejecución
-  int responseTime;   // Tiempo de respuesta
+  SimTime waitTime;       // Tiempo de espera
+  SimTime turnaroundTime; // Tiempo total de ejecución
+  SimTime responseTime;   // Tiempo de respuesta
 } Process;
 
+#define PROCESS_VIRTUAL_BASE 0x400000UL // Dirección virtual de la primera página
+#define SHARED_REGION_BASE 0x40000000UL // Dirección de los segmentos compartidos
+
+// Inicializar una página no residente con un identificador global nuevo
+void initializePage(Page *page, int processId, unsigned long virtualAddress,
+                    PageSizeClass sizeClass);
+
+// Siguiente identificador global de página
+int nextPageIdentifier();
+
+// Continuar la numeración global de páginas desde nextId (al restaurar un
+// checkpoint)
+void resumePageIds(int nextId);
+
+// Reservar las páginas de un proceso y mapearlas en su tabla de páginas
+bool initializeProcessPages(Process *process);
+
+// Liberar las páginas y la tabla de páginas de un proceso
+void releaseProcessPages(Process *process);
+
+// Crear un proceso hijo que comparte las páginas del padre con
+// copia en escritura y hereda sus ráfagas pendientes
+Process *forkProcess(Process *parent, int childId, SimTime currentTime);
+
+// Crear un segmento compartido de totalPages páginas de 4 KiB
+SharedRegion *createSharedRegion(int id, int totalPages);
+
+// Liberar un segmento compartido (sin procesos adjuntos)
+void destroySharedRegion(SharedRegion *region);
+
+// Adjuntar un segmento compartido a un proceso, mapeándolo en
+// SHARED_REGION_BASE
+bool attachSharedRegion(Process *process, SharedRegion *region);
+
 #endif // PROCESS_H
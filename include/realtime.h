@@ -0,0 +1,91 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define MAX_REALTIME_TASKS 8 // Tareas de tiempo real admitidas a la vez
+#define REALTIME_RTA_ITERATIONS 64 // Iteraciones máximas del análisis de
+                                   // tiempo de respuesta
+
+// Políticas de la clase de tiempo real
+typedef enum {
+  REALTIME_EDF = 0,            // Plazo absoluto más próximo primero
+  REALTIME_RATE_MONOTONIC = 1  // Prioridad fija: menor periodo primero
+} RealTimePolicy;
+
+#define REALTIME_DEFAULT_POLICY REALTIME_EDF
+
+// Tarea de tiempo real: cada ráfaga de CPU del proceso es un trabajo (su
+// demanda real, que puede superar el WCET declarado). Una tarea periódica
+// se activa cada period y su E/S se solapa con el resto del periodo; una
+// esporádica, como pronto period después de la activación anterior más la
+// ráfaga de E/S que sigue al trabajo
+typedef struct RealTimeTask {
+  Process *process;         // Proceso de la tarea (NULL cuando terminó)
+  SimTime period;           // Periodo o separación mínima entre activaciones
+  SimTime deadline;         // Plazo relativo a cada activación
+  SimTime wcet;             // Peor tiempo de ejecución declarado
+  SimTime release;          // Activación del trabajo actual o del siguiente
+  SimTime absoluteDeadline; // Plazo del trabajo actual
+  SimTime remaining;        // CPU que le queda al trabajo actual
+  SimTime worstResponse;    // Mayor tiempo de respuesta de sus trabajos
+  SimTime worstLateness;    // Mayor retraso respecto a su plazo
+  long jobs;                // Trabajos activados
+  long completedJobs;       // Trabajos terminados
+  long missedDeadlines;     // Trabajos terminados después de su plazo
+  long overruns;            // Trabajos que superaron el WCET
+  int processId;            // Identificador del proceso
+  int readyIndex;           // Posición en el montículo de trabajos activos
+  int releaseIndex;         // Posición en el montículo de activaciones
+  bool sporadic;            // Activaciones esporádicas
+} RealTimeTask;
+
+// Estadísticas globales de la clase de tiempo real
+typedef struct {
+  long admitted;        // Tareas admitidas
+  long rejected;        // Tareas rechazadas por el test de admisión
+  long jobs;            // Trabajos activados
+  long missedDeadlines; // Trabajos que superaron su plazo
+  long preemptions;     // Quantums de Round Robin acortados por una
+                        // activación
+} RealTimeStatistics;
+
+// Elegir la política (vacía la clase; debe llamarse antes de admitir)
+void configureRealTime(RealTimePolicy policy);
+
+// Admitir un proceso como tarea de tiempo real si el conjunto sigue siendo
+// planificable: con EDF, densidad total (WCET / min(plazo, periodo)) de
+// como máximo 1; con rate-monotonic, la cota de Liu y Layland o, si no
+// basta, el análisis exacto del tiempo de respuesta. El primer trabajo se
+// activa en su startTime. Devuelve false si se rechaza
+bool admitRealTimeTask(Process *process, SimTime period, SimTime deadline,
+                       SimTime wcet, bool sporadic);
+
+// Activar los trabajos que llegaron hasta currentTime y devolver el de
+// mayor prioridad que puede ejecutarse (NULL si ninguno)
+RealTimeTask *realTimeNext(SimTime currentTime);
+
+// Próxima activación o fin de un bloqueo de la clase (-1 si no hay)
+SimTime realTimeNextEvent(SimTime currentTime);
+
+// CPU que puede recibir el trabajo antes de la próxima activación, que
+// podría adelantársele
+SimTime realTimeSlice(const RealTimeTask *task, SimTime currentTime);
+
+// Acortar un quantum de Round Robin que empieza en currentTime para que
+// termine en la próxima activación; devuelve su duración
+SimTime realTimePreempt(SimTime currentTime, SimTime executionTime);
+
+// Cargar al trabajo la CPU recibida hasta currentTime; al terminar el
+// trabajo programa la siguiente activación. Devuelve true si la tarea
+// terminó su último trabajo
+bool realTimeCharge(RealTimeTask *task, SimTime ran, SimTime currentTime);
+
+// Obtener las estadísticas acumuladas
+RealTimeStatistics getRealTimeStatistics();
+
+// Mostrar trabajos, plazos incumplidos y respuesta de cada tarea
+void displayRealTimeStatistics();
+
+#endif // REALTIME_H
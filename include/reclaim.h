@@ -0,0 +1,60 @@
+#ifndef RECLAIM_H
+#define RECLAIM_H
+
+#include "simtime.h"
+#include <stdbool.h>
+
+#define RECLAIM_LOW_WATERMARK 2   // Marcos libres por debajo de los que
+                                  // despierta el demonio
+#define RECLAIM_HIGH_WATERMARK 4  // Marcos libres con los que vuelve a dormir
+#define RECLAIM_BATCH 2           // Bloques recuperados por turno
+#define RECLAIM_DIRECT_COST 2     // Tiempo de reclamación directa por bloque
+#define RECLAIM_LATENCY_BUCKETS 8 // Intervalos del histograma de latencia
+
+// Camino por el que se resolvió un fallo de página
+typedef enum {
+  RECLAIM_FAST_PATH = 0, // Había un bloque libre
+  RECLAIM_DIRECT = 1     // El fallo tuvo que desalojar
+} ReclaimPath;
+
+#define NUM_RECLAIM_PATHS 2
+
+// Estadísticas de la reclamación de memoria
+typedef struct {
+  long wakeups;                   // Veces que el demonio despertó
+  long backgroundFrames;          // Bloques recuperados por el demonio
+  long directFrames;              // Bloques desalojados dentro de un fallo
+  long faults[NUM_RECLAIM_PATHS]; // Fallos por camino
+  // Histograma por camino: el intervalo 0 es latencia nula y el k cubre
+  // [2^(k-1), 2^k); el último recoge el resto
+  long latency[NUM_RECLAIM_PATHS][RECLAIM_LATENCY_BUCKETS];
+  TimeAccumulator latencyTime[NUM_RECLAIM_PATHS]; // Latencia acumulada
+  SimTime maxLatency[NUM_RECLAIM_PATHS];          // Latencia máxima
+} ReclaimStatistics;
+
+// Configurar la reclamación: el demonio despierta con menos de low marcos
+// libres y recupera como máximo batch por turno hasta tener high (low 0 lo
+// desactiva); cada bloque desalojado dentro de un fallo lo retrasa
+// directCost. Vacía las estadísticas
+bool configureReclaim(int low, int high, int batch, SimTime directCost);
+
+// Turno del demonio entre dos quantums (uno por instante simulado):
+// despertarlo si la memoria libre bajó de la marca baja y recuperar
+// bloques LRU fuera del camino de los fallos
+void runBackgroundReclaim(SimTime currentTime);
+
+// Retraso que añaden a un fallo sus desalojos directos
+SimTime directReclaimDelay(int evictedBlocks);
+
+// Registrar un fallo resuelto, los bloques que desalojó y su latencia
+// (hasta que la página está lista)
+void reclaimRecordFault(int evictedBlocks, SimTime latency);
+
+// Obtener las estadísticas acumuladas
+ReclaimStatistics getReclaimStatistics();
+
+// Mostrar la reclamación directa y en segundo plano y la latencia de los
+// fallos (solo si se configuró)
+void displayReclaimStatistics();
+
+#endif // RECLAIM_H
@@ -0,0 +1,28 @@
+#ifndef RNG_H
+#define RNG_H
+
+#define SIMULATION_SEED 1 // Semilla global por defecto
+
+// Flujo de números pseudoaleatorios (splitmix64): la secuencia depende solo
+// de la semilla global y del identificador del flujo, no de la biblioteca C
+typedef struct {
+  unsigned long long state;
+} RngStream;
+
+// Fijar la semilla global; los flujos creados después derivan de ella
+void setSimulationSeed(unsigned long long seed);
+
+// Semilla global actual
+unsigned long long getSimulationSeed();
+
+// Inicializar un flujo independiente para un componente (streamId
+// distingue, por ejemplo, cada dispositivo)
+void rngSeed(RngStream *stream, unsigned long long streamId);
+
+// Siguiente valor de 32 bits del flujo
+unsigned int rngNext(RngStream *stream);
+
+// Valor uniforme en [0, 1)
+double rngUniform(RngStream *stream);
+
+#endif // RNG_H
@@ -11,6 +11,15 @@ int addProcessToQueue(Process *process);
 // Función para ejecutar el planificador Round Robin avanzado
 void advancedRoundRobinScheduler();
 
+// Reloj simulado del planificador
+SimTime getSchedulerClock();
+
+// Fijar el reloj simulado (al restaurar un checkpoint)
+void setSchedulerClock(SimTime time);
+
+// Guardar un checkpoint en path en cuanto el reloj alcance time
+void requestCheckpoint(SimTime time, const char *path);
+
 // Obtener acceso a la cola de procesos
 Process **getProcessQueue();
 
@@ -0,0 +1,56 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include "simtime.h"
+#include <stdbool.h>
+
+#define SIMCLOCK_TICKS_PER_SECOND SIM_TICKS_PER_SECOND // Ritmo sincronizado
+                                                    // por defecto (tiempo real)
+
+// Modo de avance del reloj simulado
+typedef enum {
+  CLOCK_MODE_BATCH = 0, // Tan rápido como se pueda, saltando los huecos
+  CLOCK_MODE_PACED = 1  // Cada tick dura un tiempo fijo de reloj de pared
+} ClockMode;
+
+// Estadísticas del reloj
+typedef struct {
+  SimTime busyTicks;   // Ticks con algún proceso en ejecución
+  SimTime idleTicks;   // Ticks de huecos sin procesos ejecutables
+  long advances;       // Avances del reloj
+  double sleptSeconds; // Tiempo dormido para mantener el ritmo
+  long lateAdvances;   // Avances que llegaron tarde a su instante de pared
+  SimTime maxLagTicks; // Mayor retraso respecto al reloj de pared
+} ClockStatistics;
+
+// Configurar el modo y, en modo sincronizado, los ticks por segundo de
+// pared; el reloj de pared se ancla en el primer avance
+bool configureSimulationClock(ClockMode mode, double ticksPerSecond);
+
+// Modo configurado
+ClockMode simclockMode();
+
+// Avanzar de from a to ejecutando procesos; en modo sincronizado espera
+// hasta el instante de pared de to. Devuelve to
+SimTime simclockAdvance(SimTime from, SimTime to);
+
+// Saltar un hueco sin procesos ejecutables de from a to; por lotes es
+// inmediato y sincronizado espera como un avance normal. Devuelve to
+SimTime simclockSkip(SimTime from, SimTime to);
+
+// Tick que corresponde al reloj de pared actual, nunca menor que time (en
+// modo sincronizado, para fechar las llegadas externas); por lotes o antes
+// del primer avance devuelve time. No avanza el reloj
+SimTime simclockSync(SimTime time);
+
+// Segundos de reloj de pared desde la configuración del reloj
+double simclockWallSeconds();
+
+// Obtener las estadísticas acumuladas
+ClockStatistics getClockStatistics();
+
+// Mostrar el modo, los ticks y el rendimiento (eventos por segundo de
+// pared); se imprime fuera del registro porque depende del reloj de pared
+void displayClockStatistics();
+
+#endif // SIMCLOCK_H
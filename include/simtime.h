@@ -0,0 +1,40 @@
+#ifndef SIMTIME_H
+#define SIMTIME_H
+
+#include <limits.h>
+#include <stdbool.h>
+
+// Tiempo simulado en ticks de 64 bits: con ticks de un microsegundo una
+// traza puede durar cientos de miles de años antes de desbordarse
+typedef long long SimTime;
+
+#define SIM_TIME_MAX LLONG_MAX // Tiempo "nunca" de los acumuladores
+
+// Resolución del tick en nanosegundos (1 ms por defecto); todas las
+// constantes de tiempo del simulador (quantum, latencias) están en ticks
+#ifndef SIM_TICK_NS
+#define SIM_TICK_NS 1000000LL
+#endif
+#define SIM_TICKS_PER_SECOND (1e9 / SIM_TICK_NS)
+
+// Acumulador de métricas de tiempo que satura en lugar de desbordarse
+typedef struct {
+  SimTime sum;    // Suma de las muestras (SIM_TIME_MAX si saturó)
+  long count;     // Muestras acumuladas
+  bool saturated; // La suma dejó de ser exacta
+} TimeAccumulator;
+
+// Suma de tiempos saturada a [-SIM_TIME_MAX, SIM_TIME_MAX]
+SimTime simTimeAdd(SimTime a, SimTime b);
+
+// Convertir entre ticks y nanosegundos de la resolución configurada
+SimTime simTimeFromNanoseconds(long long nanoseconds);
+double simTimeToSeconds(SimTime ticks);
+
+// Añadir una muestra al acumulador
+void accumulateTime(TimeAccumulator *accumulator, SimTime sample);
+
+// Media de las muestras (0 sin muestras)
+double accumulatorMean(const TimeAccumulator *accumulator);
+
+#endif // SIMTIME_H
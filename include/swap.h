@@ -0,0 +1,84 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include "process.h"
+
+#define SWAP_SLOTS 1024          // Slots del dispositivo de swap
+#define SWAP_LATENCY 5           // Latencia fija por operación
+#define SWAP_BANDWIDTH 2         // Páginas transferidas por unidad de tiempo
+#define SWAP_READAHEAD_CLUSTER 4 // Slots leídos juntos (ventana alineada)
+#define SWAP_QUEUE_DEPTH 64      // Operaciones pendientes registradas
+#define NO_SWAP_SLOT -1
+
+// Tipo de operación del dispositivo de swap
+typedef enum { SWAP_READ = 0, SWAP_WRITE = 1 } SwapOperation;
+
+// Operación encolada en el dispositivo
+typedef struct {
+  SwapOperation operation; // Lectura o escritura
+  int slot;                // Primer slot transferido
+  int pages;               // Páginas transferidas
+  SimTime submitTime;      // Tiempo de envío
+  SimTime completeTime;    // Tiempo de finalización
+} SwapRequest;
+
+// Estadísticas del dispositivo de swap
+typedef struct {
+  long reads;                 // Operaciones de lectura
+  long writes;                // Operaciones de escritura (write-back)
+  long pagesRead;             // Páginas leídas (incluye lectura anticipada)
+  long pagesWritten;          // Páginas escritas
+  long readAheadPages;        // Páginas cargadas por lectura anticipada
+  long readAheadHits;         // Páginas anticipadas que se usaron
+  long readAheadWasted;       // Páginas anticipadas desalojadas sin usarse
+  long slotExhausted;         // Escrituras descartadas por falta de slots
+  TimeAccumulator queueDelay; // Espera en cola antes del servicio
+  SimTime writeBackTime;      // Tiempo de dispositivo dedicado a escrituras
+  int maxQueueDepth;          // Profundidad máxima de la cola
+} SwapStatistics;
+
+// Configurar el dispositivo (slots, latencia, ancho de banda y lectura
+// anticipada) y vaciar su estado
+bool configureSwapDevice(int slots, int latency, int bandwidth, int cluster);
+
+// Encolar la escritura de una página sucia; asigna slot si no tiene.
+// Devuelve el tiempo de finalización o -1 si no quedan slots
+SimTime swapWriteBack(Page *page, SimTime currentTime);
+
+// Encolar la lectura de una página y de sus vecinas de la ventana de
+// lectura anticipada (como máximo *readAheadCount, que al volver indica las
+// elegidas); devuelve el tiempo de finalización
+SimTime swapReadPage(Page *page, Page **readAhead, int *readAheadCount,
+                 SimTime currentTime);
+
+// Compartir un slot ocupado con otra página (fork); el slot se libera
+// cuando lo sueltan todas
+void swapShareSlot(Page *page, int slot);
+
+// Soltar el slot de una página (al terminar su proceso o al dejar de
+// coincidir su contenido)
+void swapFreeSlot(Page *page);
+
+// Ocupar un slot concreto con una página restaurada de un checkpoint (la
+// primera que lo referencia queda como dueña); false si no existe
+bool swapRestoreSlot(Page *page, int slot);
+
+// Retirar de la cola las operaciones finalizadas
+void swapAdvance(SimTime currentTime);
+
+// Notificar el uso o desalojo de una página anticipada
+void swapRecordReadAhead(bool used);
+
+// Tiempo en que el dispositivo queda libre
+SimTime swapBusyUntil();
+
+// Slots del dispositivo
+int swapSlotCount();
+
+// Obtener las estadísticas acumuladas
+SwapStatistics getSwapStatistics();
+
+// Mostrar la actividad del dispositivo de swap
+void displaySwapStatistics();
+
+#endif // SWAP_H
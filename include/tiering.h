@@ -0,0 +1,69 @@
+#ifndef TIERING_H
+#define TIERING_H
+
+#include "simtime.h"
+#include <stdbool.h>
+
+#define TIER_SLOW_FRAMES 2        // Marcos de memoria lenta por defecto
+#define TIER_SAMPLE_RATE 1        // Se muestrea 1 de cada N accesos lentos
+#define TIER_HOT_WINDOW 120       // Reuso que marca una muestra como caliente
+#define TIER_PROMOTE_THRESHOLD 2  // Muestras calientes antes de promover
+#define TIER_MIGRATION_BUDGET 4   // Páginas migradas por ventana
+#define TIER_MIGRATION_WINDOW 100 // Duración de la ventana de migración
+#define TIER_MIGRATION_COST 1     // Tiempo por página migrada entre niveles
+#define TIER_MAX_PROCESSES 64     // Procesos con estadísticas propias
+
+// Accesos de un proceso por nivel de memoria
+typedef struct {
+  int processId;     // Proceso (-1 si la entrada está libre)
+  long fastAccesses; // Accesos servidos desde la memoria rápida
+  long slowAccesses; // Accesos servidos desde la memoria lenta
+} TierProcessStatistics;
+
+// Estadísticas de la gestión de niveles de memoria
+typedef struct {
+  long samples;          // Accesos lentos muestreados
+  long hotSamples;       // Muestras con reuso dentro de la ventana
+  long promotions;       // Páginas subidas a la memoria rápida
+  long demotions;        // Páginas bajadas a la memoria lenta
+  long throttled;        // Migraciones aplazadas por el límite de ancho
+  SimTime migrationTime; // Tiempo dedicado a migrar
+} TierStatistics;
+
+// Configurar la promoción y degradación de páginas: se muestrea uno de
+// cada sampleRate accesos a la memoria lenta, una muestra es caliente si
+// la página se reusó antes de hotWindow y threshold muestras calientes la
+// promueven; como máximo budget páginas migran en cada ventana de window
+// ticks, y cada una cuesta migrationCost. Vacía las estadísticas
+bool configureTiering(int sampleRate, SimTime hotWindow, int threshold,
+                      int budget, SimTime window, SimTime migrationCost);
+
+// Indica si la gestión de niveles está activa
+bool tieringEnabled();
+
+// Contabilizar un acceso de un proceso; en la memoria lenta actualiza las
+// muestras calientes de la página (*hotSamples; sinceLastUse es el tiempo
+// desde el anterior uso de su bloque) y devuelve true si debe promoverse
+bool tierRecordAccess(int processId, bool slow, SimTime sinceLastUse,
+                      int *hotSamples);
+
+// Indica si queda ancho de banda para migrar una página en la ventana
+// actual; si no, la migración se aplaza
+bool tierMigrationAllowed(SimTime currentTime);
+
+// Contabilizar una página migrada (promovida o degradada), que consume
+// presupuesto de la ventana
+void tierRecordMigration(bool promotion);
+
+// Tiempo de migración acumulado desde la última llamada, que el
+// planificador carga al reloj simulado
+SimTime tierTakeMigrationTime();
+
+// Obtener las estadísticas acumuladas
+TierStatistics getTierStatistics();
+
+// Mostrar las migraciones y la fracción de accesos servidos desde la
+// memoria rápida por proceso (solo si está activa)
+void displayTierStatistics();
+
+#endif // TIERING_H
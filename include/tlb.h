@@ -0,0 +1,63 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include "process.h"
+
+#define TLB_SETS 16            // Conjuntos del TLB (potencia de 2)
+#define TLB_WAYS 4             // Vías por conjunto
+#define TLB_USE_ASID true      // false = vaciar el TLB en cada cambio de contexto
+#define PAGE_WALK_LEVEL_COST 1 // Coste de acceso a memoria por nivel recorrido
+
+// Entrada del TLB
+typedef struct {
+  bool valid;             // Entrada válida
+  int asid;               // Identificador de espacio de direcciones
+  unsigned long vpn;      // Número de página virtual
+  PageSizeClass sizeClass; // Tamaño de la página traducida
+  Page *page;             // Página traducida
+  unsigned long lastUsed; // Marca para reemplazo LRU dentro del conjunto
+} TlbEntry;
+
+// Estadísticas del TLB y de los recorridos de tabla
+typedef struct {
+  long hits;          // Aciertos
+  long misses;        // Fallos
+  long flushes;       // Vaciados completos
+  long invalidations; // Entradas invalidadas por desalojo
+  long walks;         // Recorridos de tabla de páginas
+  long walkCost;      // Coste acumulado de los recorridos
+} TlbStatistics;
+
+// Configurar el TLB (conjuntos, vías y uso de ASID) y vaciar estadísticas
+bool initializeTlb(int sets, int ways, bool useAsid);
+
+// Buscar una traducción para cualquier tamaño de página; devuelve NULL en
+// caso de fallo
+Page *tlbLookup(int asid, unsigned long virtualAddress);
+
+// Insertar la traducción de una página reemplazando la entrada LRU del
+// conjunto
+void tlbInsert(int asid, Page *page);
+
+// Invalidar la traducción de una página desalojada o migrada
+void tlbInvalidate(int asid, const Page *page);
+
+// Invalidar todas las entradas de un espacio de direcciones
+void tlbFlushAsid(int asid);
+
+// Notificar un cambio de contexto (vacía el TLB si no se usan ASID)
+void tlbContextSwitch(int asid);
+
+// Registrar un recorrido de tabla de páginas
+void tlbRecordWalk(int levelsVisited);
+
+// Memoria cubierta por las entradas válidas del TLB (en bytes)
+unsigned long tlbReach();
+
+// Obtener las estadísticas acumuladas
+TlbStatistics getTlbStatistics();
+
+// Mostrar tasa de aciertos y coste de recorridos
+void displayTlbStatistics();
+
+#endif // TLB_H
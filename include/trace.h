@@ -0,0 +1,64 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "process.h"
+#include <stdbool.h>
+
+#define TRACE_TICKS_PER_SECOND 1000.0 // Ticks simulados por segundo de traza
+#define TRACE_DEFAULT_THREADS 4       // Hilos del análisis por fragmentos
+#define TRACE_MIN_CHUNK (1L << 20)    // Bytes mínimos por fragmento
+#define TRACE_MAX_LINE 1024           // Longitud máxima de línea analizada
+#define TRACE_PROC_HZ 100             // USER_HZ de los tiempos de /proc
+#define TRACE_DEFAULT_PAGES 2         // Páginas de las tareas sin RSS
+#define TRACE_MAX_PAGES 8             // Páginas máximas de una tarea
+#define TRACE_COMM_LENGTH 16          // Nombre de tarea (TASK_COMM_LEN)
+
+// Formatos de traza reconocidos
+typedef enum {
+  TRACE_FORMAT_AUTO = 0,  // Detectar por la primera línea con datos
+  TRACE_FORMAT_FTRACE,    // Texto de ftrace: sched_switch / sched_wakeup
+  TRACE_FORMAT_PERF_SCHED, // perf script / perf sched (sched:sched_*)
+  TRACE_FORMAT_PROC_STAT  // Muestras "TIEMPO <línea de /proc/PID/stat>"
+} TraceFormat;
+
+// Tarea de la traza convertida en ráfagas: la CPU que consumió entre dos
+// esperas y el tiempo que pasó dormida (E/S) hasta despertarse; las
+// esperas en la cola de ejecución no cuentan como E/S
+typedef struct {
+  int pid;                     // PID en la traza
+  char comm[TRACE_COMM_LENGTH]; // Nombre de la tarea
+  int kernelPriority;          // Prioridad del núcleo (120: normal)
+  int pages;                   // Páginas (del RSS muestreado si lo hay)
+  SimTime startTime;           // Primera ejecución desde el inicio
+  SimTime *cpuBursts;          // totalBursts ráfagas de CPU
+  SimTime *ioBursts;           // totalBursts - 1 esperas entre ellas
+  int totalBursts;             // Ráfagas de CPU
+} TraceTask;
+
+// Carga de trabajo importada de una traza
+typedef struct {
+  TraceFormat format; // Formato analizado
+  TraceTask *tasks;   // Tareas con alguna ráfaga, por orden de aparición
+  int taskCount;
+  long lines;         // Líneas leídas
+  long events;        // Eventos reconocidos
+  long skipped;       // Líneas con datos que no se reconocieron
+  int chunks;         // Fragmentos analizados en paralelo
+} TraceWorkload;
+
+// Importar una traza: el archivo se proyecta en memoria y se analiza en
+// hasta threads fragmentos en paralelo (cortados en fin de línea); los
+// eventos se ordenan por tiempo y se convierten en ráfagas a razón de
+// ticksPerSecond ticks por segundo. El resultado no depende del número de
+// hilos. false si el archivo no se puede leer o no tiene eventos
+bool importTrace(const char *path, TraceFormat format, double ticksPerSecond,
+                 int threads, TraceWorkload *workload);
+
+// Crear un proceso (con sus ráfagas copiadas) a partir de una tarea
+// importada; NULL si no hay memoria
+Process *traceTaskProcess(const TraceTask *task, int id);
+
+// Liberar las tareas de una carga importada
+void releaseTraceWorkload(TraceWorkload *workload);
+
+#endif // TRACE_H
@@ -0,0 +1,66 @@
+#ifndef ZSWAP_H
+#define ZSWAP_H
+
+#include "process.h"
+
+#define ZSWAP_POOL_FRAMES 2         // Marcos del almacén por defecto
+#define ZSWAP_MAX_RATIO 8.0         // Mayor compresión considerada
+#define ZSWAP_REJECT_RATIO 1.25     // Por debajo la página no se guarda
+#define ZSWAP_COMPRESS_COST 1       // CPU por página comprimida
+#define ZSWAP_DECOMPRESS_COST 1     // CPU por página descomprimida
+#define ZSWAP_MAX_RATIO_CLASSES 8   // Clases de la distribución de ratios
+#define ZSWAP_RNG_STREAM 0x7a737770 // Flujo aleatorio de los ratios
+
+// Clase de la distribución de ratios de compresión: una página comprimida
+// ocupa PAGE_SIZE / ratio bytes con probabilidad proporcional a weight
+typedef struct {
+  double ratio;  // Ratio de compresión de la clase
+  double weight; // Peso relativo de la clase
+} ZswapRatioClass;
+
+// Estadísticas del almacén comprimido
+typedef struct {
+  long stores;          // Páginas guardadas comprimidas
+  long rejected;        // Páginas incompresibles enviadas a swap
+  long loads;           // Lecturas servidas desde el almacén
+  long swapLoads;       // Lecturas de páginas desalojadas servidas por swap
+  long writebacks;      // Páginas expulsadas del almacén hacia swap
+  long invalidated;     // Páginas descartadas al terminar su proceso
+  long storedBytes;     // Bytes ocupados por las páginas guardadas
+  long originalBytes;   // Bytes sin comprimir de las páginas guardadas
+  long maxUsedBytes;    // Mayor ocupación del almacén
+  SimTime cpuTime;      // CPU dedicada a comprimir y descomprimir
+} ZswapStatistics;
+
+// Reservar poolFrames marcos de la memoria física para el almacén (0 lo
+// desactiva y devuelve sus páginas a swap); classes/count describen la
+// distribución de ratios (NULL: la distribución por defecto) y los costes
+// son CPU por página. Vacía las estadísticas
+bool configureZswap(int poolFrames, const ZswapRatioClass *classes,
+                    int count, SimTime compressCost, SimTime decompressCost,
+                    SimTime currentTime);
+
+// Intentar guardar comprimida una página desalojada; si el almacén está
+// lleno expulsa a swap sus páginas más antiguas. Devuelve false si el
+// almacén está desactivado o la página no se comprime lo suficiente
+bool zswapStore(Page *page, SimTime currentTime);
+
+// Recuperar una página del almacén (se retira de él); devuelve false si no
+// estaba guardada
+bool zswapLoad(Page *page, SimTime currentTime);
+
+// Descartar la copia comprimida de una página que ya no se necesita
+void zswapInvalidate(Page *page);
+
+// CPU de compresión acumulada desde la última llamada, que el planificador
+// carga al reloj simulado
+SimTime zswapTakeCpuTime();
+
+// Obtener las estadísticas acumuladas
+ZswapStatistics getZswapStatistics();
+
+// Mostrar la ocupación, el ratio efectivo y la tasa de aciertos del
+// almacén (solo si está activo)
+void displayZswapStatistics();
+
+#endif // ZSWAP_H
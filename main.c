@@ -1,125 +1,437 @@
+#include "cgroup.h"
+#include "checkpoint.h"
+#include "framelog.h"
+#include "history.h"
+#include "iodevice.h"
 #include "memory.h"
+#include "mrc.h"
+#include "numa.h"
+#include "oom.h"
+#include "online.h"
+#include "pagecache.h"
+#include "prefetch.h"
+#include "reclaim.h"
 #include "process.h"
+#include "rng.h"
 #include "scheduler.h"
+#include "simclock.h"
+#include "swap.h"
+#include "tiering.h"
+#include "tlb.h"
+#include "trace.h"
+#include "zswap.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 extern void logMessage(const char *message);
 int *processCount = NULL;
 Process **processQueue = NULL;
 
-int main() {
+// Encolar las tareas de una traza (las que caben en la cola de procesos)
+static bool loadTraceWorkload(const char *path) {
+  char buffer[256];
+  TraceWorkload workload;
+  if (!importTrace(path, TRACE_FORMAT_AUTO, TRACE_TICKS_PER_SECOND,
+                   TRACE_DEFAULT_THREADS, &workload))
+    return false;
+
+  int dropped = 0;
+  for (int i = 0; i < workload.taskCount; i++) {
+    Process *process = traceTaskProcess(&workload.tasks[i], i + 1);
+    if (process != NULL && addProcessToQueue(process) >= 0)
+      continue;
+    if (process != NULL) {
+      releaseProcessPages(process);
+      free(process);
+    }
+    dropped++;
+  }
+  if (dropped > 0) {
+    snprintf(buffer, sizeof(buffer),
+             "Traza: %d tareas no entraron en la cola de procesos", dropped);
+    logMessage(buffer);
+  }
+  releaseTraceWorkload(&workload);
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  // Subcomandos: consultar un historial guardado con --history o
+  // reconstruir la tabla de marcos de un registro guardado con --frame-log
+  if (argc >= 2 && strcmp(argv[1], "query") == 0)
+    return runHistoryQuery(argc - 2, argv + 2);
+  if (argc >= 2 && strcmp(argv[1], "frames") == 0)
+    return runFrameLogQuery(argc - 2, argv + 2);
+  SimTime checkpointAt = -1;
+  const char *checkpointFile = "simulacion.ckpt";
+  const char *restoreFile = NULL;
+  const char *onlineSocket = NULL;
+  const char *traceFile = NULL;
+  const char *historyFile = NULL;
+  const char *frameLogFile = NULL;
+  bool online = false;
+  bool clockStatistics = false;
+  ClockMode clockMode = CLOCK_MODE_BATCH;
+  double ticksPerSecond = SIMCLOCK_TICKS_PER_SECOND;
+  int zswapFrames = 0;
+  int slowFrames = 0;
+  int groupWeight = 0;
+  long long groupQuota = GROUP_NO_QUOTA;
+  int groupFrames = GROUP_NO_MEMORY_LIMIT;
+  int overcommitPolicy = OOM_DEFAULT_POLICY;
+  int overcommitRatio = OOM_DEFAULT_RATIO;
+  bool oomConfigured = false;
+  bool oomKiller = false;
+
+  // Opciones de la simulación
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      setSimulationSeed(strtoull(argv[++i], NULL, 10));
+    } else if (strcmp(argv[i], "--checkpoint-at") == 0 && i + 1 < argc) {
+      // Guardar un checkpoint al llegar a un tiempo
+      checkpointAt = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "--checkpoint-file") == 0 && i + 1 < argc) {
+      checkpointFile = argv[++i];
+    } else if (strcmp(argv[i], "--restore") == 0 && i + 1 < argc) {
+      restoreFile = argv[++i];
+    } else if (strcmp(argv[i], "--online") == 0) {
+      // Recibir llegadas en línea por la entrada estándar o un socket
+      online = true;
+    } else if (strcmp(argv[i], "--online-socket") == 0 && i + 1 < argc) {
+      online = true;
+      onlineSocket = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      // Carga de trabajo importada de una traza de ftrace, perf sched o
+      // muestras de /proc/PID/stat
+      traceFile = argv[++i];
+    } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc) {
+      // Historial de marcos, estados y cola de listos para query
+      historyFile = argv[++i];
+    } else if (strcmp(argv[i], "--frame-log") == 0 && i + 1 < argc) {
+      // Instantáneas de la tabla de marcos para frames
+      frameLogFile = argv[++i];
+    } else if (strcmp(argv[i], "--paced") == 0 && i + 1 < argc) {
+      // Sincronizar los ticks con el reloj de pared
+      clockMode = CLOCK_MODE_PACED;
+      ticksPerSecond = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--clock-stats") == 0) {
+      clockStatistics = true;
+    } else if (strcmp(argv[i], "--kswapd") == 0 && i + 1 < argc) {
+      // Reclamación en segundo plano con marcas de agua de marcos libres
+      int low, high;
+      if (sscanf(argv[++i], "%d,%d", &low, &high) != 2 ||
+          !configureReclaim(low, high, RECLAIM_BATCH, RECLAIM_DIRECT_COST)) {
+        fprintf(stderr, "Marcas de agua inválidas: %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--zswap") == 0 && i + 1 < argc) {
+      // Marcos para guardar comprimidas las páginas desalojadas
+      zswapFrames = atoi(argv[++i]);
+      if (zswapFrames <= 0) {
+        fprintf(stderr, "Marcos de zswap inválidos: %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--mrc") == 0 && i + 1 < argc) {
+      // Curva de fallos LRU en una pasada (muestreada con SHARDS si la
+      // tasa es menor que 1)
+      if (!configureMrc(atof(argv[++i]))) {
+        fprintf(stderr, "Tasa de muestreo inválida: %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--tiering") == 0 && i + 1 < argc) {
+      // Marcos de memoria lenta con promoción de páginas calientes
+      slowFrames = atoi(argv[++i]);
+      if (slowFrames <= 0) {
+        fprintf(stderr, "Marcos de memoria lenta inválidos: %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--overcommit") == 0 && i + 1 < argc) {
+      // Política de compromiso: 0 heurística, 1 siempre, 2 nunca (con el
+      // porcentaje de RAM indicado)
+      if (sscanf(argv[++i], "%d,%d", &overcommitPolicy, &overcommitRatio) <
+          1) {
+        fprintf(stderr, "Política de compromiso inválida: %s\n", argv[i]);
+        return 1;
+      }
+      oomConfigured = true;
+    } else if (strcmp(argv[i], "--oom-killer") == 0) {
+      // Eliminar un proceso cuando la reclamación no consigue marcos
+      oomKiller = oomConfigured = true;
+    } else if (strcmp(argv[i], "--cgroup") == 0 && i + 1 < argc) {
+      // Grupo con cuota de CPU y límite de marcos para los procesos de
+      // ejemplo; el primero recibe el peso indicado frente al segundo
+      if (sscanf(argv[++i], "%d,%lld,%d", &groupWeight, &groupQuota,
+                 &groupFrames) != 3 ||
+          groupWeight < 1) {
+        fprintf(stderr, "Grupo de recursos inválido: %s\n", argv[i]);
+        return 1;
+      }
+    } else {
+      fprintf(stderr,
+              "Uso: %s [--seed SEMILLA] [--checkpoint-at TIEMPO] "
+              "[--checkpoint-file ARCHIVO] [--restore ARCHIVO] [--online] "
+              "[--online-socket RUTA] [--paced TICKS_POR_SEGUNDO] "
+              "[--clock-stats] [--kswapd BAJA,ALTA] [--zswap MARCOS] "
+              "[--tiering MARCOS] [--mrc TASA] "
+              "[--cgroup PESO,CUOTA,MARCOS] [--overcommit MODO[,RATIO]] "
+              "[--oom-killer] [--trace ARCHIVO] [--history ARCHIVO] "
+              "[--frame-log ARCHIVO]\n"
+              "       %s query ARCHIVO CONSULTA...\n"
+              "       %s frames ARCHIVO T\n",
+              argv[0], argv[0], argv[0]);
+      return 1;
+    }
+  }
+  if (historyFile != NULL)
+    startHistory();
+  if (frameLogFile != NULL)
+    startFrameLog();
+  if (oomConfigured &&
+      !configureOom((OvercommitPolicy)overcommitPolicy, overcommitRatio,
+                    oomKiller)) {
+    fprintf(stderr, "Política de compromiso inválida: %d\n",
+            overcommitPolicy);
+    return 1;
+  }
+  if (!configureSimulationClock(clockMode, ticksPerSecond)) {
+    fprintf(stderr, "Ticks por segundo inválidos: %g\n", ticksPerSecond);
+    return 1;
+  }
+
+  // Configurar una máquina de dos sockets con una CPU cada uno; los marcos
+  // se reparten entre los nodos al inicializar la memoria (con --tiering el
+  // último cede los suyos finales a un nodo de memoria lenta)
+  configureNumaTopology(2, NUMA_CPUS_PER_NODE, NUMA_LOCAL_LATENCY,
+                        NUMA_REMOTE_LATENCY, NUMA_MIGRATION_COST,
+                        NUMA_BALANCING);
+  if (slowFrames > 0 &&
+      (!configureSlowTier(slowFrames, NUMA_SLOW_LATENCY) ||
+       !configureTiering(TIER_SAMPLE_RATE, TIER_HOT_WINDOW,
+                         TIER_PROMOTE_THRESHOLD, TIER_MIGRATION_BUDGET,
+                         TIER_MIGRATION_WINDOW, TIER_MIGRATION_COST))) {
+    fprintf(stderr, "No se pudo separar la memoria lenta\n");
+    return 1;
+  }
+
   // Inicializar sistema de memoria
   initializeMemorySystem();
 
+  // Configurar el TLB simulado
+  initializeTlb(TLB_SETS, TLB_WAYS, TLB_USE_ASID);
+
+  // Configurar el dispositivo de swap simulado
+  configureSwapDevice(SWAP_SLOTS, SWAP_LATENCY, SWAP_BANDWIDTH,
+                      SWAP_READAHEAD_CLUSTER);
+
+  // Configurar los dispositivos de bloques: el disco del sistema (E/S sin
+  // archivo y archivos pares) y un SSD con varias posiciones de cola
+  resetIoDevices();
+  addIoDevice("disco0", IO_SCHED_MQ_DEADLINE, IO_DEFAULT_QUEUE_DEPTH,
+              IO_DEFAULT_LATENCY, IO_DEFAULT_SPEED, IO_SERVICE_UNIFORM, 1);
+  addIoDevice("ssd0", IO_SCHED_BFQ, 4, 1, 50, IO_SERVICE_EXPONENTIAL, 2);
+
+  // Configurar la precarga tras los fallos de página
+  configurePrefetcher(PREFETCH_ENABLED, PREFETCH_MAX_WINDOW, PREFETCH_MARKOV);
+
   // Obtener referencias a la cola de procesos y el contador de procesos
   processQueue = getProcessQueue();
   processCount = getProcessCount();
 
   // Definición de ráfagas de procesos
-  int cpuBursts1[] = {50, 30, 40}; // Ráfagas de CPU para el proceso 1
-  int ioBursts1[] = {20, 30, 10};  // Ráfagas de E/S para el proceso 1
-  int cpuBursts2[] = {60, 40, 35}; // Ráfagas de CPU para el proceso 2
-  int ioBursts2[] = {25, 20, 15};  // Ráfagas de E/S para el proceso 2
+  SimTime cpuBursts1[] = {50, 30, 40}; // Ráfagas de CPU para el proceso 1
+  SimTime ioBursts1[] = {20, 30, 10};  // Ráfagas de E/S para el proceso 1
+  SimTime cpuBursts2[] = {60, 40, 35}; // Ráfagas de CPU para el proceso 2
+  SimTime ioBursts2[] = {25, 20, 15};  // Ráfagas de E/S para el proceso 2
 
   // Definición de ráfagas de procesos adicionales
-  int cpuBursts3[] = {45, 25, 55}; // Ráfagas de CPU para el proceso 3
-  int ioBursts3[] = {15, 35, 25};  // Ráfagas de E/S para el proceso 3
-  int cpuBursts4[] = {55, 50, 45}; // Ráfagas de CPU para el proceso 4
-  int ioBursts4[] = {20, 40, 30};  // Ráfagas de E/S para el proceso 4
+  SimTime cpuBursts3[] = {45, 25, 55}; // Ráfagas de CPU para el proceso 3
+  SimTime ioBursts3[] = {15, 35, 25};  // Ráfagas de E/S para el proceso 3
+  SimTime cpuBursts4[] = {55, 50, 45}; // Ráfagas de CPU para el proceso 4
+  SimTime ioBursts4[] = {20, 40, 30};  // Ráfagas de E/S para el proceso 4
+
+  // Archivos accedidos en las ráfagas de E/S (ambos procesos leen el
+  // archivo 1, que queda en la caché de páginas)
+  FileRequest ioFiles1[] = {{1, 0, 2 * PAGE_SIZE, false},
+                            {1, 0, 2 * PAGE_SIZE, false},
+                            {1, 0, PAGE_SIZE, false}};
+  FileRequest ioFiles2[] = {{1, 0, 2 * PAGE_SIZE, false},
+                            {2, 0, PAGE_SIZE, true},
+                            {2, 0, PAGE_SIZE, false}};
 
   // Inicialización del Proceso 1
-  Process *p1 = malloc(sizeof(Process));
+  Process *p1 = calloc(1, sizeof(Process));
   p1->id = 1;
   p1->startTime = 0; // Inicia en tiempo 0
   p1->priority = SYSTEM_PRIORITY;
   p1->cpuBurstTimes = cpuBursts1;
   p1->ioBurstTimes = ioBursts1;
+  p1->ioRequests = ioFiles1;
   p1->totalBursts = 3;
+  p1->memorySize = 4 * PAGE_SIZE; // Tamaño de memoria del proceso 1
+  p1->pageSizeClasses = NULL; // Todas las páginas de 4 KiB
   p1->totalPages = 4;
   p1->burstIndex = 0;
+  p1->writtenPages = 2; // Páginas modificadas en cada quantum
   p1->state = READY;
-  p1->pages = malloc(p1->totalPages * sizeof(Page));
 
-  // Inicializar páginas del Proceso 1
-  for (int i = 0; i < p1->totalPages; i++) {
-    p1->pages[i].id = p1->id * 10 + i;
-    p1->pages[i].processId = p1->id;
-    p1->pages[i].inMemory = false;
-  }
+  // Inicializar páginas y tabla de páginas del Proceso 1
+  initializeProcessPages(p1);
 
   // Inicialización del Proceso 2
-  Process *p2 = malloc(sizeof(Process));
+  Process *p2 = calloc(1, sizeof(Process));
   p2->id = 2;
   p2->startTime = 5; // Inicia 5 unidades después
   p2->priority = INTERACTIVE_PRIORITY;
   p2->cpuBurstTimes = cpuBursts2;
   p2->ioBurstTimes = ioBursts2;
+  p2->ioRequests = ioFiles2;
   p2->totalBursts = 3;
+  p2->memorySize = 6 * PAGE_SIZE; // Tamaño de memoria del proceso 2
+  p2->pageSizeClasses = NULL; // Todas las páginas de 4 KiB
   p2->totalPages = 6;
   p2->burstIndex = 0;
+  p2->writtenPages = 3; // Páginas modificadas en cada quantum
+  p2->numaPolicy = NUMA_POLICY_INTERLEAVE; // Repartida entre los nodos
   p2->state = READY;
-  p2->pages = malloc(p2->totalPages * sizeof(Page));
 
-  // Inicializar páginas del Proceso 2
-  for (int i = 0; i < p2->totalPages; i++) {
-    p2->pages[i].id = p2->id * 10 + i;
-    p2->pages[i].processId = p2->id;
-    p2->pages[i].inMemory = false;
-  }
+  // Inicializar páginas y tabla de páginas del Proceso 2
+  initializeProcessPages(p2);
 
   // Inicialización del Proceso 3
-  Process *p3 = malloc(sizeof(Process));
+  Process *p3 = calloc(1, sizeof(Process));
   p3->id = 3;
   p3->startTime = 10; // Inicia 10 unidades después
   p3->priority = SYSTEM_PRIORITY;
   p3->cpuBurstTimes = cpuBursts3;
   p3->ioBurstTimes = ioBursts3;
   p3->totalBursts = 3;
+  p3->memorySize = 5 * PAGE_SIZE; // Tamaño de memoria del proceso 3
+  p3->pageSizeClasses = NULL; // Todas las páginas de 4 KiB
   p3->totalPages = 5;
   p3->burstIndex = 0;
+  p3->writtenPages = 2; // Páginas modificadas en cada quantum
   p3->state = READY;
-  p3->pages = malloc(p3->totalPages * sizeof(Page));
 
-  // Inicializar páginas del Proceso 3
-  for (int i = 0; i < p3->totalPages; i++) {
-    p3->pages[i].id = p3->id * 10 + i;
-    p3->pages[i].processId = p3->id;
-    p3->pages[i].inMemory = false;
-  }
+  // Inicializar páginas y tabla de páginas del Proceso 3
+  initializeProcessPages(p3);
 
   // Inicialización del Proceso 4
-  Process *p4 = malloc(sizeof(Process));
+  Process *p4 = calloc(1, sizeof(Process));
   p4->id = 4;
   p4->startTime = 15; // Inicia 15 unidades después
   p4->priority = INTERACTIVE_PRIORITY;
   p4->cpuBurstTimes = cpuBursts4;
   p4->ioBurstTimes = ioBursts4;
   p4->totalBursts = 3;
+  p4->memorySize = 7 * PAGE_SIZE; // Tamaño de memoria del proceso 4
+  p4->pageSizeClasses = NULL; // Todas las páginas de 4 KiB
   p4->totalPages = 7;
   p4->burstIndex = 0;
+  p4->writtenPages = 4; // Páginas modificadas en cada quantum
   p4->state = READY;
-  p4->pages = malloc(p4->totalPages * sizeof(Page));
 
-  // Inicializar páginas del Proceso 4
-  for (int i = 0; i < p4->totalPages; i++) {
-    p4->pages[i].id = p4->id * 10 + i;
-    p4->pages[i].processId = p4->id;
-    p4->pages[i].inMemory = false;
+  // Inicializar páginas y tabla de páginas del Proceso 4
+  initializeProcessPages(p4);
+
+  if (restoreFile != NULL || online || traceFile != NULL) {
+    // El checkpoint, las llegadas en línea y las trazas sustituyen a la
+    // carga de trabajo de ejemplo
+    releaseProcessPages(p1);
+    releaseProcessPages(p2);
+    free(p1);
+    free(p2);
+    if (restoreFile != NULL && !restoreCheckpoint(restoreFile)) {
+      fprintf(stderr, "No se pudo restaurar el checkpoint %s\n", restoreFile);
+      return 1;
+    }
+    if (online && !startOnlineIngest(onlineSocket)) {
+      fprintf(stderr, "No se pudo abrir el modo en línea\n");
+      return 1;
+    }
+    if (traceFile != NULL && !loadTraceWorkload(traceFile)) {
+      fprintf(stderr, "No se pudo importar la traza %s\n", traceFile);
+      return 1;
+    }
+  } else {
+    // Agrupar los procesos antes de que ocupen marcos
+    if (groupWeight > 0) {
+      ResourceGroup *group =
+          createResourceGroup("sim", NULL, GROUP_DEFAULT_WEIGHT, groupQuota,
+                              GROUP_DEFAULT_PERIOD, groupFrames);
+      ResourceGroup *first = createResourceGroup(
+          "p1", group, groupWeight, GROUP_NO_QUOTA, GROUP_DEFAULT_PERIOD,
+          GROUP_NO_MEMORY_LIMIT);
+      ResourceGroup *second = createResourceGroup(
+          "p2", group, GROUP_DEFAULT_WEIGHT, GROUP_NO_QUOTA,
+          GROUP_DEFAULT_PERIOD, GROUP_NO_MEMORY_LIMIT);
+      if (group == NULL || first == NULL || second == NULL) {
+        fprintf(stderr, "No se pudo crear el grupo de recursos\n");
+        return 1;
+      }
+      attachProcessToGroup(p1, first);
+      attachProcessToGroup(p2, second);
+    }
+
+    // Agregar procesos a la cola (los que rechaza la política de
+    // compromiso de memoria no se ejecutan)
+    if (addProcessToQueue(p1) < 0) {
+      releaseProcessPages(p1);
+      free(p1);
+    }
+    if (addProcessToQueue(p2) < 0) {
+      releaseProcessPages(p2);
+      free(p2);
+    }
+    /* addProcessToQueue(p3); */
+    /* addProcessToQueue(p4); */
   }
 
-  // Agregar procesos a la cola
-  addProcessToQueue(p1);
-  addProcessToQueue(p2);
-  /* addProcessToQueue(p3); */
-  /* addProcessToQueue(p4); */
+  // El almacén comprimido se reserva sobre la memoria ya restaurada
+  if (zswapFrames > 0 &&
+      !configureZswap(zswapFrames, NULL, 0, ZSWAP_COMPRESS_COST,
+                      ZSWAP_DECOMPRESS_COST, 0)) {
+    fprintf(stderr, "No se pudo reservar el almacén de zswap\n");
+    return 1;
+  }
+  if (checkpointAt >= 0)
+    requestCheckpoint(checkpointAt, checkpointFile);
 
   // Ejecutar el planificador Round Robin
   advancedRoundRobinScheduler();
+  if (online) {
+    stopOnlineIngest();
+    displayOnlineStatistics();
+  }
+  if (historyFile != NULL && !saveHistory(historyFile)) {
+    fprintf(stderr, "No se pudo guardar el historial %s\n", historyFile);
+    return 1;
+  }
+  if (frameLogFile != NULL && !saveFrameLog(frameLogFile)) {
+    fprintf(stderr, "No se pudo guardar el registro de marcos %s\n",
+            frameLogFile);
+    return 1;
+  }
+
+  // Escribir y vaciar la caché de páginas
+  dropPageCache();
+  resetIoDevices();
+
+  // Mostrar estadísticas de tamaños de página, fragmentación y compartición
+  displayPageSizeStatistics();
+  displayBuddyStatistics();
+  displayProcessMemoryUsage();
 
   // Liberación de recursos
   for (int i = 0; i < *processCount; i++) {
-    free(processQueue[i]->pages);
+    releaseProcessPages(processQueue[i]);
     free(processQueue[i]);
   }
+  releaseCheckpointRegions();
+
+  // Resumen reproducible de la ejecución
+  displayEventLogDigest();
+  if (clockStatistics || clockMode == CLOCK_MODE_PACED)
+    displayClockStatistics();
   return 0;
 }
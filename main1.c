@@ -93,9 +93,10 @@ void initializeProcessMetrics(Process *p) {
 
 // Función para registrar y mostrar métricas de rendimiento
 void logPerformanceMetrics() {
-  int totalWaitTime = 0;
-  int totalTurnaroundTime = 0;
-  int totalResponseTime = 0;
+  // Sumas de 64 bits: las de int se desbordaban con trazas largas
+  long long totalWaitTime = 0;
+  long long totalTurnaroundTime = 0;
+  long long totalResponseTime = 0;
   int completedProcesses = 0;
 
   for (int i = 0; i < processCount; i++) {
@@ -109,9 +110,9 @@ void logPerformanceMetrics() {
   }
 
   if (completedProcesses > 0) {
-    float avgWaitTime = (float)totalWaitTime / completedProcesses;
-    float avgTurnaroundTime = (float)totalTurnaroundTime / completedProcesses;
-    float avgResponseTime = (float)totalResponseTime / completedProcesses;
+    double avgWaitTime = (double)totalWaitTime / completedProcesses;
+    double avgTurnaroundTime = (double)totalTurnaroundTime / completedProcesses;
+    double avgResponseTime = (double)totalResponseTime / completedProcesses;
     float throughput = (float)completedProcesses / (float)MAX_PROCESSES;
 
     char buffer[256];
@@ -148,7 +149,7 @@ void displayMemoryFrames(int currentTime) {
                physicalMemory[i].occupyingPage->processId,
                physicalMemory[i].lastUsedTime);
     } else {
-      snprintf(buffer, sizeof(buffer), "Marco %d: [VACÍO ]", i);
+      snprintf(buffer, sizeof(buffer), "Marco %d: [VACÍO]", i);
     }
     logMessage(buffer);
   }
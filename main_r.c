@@ -181,9 +181,10 @@ bool handlePageFault(Page *page, int currentTime) {
 }
 
 void logPerformanceMetrics() {
-  int totalWaitTime = 0;
-  int totalTurnaroundTime = 0;
-  int totalResponseTime = 0;
+  // Sumas de 64 bits: las de int se desbordaban con trazas largas
+  long long totalWaitTime = 0;
+  long long totalTurnaroundTime = 0;
+  long long totalResponseTime = 0;
   int completedProcesses = 0;
 
   for (int i = 0; i < processCount; i++) {
@@ -197,9 +198,9 @@ void logPerformanceMetrics() {
   }
 
   if (completedProcesses > 0) {
-    float avgWaitTime = (float)totalWaitTime / completedProcesses;
-    float avgTurnaroundTime = (float)totalTurnaroundTime / completedProcesses;
-    float avgResponseTime = (float)totalResponseTime / completedProcesses;
+    double avgWaitTime = (double)totalWaitTime / completedProcesses;
+    double avgTurnaroundTime = (double)totalTurnaroundTime / completedProcesses;
+    double avgResponseTime = (double)totalResponseTime / completedProcesses;
     float throughput = (float)completedProcesses / (float)MAX_PROCESSES;
 
     char buffer[256];
@@ -0,0 +1,181 @@
+#include "buddy.h"
+#include <stdlib.h>
+
+#define NO_BLOCK -1
+
+// Insertar un bloque libre (índice relativo) en la lista de su orden
+static void pushFreeBlock(BuddyAllocator *buddy, int block, int order) {
+  buddy->freeOrder[block] = (signed char)order;
+  buddy->prevFree[block] = NO_BLOCK;
+  buddy->nextFree[block] = buddy->freeHead[order];
+  if (buddy->freeHead[order] != NO_BLOCK)
+    buddy->prevFree[buddy->freeHead[order]] = block;
+  buddy->freeHead[order] = block;
+  buddy->freeBlocks[order]++;
+  buddy->freeFrames += 1 << order;
+}
+
+// Quitar un bloque libre de la lista de su orden en O(1)
+static void removeFreeBlock(BuddyAllocator *buddy, int block) {
+  int order = buddy->freeOrder[block];
+  if (buddy->prevFree[block] != NO_BLOCK)
+    buddy->nextFree[buddy->prevFree[block]] = buddy->nextFree[block];
+  else
+    buddy->freeHead[order] = buddy->nextFree[block];
+  if (buddy->nextFree[block] != NO_BLOCK)
+    buddy->prevFree[buddy->nextFree[block]] = buddy->prevFree[block];
+  buddy->freeOrder[block] = NO_BLOCK;
+  buddy->freeBlocks[order]--;
+  buddy->freeFrames -= 1 << order;
+}
+
+// Marcar como libre el rango [first, numFrames) con bloques alineados
+static void seedFreeRange(BuddyAllocator *buddy, int first) {
+  int block = first;
+  while (block < buddy->numFrames) {
+    int order = buddy->maxOrder;
+    while (order > 0 && ((block & ((1 << order) - 1)) != 0 ||
+                         block + (1 << order) > buddy->numFrames))
+      order--;
+    pushFreeBlock(buddy, block, order);
+    block += 1 << order;
+  }
+}
+
+bool buddyInit(BuddyAllocator *buddy, int baseFrame, int numFrames) {
+  buddy->baseFrame = baseFrame;
+  buddy->numFrames = numFrames;
+  buddy->nextFree = malloc(numFrames * sizeof(int));
+  buddy->prevFree = malloc(numFrames * sizeof(int));
+  buddy->freeOrder = malloc(numFrames * sizeof(signed char));
+  if (buddy->nextFree == NULL || buddy->prevFree == NULL ||
+      buddy->freeOrder == NULL) {
+    buddyDestroy(buddy);
+    return false;
+  }
+
+  // El orden máximo está limitado por el tamaño del rango
+  buddy->maxOrder = 0;
+  while (buddy->maxOrder < BUDDY_MAX_ORDER &&
+         (2 << buddy->maxOrder) <= numFrames)
+    buddy->maxOrder++;
+
+  for (int order = 0; order <= BUDDY_MAX_ORDER; order++) {
+    buddy->freeHead[order] = NO_BLOCK;
+    buddy->freeBlocks[order] = 0;
+    buddy->allocations[order] = buddy->frees[order] = 0;
+    buddy->failures[order] = 0;
+  }
+  for (int i = 0; i < numFrames; i++)
+    buddy->freeOrder[i] = NO_BLOCK;
+  buddy->freeFrames = 0;
+  buddy->splits = buddy->merges = 0;
+  seedFreeRange(buddy, 0);
+  return true;
+}
+
+void buddyDestroy(BuddyAllocator *buddy) {
+  free(buddy->nextFree);
+  free(buddy->prevFree);
+  free(buddy->freeOrder);
+  buddy->nextFree = buddy->prevFree = NULL;
+  buddy->freeOrder = NULL;
+}
+
+int buddyAlloc(BuddyAllocator *buddy, int order) {
+  if (order < 0 || order > buddy->maxOrder)
+    return NO_BLOCK;
+
+  // Buscar el menor orden con un bloque libre
+  int current = order;
+  while (current <= buddy->maxOrder && buddy->freeHead[current] == NO_BLOCK)
+    current++;
+  if (current > buddy->maxOrder) {
+    buddy->failures[order]++;
+    return NO_BLOCK;
+  }
+
+  int block = buddy->freeHead[current];
+  removeFreeBlock(buddy, block);
+
+  // Dividir el bloque devolviendo las mitades superiores a sus listas
+  while (current > order) {
+    current--;
+    pushFreeBlock(buddy, block + (1 << current), current);
+    buddy->splits++;
+  }
+  buddy->allocations[order]++;
+  return buddy->baseFrame + block;
+}
+
+bool buddyReserve(BuddyAllocator *buddy, int frame, int order) {
+  int block = frame - buddy->baseFrame;
+  if (order < 0 || order > buddy->maxOrder || block < 0 ||
+      (block & ((1 << order) - 1)) != 0)
+    return false;
+
+  // Buscar el bloque libre que contiene al pedido
+  int current = order;
+  int container = block;
+  while (current <= buddy->maxOrder) {
+    container = block & ~((1 << current) - 1);
+    if (buddy->freeOrder[container] == current)
+      break;
+    current++;
+  }
+  if (current > buddy->maxOrder)
+    return false;
+  removeFreeBlock(buddy, container);
+
+  // Dividir conservando la mitad que contiene el bloque pedido
+  while (current > order) {
+    current--;
+    int half = container + (1 << current);
+    if (block >= half) {
+      pushFreeBlock(buddy, container, current);
+      container = half;
+    } else {
+      pushFreeBlock(buddy, half, current);
+    }
+    buddy->splits++;
+  }
+  buddy->allocations[order]++;
+  return true;
+}
+
+void buddyFree(BuddyAllocator *buddy, int frame, int order) {
+  int block = frame - buddy->baseFrame;
+  buddy->frees[order]++;
+
+  // Fusionar mientras el compañero esté libre y tenga el mismo orden
+  while (order < buddy->maxOrder) {
+    int companion = block ^ (1 << order);
+    if (companion + (1 << order) > buddy->numFrames ||
+        buddy->freeOrder[companion] != order)
+      break;
+    removeFreeBlock(buddy, companion);
+    block &= ~(1 << order);
+    order++;
+    buddy->merges++;
+  }
+  pushFreeBlock(buddy, block, order);
+}
+
+int buddyLargestFreeOrder(const BuddyAllocator *buddy) {
+  for (int order = buddy->maxOrder; order >= 0; order--) {
+    if (buddy->freeHead[order] != NO_BLOCK)
+      return order;
+  }
+  return NO_BLOCK;
+}
+
+double buddyUnusableIndex(const BuddyAllocator *buddy, int order) {
+  if (buddy->freeFrames == 0)
+    return 0.0;
+
+  // Marcos libres en bloques lo bastante grandes para el orden pedido
+  long usable = 0;
+  for (int o = order; o <= buddy->maxOrder; o++)
+    usable += (long)buddy->freeBlocks[o] << o;
+  return (double)(buddy->freeFrames - usable) / buddy->freeFrames;
+}
@@ -0,0 +1,178 @@
+#include "cgroup.h"
+#include "memory.h"
+#include <stdio.h>
+#include <string.h>
+
+static ResourceGroup groups[MAX_RESOURCE_GROUPS];
+static int groupCount = 0;
+
+void resetResourceGroups() {
+  memset(groups, 0, sizeof(groups));
+  groupCount = 0;
+}
+
+ResourceGroup *createResourceGroup(const char *name, ResourceGroup *parent,
+                                   int weight, SimTime quota, SimTime period,
+                                   int memoryLimit) {
+  if (groupCount == MAX_RESOURCE_GROUPS || name == NULL || weight < 1 ||
+      weight > GROUP_MAX_WEIGHT || period < 1 ||
+      (quota != GROUP_NO_QUOTA && quota < 1) || memoryLimit < 0)
+    return NULL;
+
+  ResourceGroup *group = &groups[groupCount++];
+  memset(group, 0, sizeof(ResourceGroup));
+  snprintf(group->name, sizeof(group->name), "%s", name);
+  group->parent = parent;
+  group->cpuWeight = weight;
+  group->cpuQuota = quota;
+  group->cpuPeriod = period;
+  group->memoryLimit = memoryLimit;
+  group->throttledPeriod = -1;
+  return group;
+}
+
+void attachProcessToGroup(Process *process, ResourceGroup *group) {
+  process->group = group;
+  for (ResourceGroup *g = group; g != NULL; g = g->parent)
+    g->processes++;
+}
+
+void detachProcessFromGroup(Process *process) {
+  for (ResourceGroup *g = process->group; g != NULL; g = g->parent)
+    g->processes--;
+}
+
+bool groupContains(const ResourceGroup *group, const ResourceGroup *member) {
+  while (member != NULL && member != group)
+    member = member->parent;
+  return member != NULL;
+}
+
+// Empezar un periodo nuevo del límite de CPU si el actual ya terminó (los
+// periodos se alinean a múltiplos de su duración)
+static void rollPeriod(ResourceGroup *group, SimTime currentTime) {
+  if (currentTime >= group->periodStart + group->cpuPeriod) {
+    group->periodStart = currentTime - currentTime % group->cpuPeriod;
+    group->periodUsage = 0;
+  }
+}
+
+SimTime groupQuantum(const Process *process, SimTime quantum,
+                     SimTime currentTime) {
+  double scale = 1.0;
+  SimTime remaining = -1;
+
+  // El peso reparte la CPU entre hermanos: el quantum crece o mengua en
+  // proporción al peso de cada nivel de la jerarquía
+  for (ResourceGroup *g = process->group; g != NULL; g = g->parent) {
+    scale *= (double)g->cpuWeight / GROUP_DEFAULT_WEIGHT;
+    if (g->cpuQuota == GROUP_NO_QUOTA)
+      continue;
+    rollPeriod(g, currentTime);
+    SimTime left = g->cpuQuota - g->periodUsage;
+    if (remaining < 0 || left < remaining)
+      remaining = left;
+  }
+  if (process->group == NULL)
+    return quantum;
+
+  SimTime slice = (SimTime)(quantum * scale + 0.5);
+  if (slice < 1)
+    slice = 1;
+  return remaining >= 0 && remaining < slice ? remaining : slice;
+}
+
+SimTime groupThrottledUntil(const Process *process, SimTime currentTime) {
+  char buffer[256];
+  SimTime until = currentTime;
+
+  for (ResourceGroup *g = process->group; g != NULL; g = g->parent) {
+    if (g->cpuQuota == GROUP_NO_QUOTA)
+      continue;
+    rollPeriod(g, currentTime);
+    if (g->periodUsage < g->cpuQuota)
+      continue;
+    SimTime periodEnd = g->periodStart + g->cpuPeriod;
+    if (periodEnd > until)
+      until = periodEnd;
+    if (g->throttledPeriod == g->periodStart)
+      continue;
+
+    // Primera vez que se encuentra el grupo sin cuota en este periodo
+    g->throttledPeriod = g->periodStart;
+    g->throttledPeriods++;
+    g->throttledTime += periodEnd - currentTime;
+    snprintf(buffer, sizeof(buffer),
+             "Tiempo %lld: Grupo %s agotó su cuota de CPU (%lld/%lld) "
+             "hasta %lld",
+             currentTime, g->name, g->cpuQuota, g->cpuPeriod, periodEnd);
+    logMessage(buffer);
+  }
+  return until;
+}
+
+void groupChargeCpu(const Process *process, SimTime time,
+                    SimTime currentTime) {
+  for (ResourceGroup *g = process->group; g != NULL; g = g->parent) {
+    g->cpuUsage += time;
+    if (g->cpuQuota == GROUP_NO_QUOTA)
+      continue;
+    rollPeriod(g, currentTime);
+    g->periodUsage += time;
+  }
+}
+
+void groupChargeFrames(ResourceGroup *group, int frames) {
+  for (ResourceGroup *g = group; g != NULL; g = g->parent) {
+    g->residentFrames += frames;
+    if (g->residentFrames > g->maxResidentFrames)
+      g->maxResidentFrames = g->residentFrames;
+  }
+}
+
+ResourceGroup *groupOverMemoryLimit(ResourceGroup *group, int frames) {
+  for (ResourceGroup *g = group; g != NULL; g = g->parent) {
+    if (g->memoryLimit != GROUP_NO_MEMORY_LIMIT &&
+        g->residentFrames + frames > g->memoryLimit)
+      return g;
+  }
+  return NULL;
+}
+
+void groupRecordReclaim(ResourceGroup *group) { group->limitReclaims++; }
+
+// Ruta del grupo desde la raíz (/padre/hijo)
+static void groupPath(const ResourceGroup *group, char *path, size_t size) {
+  if (group->parent != NULL)
+    groupPath(group->parent, path, size);
+  else
+    path[0] = '\0';
+  size_t length = strlen(path);
+  snprintf(path + length, size - length, "/%s", group->name);
+}
+
+void displayResourceGroupStatistics() {
+  char path[64], buffer[256];
+
+  for (int i = 0; i < groupCount; i++) {
+    const ResourceGroup *g = &groups[i];
+    groupPath(g, path, sizeof(path));
+    int length = snprintf(buffer, sizeof(buffer),
+                          "Grupo %s: %d procesos activos, CPU %lld (peso "
+                          "%d), memoria %d marcos (máximo %d)",
+                          path, g->processes, g->cpuUsage, g->cpuWeight,
+                          g->residentFrames, g->maxResidentFrames);
+    if (g->cpuQuota != GROUP_NO_QUOTA && length < (int)sizeof(buffer))
+      length += snprintf(buffer + length, sizeof(buffer) - length,
+                         ", cuota %lld/%lld agotada en %ld periodos (%lld "
+                         "sin CPU)",
+                         g->cpuQuota, g->cpuPeriod, g->throttledPeriods,
+                         g->throttledTime);
+    if (g->memoryLimit != GROUP_NO_MEMORY_LIMIT &&
+        length < (int)sizeof(buffer))
+      snprintf(buffer + length, sizeof(buffer) - length,
+               ", límite %d marcos (%ld desalojados)", g->memoryLimit,
+               g->limitReclaims);
+    logMessage(buffer);
+  }
+}
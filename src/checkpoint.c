@@ -0,0 +1,667 @@
+#include "checkpoint.h"
+#include "iodevice.h"
+#include "memory.h"
+#include "numa.h"
+#include "oom.h"
+#include "pagetable.h"
+#include "scheduler.h"
+#include "swap.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Arreglo contiguo de páginas y su primer índice en el checkpoint
+typedef struct {
+  const Page *base;
+  int count;
+  int first;
+} PageArray;
+
+// Traducción de punteros a índices durante el guardado y de índices a
+// punteros durante la restauración
+static PageArray *pageArrays = NULL; // Ordenados por dirección
+static int pageArrayCount = 0;
+static Process **indexedProcesses = NULL;
+static int indexedProcessCount = 0;
+static Page **restoredPages = NULL;
+static int restoredPageCount = 0;
+
+// Segmentos creados al restaurar (se liberan con releaseCheckpointRegions)
+static SharedRegion **restoredRegions = NULL;
+static int restoredRegionCount = 0;
+
+// Redondear un desplazamiento a 8 bytes
+static long align8(long offset) { return (offset + 7) & ~7L; }
+
+static int comparePageArrays(const void *a, const void *b) {
+  const Page *x = ((const PageArray *)a)->base;
+  const Page *y = ((const PageArray *)b)->base;
+  return x < y ? -1 : x > y;
+}
+
+// Índice de una página: búsqueda binaria del arreglo que la contiene
+static int pageIndex(const Page *page) {
+  int low = 0, high = pageArrayCount - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    const PageArray *array = &pageArrays[mid];
+    if (page < array->base)
+      high = mid - 1;
+    else if (page >= array->base + array->count)
+      low = mid + 1;
+    else
+      return array->first + (int)(page - array->base);
+  }
+  return CHECKPOINT_NONE;
+}
+
+static int processIndex(const Process *process) {
+  for (int i = 0; i < indexedProcessCount; i++) {
+    if (indexedProcesses[i] == process)
+      return i;
+  }
+  return CHECKPOINT_NONE;
+}
+
+static Page *pageAt(int index) {
+  return index >= 0 && index < restoredPageCount ? restoredPages[index]
+                                                 : NULL;
+}
+
+static Process *processAt(int index) {
+  return index >= 0 && index < indexedProcessCount ? indexedProcesses[index]
+                                                   : NULL;
+}
+
+// Añadir un arreglo de páginas a la tabla de traducción
+static void addPageArray(const Page *base, int count, int *pageCount) {
+  *pageCount += count;
+  if (pageArrays == NULL)
+    return;
+  pageArrays[pageArrayCount].base = base;
+  pageArrays[pageArrayCount].count = count;
+  pageArrays[pageArrayCount].first = *pageCount - count;
+  pageArrayCount++;
+}
+
+// Convertir una página en su registro
+static void savePage(const Page *page, CheckpointPage *record) {
+  memset(record, 0, sizeof(*record));
+  record->virtualAddress = page->virtualAddress;
+  record->id = page->id;
+  record->processId = page->processId;
+  record->lastAccessTime = page->lastAccessTime;
+  record->frameIndex = page->frameIndex;
+  record->swapSlot = page->swapSlot;
+  record->readyTime = page->readyTime;
+  record->nextSharer = page->nextSharer != NULL ? pageIndex(page->nextSharer)
+                                                : CHECKPOINT_NONE;
+  record->sharedAnchor = page->sharedAnchor != NULL
+                             ? pageIndex(page->sharedAnchor)
+                             : CHECKPOINT_NONE;
+  record->accessNode = page->accessNode;
+  record->remoteAccesses = page->remoteAccesses;
+  record->sizeClass = (unsigned char)page->sizeClass;
+  record->flags = (page->active ? CHECKPOINT_PAGE_ACTIVE : 0) |
+                  (page->inMemory ? CHECKPOINT_PAGE_IN_MEMORY : 0) |
+                  (page->dirty ? CHECKPOINT_PAGE_DIRTY : 0) |
+                  (page->readAhead ? CHECKPOINT_PAGE_READ_AHEAD : 0) |
+                  (page->copyOnWrite ? CHECKPOINT_PAGE_COPY_ON_WRITE : 0);
+}
+
+// Escribir una sección y rellenar hasta el siguiente múltiplo de 8
+static bool writeSection(FILE *file, const void *data, size_t size,
+                         long *position) {
+  static const char padding[8] = {0};
+  long end = align8(*position + (long)size);
+  bool written = size == 0 || fwrite(data, size, 1, file) == 1;
+  written = written && (end == *position + (long)size ||
+                        fwrite(padding, end - *position - size, 1, file) == 1);
+  *position = end;
+  return written;
+}
+
+bool saveCheckpoint(const char *path) {
+  char buffer[256];
+  Process **queue = getProcessQueue();
+  int count = *getProcessCount();
+  CheckpointHeader header;
+  SharedRegion *regions[MAX_PROCESSES];
+  int regionCount = 0, pageCount = 0, burstCount = 0, requestCount = 0;
+
+  // Sin su tarea de tiempo real o su grupo el proceso se planificaría de
+  // otra forma al restaurarlo
+  for (int i = 0; i < count; i++) {
+    if (queue[i]->realTime == NULL && queue[i]->group == NULL)
+      continue;
+    snprintf(buffer, sizeof(buffer),
+             "Checkpoint: no se guarda en %s, el Proceso %d es de tiempo "
+             "real o pertenece a un grupo de recursos",
+             path, queue[i]->id);
+    logMessage(buffer);
+    return false;
+  }
+
+  // Segmentos compartidos adjuntos a los procesos de la cola
+  for (int i = 0; i < count; i++) {
+    SharedRegion *region = queue[i]->sharedRegion;
+    int r = 0;
+    while (region != NULL && r < regionCount && regions[r] != region)
+      r++;
+    if (region != NULL && r == regionCount)
+      regions[regionCount++] = region;
+  }
+
+  // Índices de páginas: las de cada proceso y después las anclas
+  pageArrays = malloc((2 * count + regionCount + 1) * sizeof(PageArray));
+  pageArrayCount = 0;
+  indexedProcesses = queue;
+  indexedProcessCount = count;
+  for (int i = 0; i < count; i++) {
+    addPageArray(queue[i]->pages, queue[i]->totalPages, &pageCount);
+    if (queue[i]->sharedRegion != NULL)
+      addPageArray(queue[i]->sharedPages, queue[i]->sharedRegion->totalPages,
+                   &pageCount);
+    burstCount += queue[i]->totalBursts;
+    if (queue[i]->ioRequests != NULL)
+      requestCount += queue[i]->totalBursts;
+  }
+  for (int r = 0; r < regionCount; r++)
+    addPageArray(regions[r]->pages, regions[r]->totalPages, &pageCount);
+  if (pageArrays != NULL)
+    qsort(pageArrays, pageArrayCount, sizeof(PageArray), comparePageArrays);
+
+  CheckpointProcess *processes = calloc(count + 1, sizeof(CheckpointProcess));
+  CheckpointPage *pages = calloc(pageCount + 1, sizeof(CheckpointPage));
+  CheckpointBurst *bursts = calloc(burstCount + 1, sizeof(CheckpointBurst));
+  CheckpointRequest *requests =
+      calloc(requestCount + 1, sizeof(CheckpointRequest));
+  CheckpointRegion *regionRecords =
+      calloc(regionCount + 1, sizeof(CheckpointRegion));
+  CheckpointFrame *frames = calloc(NUM_FRAMES, sizeof(CheckpointFrame));
+  CheckpointFrameSet *sets = calloc(MAX_PROCESSES, sizeof(CheckpointFrameSet));
+  bool saved = pageArrays != NULL && processes != NULL && pages != NULL &&
+               bursts != NULL && requests != NULL && regionRecords != NULL &&
+               frames != NULL && sets != NULL;
+
+  // Registros de procesos, con sus ráfagas pendientes y sus páginas
+  int page = 0, burst = 0, request = 0;
+  for (int i = 0; i < count && saved; i++) {
+    const Process *process = queue[i];
+    CheckpointProcess *record = &processes[i];
+    record->id = process->id;
+    record->startTime = process->startTime;
+    record->priority = process->priority;
+    record->memorySize = process->memorySize;
+    record->totalPages = process->totalPages;
+    record->firstPage = page;
+    for (int p = 0; p < process->totalPages; p++)
+      savePage(&process->pages[p], &pages[page++]);
+    record->sharedRegion = CHECKPOINT_NONE;
+    record->firstSharedPage = CHECKPOINT_NONE;
+    for (int r = 0; r < regionCount && process->sharedRegion != NULL; r++) {
+      if (regions[r] != process->sharedRegion)
+        continue;
+      record->sharedRegion = r;
+      record->firstSharedPage = page;
+      for (int p = 0; p < regions[r]->totalPages; p++)
+        savePage(&process->sharedPages[p], &pages[page++]);
+    }
+    record->totalBursts = process->totalBursts;
+    record->burstIndex = process->burstIndex;
+    record->firstBurst = burst;
+    // La última ráfaga de CPU no va seguida de E/S
+    for (int b = 0; b < process->totalBursts; b++, burst++) {
+      bursts[burst].cpuTime = process->cpuBurstTimes[b];
+      bursts[burst].ioTime =
+          b < process->totalBursts - 1 ? process->ioBurstTimes[b] : 0;
+    }
+    record->firstRequest = CHECKPOINT_NONE;
+    if (process->ioRequests != NULL) {
+      record->firstRequest = request;
+      for (int b = 0; b < process->totalBursts - 1; b++, request++) {
+        requests[request].offset = process->ioRequests[b].offset;
+        requests[request].length = process->ioRequests[b].length;
+        requests[request].fileId = process->ioRequests[b].fileId;
+        requests[request].write = process->ioRequests[b].write;
+      }
+      request++;
+    }
+    record->writtenPages = process->writtenPages;
+    record->blockedUntil = process->blockedUntil;
+    record->state = process->state;
+    record->numaPolicy = process->numaPolicy;
+    record->numaNode = process->numaNode;
+    record->cpu = process->cpu;
+    record->waitTime = process->waitTime;
+    record->turnaroundTime = process->turnaroundTime;
+    record->responseTime = process->responseTime;
+    record->pagesLoaded = process->pagesLoaded;
+    record->oomScoreAdj = process->oomScoreAdj;
+  }
+  for (int r = 0; r < regionCount && saved; r++) {
+    regionRecords[r].id = regions[r]->id;
+    regionRecords[r].totalPages = regions[r]->totalPages;
+    regionRecords[r].firstAnchor = page;
+    for (int p = 0; p < regions[r]->totalPages; p++)
+      savePage(&regions[r]->pages[p], &pages[page++]);
+  }
+
+  // Tabla de marcos y estado de reemplazo, sin punteros
+  memset(&header, 0, sizeof(header));
+  saved = saved && saveMemoryState(frames, sets, &header.memory, pageIndex,
+                                   processIndex);
+
+  memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+  header.version = CHECKPOINT_VERSION;
+  header.numFrames = NUM_FRAMES;
+  header.maxProcesses = MAX_PROCESSES;
+  header.numaNodes = numaNodeCount();
+  header.clock = getSchedulerClock();
+  header.nextPageId = nextPageIdentifier();
+  header.processCount = count;
+  header.pageCount = pageCount;
+  header.burstCount = burstCount;
+  header.requestCount = requestCount;
+  header.regionCount = regionCount;
+  header.processOffset = align8(sizeof(header));
+  header.pageOffset =
+      align8(header.processOffset + count * (long)sizeof(CheckpointProcess));
+  header.burstOffset =
+      align8(header.pageOffset + pageCount * (long)sizeof(CheckpointPage));
+  header.requestOffset =
+      align8(header.burstOffset + burstCount * (long)sizeof(CheckpointBurst));
+  header.regionOffset = align8(header.requestOffset +
+                               requestCount * (long)sizeof(CheckpointRequest));
+  header.frameOffset = align8(header.regionOffset +
+                              regionCount * (long)sizeof(CheckpointRegion));
+  header.frameSetOffset =
+      align8(header.frameOffset + NUM_FRAMES * (long)sizeof(CheckpointFrame));
+
+  FILE *file = saved ? fopen(path, "wb") : NULL;
+  long position = 0;
+  saved = file != NULL &&
+          writeSection(file, &header, sizeof(header), &position) &&
+          writeSection(file, processes, count * sizeof(CheckpointProcess),
+                       &position) &&
+          writeSection(file, pages, pageCount * sizeof(CheckpointPage),
+                       &position) &&
+          writeSection(file, bursts, burstCount * sizeof(CheckpointBurst),
+                       &position) &&
+          writeSection(file, requests,
+                       requestCount * sizeof(CheckpointRequest), &position) &&
+          writeSection(file, regionRecords,
+                       regionCount * sizeof(CheckpointRegion), &position) &&
+          writeSection(file, frames, NUM_FRAMES * sizeof(CheckpointFrame),
+                       &position) &&
+          writeSection(file, sets, MAX_PROCESSES * sizeof(CheckpointFrameSet),
+                       &position);
+  if (file != NULL && fclose(file) != 0)
+    saved = false;
+
+  free(pageArrays);
+  pageArrays = NULL;
+  pageArrayCount = 0;
+  indexedProcesses = NULL;
+  indexedProcessCount = 0;
+  free(processes);
+  free(pages);
+  free(bursts);
+  free(requests);
+  free(regionRecords);
+  free(frames);
+  free(sets);
+
+  if (saved)
+    snprintf(buffer, sizeof(buffer),
+             "Checkpoint guardado en %s: %d procesos, %d páginas (Tiempo: "
+             "%lld)",
+             path, count, pageCount, header.clock);
+  else
+    snprintf(buffer, sizeof(buffer), "Checkpoint: no se pudo guardar en %s",
+             path);
+  logMessage(buffer);
+  return saved;
+}
+
+// Comprobar que una sección de count registros cabe en el archivo (sin
+// desbordar con valores dañados)
+static bool sectionFits(long offset, int count, size_t size, long fileSize) {
+  return offset >= (long)sizeof(CheckpointHeader) && offset <= fileSize &&
+         offset % 8 == 0 && count >= 0 &&
+         count <= (fileSize - offset) / (long)size;
+}
+
+// Comprobar la cabecera contra la configuración actual del simulador
+static bool validHeader(const CheckpointHeader *header, long fileSize) {
+  return fileSize >= (long)sizeof(CheckpointHeader) &&
+         memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) == 0 &&
+         header->version == CHECKPOINT_VERSION &&
+         header->numFrames == NUM_FRAMES &&
+         header->maxProcesses == MAX_PROCESSES &&
+         header->numaNodes == numaNodeCount() &&
+         header->processCount <= MAX_PROCESSES &&
+         sectionFits(header->processOffset, header->processCount,
+                     sizeof(CheckpointProcess), fileSize) &&
+         sectionFits(header->pageOffset, header->pageCount,
+                     sizeof(CheckpointPage), fileSize) &&
+         sectionFits(header->burstOffset, header->burstCount,
+                     sizeof(CheckpointBurst), fileSize) &&
+         sectionFits(header->requestOffset, header->requestCount,
+                     sizeof(CheckpointRequest), fileSize) &&
+         sectionFits(header->regionOffset, header->regionCount,
+                     sizeof(CheckpointRegion), fileSize) &&
+         sectionFits(header->frameOffset, NUM_FRAMES, sizeof(CheckpointFrame),
+                     fileSize) &&
+         sectionFits(header->frameSetOffset, MAX_PROCESSES,
+                     sizeof(CheckpointFrameSet), fileSize);
+}
+
+// Comprobar que count registros desde first caben en una sección de limit
+// (sin sumar valores del archivo, que podrían desbordar)
+static bool rangeFits(int first, int count, int limit) {
+  return first >= 0 && count >= 0 && first <= limit && count <= limit - first;
+}
+
+// Comprobar que los rangos de un proceso caen dentro de sus secciones y
+// que su ráfaga actual, sus enumerados y su CPU tienen valores posibles
+// (solo un proceso terminado puede haber agotado sus ráfagas)
+static bool validProcess(const CheckpointHeader *header,
+                         const CheckpointProcess *record,
+                         const CheckpointRegion *regions) {
+  bool shared = record->sharedRegion != CHECKPOINT_NONE;
+  return record->state >= READY && record->state <= TERMINATED &&
+         record->priority >= REAL_TIME_PRIORITY &&
+         record->priority <= BACKGROUND_PRIORITY &&
+         record->numaPolicy >= NUMA_POLICY_FIRST_TOUCH &&
+         record->numaPolicy <= NUMA_POLICY_BIND &&
+         (record->cpu == NO_CPU ||
+          (record->cpu >= 0 && record->cpu < numaCpuCount())) &&
+         record->oomScoreAdj >= OOM_SCORE_ADJ_MIN &&
+         record->oomScoreAdj <= OOM_SCORE_ADJ_MAX &&
+         record->burstIndex >= 0 &&
+         (record->burstIndex < record->totalBursts ||
+          (record->burstIndex == record->totalBursts &&
+           record->state == TERMINATED)) &&
+         rangeFits(record->firstPage, record->totalPages,
+                   header->pageCount) &&
+         (!shared ||
+          (record->sharedRegion >= 0 &&
+           record->sharedRegion < header->regionCount &&
+           rangeFits(record->firstSharedPage,
+                     regions[record->sharedRegion].totalPages,
+                     header->pageCount))) &&
+         record->totalBursts > 0 &&
+         rangeFits(record->firstBurst, record->totalBursts,
+                   header->burstCount) &&
+         (record->firstRequest == CHECKPOINT_NONE ||
+          rangeFits(record->firstRequest, record->totalBursts,
+                    header->requestCount));
+}
+
+// Cargar una página desde su registro (sus enlaces ya tienen destino)
+static bool restorePage(Page *page, const CheckpointPage *record) {
+  page->id = record->id;
+  page->active = (record->flags & CHECKPOINT_PAGE_ACTIVE) != 0;
+  page->processId = record->processId;
+  page->lastAccessTime = record->lastAccessTime;
+  page->inMemory = (record->flags & CHECKPOINT_PAGE_IN_MEMORY) != 0;
+  page->virtualAddress = record->virtualAddress;
+  page->frameIndex = record->frameIndex;
+  page->sizeClass = (PageSizeClass)record->sizeClass;
+  page->dirty = (record->flags & CHECKPOINT_PAGE_DIRTY) != 0;
+  page->zswapEntry = NO_ZSWAP_ENTRY;
+  page->readyTime = record->readyTime;
+  page->readAhead = (record->flags & CHECKPOINT_PAGE_READ_AHEAD) != 0;
+  page->copyOnWrite = (record->flags & CHECKPOINT_PAGE_COPY_ON_WRITE) != 0;
+  page->nextSharer = pageAt(record->nextSharer);
+  page->sharedAnchor = pageAt(record->sharedAnchor);
+  page->accessNode = record->accessNode;
+  page->remoteAccesses = record->remoteAccesses;
+  return page->sizeClass < NUM_PAGE_SIZES &&
+         (page->frameIndex == NO_FRAME ||
+          (page->frameIndex >= 0 && page->frameIndex < NUM_FRAMES)) &&
+         (record->nextSharer == CHECKPOINT_NONE || page->nextSharer != NULL) &&
+         (record->sharedAnchor == CHECKPOINT_NONE ||
+          page->sharedAnchor != NULL) &&
+         swapRestoreSlot(page, record->swapSlot);
+}
+
+// Reconstruir un proceso con sus páginas, tabla de páginas y ráfagas
+static Process *restoreProcess(const CheckpointHeader *header,
+                               const CheckpointProcess *record,
+                               const CheckpointBurst *bursts,
+                               const CheckpointRequest *requests,
+                               const CheckpointRegion *regions) {
+  Process *process = calloc(1, sizeof(Process));
+  if (process == NULL)
+    return NULL;
+  int sharedPages = record->sharedRegion != CHECKPOINT_NONE
+                        ? regions[record->sharedRegion].totalPages
+                        : 0;
+
+  process->id = record->id;
+  process->startTime = record->startTime;
+  process->priority = (ProcessPriority)record->priority;
+  process->memorySize = record->memorySize;
+  process->totalPages = record->totalPages;
+  process->pages = malloc((record->totalPages + 1) * sizeof(Page));
+  process->pageTable = createPageTable(PAGE_TABLE_LEVELS);
+  process->totalBursts = record->totalBursts;
+  process->burstIndex = record->burstIndex;
+  process->cpuBurstTimes = malloc(record->totalBursts * sizeof(SimTime));
+  process->ioBurstTimes = malloc(record->totalBursts * sizeof(SimTime));
+  process->ownsBursts = true;
+  process->ownsLayout = true;
+  if (sharedPages > 0) {
+    process->sharedRegion = restoredRegions[record->sharedRegion];
+    process->sharedPages = malloc(sharedPages * sizeof(Page));
+  }
+  if (process->pages == NULL || process->pageTable == NULL ||
+      process->cpuBurstTimes == NULL || process->ioBurstTimes == NULL ||
+      (sharedPages > 0 && process->sharedPages == NULL)) {
+    releaseProcessPages(process);
+    free(process);
+    return NULL;
+  }
+
+  for (int p = 0; p < process->totalPages; p++)
+    restoredPages[record->firstPage + p] = &process->pages[p];
+  for (int p = 0; p < sharedPages; p++)
+    restoredPages[record->firstSharedPage + p] = &process->sharedPages[p];
+  for (int b = 0; b < record->totalBursts; b++) {
+    process->cpuBurstTimes[b] = bursts[record->firstBurst + b].cpuTime;
+    process->ioBurstTimes[b] = bursts[record->firstBurst + b].ioTime;
+  }
+  if (record->firstRequest != CHECKPOINT_NONE) {
+    FileRequest *restored = calloc(record->totalBursts, sizeof(FileRequest));
+    for (int b = 0; restored != NULL && b < record->totalBursts; b++) {
+      const CheckpointRequest *from = &requests[record->firstRequest + b];
+      restored[b].fileId = from->fileId;
+      restored[b].offset = from->offset;
+      restored[b].length = from->length;
+      restored[b].write = from->write != 0;
+    }
+    process->ioRequests = restored;
+  }
+
+  // Las colas de los dispositivos no se guardan: la E/S pendiente termina
+  process->writtenPages = record->writtenPages;
+  process->blockedUntil = record->blockedUntil == IO_PENDING
+                              ? header->clock
+                              : record->blockedUntil;
+  process->pagesLoaded = record->pagesLoaded != 0;
+  process->state = record->state;
+  process->numaPolicy = (NumaPolicy)record->numaPolicy;
+  process->numaNode = record->numaNode;
+  process->cpu = NO_CPU;
+  process->waitTime = record->waitTime;
+  process->turnaroundTime = record->turnaroundTime;
+  process->responseTime = record->responseTime;
+  process->oomScoreAdj = record->oomScoreAdj;
+  pthread_mutex_init(&process->processMutex, NULL);
+  return process;
+}
+
+// Mapear las páginas restauradas de un proceso y anotar sus tamaños
+static bool mapRestoredPages(Process *process) {
+  int sharedPages =
+      process->sharedRegion != NULL ? process->sharedRegion->totalPages : 0;
+  PageSizeClass *sizeClasses = NULL;
+
+  for (int p = 0; p < process->totalPages + sharedPages; p++) {
+    Page *page = p < process->totalPages
+                     ? &process->pages[p]
+                     : &process->sharedPages[p - process->totalPages];
+    if (!mapPage(process->pageTable, page->virtualAddress, page))
+      return false;
+    if (p < process->totalPages && page->sizeClass != PAGE_SIZE_4K &&
+        sizeClasses == NULL) {
+      sizeClasses = calloc(process->totalPages, sizeof(PageSizeClass));
+      if (sizeClasses == NULL)
+        return false;
+    }
+  }
+
+  // Los hijos de un fork heredan los tamaños de página del padre
+  for (int p = 0; sizeClasses != NULL && p < process->totalPages; p++)
+    sizeClasses[p] = process->pages[p].sizeClass;
+  process->pageSizeClasses = sizeClasses;
+  return true;
+}
+
+bool restoreCheckpoint(const char *path) {
+  char buffer[256];
+  struct stat info;
+  int fd = open(path, O_RDONLY);
+
+  if (fd < 0 || fstat(fd, &info) != 0 || *getProcessCount() != 0) {
+    if (fd >= 0)
+      close(fd);
+    snprintf(buffer, sizeof(buffer),
+             "Checkpoint: no se pudo restaurar %s", path);
+    logMessage(buffer);
+    return false;
+  }
+
+  // El archivo se lee en su sitio a través de la proyección
+  void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  const CheckpointHeader *header = map != MAP_FAILED ? map : NULL;
+  bool restored = header != NULL && validHeader(header, info.st_size);
+  const char *base = map;
+  const CheckpointProcess *processes =
+      restored ? (const void *)(base + header->processOffset) : NULL;
+  const CheckpointPage *pages =
+      restored ? (const void *)(base + header->pageOffset) : NULL;
+  const CheckpointBurst *bursts =
+      restored ? (const void *)(base + header->burstOffset) : NULL;
+  const CheckpointRequest *requests =
+      restored ? (const void *)(base + header->requestOffset) : NULL;
+  const CheckpointRegion *regions =
+      restored ? (const void *)(base + header->regionOffset) : NULL;
+
+  for (int r = 0; restored && r < header->regionCount; r++)
+    restored = rangeFits(regions[r].firstAnchor, regions[r].totalPages,
+                         header->pageCount);
+  for (int i = 0; restored && i < header->processCount; i++)
+    restored = validProcess(header, &processes[i], regions);
+
+  // Crear los segmentos, los procesos y la tabla de índices de páginas
+  Process *created[MAX_PROCESSES];
+  int processCount = 0;
+  if (restored) {
+    restoredPageCount = header->pageCount;
+    restoredPages = calloc(header->pageCount + 1, sizeof(Page *));
+    restoredRegions = calloc(header->regionCount + 1, sizeof(SharedRegion *));
+    restored = restoredPages != NULL && restoredRegions != NULL;
+  }
+  for (int r = 0; restored && r < header->regionCount; r++) {
+    SharedRegion *region = createSharedRegion(regions[r].id,
+                                              regions[r].totalPages);
+    restored = region != NULL;
+    if (!restored)
+      break;
+    restoredRegions[restoredRegionCount++] = region;
+    for (int p = 0; p < region->totalPages; p++)
+      restoredPages[regions[r].firstAnchor + p] = &region->pages[p];
+  }
+  for (int i = 0; restored && i < header->processCount; i++) {
+    created[i] =
+        restoreProcess(header, &processes[i], bursts, requests, regions);
+    restored = created[i] != NULL;
+    processCount += restored;
+  }
+  for (int i = 0; restored && i < header->pageCount; i++)
+    restored = restoredPages[i] != NULL && restorePage(restoredPages[i],
+                                                       &pages[i]);
+  for (int i = 0; restored && i < processCount; i++)
+    restored = mapRestoredPages(created[i]);
+
+  // Encolar los procesos (el registro en memoria se sustituye después por
+  // los conjuntos de marcos guardados) y cargar la tabla de marcos. Los
+  // terminados ya no tienen conjunto ni memoria comprometida, y si la
+  // restauración falla se encolan sin registrar para poder liberarlos
+  Process **queue = getProcessQueue();
+  int *queued = getProcessCount();
+  for (int i = 0; i < processCount; i++) {
+    if (restored && created[i]->state != TERMINATED &&
+        addProcessToQueue(created[i]) >= 0)
+      continue;
+    restored = restored && created[i]->state == TERMINATED;
+    queue[(*queued)++] = created[i];
+  }
+  indexedProcesses = created;
+  indexedProcessCount = processCount;
+  restored =
+      restored &&
+      restoreMemoryState((const void *)(base + header->frameOffset),
+                         (const void *)(base + header->frameSetOffset),
+                         &header->memory, pageAt, processAt);
+  for (int i = 0; restored && i < processCount; i++) {
+    if (created[i]->state != TERMINATED)
+      numaRestoreCpu(created[i], processes[i].cpu);
+  }
+  indexedProcesses = NULL;
+  indexedProcessCount = 0;
+
+  if (restored) {
+    setSchedulerClock(header->clock);
+    resumePageIds(header->nextPageId);
+    snprintf(buffer, sizeof(buffer),
+             "Checkpoint restaurado desde %s: %d procesos, %d páginas "
+             "(Tiempo: %lld)",
+             path, processCount, header->pageCount, header->clock);
+  } else {
+    // Un checkpoint incompleto deja el simulador inservible; la memoria no
+    // se ha cargado, así que ninguna página restaurada queda residente
+    for (int i = 0; restoredPages != NULL && i < restoredPageCount; i++) {
+      if (restoredPages[i] != NULL) {
+        restoredPages[i]->inMemory = false;
+        restoredPages[i]->frameIndex = NO_FRAME;
+      }
+    }
+    snprintf(buffer, sizeof(buffer),
+             "Checkpoint: %s no es válido para esta configuración", path);
+  }
+  logMessage(buffer);
+
+  free(restoredPages);
+  restoredPages = NULL;
+  restoredPageCount = 0;
+  if (map != MAP_FAILED)
+    munmap(map, info.st_size);
+  return restored;
+}
+
+void releaseCheckpointRegions() {
+  for (int r = 0; r < restoredRegionCount; r++)
+    destroySharedRegion(restoredRegions[r]);
+  free(restoredRegions);
+  restoredRegions = NULL;
+  restoredRegionCount = 0;
+}
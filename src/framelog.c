@@ -0,0 +1,472 @@
+#include "framelog.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static unsigned char *stream = NULL; // Registros codificados
+static long streamBytes = 0;
+static long streamCapacity = 0;
+static FrameLogKeyframe *keyframes = NULL;
+static long keyframeCount = 0;
+static long keyframeCapacity = 0;
+static FrameState previous[NUM_FRAMES]; // Tabla de la última instantánea
+static SimTime lastTime = 0;
+static bool recording = false; // Se pidió guardar el registro
+static bool failed = false;    // Sin memoria: se deja de codificar
+static FrameLogStatistics stats = {0};
+
+static const FrameState emptyFrame = {-1, NO_FRAME, FRAME_USER, -1, 0, 0};
+
+void resetFrameLog() {
+  free(stream);
+  free(keyframes);
+  stream = NULL;
+  keyframes = NULL;
+  streamBytes = streamCapacity = keyframeCount = keyframeCapacity = 0;
+  lastTime = 0;
+  failed = false;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void startFrameLog() {
+  resetFrameLog();
+  recording = true;
+}
+
+// Asegurar sitio para bytes más en el flujo
+static bool reserveStream(long bytes) {
+  if (failed)
+    return false;
+  if (streamBytes + bytes <= streamCapacity)
+    return true;
+  long capacity = streamCapacity > 0 ? streamCapacity : 4096;
+  while (capacity < streamBytes + bytes)
+    capacity *= 2;
+  unsigned char *grown = realloc(stream, capacity);
+  if (grown == NULL)
+    return false;
+  stream = grown;
+  streamCapacity = capacity;
+  return true;
+}
+
+static void putVarint(unsigned long long value) {
+  while (value >= 0x80) {
+    stream[streamBytes++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  stream[streamBytes++] = (unsigned char)value;
+}
+
+// Zigzag: los valores pequeños de cualquier signo ocupan pocos bytes
+static void putSigned(long long value) {
+  putVarint(((unsigned long long)value << 1) ^
+            (unsigned long long)(value >> 63));
+}
+
+// Máscara de los campos en que difieren dos marcos
+static int changedFields(const FrameState *a, const FrameState *b) {
+  return (a->lastUsedTime != b->lastUsedTime ? FRAMELOG_FIELD_LAST_USED : 0) |
+         (a->headFrame != b->headFrame ? FRAMELOG_FIELD_HEAD : 0) |
+         (a->use != b->use ? FRAMELOG_FIELD_USE : 0) |
+         (a->pageId != b->pageId ? FRAMELOG_FIELD_PAGE : 0) |
+         (a->processId != b->processId ? FRAMELOG_FIELD_PROCESS : 0) |
+         (a->mapCount != b->mapCount ? FRAMELOG_FIELD_MAP_COUNT : 0);
+}
+
+// Escribir un marco cambiado: distancia, máscara y diferencias
+static void putFrame(int gap, int mask, const FrameState *from,
+                     const FrameState *to) {
+  putVarint(gap);
+  stream[streamBytes++] = (unsigned char)mask;
+  if (mask & FRAMELOG_FIELD_LAST_USED)
+    putSigned(to->lastUsedTime - from->lastUsedTime);
+  if (mask & FRAMELOG_FIELD_HEAD)
+    putSigned((long long)to->headFrame - from->headFrame);
+  if (mask & FRAMELOG_FIELD_USE)
+    putSigned((long long)to->use - from->use);
+  if (mask & FRAMELOG_FIELD_PAGE)
+    putSigned((long long)to->pageId - from->pageId);
+  if (mask & FRAMELOG_FIELD_PROCESS)
+    putSigned((long long)to->processId - from->processId);
+  if (mask & FRAMELOG_FIELD_MAP_COUNT)
+    putSigned((long long)to->mapCount - from->mapCount);
+}
+
+// Mayor tamaño de un registro: tipo, tiempo, cuenta y, por marco,
+// distancia, máscara y seis campos de hasta 10 bytes
+#define FRAMELOG_MAX_RECORD (1 + 10 + 10 + NUM_FRAMES * (10 + 1 + 6 * 10))
+
+bool frameLogRecord(SimTime time, const FrameState *states) {
+  bool keyframe = stats.snapshots % FRAMELOG_KEYFRAME_INTERVAL == 0;
+  if (time < lastTime)
+    time = lastTime;
+  if (recording && !reserveStream(FRAMELOG_MAX_RECORD))
+    failed = true;
+  if (recording && !failed && keyframe && keyframeCount == keyframeCapacity) {
+    long capacity = keyframeCapacity > 0 ? 2 * keyframeCapacity : 64;
+    FrameLogKeyframe *grown =
+        realloc(keyframes, capacity * sizeof(FrameLogKeyframe));
+    if (grown != NULL) {
+      keyframes = grown;
+      keyframeCapacity = capacity;
+    } else {
+      failed = true;
+    }
+  }
+
+  // Las completas se codifican contra la tabla vacía (sin registro o sin
+  // memoria solo se sigue la tabla para mostrar los cambios)
+  int masks[NUM_FRAMES];
+  int changed = 0;
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    masks[i] = changedFields(keyframe ? &emptyFrame : &previous[i],
+                             &states[i]);
+    if (masks[i] != 0)
+      changed++;
+  }
+  if (recording && !failed) {
+    if (keyframe)
+      keyframes[keyframeCount++] =
+          (FrameLogKeyframe){time, streamBytes, stats.snapshots};
+    stream[streamBytes++] = keyframe ? FRAMELOG_KEYFRAME : FRAMELOG_DELTA;
+    putVarint((unsigned long long)(time - lastTime));
+    putVarint(changed);
+    for (int i = 0, last = -1; i < NUM_FRAMES; i++) {
+      if (masks[i] == 0)
+        continue;
+      putFrame(i - last - 1, masks[i],
+               keyframe ? &emptyFrame : &previous[i], &states[i]);
+      last = i;
+    }
+  }
+
+  memcpy(previous, states, sizeof(previous));
+  lastTime = time;
+  stats.snapshots++;
+  if (keyframe)
+    stats.keyframes++;
+  else
+    stats.changedFrames += changed;
+  stats.encodedBytes = streamBytes;
+  stats.fullBytes += sizeof(previous);
+  return keyframe;
+}
+
+void recordFrameSnapshot(SimTime currentTime) {
+  char buffer[256];
+  FrameState states[NUM_FRAMES];
+  captureFrameStates(states);
+
+  // Solo las completas repiten la tabla entera
+  if (stats.snapshots % FRAMELOG_KEYFRAME_INTERVAL == 0) {
+    frameLogRecord(currentTime, states);
+    logMessage("\nEstado de los marcos de memoria:");
+    for (int i = 0; i < NUM_FRAMES; i++) {
+      formatFrameState(i, &states[i], buffer, sizeof(buffer));
+      logMessage(buffer);
+    }
+  } else {
+    int changed = 0;
+    for (int i = 0; i < NUM_FRAMES; i++)
+      changed += changedFields(&previous[i], &states[i]) != 0;
+    snprintf(buffer, sizeof(buffer),
+             "\nCambios en los marcos de memoria (%d de %d):", changed,
+             NUM_FRAMES);
+    logMessage(buffer);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+      if (changedFields(&previous[i], &states[i]) == 0)
+        continue;
+      formatFrameState(i, &states[i], buffer, sizeof(buffer));
+      logMessage(buffer);
+    }
+    frameLogRecord(currentTime, states);
+  }
+  snprintf(buffer, sizeof(buffer), "Tiempo actual: %lld\n", currentTime);
+  logMessage(buffer);
+}
+
+static long align8(long offset) { return (offset + 7) & ~7L; }
+
+// Escribir una sección y rellenar hasta el siguiente múltiplo de 8
+static bool writeSection(FILE *file, const void *data, size_t size,
+                         long *position) {
+  static const char padding[8] = {0};
+  long end = align8(*position + (long)size);
+  bool written = size == 0 || fwrite(data, size, 1, file) == 1;
+  written = written && (end == *position + (long)size ||
+                        fwrite(padding, end - *position - size, 1, file) == 1);
+  *position = end;
+  return written;
+}
+
+bool saveFrameLog(const char *path) {
+  char buffer[256];
+  FrameLogHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, FRAMELOG_MAGIC, sizeof(header.magic));
+  header.version = FRAMELOG_VERSION;
+  header.numFrames = NUM_FRAMES;
+  header.snapshotCount = stats.snapshots;
+  header.keyframeCount = keyframeCount;
+  header.streamBytes = streamBytes;
+  header.endTime = lastTime;
+  header.keyframeOffset = align8(sizeof(header));
+  header.streamOffset = align8(header.keyframeOffset +
+                               keyframeCount * (long)sizeof(FrameLogKeyframe));
+
+  FILE *file = !recording || failed ? NULL : fopen(path, "wb");
+  long position = 0;
+  bool saved =
+      file != NULL && writeSection(file, &header, sizeof(header), &position) &&
+      writeSection(file, keyframes, keyframeCount * sizeof(FrameLogKeyframe),
+                   &position) &&
+      writeSection(file, stream, streamBytes, &position);
+  if (file != NULL && fclose(file) != 0)
+    saved = false;
+
+  if (saved)
+    snprintf(buffer, sizeof(buffer),
+             "Registro de marcos guardado en %s: %ld instantáneas (%ld "
+             "completas) en %ld bytes",
+             path, stats.snapshots, keyframeCount, streamBytes);
+  else
+    snprintf(buffer, sizeof(buffer),
+             "Registro de marcos: no se pudo guardar en %s", path);
+  logMessage(buffer);
+  return saved;
+}
+
+// Comprobar que una sección de count registros cabe en el archivo (sin
+// desbordar con valores dañados)
+static bool sectionFits(long offset, long count, size_t size, long fileSize) {
+  return offset >= (long)sizeof(FrameLogHeader) && offset <= fileSize &&
+         offset % 8 == 0 && count >= 0 &&
+         count <= (fileSize - offset) / (long)size;
+}
+
+// Comprobar la cabecera contra el tamaño del archivo
+static bool validHeader(const FrameLogHeader *h, long fileSize) {
+  return memcmp(h->magic, FRAMELOG_MAGIC, sizeof(h->magic)) == 0 &&
+         h->version == FRAMELOG_VERSION && h->numFrames >= 1 &&
+         sectionFits(h->keyframeOffset, h->keyframeCount,
+                     sizeof(FrameLogKeyframe), fileSize) &&
+         sectionFits(h->streamOffset, h->streamBytes, 1, fileSize) &&
+         h->keyframeCount <= h->snapshotCount;
+}
+
+// Comprobar que el índice apunta dentro del flujo y en orden
+static bool validIndex(const FrameLogView *view) {
+  const FrameLogHeader *h = view->header;
+  for (long k = 0; k < h->keyframeCount; k++) {
+    const FrameLogKeyframe *entry = &view->keyframes[k];
+    const FrameLogKeyframe *before = k > 0 ? entry - 1 : NULL;
+    if (entry->offset < 0 || entry->offset >= h->streamBytes ||
+        view->stream[entry->offset] != FRAMELOG_KEYFRAME ||
+        entry->snapshot < 0 || entry->snapshot >= h->snapshotCount ||
+        (before != NULL && (entry->offset <= before->offset ||
+                            entry->snapshot <= before->snapshot ||
+                            entry->time < before->time)))
+      return false;
+  }
+  return true;
+}
+
+bool openFrameLog(const char *path, FrameLogView *view) {
+  memset(view, 0, sizeof(FrameLogView));
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      info.st_size < (off_t)sizeof(FrameLogHeader)) {
+    close(fd);
+    return false;
+  }
+  void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+  view->data = data;
+  view->size = (long)info.st_size;
+  view->header = data;
+  if (!validHeader(view->header, view->size)) {
+    closeFrameLog(view);
+    return false;
+  }
+
+  // Las secciones se leen en su sitio
+  const char *base = data;
+  view->keyframes =
+      (const FrameLogKeyframe *)(base + view->header->keyframeOffset);
+  view->stream = (const unsigned char *)(base + view->header->streamOffset);
+  if (!validIndex(view)) {
+    closeFrameLog(view);
+    return false;
+  }
+  return true;
+}
+
+void closeFrameLog(FrameLogView *view) {
+  if (view->data != NULL)
+    munmap(view->data, view->size);
+  memset(view, 0, sizeof(FrameLogView));
+}
+
+// Cursor de lectura del flujo
+typedef struct {
+  const unsigned char *bytes;
+  long position;
+  long end;
+  bool valid; // false al salirse del flujo o leer un varint demasiado largo
+} Reader;
+
+static unsigned long long getVarint(Reader *reader) {
+  unsigned long long value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (reader->position >= reader->end)
+      break;
+    unsigned char byte = reader->bytes[reader->position++];
+    value |= (unsigned long long)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  reader->valid = false;
+  return 0;
+}
+
+static long long getSigned(Reader *reader) {
+  unsigned long long value = getVarint(reader);
+  return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+// Aplicar los marcos cambiados de un registro; false si está dañado
+static bool applyFrames(Reader *reader, int numFrames, FrameState *states) {
+  unsigned long long changed = getVarint(reader);
+  long frame = -1;
+  for (unsigned long long c = 0; c < changed && reader->valid; c++) {
+    // La distancia se comprueba antes de sumarla: un varint dañado no
+    // puede dar la vuelta a un índice negativo
+    unsigned long long gap = getVarint(reader);
+    if (!reader->valid || gap >= (unsigned long long)(numFrames - frame - 1))
+      return false;
+    frame += (long)gap + 1;
+    if (frame < 0 || reader->position >= reader->end)
+      return false;
+    int mask = reader->bytes[reader->position++];
+    FrameState *state = &states[frame];
+    if (mask & FRAMELOG_FIELD_LAST_USED)
+      state->lastUsedTime = (SimTime)((unsigned long long)state->lastUsedTime +
+                                      (unsigned long long)getSigned(reader));
+    if (mask & FRAMELOG_FIELD_HEAD)
+      state->headFrame = (int)(state->headFrame + getSigned(reader));
+    if (mask & FRAMELOG_FIELD_USE)
+      state->use = (int)(state->use + getSigned(reader));
+    if (mask & FRAMELOG_FIELD_PAGE)
+      state->pageId = (int)(state->pageId + getSigned(reader));
+    if (mask & FRAMELOG_FIELD_PROCESS)
+      state->processId = (int)(state->processId + getSigned(reader));
+    if (mask & FRAMELOG_FIELD_MAP_COUNT)
+      state->mapCount = (int)(state->mapCount + getSigned(reader));
+  }
+  return reader->valid;
+}
+
+long frameLogStateAt(const FrameLogView *view, SimTime time,
+                     FrameState *states) {
+  const FrameLogHeader *h = view->header;
+
+  // Última instantánea completa no posterior a time
+  long low = 0, high = h->keyframeCount;
+  while (low < high) {
+    long middle = low + (high - low) / 2;
+    if (view->keyframes[middle].time <= time)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == 0)
+    return -1;
+  const FrameLogKeyframe *keyframe = &view->keyframes[low - 1];
+
+  // Aplicar desde ella los registros hasta el primero posterior a time
+  // (el avance de tiempo de la completa es respecto a la anterior, que no
+  // se lee: su tiempo está en el índice)
+  Reader reader = {view->stream, keyframe->offset, h->streamBytes, true};
+  SimTime recordTime = keyframe->time;
+  long snapshot = keyframe->snapshot;
+  reader.position++;
+  getVarint(&reader);
+  for (int i = 0; i < h->numFrames; i++)
+    states[i] = emptyFrame;
+  if (!applyFrames(&reader, h->numFrames, states))
+    return -1;
+  while (reader.position < reader.end) {
+    int type = reader.bytes[reader.position++];
+    SimTime next = recordTime + (SimTime)getVarint(&reader);
+    if (!reader.valid || (type != FRAMELOG_KEYFRAME && type != FRAMELOG_DELTA))
+      return -1;
+    if (next > time)
+      break;
+    if (type == FRAMELOG_KEYFRAME) {
+      for (int i = 0; i < h->numFrames; i++)
+        states[i] = emptyFrame;
+    }
+    if (!applyFrames(&reader, h->numFrames, states))
+      return -1;
+    recordTime = next;
+    snapshot++;
+  }
+  return snapshot < h->snapshotCount ? snapshot : -1;
+}
+
+int runFrameLogQuery(int argc, char *argv[]) {
+  FrameLogView view;
+  char *end = NULL;
+  long long time = argc == 2 ? strtoll(argv[1], &end, 10) : 0;
+  if (argc != 2 || end == argv[1] || *end != '\0') {
+    fprintf(stderr, "Uso: frames ARCHIVO T\n");
+    return 1;
+  }
+  if (!openFrameLog(argv[0], &view)) {
+    fprintf(stderr, "No se pudo abrir el registro de marcos %s\n", argv[0]);
+    return 1;
+  }
+  FrameState *states = malloc(view.header->numFrames * sizeof(FrameState));
+  long snapshot =
+      states != NULL ? frameLogStateAt(&view, time, states) : -1;
+  if (snapshot < 0) {
+    printf("Marcos en %lld: sin datos\n", time);
+  } else {
+    char text[256];
+    printf("Marcos en %lld (instantánea %ld de %ld):\n", time, snapshot + 1,
+           view.header->snapshotCount);
+    for (int i = 0; i < view.header->numFrames; i++) {
+      formatFrameState(i, &states[i], text, sizeof(text));
+      printf("  %s\n", text);
+    }
+  }
+  free(states);
+  closeFrameLog(&view);
+  return 0;
+}
+
+FrameLogStatistics getFrameLogStatistics() { return stats; }
+
+void displayFrameLogStatistics() {
+  char buffer[256];
+  if (!recording || stats.snapshots == 0)
+    return;
+  snprintf(buffer, sizeof(buffer),
+           "Instantáneas de marcos: %ld (%ld completas), %ld marcos "
+           "cambiados en las parciales; %ld bytes codificados frente a %ld "
+           "de tablas completas (%.1f%%)",
+           stats.snapshots, stats.keyframes, stats.changedFrames,
+           stats.encodedBytes, stats.fullBytes,
+           100.0 * stats.encodedBytes / stats.fullBytes);
+  logMessage(buffer);
+}
@@ -0,0 +1,674 @@
+#include "history.h"
+#include "memory.h"
+#include "pagecache.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Último valor registrado de una clave (tabla de direccionamiento abierto)
+typedef struct {
+  int series;
+  int key;
+  int value;
+  int detail;
+  long row; // Su última fila
+  bool used;
+} LastValue;
+
+static bool recording = false;
+static SimTime *times = NULL; // Columnas de los cambios registrados
+static int *seriesColumn = NULL;
+static int *keys = NULL;
+static int *values = NULL;
+static int *details = NULL;
+static long rowCount = 0;
+static long rowCapacity = 0;
+static SimTime lastTime = 0;
+static LastValue *lastValues = NULL;
+static long lastCount = 0;
+static long lastCapacity = 0; // Potencia de dos, al menos el doble de
+                              // lastCount
+
+// Liberar las columnas y la tabla de últimos valores
+static void releaseRecording() {
+  free(times);
+  free(seriesColumn);
+  free(keys);
+  free(values);
+  free(details);
+  free(lastValues);
+  times = NULL;
+  seriesColumn = keys = values = details = NULL;
+  lastValues = NULL;
+  rowCount = rowCapacity = lastCount = lastCapacity = 0;
+  lastTime = 0;
+}
+
+bool startHistory() {
+  releaseRecording();
+  recording = true;
+  return true;
+}
+
+bool historyEnabled() { return recording; }
+
+static LastValue *findLastValue(LastValue *table, long capacity, int series,
+                                int key) {
+  unsigned long mask = (unsigned long)capacity - 1;
+  unsigned long slot =
+      ((unsigned long)(unsigned)key * 2654435761u + series) & mask;
+  while (table[slot].used &&
+         (table[slot].series != series || table[slot].key != key))
+    slot = (slot + 1) & mask;
+  return &table[slot];
+}
+
+// Hacer sitio para una clave más; false si no hay memoria
+static bool growLastValues() {
+  if (2 * (lastCount + 1) <= lastCapacity)
+    return true;
+  long capacity = lastCapacity > 0 ? 2 * lastCapacity : 256;
+  LastValue *table = calloc(capacity, sizeof(LastValue));
+  if (table == NULL)
+    return false;
+  for (long i = 0; i < lastCapacity; i++) {
+    if (lastValues[i].used)
+      *findLastValue(table, capacity, lastValues[i].series,
+                     lastValues[i].key) = lastValues[i];
+  }
+  free(lastValues);
+  lastValues = table;
+  lastCapacity = capacity;
+  return true;
+}
+
+// Hacer sitio para una fila más en cada columna; false si no hay memoria
+static bool growRows() {
+  if (rowCount < rowCapacity)
+    return true;
+  long capacity = rowCapacity > 0 ? 2 * rowCapacity : 4096;
+  SimTime *newTimes = realloc(times, capacity * sizeof(SimTime));
+  if (newTimes != NULL)
+    times = newTimes;
+  int **columns[] = {&seriesColumn, &keys, &values, &details};
+  bool grown = newTimes != NULL;
+  for (int c = 0; c < 4 && grown; c++) {
+    int *column = realloc(*columns[c], capacity * sizeof(int));
+    if (column != NULL)
+      *columns[c] = column;
+    grown = column != NULL;
+  }
+  if (grown)
+    rowCapacity = capacity;
+  return grown;
+}
+
+void historyRecord(HistorySeries series, SimTime time, int key, int value,
+                   int detail) {
+  if (!recording || !growLastValues())
+    return;
+  LastValue *last = findLastValue(lastValues, lastCapacity, series, key);
+  if (last->used && last->value == value && last->detail == detail)
+    return;
+  if (time < lastTime)
+    time = lastTime;
+
+  // Los valores que duran cero ticks no se guardan: un segundo cambio en
+  // el mismo tiempo sustituye al primero
+  if (last->used && times[last->row] == time) {
+    values[last->row] = last->value = value;
+    details[last->row] = last->detail = detail;
+    return;
+  }
+  if (!growRows())
+    return;
+  lastTime = time;
+  times[rowCount] = time;
+  seriesColumn[rowCount] = series;
+  keys[rowCount] = key;
+  values[rowCount] = value;
+  details[rowCount] = detail;
+  rowCount++;
+  if (!last->used)
+    lastCount++;
+  *last = (LastValue){series, key, value, detail, rowCount - 1, true};
+}
+
+// Orden del índice: por serie, clave y fila (la fila sigue el tiempo)
+static int compareIndexRows(const void *a, const void *b) {
+  long x = *(const long *)a, y = *(const long *)b;
+  if (seriesColumn[x] != seriesColumn[y])
+    return seriesColumn[x] < seriesColumn[y] ? -1 : 1;
+  if (keys[x] != keys[y])
+    return keys[x] < keys[y] ? -1 : 1;
+  return (x > y) - (x < y);
+}
+
+static long align8(long offset) { return (offset + 7) & ~7L; }
+
+// Escribir una sección y rellenar hasta el siguiente múltiplo de 8
+static bool writeSection(FILE *file, const void *data, size_t size,
+                         long *position) {
+  static const char padding[8] = {0};
+  long end = align8(*position + (long)size);
+  bool written = size == 0 || fwrite(data, size, 1, file) == 1;
+  written = written && (end == *position + (long)size ||
+                        fwrite(padding, end - *position - size, 1, file) == 1);
+  *position = end;
+  return written;
+}
+
+// Indica si dos filas son de la misma clave
+static bool sameKey(long a, long b) {
+  return seriesColumn[a] == seriesColumn[b] && keys[a] == keys[b];
+}
+
+bool saveHistory(const char *path) {
+  char buffer[256];
+  HistoryHeader header;
+  recording = false;
+
+  long *order = malloc((rowCount > 0 ? rowCount : 1) * sizeof(long));
+  long *newRow = malloc((rowCount > 0 ? rowCount : 1) * sizeof(long));
+  HistoryKey *keyIndex =
+      malloc((lastCount > 0 ? lastCount : 1) * sizeof(HistoryKey));
+  HistoryInterval *intervals =
+      malloc((rowCount > 0 ? rowCount : 1) * sizeof(HistoryInterval));
+  bool saved = order != NULL && newRow != NULL && keyIndex != NULL &&
+               intervals != NULL;
+
+  // Las filas de cada clave juntas y en orden de tiempo; se descartan las
+  // que repiten el valor anterior de su clave (un cambio sustituido en el
+  // mismo tiempo puede devolverla a él)
+  for (long i = 0; i < rowCount && saved; i++)
+    order[i] = i;
+  if (saved)
+    qsort(order, rowCount, sizeof(long), compareIndexRows);
+  for (long i = 0; i < rowCount && saved; i++) {
+    long row = order[i], previous = i > 0 ? order[i - 1] : -1;
+    newRow[row] = previous >= 0 && sameKey(previous, row) &&
+                          values[previous] == values[row] &&
+                          details[previous] == details[row]
+                      ? -1
+                      : 0;
+  }
+
+  // Índice de intervalos: cada cambio dura hasta el siguiente de su clave
+  long keyCount = 0, kept = 0;
+  for (long i = 0; i < rowCount && saved; i++) {
+    long row = order[i];
+    if (newRow[row] < 0)
+      continue;
+    if (keyCount > 0 && keyIndex[keyCount - 1].series == seriesColumn[row] &&
+        keyIndex[keyCount - 1].key == keys[row])
+      intervals[kept - 1].end = times[row];
+    else
+      keyIndex[keyCount++] =
+          (HistoryKey){seriesColumn[row], keys[row], kept, 0};
+    keyIndex[keyCount - 1].intervalCount++;
+    intervals[kept++] = (HistoryInterval){times[row], HISTORY_OPEN_END, row};
+  }
+
+  // Compactar las columnas sin las filas descartadas
+  kept = 0;
+  for (long row = 0; row < rowCount && saved; row++) {
+    if (newRow[row] < 0)
+      continue;
+    times[kept] = times[row];
+    seriesColumn[kept] = seriesColumn[row];
+    keys[kept] = keys[row];
+    values[kept] = values[row];
+    details[kept] = details[row];
+    newRow[row] = kept++;
+  }
+  for (long i = 0; i < kept; i++)
+    intervals[i].row = newRow[intervals[i].row];
+  if (saved)
+    rowCount = kept;
+
+  // Particiones de tiempo: bloques consecutivos de filas
+  long partitionCount = (rowCount + HISTORY_PARTITION_ROWS - 1) /
+                        HISTORY_PARTITION_ROWS;
+  HistoryPartition *partitions =
+      calloc(partitionCount > 0 ? partitionCount : 1,
+             sizeof(HistoryPartition));
+  saved = saved && partitions != NULL;
+  for (long p = 0; p < partitionCount && saved; p++) {
+    HistoryPartition *partition = &partitions[p];
+    partition->firstRow = p * HISTORY_PARTITION_ROWS;
+    partition->rows = rowCount - partition->firstRow;
+    if (partition->rows > HISTORY_PARTITION_ROWS)
+      partition->rows = HISTORY_PARTITION_ROWS;
+    partition->firstTime = times[partition->firstRow];
+    partition->lastTime = times[partition->firstRow + partition->rows - 1];
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, HISTORY_MAGIC, sizeof(header.magic));
+  header.version = HISTORY_VERSION;
+  header.partitionRows = HISTORY_PARTITION_ROWS;
+  header.endTime = lastTime;
+  header.rowCount = rowCount;
+  header.partitionCount = partitionCount;
+  header.keyCount = keyCount;
+  header.timeOffset = align8(sizeof(header));
+  header.seriesOffset =
+      align8(header.timeOffset + rowCount * (long)sizeof(SimTime));
+  header.keyOffset = align8(header.seriesOffset + rowCount * (long)sizeof(int));
+  header.valueOffset = align8(header.keyOffset + rowCount * (long)sizeof(int));
+  header.detailOffset =
+      align8(header.valueOffset + rowCount * (long)sizeof(int));
+  header.partitionOffset =
+      align8(header.detailOffset + rowCount * (long)sizeof(int));
+  header.keyIndexOffset =
+      align8(header.partitionOffset +
+             partitionCount * (long)sizeof(HistoryPartition));
+  header.intervalOffset =
+      align8(header.keyIndexOffset + keyCount * (long)sizeof(HistoryKey));
+
+  FILE *file = saved ? fopen(path, "wb") : NULL;
+  long position = 0;
+  saved = file != NULL &&
+          writeSection(file, &header, sizeof(header), &position) &&
+          writeSection(file, times, rowCount * sizeof(SimTime), &position) &&
+          writeSection(file, seriesColumn, rowCount * sizeof(int),
+                       &position) &&
+          writeSection(file, keys, rowCount * sizeof(int), &position) &&
+          writeSection(file, values, rowCount * sizeof(int), &position) &&
+          writeSection(file, details, rowCount * sizeof(int), &position) &&
+          writeSection(file, partitions,
+                       partitionCount * sizeof(HistoryPartition),
+                       &position) &&
+          writeSection(file, keyIndex, keyCount * sizeof(HistoryKey),
+                       &position) &&
+          writeSection(file, intervals, rowCount * sizeof(HistoryInterval),
+                       &position);
+  if (file != NULL && fclose(file) != 0)
+    saved = false;
+  free(partitions);
+  free(order);
+  free(newRow);
+  free(keyIndex);
+  free(intervals);
+
+  if (saved)
+    snprintf(buffer, sizeof(buffer),
+             "Historial guardado en %s: %ld cambios de %ld claves en %ld "
+             "particiones (hasta el tiempo %lld)",
+             path, rowCount, keyCount, partitionCount, lastTime);
+  else
+    snprintf(buffer, sizeof(buffer), "Historial: no se pudo guardar en %s",
+             path);
+  logMessage(buffer);
+  releaseRecording();
+  return saved;
+}
+
+// Comprobar que una sección de count registros cabe en el archivo (sin
+// desbordar con valores dañados)
+static bool sectionFits(long offset, long count, size_t size, long fileSize) {
+  return offset >= (long)sizeof(HistoryHeader) && offset <= fileSize &&
+         offset % 8 == 0 && count >= 0 &&
+         count <= (fileSize - offset) / (long)size;
+}
+
+// Comprobar la cabecera contra el tamaño del archivo
+static bool validHeader(const HistoryHeader *h, long fileSize) {
+  return memcmp(h->magic, HISTORY_MAGIC, sizeof(h->magic)) == 0 &&
+         h->version == HISTORY_VERSION && h->partitionRows >= 1 &&
+         sectionFits(h->timeOffset, h->rowCount, sizeof(SimTime),
+                     fileSize) &&
+         sectionFits(h->seriesOffset, h->rowCount, sizeof(int), fileSize) &&
+         sectionFits(h->keyOffset, h->rowCount, sizeof(int), fileSize) &&
+         sectionFits(h->valueOffset, h->rowCount, sizeof(int), fileSize) &&
+         sectionFits(h->detailOffset, h->rowCount, sizeof(int), fileSize) &&
+         sectionFits(h->partitionOffset, h->partitionCount,
+                     sizeof(HistoryPartition), fileSize) &&
+         sectionFits(h->keyIndexOffset, h->keyCount, sizeof(HistoryKey),
+                     fileSize) &&
+         sectionFits(h->intervalOffset, h->rowCount, sizeof(HistoryInterval),
+                     fileSize) &&
+         h->partitionCount ==
+             (h->rowCount + h->partitionRows - 1) / h->partitionRows;
+}
+
+// Comprobar que el directorio y el índice apuntan dentro de las columnas
+// (los rangos se comparan con lo que queda tras su inicio, sin sumarlos)
+static bool validIndex(const HistoryStore *store) {
+  const HistoryHeader *h = store->header;
+  for (long p = 0; p < h->partitionCount; p++) {
+    const HistoryPartition *partition = &store->partitions[p];
+    if (partition->firstRow != p * h->partitionRows || partition->rows < 1 ||
+        partition->rows > h->rowCount - partition->firstRow)
+      return false;
+  }
+  for (long k = 0; k < h->keyCount; k++) {
+    const HistoryKey *key = &store->keyIndex[k];
+    if (key->firstInterval < 0 || key->firstInterval > h->rowCount ||
+        key->intervalCount < 1 ||
+        key->intervalCount > h->rowCount - key->firstInterval)
+      return false;
+  }
+  for (long i = 0; i < h->rowCount; i++) {
+    if (store->intervals[i].row < 0 || store->intervals[i].row >= h->rowCount)
+      return false;
+  }
+  return true;
+}
+
+bool openHistory(const char *path, HistoryStore *store) {
+  memset(store, 0, sizeof(HistoryStore));
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(HistoryHeader)) {
+    close(fd);
+    return false;
+  }
+  void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+  store->data = data;
+  store->size = (long)info.st_size;
+  store->header = data;
+  if (!validHeader(store->header, store->size)) {
+    closeHistory(store);
+    return false;
+  }
+
+  // Las secciones se leen en su sitio
+  const char *base = data;
+  const HistoryHeader *h = store->header;
+  store->times = (const SimTime *)(base + h->timeOffset);
+  store->series = (const int *)(base + h->seriesOffset);
+  store->keys = (const int *)(base + h->keyOffset);
+  store->values = (const int *)(base + h->valueOffset);
+  store->details = (const int *)(base + h->detailOffset);
+  store->partitions = (const HistoryPartition *)(base + h->partitionOffset);
+  store->keyIndex = (const HistoryKey *)(base + h->keyIndexOffset);
+  store->intervals = (const HistoryInterval *)(base + h->intervalOffset);
+  if (!validIndex(store)) {
+    closeHistory(store);
+    return false;
+  }
+  return true;
+}
+
+void closeHistory(HistoryStore *store) {
+  if (store->data != NULL)
+    munmap(store->data, store->size);
+  memset(store, 0, sizeof(HistoryStore));
+}
+
+// Entrada del índice de una clave (búsqueda binaria); NULL si no existe
+static const HistoryKey *findKey(const HistoryStore *store,
+                                 HistorySeries series, int key) {
+  long low = 0, high = store->header->keyCount;
+  while (low < high) {
+    long middle = low + (high - low) / 2;
+    const HistoryKey *entry = &store->keyIndex[middle];
+    if (entry->series < (int)series ||
+        (entry->series == (int)series && entry->key < key))
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == store->header->keyCount)
+    return NULL;
+  const HistoryKey *entry = &store->keyIndex[low];
+  return entry->series == (int)series && entry->key == key ? entry : NULL;
+}
+
+// Número de intervalos de la clave que empiezan no después de time
+static long intervalsUntil(const HistoryStore *store, const HistoryKey *key,
+                           SimTime time) {
+  const HistoryInterval *intervals = &store->intervals[key->firstInterval];
+  long low = 0, high = key->intervalCount;
+  while (low < high) {
+    long middle = low + (high - low) / 2;
+    if (intervals[middle].start <= time)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+const HistoryInterval *historyValueAt(const HistoryStore *store,
+                                      HistorySeries series, int key,
+                                      SimTime time) {
+  const HistoryKey *entry = findKey(store, series, key);
+  if (entry == NULL)
+    return NULL;
+  long until = intervalsUntil(store, entry, time);
+  return until > 0 ? &store->intervals[entry->firstInterval + until - 1]
+                   : NULL;
+}
+
+const HistoryInterval *historyIntervals(const HistoryStore *store,
+                                        HistorySeries series, int key,
+                                        SimTime from, SimTime to,
+                                        long *count) {
+  *count = 0;
+  const HistoryKey *entry = findKey(store, series, key);
+  if (entry == NULL || to < from)
+    return NULL;
+  // Desde el intervalo que contiene from (o el primero) hasta el último
+  // que empieza no después de to
+  long first = intervalsUntil(store, entry, from);
+  if (first > 0)
+    first--;
+  long last = intervalsUntil(store, entry, to);
+  if (last > first)
+    *count = last - first;
+  return &store->intervals[entry->firstInterval + first];
+}
+
+long historyFirstRow(const HistoryStore *store, SimTime time) {
+  const HistoryHeader *h = store->header;
+
+  // Partición: la primera que termina no antes de time
+  long low = 0, high = h->partitionCount;
+  while (low < high) {
+    long middle = low + (high - low) / 2;
+    if (store->partitions[middle].lastTime < time)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == h->partitionCount)
+    return h->rowCount;
+
+  // Fila: la primera de la partición con tiempo no anterior
+  const HistoryPartition *partition = &store->partitions[low];
+  long row = partition->firstRow, end = row + partition->rows;
+  while (row < end) {
+    long middle = row + (end - row) / 2;
+    if (store->times[middle] < time)
+      row = middle + 1;
+    else
+      end = middle;
+  }
+  return row;
+}
+
+// Describir el valor de una fila
+static void describeRow(const HistoryStore *store, long row, char *text,
+                        size_t size) {
+  static const char *stateNames[] = {"listo", "en ejecución", "esperando",
+                                     "terminado"};
+  int value = store->values[row], detail = store->details[row];
+  switch (store->series[row]) {
+  case HISTORY_FRAME:
+    if (value == HISTORY_NONE)
+      snprintf(text, size, "vacío");
+    else if (detail == PAGE_CACHE_OWNER)
+      snprintf(text, size, "página %d de la caché de archivos", value);
+    else if (detail == SHARED_REGION_OWNER)
+      snprintf(text, size, "página %d de un segmento compartido", value);
+    else
+      snprintf(text, size, "página %d del proceso %d", value, detail);
+    break;
+  case HISTORY_PROCESS:
+    if (value >= 0 && value < 4 && detail >= 0)
+      snprintf(text, size, "%s (CPU %d)", stateNames[value], detail);
+    else if (value >= 0 && value < 4)
+      snprintf(text, size, "%s", stateNames[value]);
+    else
+      snprintf(text, size, "estado %d", value);
+    break;
+  default:
+    snprintf(text, size, "%d procesos listos", value);
+    break;
+  }
+}
+
+// Escribir un intervalo de una clave
+static void printInterval(const HistoryStore *store,
+                          const HistoryInterval *interval) {
+  char text[128], end[32];
+  describeRow(store, interval->row, text, sizeof(text));
+  if (interval->end == HISTORY_OPEN_END)
+    snprintf(end, sizeof(end), "fin");
+  else
+    snprintf(end, sizeof(end), "%lld", interval->end);
+  printf("  [%lld, %s): %s\n", interval->start, end, text);
+}
+
+// Consultar una clave en un tiempo o en un rango; para la cola también la
+// longitud media y máxima del rango
+static void queryKey(const HistoryStore *store, HistorySeries series,
+                     int key, const char *name, SimTime from, SimTime to,
+                     bool range) {
+  if (!range) {
+    const HistoryInterval *interval =
+        historyValueAt(store, series, key, from);
+    printf("%s en %lld:\n", name, from);
+    if (interval == NULL)
+      printf("  sin datos\n");
+    else
+      printInterval(store, interval);
+    return;
+  }
+
+  long count;
+  const HistoryInterval *intervals =
+      historyIntervals(store, series, key, from, to, &count);
+  printf("%s en [%lld, %lld]: %ld intervalos\n", name, from, to, count);
+  SimTime end = to < store->header->endTime ? to : store->header->endTime;
+  double weighted = 0.0;
+  SimTime covered = 0;
+  int maximum = 0;
+  for (long i = 0; i < count; i++) {
+    printInterval(store, &intervals[i]);
+    int value = store->values[intervals[i].row];
+    SimTime start = intervals[i].start > from ? intervals[i].start : from;
+    SimTime stop = intervals[i].end == HISTORY_OPEN_END ||
+                           intervals[i].end > end
+                       ? end
+                       : intervals[i].end;
+    if (stop > start) {
+      weighted += (double)value * (stop - start);
+      covered += stop - start;
+    }
+    if (value > maximum)
+      maximum = value;
+  }
+  if (series == HISTORY_QUEUE && count > 0)
+    printf("  longitud media %.2f, máxima %d\n",
+           covered > 0 ? weighted / covered : 0.0, maximum);
+}
+
+// Leer un tiempo o un número de la línea de órdenes
+static bool parseNumber(const char *text, long long *number) {
+  char *end;
+  *number = strtoll(text, &end, 10);
+  return end != text && *end == '\0';
+}
+
+int runHistoryQuery(int argc, char *argv[]) {
+  HistoryStore store;
+  long long numbers[3];
+  int count = argc - 2;
+  char name[64];
+
+  // Números que admite cada consulta (mínimo y máximo)
+  const char *kind = argc >= 2 ? argv[1] : "";
+  int minimum = 0, maximum = 0;
+  if (strcmp(kind, "marco") == 0 || strcmp(kind, "proceso") == 0)
+    minimum = 2, maximum = 3;
+  else if (strcmp(kind, "cola") == 0)
+    minimum = 1, maximum = 2;
+  else if (strcmp(kind, "marcos") == 0)
+    minimum = maximum = 1;
+  else if (strcmp(kind, "eventos") == 0)
+    minimum = maximum = 2;
+  if (count < minimum || count > maximum || maximum == 0) {
+    fprintf(stderr, "Uso: query ARCHIVO marco N T [HASTA] | marcos T | "
+                    "proceso ID T [HASTA] | cola T [HASTA] | "
+                    "eventos DESDE HASTA\n");
+    return 1;
+  }
+  for (int i = 0; i < count; i++) {
+    if (!parseNumber(argv[i + 2], &numbers[i])) {
+      fprintf(stderr, "Número inválido: %s\n", argv[i + 2]);
+      return 1;
+    }
+  }
+  if (!openHistory(argv[0], &store)) {
+    fprintf(stderr, "No se pudo abrir el historial %s\n", argv[0]);
+    return 1;
+  }
+
+  if (strcmp(kind, "marco") == 0 || strcmp(kind, "proceso") == 0) {
+    bool frame = kind[0] == 'm';
+    snprintf(name, sizeof(name), "%s %lld", frame ? "Marco" : "Proceso",
+             numbers[0]);
+    queryKey(&store, frame ? HISTORY_FRAME : HISTORY_PROCESS,
+             (int)numbers[0], name, numbers[1],
+             count == 3 ? numbers[2] : numbers[1], count == 3);
+  } else if (strcmp(kind, "cola") == 0) {
+    queryKey(&store, HISTORY_QUEUE, 0, "Cola de listos", numbers[0],
+             count == 2 ? numbers[1] : numbers[0], count == 2);
+  } else if (strcmp(kind, "marcos") == 0) {
+    // Las claves de los marcos van juntas y ordenadas en el índice
+    char text[128];
+    printf("Marcos en %lld:\n", numbers[0]);
+    for (long k = 0; k < store.header->keyCount; k++) {
+      const HistoryKey *entry = &store.keyIndex[k];
+      if (entry->series != HISTORY_FRAME)
+        continue;
+      const HistoryInterval *interval =
+          historyValueAt(&store, HISTORY_FRAME, entry->key, numbers[0]);
+      if (interval == NULL)
+        continue;
+      describeRow(&store, interval->row, text, sizeof(text));
+      printf("  Marco %d: %s\n", entry->key, text);
+    }
+  } else {
+    // Cambios de todas las series, por orden de tiempo
+    static const char *seriesNames[] = {"Marco", "Proceso", "Cola"};
+    char text[128];
+    long row = historyFirstRow(&store, numbers[0]);
+    printf("Cambios en [%lld, %lld]:\n", numbers[0], numbers[1]);
+    for (; row < store.header->rowCount && store.times[row] <= numbers[1];
+         row++) {
+      int series = store.series[row];
+      describeRow(&store, row, text, sizeof(text));
+      if (series == HISTORY_QUEUE)
+        printf("  %lld %s: %s\n", store.times[row], seriesNames[series],
+               text);
+      else if (series >= 0 && series < HISTORY_SERIES)
+        printf("  %lld %s %d: %s\n", store.times[row], seriesNames[series],
+               store.keys[row], text);
+    }
+  }
+  closeHistory(&store);
+  return 0;
+}
@@ -0,0 +1,379 @@
+#include "iodevice.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Dispositivos de bloques simulados
+static IoDevice devices[MAX_IO_DEVICES];
+static int deviceCount = 0;
+
+static const char *schedulerNames[] = {"FIFO", "deadline", "BFQ",
+                                       "mq-deadline"};
+
+int addIoDevice(const char *name, IoSchedulerKind scheduler, int queueDepth,
+                int latency, int speed, IoServiceDistribution distribution,
+                unsigned int seed) {
+  if (deviceCount == MAX_IO_DEVICES || queueDepth <= 0 || latency < 0 ||
+      speed <= 0)
+    return -1;
+
+  IoDevice *d = &devices[deviceCount];
+  memset(d, 0, sizeof(IoDevice));
+  snprintf(d->name, sizeof(d->name), "%s", name);
+  d->scheduler = scheduler;
+  d->queueDepth = queueDepth;
+  d->latency = latency;
+  d->speed = speed;
+  d->distribution = distribution;
+  rngSeed(&d->rng, seed);
+  for (int i = 0; i < IO_MAX_FLOWS; i++)
+    d->flows[i].flowId = NO_FRAME;
+  return deviceCount++;
+}
+
+// Liberar una lista de peticiones
+static void freeRequests(IoRequest *request) {
+  while (request != NULL) {
+    IoRequest *next = request->next;
+    free(request);
+    request = next;
+  }
+}
+
+void resetIoDevices() {
+  for (int i = 0; i < deviceCount; i++) {
+    freeRequests(devices[i].queue);
+    freeRequests(devices[i].inFlight);
+  }
+  deviceCount = 0;
+}
+
+int ioDeviceCount() { return deviceCount; }
+
+int ioDeviceForFile(int fileId) {
+  if (deviceCount == 0)
+    return 0;
+  int device = fileId % deviceCount;
+  return device < 0 ? device + deviceCount : device;
+}
+
+long ioSector(int fileId, long pageIndex) {
+  return (long)fileId * IO_FILE_SPAN + pageIndex;
+}
+
+// Tiempo de servicio de una petición según la distribución del dispositivo
+static SimTime sampleService(IoDevice *d, SimTime demand) {
+  double scaled = demand * d->speed / 100.0;
+  double u = rngUniform(&d->rng);
+  double value = scaled;
+
+  if (d->distribution == IO_SERVICE_UNIFORM)
+    value = scaled * (0.5 + u);
+  else if (d->distribution == IO_SERVICE_EXPONENTIAL)
+    value = -scaled * log(1.0 - u);
+
+  SimTime service = d->latency + (SimTime)(value + 0.5);
+  return service > 0 ? service : 1;
+}
+
+// Filtro de dirección de las peticiones candidatas
+typedef enum { ANY_DIRECTION = -1, READS_ONLY = 0, WRITES_ONLY = 1 } Direction;
+
+static bool matches(const IoRequest *r, Direction direction) {
+  return direction == ANY_DIRECTION || r->write == (direction == WRITES_ONLY);
+}
+
+// Petición con el plazo más próximo ya vencido (NULL si ninguna vencida)
+static IoRequest *earliestExpired(IoDevice *d, Direction direction,
+                                  SimTime currentTime) {
+  IoRequest *best = NULL;
+  for (IoRequest *r = d->queue; r != NULL; r = r->next) {
+    if (matches(r, direction) && r->deadline <= currentTime &&
+        (best == NULL || r->deadline < best->deadline))
+      best = r;
+  }
+  return best;
+}
+
+// Elevador circular: primer sector a partir del cabezal, o el menor si no
+// queda ninguno por delante
+static IoRequest *nextInSectorOrder(IoDevice *d, Direction direction) {
+  IoRequest *ahead = NULL, *lowest = NULL;
+  for (IoRequest *r = d->queue; r != NULL; r = r->next) {
+    if (!matches(r, direction))
+      continue;
+    if (r->sector >= d->headSector &&
+        (ahead == NULL || r->sector < ahead->sector))
+      ahead = r;
+    if (lowest == NULL || r->sector < lowest->sector)
+      lowest = r;
+  }
+  return ahead != NULL ? ahead : lowest;
+}
+
+// Flujo de reparto justo de un proceso (o de la escritura diferida)
+static IoFlow *findFlow(IoDevice *d, int flowId) {
+  IoFlow *freeFlow = NULL;
+  for (int i = 0; i < IO_MAX_FLOWS; i++) {
+    if (d->flows[i].flowId == flowId)
+      return &d->flows[i];
+    if (freeFlow == NULL && d->flows[i].flowId == NO_FRAME)
+      freeFlow = &d->flows[i];
+  }
+  if (freeFlow == NULL)
+    return &d->flows[IO_MAX_FLOWS - 1];
+  freeFlow->flowId = flowId;
+  freeFlow->vtime = d->virtualTime;
+  return freeFlow;
+}
+
+static int requestFlow(const IoRequest *r) {
+  return r->process != NULL ? r->process->id : -1;
+}
+
+// Peso de un flujo: los procesos más prioritarios reciben más servicio
+static int requestWeight(const IoRequest *r) {
+  return r->process != NULL ? BACKGROUND_PRIORITY + 1 - r->process->priority
+                            : 1;
+}
+
+// BFQ: servir el flujo con menos servicio ponderado recibido; un flujo que
+// vuelve tras estar inactivo no acumula crédito
+static IoRequest *selectFairQueued(IoDevice *d) {
+  IoRequest *best = NULL;
+  long bestStart = 0;
+  for (IoRequest *r = d->queue; r != NULL; r = r->next) {
+    IoFlow *flow = findFlow(d, requestFlow(r));
+    long start = flow->vtime > d->virtualTime ? flow->vtime : d->virtualTime;
+    if (best == NULL || start < bestStart) {
+      best = r;
+      bestStart = start;
+    }
+  }
+  IoFlow *flow = findFlow(d, requestFlow(best));
+  d->virtualTime = bestStart;
+  flow->vtime = bestStart + (long)best->demand * IO_WEIGHT_SCALE /
+                                requestWeight(best);
+  return best;
+}
+
+// mq-deadline: lotes en orden de sector que prefieren las lecturas; las
+// escrituras se sirven tras IO_WRITES_STARVED lotes de lectura y cualquier
+// petición vencida abre el lote
+static IoRequest *selectMqDeadline(IoDevice *d, SimTime currentTime) {
+  bool hasReads = false, hasWrites = false;
+  for (IoRequest *r = d->queue; r != NULL; r = r->next) {
+    if (r->write)
+      hasWrites = true;
+    else
+      hasReads = true;
+  }
+
+  Direction current = d->servingWrites ? WRITES_ONLY : READS_ONLY;
+  if (d->batchRemaining > 0 && (d->servingWrites ? hasWrites : hasReads)) {
+    d->batchRemaining--;
+    return nextInSectorOrder(d, current);
+  }
+
+  // Elegir la dirección del nuevo lote
+  if (hasReads && (!hasWrites || d->writesStarved < IO_WRITES_STARVED)) {
+    d->servingWrites = false;
+    if (hasWrites)
+      d->writesStarved++;
+  } else {
+    d->servingWrites = true;
+    d->writesStarved = 0;
+  }
+  current = d->servingWrites ? WRITES_ONLY : READS_ONLY;
+  d->batchRemaining = IO_FIFO_BATCH - 1;
+
+  IoRequest *expired = earliestExpired(d, current, currentTime);
+  return expired != NULL ? expired : nextInSectorOrder(d, current);
+}
+
+// Elegir la siguiente petición según el planificador del dispositivo
+static IoRequest *selectRequest(IoDevice *d, SimTime currentTime) {
+  switch (d->scheduler) {
+  case IO_SCHED_DEADLINE: {
+    IoRequest *expired = earliestExpired(d, ANY_DIRECTION, currentTime);
+    return expired != NULL ? expired : nextInSectorOrder(d, ANY_DIRECTION);
+  }
+  case IO_SCHED_BFQ:
+    return selectFairQueued(d);
+  case IO_SCHED_MQ_DEADLINE:
+    return selectMqDeadline(d, currentTime);
+  default:
+    return d->queue; // La cola se mantiene en orden de llegada
+  }
+}
+
+// Despachar peticiones pendientes mientras haya posiciones libres
+static void dispatchPending(IoDevice *d, SimTime currentTime) {
+  while (d->busySlots < d->queueDepth && d->queue != NULL) {
+    IoRequest *r = selectRequest(d, currentTime);
+    IoRequest **link = &d->queue;
+    while (*link != r)
+      link = &(*link)->next;
+    *link = r->next;
+    d->queued--;
+
+    SimTime service = sampleService(d, r->demand);
+    SimTime wait = currentTime - r->submitTime;
+    r->dispatchTime = currentTime;
+    r->completeTime = currentTime + service;
+    if (r->process != NULL)
+      r->process->blockedUntil = r->completeTime;
+    r->next = d->inFlight;
+    d->inFlight = r;
+    d->busySlots++;
+    d->headSector = r->sector;
+
+    accumulateTime(&d->stats.wait, wait);
+    if (wait > d->stats.maxWait)
+      d->stats.maxWait = wait;
+    accumulateTime(&d->stats.service, service);
+    if (currentTime > r->deadline)
+      d->stats.expired++;
+    if (r->write)
+      d->stats.writes++;
+    else
+      d->stats.reads++;
+  }
+}
+
+bool submitIoRequest(int device, Process *process, long sector, SimTime demand,
+                     bool write, SimTime currentTime) {
+  if (deviceCount == 0)
+    addIoDevice("disco0", IO_DEFAULT_SCHEDULER, IO_DEFAULT_QUEUE_DEPTH,
+                IO_DEFAULT_LATENCY, IO_DEFAULT_SPEED, IO_SERVICE_FIXED, 1);
+  if (device < 0 || device >= deviceCount)
+    return false;
+
+  IoRequest *request = malloc(sizeof(IoRequest));
+  if (request == NULL)
+    return false;
+
+  IoDevice *d = &devices[device];
+  ioAdvance(currentTime);
+  request->process = process;
+  request->sector = sector;
+  request->demand = demand > 0 ? demand : 1;
+  request->write = write;
+  request->submitTime = currentTime;
+  request->deadline =
+      currentTime + (write ? IO_WRITE_EXPIRE : IO_READ_EXPIRE);
+  request->dispatchTime = request->completeTime = -1;
+  request->next = NULL;
+  if (process != NULL)
+    process->blockedUntil = IO_PENDING;
+
+  // Añadir al final para conservar el orden de llegada
+  IoRequest **link = &d->queue;
+  while (*link != NULL)
+    link = &(*link)->next;
+  *link = request;
+  d->queued++;
+  d->stats.submitted++;
+  if (d->queued > d->stats.maxQueued)
+    d->stats.maxQueued = d->queued;
+
+  dispatchPending(d, currentTime);
+  return true;
+}
+
+void ioForgetProcess(const Process *process) {
+  for (int i = 0; i < deviceCount; i++) {
+    for (IoRequest *r = devices[i].queue; r != NULL; r = r->next) {
+      if (r->process == process)
+        r->process = NULL;
+    }
+    for (IoRequest *r = devices[i].inFlight; r != NULL; r = r->next) {
+      if (r->process == process)
+        r->process = NULL;
+    }
+  }
+}
+
+void ioAdvance(SimTime currentTime) {
+  char buffer[256];
+
+  for (int i = 0; i < deviceCount; i++) {
+    IoDevice *d = &devices[i];
+    for (;;) {
+      // Siguiente petición en servicio que termina antes del tiempo actual
+      IoRequest **first = NULL;
+      for (IoRequest **link = &d->inFlight; *link != NULL;
+           link = &(*link)->next) {
+        if ((*link)->completeTime <= currentTime &&
+            (first == NULL || (*link)->completeTime < (*first)->completeTime))
+          first = link;
+      }
+      if (first == NULL)
+        break;
+
+      IoRequest *done = *first;
+      *first = done->next;
+      d->busySlots--;
+      d->stats.completed++;
+      if (done->completeTime > d->stats.lastComplete)
+        d->stats.lastComplete = done->completeTime;
+      if (done->process != NULL) {
+        snprintf(buffer, sizeof(buffer),
+                 "E/S: Proceso %d terminó en %.*s (espera %lld, servicio "
+                 "%lld, Tiempo: %lld)",
+                 done->process->id, (int)sizeof(d->name), d->name,
+                 done->dispatchTime - done->submitTime,
+                 done->completeTime - done->dispatchTime, done->completeTime);
+        logMessage(buffer);
+      }
+
+      // La posición liberada se ocupa en el mismo instante
+      dispatchPending(d, done->completeTime);
+      free(done);
+    }
+  }
+}
+
+SimTime ioNextCompletion() {
+  SimTime next = -1;
+  for (int i = 0; i < deviceCount; i++) {
+    for (IoRequest *r = devices[i].inFlight; r != NULL; r = r->next) {
+      if (next < 0 || r->completeTime < next)
+        next = r->completeTime;
+    }
+  }
+  return next;
+}
+
+IoDeviceStatistics getIoDeviceStatistics(int device) {
+  IoDeviceStatistics empty = {0};
+  return device >= 0 && device < deviceCount ? devices[device].stats : empty;
+}
+
+void displayIoStatistics() {
+  char buffer[256];
+
+  for (int i = 0; i < deviceCount; i++) {
+    IoDevice *d = &devices[i];
+    IoDeviceStatistics *s = &d->stats;
+    SimTime capacity = s->lastComplete * d->queueDepth;
+
+    snprintf(buffer, sizeof(buffer),
+             "Dispositivo %.*s (%s, profundidad %d): %ld peticiones "
+             "(%ld lecturas, %ld escrituras), espera media %.1f, máxima "
+             "%lld",
+             (int)sizeof(d->name), d->name, schedulerNames[d->scheduler],
+             d->queueDepth, s->submitted, s->reads, s->writes,
+             accumulatorMean(&s->wait), s->maxWait);
+    logMessage(buffer);
+    snprintf(buffer, sizeof(buffer),
+             "Dispositivo %.*s: servicio medio %.1f, utilización %.2f, "
+             "%ld despachadas tras vencer, cola máxima %d",
+             (int)sizeof(d->name), d->name,
+             accumulatorMean(&s->service),
+             capacity > 0 ? (double)s->service.sum / capacity : 0.0,
+             s->expired, s->maxQueued);
+    logMessage(buffer);
+  }
+}
@@ -1,38 +1,408 @@
 #include "memory.h"
+#include "buddy.h"
+#include "cgroup.h"
+#include "framelog.h"
+#include "history.h"
+#include "numa.h"
+#include "oom.h"
+#include "pagecache.h"
+#include "pagetable.h"
+#include "reclaim.h"
+#include "rng.h"
+#include "swap.h"
+#include "tiering.h"
+#include "tlb.h"
+#include "zswap.h"
 #include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Variables globales para gestión de memoria
 static MemoryFrame physicalMemory[NUM_FRAMES];
+static ProcessFrameSet frameSets[MAX_PROCESSES];
+static FrameAllocationMode allocationMode = DEFAULT_FRAME_ALLOCATION_MODE;
+static BuddyAllocator nodePools[MAX_NUMA_NODES]; // Marcos libres por nodo
+static int globalLruHead = NO_FRAME;  // Marco menos recientemente usado
+static int globalLruTail = NO_FRAME;  // Marco más recientemente usado
+static long lruSequence = 0;          // Último orden de enlace asignado
+static long pageFaults[NUM_PAGE_SIZES];         // Fallos por tamaño
+static long allocationFailures[NUM_PAGE_SIZES]; // Cargas imposibles
+static long compactions = 0;                    // Pasadas de compactación
+static long migratedPages = 0;                  // Páginas movidas al compactar
+static long copyOnWriteFaults = 0; // Copias por escritura en página compartida
+static long sharedFaults = 0;      // Fallos resueltos con un marco compartido
+static int pinnedFrame = NO_FRAME; // Origen de una copia en curso
+static FragmentationSample fragmentationHistory[FRAGMENTATION_HISTORY];
+static int fragmentationSamples = 0; // Muestras registradas en total
 static pthread_mutex_t memoryMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t logMutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long long logDigest = EVENT_LOG_FNV_OFFSET;
+static long logEvents = 0;
 
-// Registrar mensajes con sincronización
+// Registrar mensajes con sincronización y acumularlos en el digest
 void logMessage(const char *message) {
   pthread_mutex_lock(&logMutex);
   printf("%s\n", message);
+  // FNV-1a sobre el mensaje y su salto de línea: el digest resume la salida
+  for (const unsigned char *c = (const unsigned char *)message; *c; c++)
+    logDigest = (logDigest ^ *c) * EVENT_LOG_FNV_PRIME;
+  logDigest = (logDigest ^ '\n') * EVENT_LOG_FNV_PRIME;
+  logEvents++;
   pthread_mutex_unlock(&logMutex);
 }
 
+unsigned long long eventLogDigest() {
+  pthread_mutex_lock(&logMutex);
+  unsigned long long digest = logDigest;
+  pthread_mutex_unlock(&logMutex);
+  return digest;
+}
+
+long eventLogLength() {
+  pthread_mutex_lock(&logMutex);
+  long events = logEvents;
+  pthread_mutex_unlock(&logMutex);
+  return events;
+}
+
+void displayEventLogDigest() {
+  // Se imprime fuera del registro para no alterar el propio digest
+  printf("Digest del registro: %016llx (%ld eventos, semilla %llu)\n",
+         eventLogDigest(), eventLogLength(), getSimulationSeed());
+}
+
+// Página que conserva el contenido: el ancla de un segmento compartido o
+// la propia página
+static Page *backingPage(Page *page) {
+  return page->sharedAnchor != NULL ? page->sharedAnchor : page;
+}
+
+// Registrar en el historial la página que ocupa cada marco de un bloque
+// (las colas de un bloque grande cuentan con la página de su cabeza)
+static void recordFrameHistory(int frame, int order, const Page *page,
+                               SimTime currentTime) {
+  if (!historyEnabled())
+    return;
+  for (int i = frame; i < frame + (1 << order); i++)
+    historyRecord(HISTORY_FRAME, currentTime, i,
+                  page != NULL ? page->id : HISTORY_NONE,
+                  page != NULL ? page->processId : HISTORY_NONE);
+}
+
+// Ocupar un bloque de marcos con una página (marco inicial y cola)
+static void occupyBlock(int frame, Page *page, SimTime currentTime) {
+  int order = PAGE_SIZE_ORDER(page->sizeClass);
+  for (int i = frame; i < frame + (1 << order); i++) {
+    physicalMemory[i].occupyingPage = i == frame ? page : NULL;
+    physicalMemory[i].headFrame = frame;
+    physicalMemory[i].lastUsedTime = currentTime;
+  }
+  recordFrameHistory(frame, order, page, currentTime);
+  physicalMemory[frame].order = order;
+  physicalMemory[frame].use = FRAME_USER;
+  physicalMemory[frame].mapCount = 1;
+  physicalMemory[frame].prefetchSource = NO_PREFETCH;
+  page->inMemory = true;
+  page->frameIndex = frame;
+  page->nextSharer = NULL;
+  if (page->sharedAnchor != NULL) {
+    page->sharedAnchor->inMemory = true;
+    page->sharedAnchor->frameIndex = frame;
+  }
+}
+
+// Vaciar un bloque de marcos, desmapeándolo de todas sus páginas, y
+// devolverlo al asignador buddy
+static void releaseBlock(int frame, SimTime currentTime) {
+  int order = physicalMemory[frame].order;
+  Page *page = physicalMemory[frame].occupyingPage;
+  if (page != NULL)
+    recordFrameHistory(frame, order, NULL, currentTime);
+
+  while (page != NULL) {
+    Page *next = page->nextSharer;
+    page->inMemory = false;
+    page->frameIndex = NO_FRAME;
+    page->nextSharer = NULL;
+    if (page->sharedAnchor != NULL) {
+      page->sharedAnchor->inMemory = false;
+      page->sharedAnchor->frameIndex = NO_FRAME;
+    }
+    page = next;
+  }
+  for (int i = frame; i < frame + (1 << order); i++) {
+    physicalMemory[i].occupyingPage = NULL;
+    physicalMemory[i].headFrame = NO_FRAME;
+    physicalMemory[i].lastUsedTime = -1;
+  }
+  physicalMemory[frame].mapCount = 0;
+  physicalMemory[frame].prefetchSource = NO_PREFETCH;
+  physicalMemory[frame].order = 0;
+  physicalMemory[frame].use = FRAME_USER;
+  buddyFree(&nodePools[numaNodeOfFrame(frame)], frame, order);
+}
+
+// Enlazar un marco ocupado al final de las listas LRU (global y del proceso)
+static void linkOccupiedFrame(int frame, int set) {
+  MemoryFrame *f = &physicalMemory[frame];
+
+  f->ownerSet = set;
+  f->lruSequence = ++lruSequence;
+  f->prevGlobal = globalLruTail;
+  f->nextGlobal = NO_FRAME;
+  if (globalLruTail != NO_FRAME)
+    physicalMemory[globalLruTail].nextGlobal = frame;
+  else
+    globalLruHead = frame;
+  globalLruTail = frame;
+
+  f->prevFrame = NO_FRAME;
+  f->nextFrame = NO_FRAME;
+  if (set == NO_FRAME)
+    return;
+  ProcessFrameSet *s = &frameSets[set];
+  f->prevFrame = s->lruTail;
+  if (s->lruTail != NO_FRAME)
+    physicalMemory[s->lruTail].nextFrame = frame;
+  else
+    s->lruHead = frame;
+  s->lruTail = frame;
+  s->residentFrames += 1 << f->order;
+  groupChargeFrames(s->process->group, 1 << f->order);
+  oomUpdateResident(set, s->residentFrames);
+}
+
+// Desenlazar un marco ocupado de las listas LRU (global y del proceso)
+static void unlinkOccupiedFrame(int frame) {
+  MemoryFrame *f = &physicalMemory[frame];
+
+  if (f->prevGlobal != NO_FRAME)
+    physicalMemory[f->prevGlobal].nextGlobal = f->nextGlobal;
+  else
+    globalLruHead = f->nextGlobal;
+  if (f->nextGlobal != NO_FRAME)
+    physicalMemory[f->nextGlobal].prevGlobal = f->prevGlobal;
+  else
+    globalLruTail = f->prevGlobal;
+
+  if (f->ownerSet != NO_FRAME) {
+    ProcessFrameSet *s = &frameSets[f->ownerSet];
+    if (f->prevFrame != NO_FRAME)
+      physicalMemory[f->prevFrame].nextFrame = f->nextFrame;
+    else
+      s->lruHead = f->nextFrame;
+    if (f->nextFrame != NO_FRAME)
+      physicalMemory[f->nextFrame].prevFrame = f->prevFrame;
+    else
+      s->lruTail = f->prevFrame;
+    s->residentFrames -= 1 << f->order;
+    groupChargeFrames(s->process->group, -(1 << f->order));
+    oomUpdateResident(f->ownerSet, s->residentFrames);
+  }
+  f->ownerSet = NO_FRAME;
+  f->prevGlobal = f->nextGlobal = NO_FRAME;
+  f->prevFrame = f->nextFrame = NO_FRAME;
+}
+
+// Buscar el conjunto de marcos de un proceso (NO_FRAME si no está registrado)
+static int findFrameSet(int processId) {
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (frameSets[i].process != NULL && frameSets[i].process->id == processId)
+      return i;
+  }
+  return NO_FRAME;
+}
+
+// Añadir una página al mapa inverso de un bloque ya ocupado (detrás de la
+// cabeza, que sigue determinando el conjunto propietario)
+static void addSharer(int frame, Page *page) {
+  Page *head = physicalMemory[frame].occupyingPage;
+  page->nextSharer = head->nextSharer;
+  head->nextSharer = page;
+  physicalMemory[frame].mapCount++;
+  page->inMemory = true;
+  page->frameIndex = frame;
+}
+
+// Quitar una página del mapa inverso de un bloque que otras siguen
+// mapeando; si era la cabeza, el bloque pasa al conjunto de la nueva
+// cabeza (al final de su lista LRU)
+static void removeSharer(int frame, Page *page) {
+  MemoryFrame *f = &physicalMemory[frame];
+  Page **link = &f->occupyingPage;
+
+  while (*link != page)
+    link = &(*link)->nextSharer;
+  *link = page->nextSharer;
+  f->mapCount--;
+  page->inMemory = false;
+  page->frameIndex = NO_FRAME;
+  page->nextSharer = NULL;
+  tlbInvalidate(page->processId, page);
+
+  int set = findFrameSet(f->occupyingPage->processId);
+  if (set != f->ownerSet) {
+    unlinkOccupiedFrame(frame);
+    linkOccupiedFrame(frame, set);
+  }
+}
+
+// Peso de un proceso según el modo de asignación
+static long frameSetWeight(const Process *process) {
+  long size = process->memorySize > 0 ? process->memorySize
+                                      : (long)process->totalPages * PAGE_SIZE;
+  switch (allocationMode) {
+  case FRAME_ALLOCATION_PROPORTIONAL:
+    return size;
+  case FRAME_ALLOCATION_PRIORITY:
+    return size * (BACKGROUND_PRIORITY + 1 - process->priority);
+  default:
+    return 1;
+  }
+}
+
+// Recalcular las cuotas de marcos de todos los procesos registrados
+static void computeFrameQuotas() {
+  long totalWeight = 0;
+  int assigned = 0;
+
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (frameSets[i].process != NULL)
+      totalWeight += frameSetWeight(frameSets[i].process);
+  }
+
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    ProcessFrameSet *s = &frameSets[i];
+    if (s->process == NULL)
+      continue;
+    if (allocationMode == FRAME_ALLOCATION_GLOBAL) {
+      s->quota = NUM_FRAMES;
+      continue;
+    }
+    s->quota = (int)(NUM_FRAMES * frameSetWeight(s->process) / totalWeight);
+    if (s->quota < 1)
+      s->quota = 1;
+    assigned += s->quota;
+  }
+
+  // Repartir los marcos sobrantes por orden de registro
+  for (int i = 0; i < MAX_PROCESSES && assigned < NUM_FRAMES &&
+                  allocationMode != FRAME_ALLOCATION_GLOBAL;
+       i++) {
+    if (frameSets[i].process != NULL) {
+      frameSets[i].quota++;
+      assigned++;
+    }
+  }
+}
+
+// Conjunto con más marcos por encima de su cuota (NO_FRAME si ninguno)
+static int findOverQuotaSet() {
+  int victimSet = NO_FRAME;
+  int maxExcess = 0;
+
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    ProcessFrameSet *s = &frameSets[i];
+    if (s->process != NULL && s->residentFrames - s->quota > maxExcess) {
+      maxExcess = s->residentFrames - s->quota;
+      victimSet = i;
+    }
+  }
+  return victimSet;
+}
+
 void initializeMemorySystem() {
   char buffer[256];
 
   // Limpiar todos los marcos de memoria
+  globalLruHead = globalLruTail = NO_FRAME;
+  lruSequence = 0;
   for (int i = 0; i < NUM_FRAMES; i++) {
     physicalMemory[i].occupyingPage = NULL;
     physicalMemory[i].lastUsedTime = -1;
+    physicalMemory[i].headFrame = NO_FRAME;
+    physicalMemory[i].order = 0;
+    physicalMemory[i].use = FRAME_USER;
+    physicalMemory[i].mapCount = 0;
+    physicalMemory[i].prefetchSource = NO_PREFETCH;
+    physicalMemory[i].ownerSet = NO_FRAME;
+    physicalMemory[i].prevFrame = physicalMemory[i].nextFrame = NO_FRAME;
+    physicalMemory[i].prevGlobal = physicalMemory[i].nextGlobal = NO_FRAME;
+    physicalMemory[i].lruSequence = 0;
+  }
+  memset(frameSets, 0, sizeof(frameSets));
+  memset(pageFaults, 0, sizeof(pageFaults));
+  memset(allocationFailures, 0, sizeof(allocationFailures));
+  compactions = migratedPages = 0;
+  copyOnWriteFaults = sharedFaults = 0;
+  pinnedFrame = NO_FRAME;
+  fragmentationSamples = 0;
+  resetFrameLog();
+
+  // Todos los marcos empiezan libres en el asignador buddy de su nodo
+  for (int n = 0; n < MAX_NUMA_NODES; n++)
+    buddyDestroy(&nodePools[n]);
+  for (int n = 0; n < numaNodeCount(); n++) {
+    int firstFrame, numFrames;
+    numaNodeFrames(n, &firstFrame, &numFrames);
+    buddyInit(&nodePools[n], firstFrame, numFrames);
   }
 
   // Registrar inicialización
   snprintf(buffer, sizeof(buffer), "Memoria inicializada con %d marcos",
            NUM_FRAMES);
   logMessage(buffer);
+  if (numaNodeCount() > 1) {
+    snprintf(buffer, sizeof(buffer), "Marcos repartidos entre %d nodos NUMA",
+             numaNodeCount());
+    logMessage(buffer);
+  }
+}
+
+// Marcos libres entre todos los nodos
+static int totalFreeFrames() {
+  int freeFrames = 0;
+  for (int n = 0; n < numaNodeCount(); n++)
+    freeFrames += nodePools[n].freeFrames;
+  return freeFrames;
+}
+
+// Mayor orden utilizable en algún nodo
+static int maxPoolOrder() {
+  int maxOrder = 0;
+  for (int n = 0; n < numaNodeCount(); n++) {
+    if (nodePools[n].maxOrder > maxOrder)
+      maxOrder = nodePools[n].maxOrder;
+  }
+  return maxOrder;
+}
+
+// Orden del mayor bloque libre entre todos los nodos (-1 si no hay)
+static int largestFreeOrder() {
+  int largest = NO_FRAME;
+  for (int n = 0; n < numaNodeCount(); n++) {
+    int order = buddyLargestFreeOrder(&nodePools[n]);
+    if (order > largest)
+      largest = order;
+  }
+  return largest;
+}
+
+// Índice de espacio inutilizable del conjunto de nodos: media de los
+// índices de cada nodo ponderada por sus marcos libres
+static double unusableIndex(int order) {
+  double unusable = 0.0;
+  int freeFrames = totalFreeFrames();
+  for (int n = 0; n < numaNodeCount() && freeFrames > 0; n++)
+    unusable += buddyUnusableIndex(&nodePools[n], order) *
+                nodePools[n].freeFrames / freeFrames;
+  return unusable;
 }
 
 int selectPageForReplacement() {
   int lruFrame = 0;
-  int oldestTime = physicalMemory[0].lastUsedTime;
+  SimTime oldestTime = physicalMemory[0].lastUsedTime;
 
   // Encontrar el marco menos recientemente usado
   for (int i = 1; i < NUM_FRAMES; i++) {
@@ -44,70 +414,1598 @@ int selectPageForReplacement() {
   return lruFrame;
 }
 
-void displayMemoryFrames(int currentTime) {
+// Primer marco desde la cabeza LRU cuya página no tenga E/S de swap en
+// curso ni sea el origen de una copia (las páginas bloqueadas no se
+// desalojan), limitado a un nodo salvo con NUMA_ANY_NODE; O(1) salvo por
+// las páginas bloqueadas, que son pocas, y los marcos de otros nodos
+static int firstUnlockedFrame(int frame, bool global, int node,
+                              SimTime currentTime) {
+  while (frame != NO_FRAME &&
+         (physicalMemory[frame].occupyingPage->readyTime > currentTime ||
+          frame == pinnedFrame ||
+          (node != NUMA_ANY_NODE && numaNodeOfFrame(frame) != node)))
+    frame = global ? physicalMemory[frame].nextGlobal
+                   : physicalMemory[frame].nextFrame;
+  return frame;
+}
+
+// Primer marco desalojable de la lista LRU global cuyo propietario
+// pertenece al subárbol de un grupo de recursos: el de menor orden de
+// enlace entre los primeros desbloqueados de las listas de sus procesos,
+// que siguen el orden global; O(MAX_PROCESSES) salvo por las páginas
+// bloqueadas
+static int firstGroupFrame(const ResourceGroup *group, SimTime currentTime) {
+  int victim = NO_FRAME;
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (frameSets[i].process == NULL ||
+        !groupContains(group, frameSets[i].process->group))
+      continue;
+    int frame = firstUnlockedFrame(frameSets[i].lruHead, false,
+                                   NUMA_ANY_NODE, currentTime);
+    if (frame != NO_FRAME &&
+        (victim == NO_FRAME || physicalMemory[frame].lruSequence <
+                                   physicalMemory[victim].lruSequence))
+      victim = frame;
+  }
+  return victim;
+}
+
+// Elegir el marco víctima según el modo de asignación (en el nodo pedido
+// salvo con NUMA_ANY_NODE)
+static int selectVictimFrame(int set, int node, SimTime currentTime) {
+  if (allocationMode == FRAME_ALLOCATION_GLOBAL || set == NO_FRAME)
+    return firstUnlockedFrame(globalLruHead, true, node, currentTime);
+
+  ProcessFrameSet *s = &frameSets[set];
+  int victim = NO_FRAME;
+
+  // Reemplazo local: el proceso ya agotó su cuota
+  if (s->residentFrames >= s->quota)
+    victim = firstUnlockedFrame(s->lruHead, false, node, currentTime);
+
+  // Rebalanceo: recuperar un marco de un proceso que excede su cuota
+  int overQuota = findOverQuotaSet();
+  if (victim == NO_FRAME && overQuota != NO_FRAME)
+    victim = firstUnlockedFrame(frameSets[overQuota].lruHead, false, node,
+                                currentTime);
+
+  if (victim == NO_FRAME)
+    victim = firstUnlockedFrame(s->lruHead, false, node, currentTime);
+  return victim != NO_FRAME
+             ? victim
+             : firstUnlockedFrame(globalLruHead, true, node, currentTime);
+}
+
+void captureFrameStates(FrameState *states) {
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    int head = physicalMemory[i].headFrame;
+    const Page *page =
+        head != NO_FRAME ? physicalMemory[head].occupyingPage : NULL;
+    states[i].lastUsedTime = physicalMemory[i].lastUsedTime;
+    states[i].headFrame = head;
+    states[i].use = head != NO_FRAME ? physicalMemory[head].use : FRAME_USER;
+    states[i].pageId = page != NULL ? page->id : -1;
+    states[i].processId = page != NULL ? page->processId : 0;
+    states[i].mapCount = physicalMemory[i].mapCount;
+  }
+}
+
+void formatFrameState(int frame, const FrameState *state, char *text,
+                      size_t size) {
+  int head = state->headFrame;
+  if (head != NO_FRAME && state->use == FRAME_CACHE) {
+    snprintf(text, size, "Marco %d: [CACHÉ] Página %d (Último uso: %lld)",
+             frame, state->pageId, state->lastUsedTime);
+  } else if (head != NO_FRAME && state->use != FRAME_USER) {
+    snprintf(text, size, "Marco %d: [%s] (marco inicial %d)", frame,
+             state->use == FRAME_DMA     ? "DMA"
+             : state->use == FRAME_ZSWAP ? "ZSWAP"
+                                         : "NÚCLEO",
+             head);
+  } else if (head != NO_FRAME && head != frame) {
+    snprintf(text, size, "Marco %d: Parte de la página %d (marco inicial %d)",
+             frame, state->pageId, head);
+  } else if (state->mapCount > 1) {
+    snprintf(text, size,
+             "Marco %d: Página %d del Proceso %d (Último uso: %lld) "
+             "[compartido por %d páginas]",
+             frame, state->pageId, state->processId, state->lastUsedTime,
+             state->mapCount);
+  } else if (state->pageId >= 0) {
+    snprintf(text, size,
+             "Marco %d: Página %d del Proceso %d (Último uso: %lld)", frame,
+             state->pageId, state->processId, state->lastUsedTime);
+  } else {
+    snprintf(text, size, "Marco %d: [VACÍO]", frame);
+  }
+}
+
+void displayMemoryFrames(SimTime currentTime) {
   char buffer[256];
+  FrameState states[NUM_FRAMES];
+  captureFrameStates(states);
   logMessage("\nEstado de los marcos de memoria:");
   for (int i = 0; i < NUM_FRAMES; i++) {
-    if (physicalMemory[i].occupyingPage != NULL) {
-      snprintf(buffer, sizeof(buffer),
-               "Marco %d: Página %d del Proceso %d (Último uso: %d)", i,
-               physicalMemory[i].occupyingPage->id,
-               physicalMemory[i].occupyingPage->processId,
-               physicalMemory[i].lastUsedTime);
-    } else {
-      snprintf(buffer, sizeof(buffer), "Marco %d: [VACÍO]", i);
-    }
+    formatFrameState(i, &states[i], buffer, sizeof(buffer));
     logMessage(buffer);
   }
-  snprintf(buffer, sizeof(buffer), "Tiempo actual: %d\n", currentTime);
+  snprintf(buffer, sizeof(buffer), "Tiempo actual: %lld\n", currentTime);
+  logMessage(buffer);
+}
+
+// Contabilizar como desperdicio un bloque precargado que se libera sin
+// haberse usado (ocupó sus marcos desde la carga)
+static void retirePrefetchedFrame(int frame, SimTime currentTime) {
+  MemoryFrame *f = &physicalMemory[frame];
+  if (f->prefetchSource == NO_PREFETCH)
+    return;
+  prefetchRecordWaste(f->occupyingPage->processId, f->prefetchSource,
+                      (long)(currentTime - f->lastUsedTime) << f->order);
+  f->prefetchSource = NO_PREFETCH;
+}
+
+// Escribir en swap el contenido de un bloque modificado; las páginas
+// privadas que lo comparten tras un fork quedan apuntando al mismo slot
+static void writeBackFrame(int frame, SimTime currentTime) {
+  char buffer[256];
+  Page *head = physicalMemory[frame].occupyingPage;
+  Page *backing = backingPage(head);
+  bool dirty = false;
+
+  for (Page *page = head; page != NULL; page = page->nextSharer)
+    dirty = dirty || backingPage(page)->dirty;
+  if (!dirty)
+    return;
+
+  SimTime doneTime = swapWriteBack(backing, currentTime);
+  if (doneTime < 0)
+    return;
+  snprintf(buffer, sizeof(buffer),
+           "Swap: página %d escrita en el slot %d (termina en %lld)",
+           backing->id, backing->swapSlot, doneTime);
   logMessage(buffer);
+
+  if (backing != head)
+    return;
+  for (Page *page = head->nextSharer; page != NULL; page = page->nextSharer) {
+    swapFreeSlot(page);
+    swapShareSlot(page, head->swapSlot);
+    page->dirty = false;
+  }
+}
+
+// Guardar en el almacén comprimido una página privada de 4 KiB que se
+// desaloja y tendría que leerse de swap; devuelve false si sigue el camino
+// normal hacia swap
+static bool compressEvictedFrame(int frame, SimTime currentTime) {
+  Page *head = physicalMemory[frame].occupyingPage;
+  if (physicalMemory[frame].mapCount != 1 || backingPage(head) != head ||
+      head->sizeClass != PAGE_SIZE_4K ||
+      head->processId == SHARED_REGION_OWNER ||
+      (!head->dirty && head->swapSlot == NO_SWAP_SLOT))
+    return false;
+  return zswapStore(head, currentTime);
 }
 
-bool handlePageFault(Page *page, int currentTime) {
+// Desalojar la página de un marco para atender el fallo de otra página
+// (o una reserva del núcleo si faulting es NULL); el mapa inverso permite
+// desmapearlo de todas las páginas que lo comparten
+static void evictFrame(int frame, const Page *faulting, SimTime currentTime) {
   char buffer[256];
+  Page *evicted = physicalMemory[frame].occupyingPage;
+  int sharers = physicalMemory[frame].mapCount;
+
+  // Registrar reemplazo de página
+  if (faulting != NULL) {
+    snprintf(buffer, sizeof(buffer),
+             "Page Fault: Proceso %d, Página %d - Reemplazando página %d en "
+             "marco %d (Tiempo: %lld)",
+             faulting->processId, faulting->id, evicted->id, frame,
+             currentTime);
+  } else {
+    snprintf(buffer, sizeof(buffer),
+             "Reclamación: página %d desalojada del marco %d (Tiempo: %lld)",
+             evicted->id, frame, currentTime);
+  }
+  logMessage(buffer);
+
+  // Una página anticipada que sale sin haberse usado fue trabajo perdido
+  if (evicted->readAhead) {
+    swapRecordReadAhead(false);
+    evicted->readAhead = false;
+  }
+
+  retirePrefetchedFrame(frame, currentTime);
+
+  // Las páginas sucias se escriben en swap (o se comprimen en el almacén);
+  // las limpias se descartan
+  if (!compressEvictedFrame(frame, currentTime))
+    writeBackFrame(frame, currentTime);
+
+  for (Page *page = evicted; page != NULL; page = page->nextSharer)
+    tlbInvalidate(page->processId, page);
+  if (sharers > 1) {
+    snprintf(buffer, sizeof(buffer),
+             "Mapa inverso: marco %d desmapeado de %d páginas", frame,
+             sharers);
+    logMessage(buffer);
+  }
+  unlinkOccupiedFrame(frame);
+  releaseBlock(frame, currentTime);
+}
+
+// Recuperar el marco de una página de la caché de archivos; la caché la
+// escribe en su archivo si está sucia
+static void evictCacheFrame(int frame, const Page *faulting,
+                            SimTime currentTime) {
+  char buffer[256];
+  Page *cached = physicalMemory[frame].occupyingPage;
+
+  if (faulting != NULL) {
+    snprintf(buffer, sizeof(buffer),
+             "Page Fault: Proceso %d, Página %d - Reemplazando página de "
+             "caché %d en marco %d (Tiempo: %lld)",
+             faulting->processId, faulting->id, cached->id, frame,
+             currentTime);
+  } else {
+    snprintf(buffer, sizeof(buffer),
+             "Reclamación: página de caché %d desalojada del marco %d "
+             "(Tiempo: %lld)",
+             cached->id, frame, currentTime);
+  }
+  logMessage(buffer);
+  releaseBlock(frame, currentTime);
+  pageCacheEvicted(cached, currentTime);
+}
+
+// Degradar un bloque a la memoria lenta en lugar de desalojarlo
+static bool demoteFrame(int frame, SimTime currentTime);
+
+// Recuperar un bloque (en un nodo o en cualquiera con NUMA_ANY_NODE): la
+// página más antigua de la caché de archivos compite por edad con la
+// víctima LRU de la memoria anónima; devuelve false si no queda nada
+// desalojable
+static bool reclaimFrame(int set, int node, const Page *faulting,
+                         SimTime currentTime) {
+  int victim = selectVictimFrame(set, node, currentTime);
+  Page *cached = pageCacheReclaimCandidate();
+
+  if (cached != NULL && node != NUMA_ANY_NODE &&
+      numaNodeOfFrame(cached->frameIndex) != node)
+    cached = NULL;
+  if (cached != NULL &&
+      (victim == NO_FRAME || physicalMemory[cached->frameIndex].lastUsedTime <=
+                                 physicalMemory[victim].lastUsedTime)) {
+    evictCacheFrame(cached->frameIndex, faulting, currentTime);
+    return true;
+  }
+  if (victim == NO_FRAME)
+    return false;
+  // Con memoria lenta, la víctima de la rápida baja de nivel en vez de ir
+  // a swap
+  if (!demoteFrame(victim, currentTime))
+    evictFrame(victim, faulting, currentTime);
+  return true;
+}
+
+bool reclaimLruBlock(SimTime currentTime) {
   pthread_mutex_lock(&memoryMutex);
+  bool reclaimed = reclaimFrame(NO_FRAME, NUMA_ANY_NODE, NULL, currentTime);
+  pthread_mutex_unlock(&memoryMutex);
+  return reclaimed;
+}
 
-  // Buscar un marco de memoria libre
-  for (int i = 0; i < NUM_FRAMES; i++) {
-    if (physicalMemory[i].occupyingPage == NULL) {
-      physicalMemory[i].occupyingPage = page;
-      physicalMemory[i].lastUsedTime = currentTime;
-      page->inMemory = true;
+// Asignador del nodo que la política NUMA del proceso del conjunto elige
+// para una página
+static BuddyAllocator *placementPool(const Page *page, int set) {
+  bool fallback;
+  return &nodePools[numaPlacementNode(
+      set != NO_FRAME ? frameSets[set].process : NULL,
+      page->virtualAddress / PAGE_SIZE_BYTES(page->sizeClass), &fallback)];
+}
+
+// Leer desde swap una página recién ubicada junto con las vecinas de su
+// ventana que quepan en marcos libres del nodo que les corresponde (y en
+// el límite de su grupo de recursos)
+static void swapInPage(Page *page, SimTime currentTime) {
+  char buffer[256];
+  Page *readAhead[SWAP_READAHEAD_CLUSTER];
+  int count = totalFreeFrames() < SWAP_READAHEAD_CLUSTER
+                  ? totalFreeFrames()
+                  : SWAP_READAHEAD_CLUSTER;
+
+  page->readyTime = swapReadPage(page, readAhead, &count, currentTime);
+  for (int i = 0; i < count; i++) {
+    int set = findFrameSet(readAhead[i]->processId);
+    // La lectura anticipada no excede el límite de marcos del grupo
+    bool limited = set != NO_FRAME &&
+                   groupOverMemoryLimit(frameSets[set].process->group, 1);
+    int frame = readAhead[i]->sizeClass == PAGE_SIZE_4K && !limited
+                    ? buddyAlloc(placementPool(readAhead[i], set), 0)
+                    : NO_FRAME;
+    if (frame == NO_FRAME)
+      continue;
+    occupyBlock(frame, readAhead[i], currentTime);
+    linkOccupiedFrame(frame, set);
+    readAhead[i]->readyTime = page->readyTime;
+    readAhead[i]->readAhead = true;
+  }
+
+  snprintf(buffer, sizeof(buffer),
+           "Swap: lectura de la página %d desde el slot %d (+%d anticipadas), "
+           "lista en %lld",
+           page->id, page->swapSlot, count, page->readyTime);
+  logMessage(buffer);
+}
+
+// Reservar un bloque del orden pedido en el nodo preferido o, si fallback
+// lo permite, en cualquier otro; compacta si hay marcos libres suficientes
+// pero fragmentados
+static int allocateBlock(int node, bool fallback, int order,
+                         SimTime currentTime);
+
+// Precargar las páginas que proponen los predictores tras un fallo, solo
+// en bloques libres del nodo que les corresponde y sin superar la cuota del
+// proceso; las que están en swap se leen de forma asíncrona
+static void prefetchAfterFault(const Page *page, int set, SimTime currentTime) {
+  char buffer[256];
+  PrefetchCandidate candidates[PREFETCH_MAX_CANDIDATES];
+  int loaded = 0;
 
-      // Registrar carga de página
-      snprintf(
-          buffer, sizeof(buffer),
-          "Page Fault: Proceso %d, Página %d cargada en marco %d (Tiempo: %d)",
-          page->processId, page->id, i, currentTime);
-      logMessage(buffer);
-      pthread_mutex_unlock(&memoryMutex);
-      return true;
+  if (set == NO_FRAME)
+    return;
+  Process *process = frameSets[set].process;
+  int count = prefetchPredict(process->id, page->virtualAddress,
+                              PAGE_SIZE_BYTES(page->sizeClass), candidates,
+                              PREFETCH_MAX_CANDIDATES);
+
+  for (int i = 0; i < count; i++) {
+    Page *target = walkPageTable(process->pageTable,
+                                 candidates[i].virtualAddress, NULL);
+    if (target == NULL || target->inMemory || target->sharedAnchor != NULL)
+      continue;
+    int order = PAGE_SIZE_ORDER(target->sizeClass);
+    if ((allocationMode != FRAME_ALLOCATION_GLOBAL &&
+         frameSets[set].residentFrames + (1 << order) > frameSets[set].quota) ||
+        groupOverMemoryLimit(process->group, 1 << order) != NULL)
+      break;
+    int frame = buddyAlloc(placementPool(target, set), order);
+    if (frame == NO_FRAME)
+      break;
+
+    occupyBlock(frame, target, currentTime);
+    linkOccupiedFrame(frame, set);
+    physicalMemory[frame].prefetchSource = candidates[i].source;
+    target->readyTime = currentTime;
+    if (!zswapLoad(target, currentTime) && target->swapSlot != NO_SWAP_SLOT)
+      target->readyTime = swapReadPage(target, NULL, NULL, currentTime);
+    prefetchRecordIssued(candidates[i].source);
+    loaded++;
+  }
+
+  if (loaded > 0) {
+    snprintf(buffer, sizeof(buffer),
+             "Precarga: Proceso %d, %d páginas tras el fallo de la página %d "
+             "(Tiempo: %lld)",
+             process->id, loaded, page->id, currentTime);
+    logMessage(buffer);
+  }
+}
+
+// Retrasar la página de un fallo que tuvo que desalojar: la reclamación
+// directa la paga el proceso que falla
+static void delayForDirectReclaim(Page *page, int evicted,
+                                  SimTime currentTime) {
+  SimTime readyTime = currentTime + directReclaimDelay(evicted);
+  if (readyTime > page->readyTime)
+    page->readyTime = readyTime;
+}
+
+// Formar un bloque libre para la página en el nodo que indica la política
+// NUMA del proceso, desalojando primero por cuota y después por LRU
+// (*evicted cuenta los bloques desalojados); devuelve NO_FRAME si no fue
+// posible
+static int placePage(Page *page, int set, SimTime currentTime, int *evicted) {
+  int order = PAGE_SIZE_ORDER(page->sizeClass);
+  // Las páginas de la caché no son de ningún proceso: se registra como
+  // reclamación
+  const Page *faulting = page->processId == PAGE_CACHE_OWNER ? NULL : page;
+  bool fallback;
+  int node = numaPlacementNode(
+      set != NO_FRAME ? frameSets[set].process : NULL,
+      page->virtualAddress / PAGE_SIZE_BYTES(page->sizeClass), &fallback);
+  // Sin alternativa de nodo solo sirve desalojar en el nodo ligado
+  int reclaimNode = fallback ? NUMA_ANY_NODE : node;
+
+  // Reemplazo local: liberar marcos propios hasta respetar la cuota
+  if (allocationMode != FRAME_ALLOCATION_GLOBAL && set != NO_FRAME) {
+    ProcessFrameSet *s = &frameSets[set];
+    int victim =
+        firstUnlockedFrame(s->lruHead, false, NUMA_ANY_NODE, currentTime);
+    while (s->residentFrames + (1 << order) > s->quota && victim != NO_FRAME) {
+      evictFrame(victim, page, currentTime);
+      (*evicted)++;
+      victim =
+          firstUnlockedFrame(s->lruHead, false, NUMA_ANY_NODE, currentTime);
     }
   }
 
-  // Si no hay marcos libres, usar reemplazo LRU
-  int replacementFrame = selectPageForReplacement();
+  // Límite de memoria del grupo: reclamar dentro de su propio subárbol (si
+  // todos sus marcos esperan E/S de swap, el grupo lo excede hasta que
+  // terminen)
+  ResourceGroup *limited;
+  while (set != NO_FRAME &&
+         (limited = groupOverMemoryLimit(frameSets[set].process->group,
+                                         1 << order)) != NULL) {
+    int victim = firstGroupFrame(limited, currentTime);
+    if (victim == NO_FRAME)
+      break;
+    evictFrame(victim, page, currentTime);
+    groupRecordReclaim(limited);
+    (*evicted)++;
+  }
+
+  // Si no hay bloque libre, usar reemplazo LRU hasta formar uno
+  int frame = allocateBlock(node, fallback, order, currentTime);
+  while (frame == NO_FRAME &&
+         reclaimFrame(set, reclaimNode, faulting, currentTime)) {
+    (*evicted)++;
+    frame = allocateBlock(node, fallback, order, currentTime);
+  }
+  return frame;
+}
 
-  // Desalojar página existente si es necesario
-  if (physicalMemory[replacementFrame].occupyingPage) {
-    physicalMemory[replacementFrame].occupyingPage->inMemory = false;
+// Eliminar el proceso con mayor puntuación OOM y liberar su memoria
+static bool oomKill(const Page *faulting, SimTime currentTime);
 
-    // Registrar reemplazo de página
+bool handlePageFault(Page *page, SimTime currentTime) {
+  char buffer[256];
+  pthread_mutex_lock(&memoryMutex);
+
+  int set = findFrameSet(page->processId);
+  int order = PAGE_SIZE_ORDER(page->sizeClass);
+  int evicted = 0;
+  Page *anchor = page->sharedAnchor;
+  pageFaults[page->sizeClass]++;
+
+  // La página no cabe en la memoria física
+  if (order > maxPoolOrder()) {
+    allocationFailures[page->sizeClass]++;
     snprintf(buffer, sizeof(buffer),
-             "Page Fault: Proceso %d, Página %d - Reemplazando página %d en "
-             "marco %d (Tiempo: %d)",
-             page->processId, page->id,
-             physicalMemory[replacementFrame].occupyingPage->id,
-             replacementFrame, currentTime);
+             "Page Fault: Proceso %d, Página %d de %lu KiB no cabe en memoria "
+             "(Tiempo: %lld)",
+             page->processId, page->id, PAGE_SIZE_BYTES(page->sizeClass) / 1024,
+             currentTime);
     logMessage(buffer);
+    pthread_mutex_unlock(&memoryMutex);
+    return false;
   }
 
-  // Cargar nueva página
-  physicalMemory[replacementFrame].occupyingPage = page;
-  physicalMemory[replacementFrame].lastUsedTime = currentTime;
-  page->inMemory = true;
+  // Segmento compartido ya residente: basta con enlazar la página al
+  // marco común (fallo menor)
+  if (anchor != NULL && anchor->inMemory) {
+    addSharer(anchor->frameIndex, page);
+    page->readyTime = anchor->readyTime;
+    sharedFaults++;
+    snprintf(buffer, sizeof(buffer),
+             "Page Fault: Proceso %d, Página %d enlazada al marco compartido "
+             "%d (Tiempo: %lld)",
+             page->processId, page->id, page->frameIndex, currentTime);
+    logMessage(buffer);
+    pthread_mutex_unlock(&memoryMutex);
+    return true;
+  }
+
+  // Si la reclamación no avanza, el OOM killer libera la memoria de un
+  // proceso; si la víctima es el propio proceso, el fallo queda sin servir
+  int frame = placePage(page, set, currentTime, &evicted);
+  while (frame == NO_FRAME && oomKillerEnabled() &&
+         oomKill(page, currentTime) &&
+         (set == NO_FRAME || frameSets[set].process != NULL))
+    frame = placePage(page, set, currentTime, &evicted);
+  if (frame == NO_FRAME) {
+    allocationFailures[page->sizeClass]++;
+    pthread_mutex_unlock(&memoryMutex);
+    return false;
+  }
+
+  // Cargar nueva página (desde swap si ella o su segmento tienen copia)
+  Page *backing = backingPage(page);
+  occupyBlock(frame, page, currentTime);
+  linkOccupiedFrame(frame, set);
+  backing->readyTime = currentTime;
+  if (!zswapLoad(backing, currentTime) && backing->swapSlot != NO_SWAP_SLOT)
+    swapInPage(backing, currentTime);
+  delayForDirectReclaim(backing, evicted, currentTime);
+  page->readyTime = backing->readyTime;
+
+  // Registrar carga de página
+  if (evicted == 0) {
+    snprintf(
+        buffer, sizeof(buffer),
+        "Page Fault: Proceso %d, Página %d cargada en marco %d (Tiempo: %lld)",
+        page->processId, page->id, frame, currentTime);
+    logMessage(buffer);
+  }
+  if (anchor == NULL)
+    prefetchAfterFault(page, set, currentTime);
+  reclaimRecordFault(evicted, page->readyTime - currentTime);
   pthread_mutex_unlock(&memoryMutex);
   return true;
 }
 
 MemoryFrame *getPhysicalMemory() { return physicalMemory; }
+
+// Copia en escritura: antes de escribir una página compartida tras un fork
+// se copia a un marco propio (se cuenta como fallo); si ya es la única que
+// mapea el marco se reutiliza sin copiar
+static bool breakCopyOnWrite(Page *page, SimTime currentTime) {
+  char buffer[256];
+  int shared = page->frameIndex;
+  int set = findFrameSet(page->processId);
+  int evicted = 0;
+
+  if (physicalMemory[shared].mapCount == 1) {
+    page->copyOnWrite = false;
+    return true;
+  }
+
+  copyOnWriteFaults++;
+  pageFaults[page->sizeClass]++;
+  pinnedFrame = shared;
+  int frame = placePage(page, set, currentTime, &evicted);
+  pinnedFrame = NO_FRAME;
+  if (frame == NO_FRAME) {
+    allocationFailures[page->sizeClass]++;
+    return false;
+  }
+
+  SimTime readyTime = page->readyTime;
+  removeSharer(shared, page);
+  occupyBlock(frame, page, currentTime);
+  linkOccupiedFrame(frame, set);
+  page->readyTime = readyTime > currentTime ? readyTime : currentTime;
+  page->copyOnWrite = false;
+  delayForDirectReclaim(page, evicted, currentTime);
+  reclaimRecordFault(evicted, page->readyTime - currentTime);
+
+  // Su copia en swap deja de coincidir con el contenido
+  swapFreeSlot(page);
+
+  snprintf(buffer, sizeof(buffer),
+           "Copia en escritura: Proceso %d, Página %d copiada del marco %d al "
+           "marco %d (Tiempo: %lld)",
+           page->processId, page->id, shared, frame, currentTime);
+  logMessage(buffer);
+  return true;
+}
+
+// Mover el bloque de una página privada a un bloque libre de otro nodo;
+// devuelve el marco nuevo o NO_FRAME si el nodo no tiene sitio (no se
+// desaloja nada para migrar)
+static int moveBlock(Page *page, int node, SimTime currentTime) {
+  int from = page->frameIndex;
+  int frame = buddyAlloc(&nodePools[node], physicalMemory[from].order);
+  if (frame == NO_FRAME)
+    return NO_FRAME;
+
+  int set = physicalMemory[from].ownerSet;
+  int prefetchSource = physicalMemory[from].prefetchSource;
+  unlinkOccupiedFrame(from);
+  releaseBlock(from, currentTime);
+  occupyBlock(frame, page, currentTime);
+  physicalMemory[frame].prefetchSource = prefetchSource;
+  linkOccupiedFrame(frame, set);
+  tlbInvalidate(page->processId, page);
+  page->remoteAccesses = 0;
+  numaRecordMigration(numaNodeOfFrame(from), node);
+  return frame;
+}
+
+// Balanceo NUMA: mover una página privada al nodo desde el que se accede
+// a ella, solo si allí hay un bloque libre
+static void migratePage(Page *page, int node, SimTime currentTime) {
+  char buffer[256];
+  int from = page->frameIndex;
+  int fromNode = numaNodeOfFrame(from);
+  int frame = moveBlock(page, node, currentTime);
+  if (frame == NO_FRAME)
+    return;
+
+  snprintf(buffer, sizeof(buffer),
+           "NUMA: página %d del Proceso %d migrada del marco %d (nodo %d) al "
+           "marco %d (nodo %d) (Tiempo: %lld)",
+           page->id, page->processId, from, fromNode, frame, node,
+           currentTime);
+  logMessage(buffer);
+}
+
+// Degradar a la memoria lenta el bloque privado de un marco de la memoria
+// rápida, si el límite de migración lo permite; si la memoria lenta está
+// llena, su bloque menos reciente sale antes a swap. Devuelve false si hay
+// que desalojarlo
+static bool demoteFrame(int frame, SimTime currentTime) {
+  char buffer[256];
+  Page *page = physicalMemory[frame].occupyingPage;
+  int fromNode = numaNodeOfFrame(frame);
+  if (!tieringEnabled() || numaNodeTier(fromNode) != MEMORY_TIER_FAST ||
+      physicalMemory[frame].mapCount != 1 || page->sharedAnchor != NULL ||
+      page->processId == SHARED_REGION_OWNER ||
+      !tierMigrationAllowed(currentTime))
+    return false;
+
+  for (int n = 0; n < numaNodeCount(); n++) {
+    if (numaNodeTier(n) != MEMORY_TIER_SLOW)
+      continue;
+    int to = moveBlock(page, n, currentTime);
+    if (to == NO_FRAME) {
+      int victim = firstUnlockedFrame(globalLruHead, true, n, currentTime);
+      if (victim == NO_FRAME)
+        continue;
+      evictFrame(victim, NULL, currentTime);
+      to = moveBlock(page, n, currentTime);
+    }
+    if (to == NO_FRAME)
+      continue;
+    tierRecordMigration(false);
+    snprintf(buffer, sizeof(buffer),
+             "Niveles: página %d del Proceso %d degradada del marco %d "
+             "(nodo %d) al marco %d (nodo lento %d) (Tiempo: %lld)",
+             page->id, page->processId, frame, fromNode, to, n, currentTime);
+    logMessage(buffer);
+    return true;
+  }
+  return false;
+}
+
+// Promover a la memoria rápida del nodo de la CPU una página caliente de
+// la memoria lenta; si ese nodo está lleno se degrada antes su bloque
+// menos reciente, siempre que esté más frío que la página
+static void promotePage(Page *page, int node, SimTime currentTime) {
+  char buffer[256];
+  int from = page->frameIndex;
+  int order = physicalMemory[from].order;
+  if (!tierMigrationAllowed(currentTime))
+    return;
+
+  if (buddyLargestFreeOrder(&nodePools[node]) < order) {
+    int victim = firstUnlockedFrame(globalLruHead, true, node, currentTime);
+    if (victim == NO_FRAME || physicalMemory[victim].order != order ||
+        physicalMemory[victim].lastUsedTime >=
+            physicalMemory[from].lastUsedTime ||
+        !demoteFrame(victim, currentTime) ||
+        !tierMigrationAllowed(currentTime))
+      return;
+  }
+  int frame = moveBlock(page, node, currentTime);
+  if (frame == NO_FRAME)
+    return;
+  tierRecordMigration(true);
+  snprintf(buffer, sizeof(buffer),
+           "Niveles: página %d del Proceso %d promovida del marco %d al marco "
+           "%d (nodo %d) (Tiempo: %lld)",
+           page->id, page->processId, from, frame, node, currentTime);
+  logMessage(buffer);
+}
+
+// Contabilizar la localidad de un acceso y migrar la página si el
+// proceso la usa repetidamente desde otro nodo; las páginas de la memoria
+// lenta solo se mueven por promoción
+static void recordNumaAccess(Process *process, Page *page,
+                             SimTime currentTime) {
+  int cpuNode = numaProcessNode(process);
+  int memoryNode = numaNodeOfFrame(page->frameIndex);
+  bool slow = numaNodeTier(memoryNode) == MEMORY_TIER_SLOW;
+  int frame = page->frameIndex;
+
+  numaRecordAccess(cpuNode, memoryNode);
+  bool hot = tierRecordAccess(
+      process->id, slow, currentTime - physicalMemory[frame].lastUsedTime,
+      &page->remoteAccesses);
+  if (slow) {
+    page->accessNode = cpuNode;
+    if (hot && physicalMemory[frame].mapCount == 1 &&
+        page->sharedAnchor == NULL && page->readyTime <= currentTime)
+      promotePage(page, cpuNode, currentTime);
+    return;
+  }
+  if (cpuNode == memoryNode || page->accessNode != cpuNode)
+    page->remoteAccesses = 0;
+  page->accessNode = cpuNode;
+  if (cpuNode == memoryNode)
+    return;
+  page->remoteAccesses++;
+
+  // Las páginas compartidas, en lectura desde swap o de procesos con otra
+  // política se quedan donde están
+  if (page->remoteAccesses >= NUMA_BALANCE_THRESHOLD &&
+      numaBalancingAllowed(process) &&
+      physicalMemory[page->frameIndex].mapCount == 1 &&
+      page->sharedAnchor == NULL && page->readyTime <= currentTime)
+    migratePage(page, cpuNode, currentTime);
+}
+
+Page *translateAddress(Process *process, unsigned long virtualAddress,
+                       bool write, SimTime currentTime) {
+  // Consultar primero el TLB; si falla, recorrer la tabla de páginas
+  Page *page = tlbLookup(process->id, virtualAddress);
+  if (page == NULL) {
+    int levelsVisited = 0;
+    page = walkPageTable(process->pageTable, virtualAddress, &levelsVisited);
+    tlbRecordWalk(levelsVisited);
+    if (page == NULL)
+      return NULL;
+    // Solo se cachean traducciones de páginas residentes
+    if (page->inMemory)
+      tlbInsert(process->id, page);
+  }
+
+  // Un acceso a una página residente la mueve al final de las listas LRU
+  page->lastAccessTime = currentTime;
+  if (page->inMemory) {
+    pthread_mutex_lock(&memoryMutex);
+    // Si no se pudo copiar la página compartida, la escritura no procede
+    if (write && page->copyOnWrite && !breakCopyOnWrite(page, currentTime))
+      write = false;
+    if (write)
+      backingPage(page)->dirty = true;
+    if (page->readAhead) {
+      swapRecordReadAhead(true);
+      page->readAhead = false;
+    }
+    recordNumaAccess(process, page, currentTime);
+    int frame = page->frameIndex;
+    if (physicalMemory[frame].prefetchSource != NO_PREFETCH) {
+      prefetchRecordHit(physicalMemory[frame].prefetchSource);
+      physicalMemory[frame].prefetchSource = NO_PREFETCH;
+    }
+    int set = physicalMemory[frame].ownerSet;
+    unlinkOccupiedFrame(frame);
+    for (int i = frame; i < frame + (1 << physicalMemory[frame].order); i++)
+      physicalMemory[i].lastUsedTime = currentTime;
+    linkOccupiedFrame(frame, set);
+    pthread_mutex_unlock(&memoryMutex);
+  }
+  return page;
+}
+
+void setFrameAllocationMode(FrameAllocationMode mode) {
+  pthread_mutex_lock(&memoryMutex);
+  allocationMode = mode;
+  computeFrameQuotas();
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+int registerProcessMemory(Process *process) {
+  pthread_mutex_lock(&memoryMutex);
+  int set = findFrameSet(process->id);
+  for (int i = 0; i < MAX_PROCESSES && set == NO_FRAME; i++) {
+    if (frameSets[i].process == NULL) {
+      // La política de compromiso puede rechazar su memoria
+      if (!oomCommitProcess(i, process))
+        break;
+      frameSets[i].process = process;
+      frameSets[i].residentFrames = 0;
+      frameSets[i].lruHead = frameSets[i].lruTail = NO_FRAME;
+      set = i;
+    }
+  }
+  computeFrameQuotas();
+  pthread_mutex_unlock(&memoryMutex);
+  return set;
+}
+
+// Desmapear una página de un proceso que termina: el marco se libera si
+// nadie más lo mapea
+static void unmapProcessPage(Page *page, SimTime currentTime) {
+  if (!page->inMemory)
+    return;
+  int frame = page->frameIndex;
+  if (physicalMemory[frame].mapCount > 1) {
+    removeSharer(frame, page);
+    return;
+  }
+
+  retirePrefetchedFrame(frame, currentTime);
+
+  // El contenido del segmento compartido sobrevive a sus procesos
+  if (page->sharedAnchor != NULL)
+    writeBackFrame(frame, currentTime);
+  unlinkOccupiedFrame(frame);
+  releaseBlock(frame, currentTime);
+}
+
+// Memoria residente (RSS) y proporcional (PSS, cada marco compartido se
+// reparte entre las páginas que lo mapean) de un proceso, en bytes
+static void processFootprint(const Process *process, unsigned long *rss,
+                             unsigned long *pss) {
+  int sharedPages =
+      process->sharedRegion != NULL ? process->sharedRegion->totalPages : 0;
+
+  *rss = *pss = 0;
+  for (int i = 0; i < process->totalPages + sharedPages; i++) {
+    const Page *page = i < process->totalPages
+                           ? &process->pages[i]
+                           : &process->sharedPages[i - process->totalPages];
+    if (!page->inMemory)
+      continue;
+    unsigned long size = PAGE_SIZE_BYTES(page->sizeClass);
+    *rss += size;
+    *pss += size / physicalMemory[page->frameIndex].mapCount;
+  }
+}
+
+// Liberar la memoria de un proceso registrado en el conjunto set;
+// devuelve los marcos que quedaron libres
+static int releaseFrameSet(Process *process, int set, SimTime currentTime) {
+  char buffer[256];
+  unsigned long rss, pss;
+
+  // Desmapear todas sus páginas: los marcos propios vuelven al asignador
+  // buddy y los compartidos pasan a otro proceso
+  int freeFrames = totalFreeFrames();
+  processFootprint(process, &rss, &pss);
+  for (int i = 0; i < process->totalPages; i++)
+    unmapProcessPage(&process->pages[i], currentTime);
+  for (int i = 0; process->sharedRegion != NULL &&
+                  i < process->sharedRegion->totalPages;
+       i++)
+    unmapProcessPage(&process->sharedPages[i], currentTime);
+
+  // Sus copias comprimidas y en swap ya no se necesitan
+  for (int i = 0; i < process->totalPages; i++) {
+    zswapInvalidate(&process->pages[i]);
+    swapFreeSlot(&process->pages[i]);
+  }
+  frameSets[set].process = NULL;
+  oomReleaseProcess(set);
+  computeFrameQuotas();
+  tlbFlushAsid(process->id);
+  prefetchForgetProcess(process->id);
+
+  int freed = totalFreeFrames() - freeFrames;
+  snprintf(buffer, sizeof(buffer),
+           "Proceso %d liberó %d marcos (RSS %lu KiB, PSS %lu KiB)",
+           process->id, freed, rss / 1024, pss / 1024);
+  logMessage(buffer);
+  return freed;
+}
+
+void releaseProcessMemory(Process *process, SimTime currentTime) {
+  pthread_mutex_lock(&memoryMutex);
+  int set = findFrameSet(process->id);
+  if (set != NO_FRAME)
+    releaseFrameSet(process, set, currentTime);
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+// La víctima sale del índice del OOM killer en O(log n); sus marcos
+// vuelven al asignador y el planificador la retira después
+static bool oomKill(const Page *faulting, SimTime currentTime) {
+  char buffer[256];
+  long score;
+  int set = oomSelectVictim(&score);
+  if (set == NO_FRAME)
+    return false;
+
+  Process *victim = frameSets[set].process;
+  snprintf(buffer, sizeof(buffer),
+           "OOM: Proceso %d eliminado (puntuación %ld, %d marcos) por el "
+           "fallo de la página %d del Proceso %d (Tiempo: %lld)",
+           victim->id, score, frameSets[set].residentFrames, faulting->id,
+           faulting->processId, currentTime);
+  logMessage(buffer);
+  victim->state = TERMINATED;
+  oomRecordKill(victim, releaseFrameSet(victim, set, currentTime));
+  return true;
+}
+
+void shareForkedPages(Process *parent, Process *child) {
+  char buffer[256];
+  int shared = 0;
+  pthread_mutex_lock(&memoryMutex);
+
+  // Las páginas privadas residentes se comparten como copia en escritura;
+  // las que están en swap comparten su slot
+  for (int i = 0; i < parent->totalPages && i < child->totalPages; i++) {
+    Page *from = &parent->pages[i];
+    Page *to = &child->pages[i];
+    to->dirty = from->dirty;
+    swapShareSlot(to, from->swapSlot);
+    if (!from->inMemory)
+      continue;
+    from->copyOnWrite = to->copyOnWrite = true;
+    addSharer(from->frameIndex, to);
+    to->readyTime = from->readyTime;
+    shared++;
+  }
+
+  // El segmento compartido sigue siendo común, sin copia en escritura
+  for (int i = 0; parent->sharedRegion != NULL &&
+                  parent->sharedRegion == child->sharedRegion &&
+                  i < parent->sharedRegion->totalPages;
+       i++) {
+    Page *from = &parent->sharedPages[i];
+    if (!from->inMemory)
+      continue;
+    addSharer(from->frameIndex, &child->sharedPages[i]);
+    child->sharedPages[i].readyTime = from->readyTime;
+    shared++;
+  }
+
+  // Las traducciones del padre permitían escribir sin copiar
+  tlbFlushAsid(parent->id);
+
+  snprintf(buffer, sizeof(buffer),
+           "Fork: Proceso %d creado desde el Proceso %d compartiendo %d "
+           "páginas residentes",
+           child->id, parent->id, shared);
+  logMessage(buffer);
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+void displayProcessMemoryUsage() {
+  char buffer[256];
+  unsigned long rss, pss;
+  pthread_mutex_lock(&memoryMutex);
+
+  logMessage("Memoria por proceso (RSS / PSS):");
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (frameSets[i].process == NULL)
+      continue;
+    processFootprint(frameSets[i].process, &rss, &pss);
+    snprintf(buffer, sizeof(buffer), "Proceso %d: RSS %lu KiB, PSS %lu KiB",
+             frameSets[i].process->id, rss / 1024, pss / 1024);
+    logMessage(buffer);
+  }
+  snprintf(buffer, sizeof(buffer),
+           "Fallos por copia en escritura: %ld, fallos en marcos compartidos: "
+           "%ld",
+           copyOnWriteFaults, sharedFaults);
+  logMessage(buffer);
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+void displayFrameQuotas() {
+  char buffer[256];
+  pthread_mutex_lock(&memoryMutex);
+  logMessage("Cuotas de marcos por proceso:");
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    ProcessFrameSet *s = &frameSets[i];
+    if (s->process == NULL)
+      continue;
+    snprintf(buffer, sizeof(buffer),
+             "Proceso %d: Cuota %d marcos, Residentes %d (Prioridad %d)",
+             s->process->id, s->quota, s->residentFrames, s->process->priority);
+    logMessage(buffer);
+  }
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+// Índice remapeado de un marco durante la compactación
+static int remapFrame(const int *remap, int frame) {
+  return frame == NO_FRAME ? NO_FRAME : remap[frame];
+}
+
+// Compactación de un nodo: reubicar sus bloques de usuario en un asignador
+// nuevo donde los bloques fijos (núcleo, DMA, caché de archivos) conservan
+// su posición. Colocar de mayor a menor orden es óptimo con tamaños
+// potencia de 2, así que los marcos libres quedan agrupados en los bloques
+// más grandes posibles. Las páginas no salen de su nodo y los marcos de
+// los demás nodos solo actualizan sus enlaces LRU
+static int compactMemoryLocked(int node, SimTime currentTime) {
+  char buffer[256];
+  BuddyAllocator *pool = &nodePools[node];
+  BuddyAllocator packed;
+  int *remap = malloc(NUM_FRAMES * sizeof(int));
+  MemoryFrame *compacted = malloc(NUM_FRAMES * sizeof(MemoryFrame));
+  int firstFrame = pool->baseFrame;
+  int lastFrame = pool->baseFrame + pool->numFrames;
+  int moved = 0;
+
+  if (remap == NULL || compacted == NULL ||
+      !buddyInit(&packed, firstFrame, pool->numFrames)) {
+    free(remap);
+    free(compacted);
+    return 0;
+  }
+
+  // Los bloques fijos y los de otros nodos se quedan donde están
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    remap[i] = i < firstFrame || i >= lastFrame ? i : NO_FRAME;
+    if (remap[i] == NO_FRAME && physicalMemory[i].headFrame == i &&
+        physicalMemory[i].use != FRAME_USER) {
+      buddyReserve(&packed, i, physicalMemory[i].order);
+      remap[i] = i;
+    }
+  }
+
+  // Asignar destino a cada bloque de usuario
+  for (int order = pool->maxOrder; order >= 0; order--) {
+    for (int i = firstFrame; i < lastFrame; i++) {
+      if (physicalMemory[i].headFrame != i ||
+          physicalMemory[i].use != FRAME_USER ||
+          physicalMemory[i].order != order)
+        continue;
+      remap[i] = buddyAlloc(&packed, order);
+      if (remap[i] == NO_FRAME) {
+        buddyDestroy(&packed);
+        free(remap);
+        free(compacted);
+        return 0;
+      }
+    }
+  }
+
+  // Construir la nueva tabla de marcos con los enlaces LRU remapeados
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    compacted[i] = physicalMemory[i];
+    if (i < firstFrame || i >= lastFrame) {
+      compacted[i].prevFrame = remapFrame(remap, compacted[i].prevFrame);
+      compacted[i].nextFrame = remapFrame(remap, compacted[i].nextFrame);
+      compacted[i].prevGlobal = remapFrame(remap, compacted[i].prevGlobal);
+      compacted[i].nextGlobal = remapFrame(remap, compacted[i].nextGlobal);
+      continue;
+    }
+    compacted[i].occupyingPage = NULL;
+    compacted[i].lastUsedTime = -1;
+    compacted[i].headFrame = NO_FRAME;
+    compacted[i].order = 0;
+    compacted[i].use = FRAME_USER;
+    compacted[i].mapCount = 0;
+    compacted[i].prefetchSource = NO_PREFETCH;
+    compacted[i].ownerSet = NO_FRAME;
+    compacted[i].prevFrame = compacted[i].nextFrame = NO_FRAME;
+    compacted[i].prevGlobal = compacted[i].nextGlobal = NO_FRAME;
+    compacted[i].lruSequence = 0;
+  }
+  for (int i = firstFrame; i < lastFrame; i++) {
+    if (physicalMemory[i].headFrame != i)
+      continue;
+    MemoryFrame *from = &physicalMemory[i];
+    int to = remap[i];
+    for (int j = 0; j < (1 << from->order); j++) {
+      compacted[to + j].headFrame = to;
+      compacted[to + j].lastUsedTime = from->lastUsedTime;
+    }
+    compacted[to].occupyingPage = from->occupyingPage;
+    compacted[to].mapCount = from->mapCount;
+    compacted[to].prefetchSource = from->prefetchSource;
+    compacted[to].order = from->order;
+    compacted[to].use = from->use;
+    compacted[to].ownerSet = from->ownerSet;
+    compacted[to].prevFrame = remapFrame(remap, from->prevFrame);
+    compacted[to].nextFrame = remapFrame(remap, from->nextFrame);
+    compacted[to].prevGlobal = remapFrame(remap, from->prevGlobal);
+    compacted[to].nextGlobal = remapFrame(remap, from->nextGlobal);
+    compacted[to].lruSequence = from->lruSequence;
+    if (from->occupyingPage == NULL)
+      continue;
+    for (Page *page = from->occupyingPage; page != NULL;
+         page = page->nextSharer) {
+      page->frameIndex = to;
+      if (page->sharedAnchor != NULL)
+        page->sharedAnchor->frameIndex = to;
+      // La traducción antigua apunta al marco anterior
+      if (to != i)
+        tlbInvalidate(page->processId, page);
+    }
+    if (to != i)
+      moved++;
+  }
+
+  globalLruHead = remapFrame(remap, globalLruHead);
+  globalLruTail = remapFrame(remap, globalLruTail);
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (frameSets[i].process == NULL)
+      continue;
+    frameSets[i].lruHead = remapFrame(remap, frameSets[i].lruHead);
+    frameSets[i].lruTail = remapFrame(remap, frameSets[i].lruTail);
+  }
+  memcpy(physicalMemory, compacted, NUM_FRAMES * sizeof(MemoryFrame));
+  free(compacted);
+  free(remap);
+  for (int i = firstFrame; i < lastFrame; i++) {
+    int head = physicalMemory[i].headFrame;
+    recordFrameHistory(i, 0,
+                       head != NO_FRAME ? physicalMemory[head].occupyingPage
+                                        : NULL,
+                       currentTime);
+  }
+
+  // El asignador reconstruido sustituye al anterior conservando sus
+  // estadísticas acumuladas
+  memcpy(packed.allocations, pool->allocations, sizeof(packed.allocations));
+  memcpy(packed.frees, pool->frees, sizeof(packed.frees));
+  memcpy(packed.failures, pool->failures, sizeof(packed.failures));
+  packed.splits = pool->splits;
+  packed.merges = pool->merges;
+  buddyDestroy(pool);
+  *pool = packed;
+  compactions++;
+  migratedPages += moved;
+
+  if (numaNodeCount() > 1)
+    snprintf(buffer, sizeof(buffer),
+             "Compactación del nodo %d: %d páginas migradas, bloque libre "
+             "máximo de orden %d (Tiempo: %lld)",
+             node, moved, buddyLargestFreeOrder(pool), currentTime);
+  else
+    snprintf(buffer, sizeof(buffer),
+             "Compactación: %d páginas migradas, bloque libre máximo de orden "
+             "%d (Tiempo: %lld)",
+             moved, buddyLargestFreeOrder(pool), currentTime);
+  logMessage(buffer);
+  return moved;
+}
+
+static int allocateBlock(int node, bool fallback, int order,
+                         SimTime currentTime) {
+  int nodes = fallback ? numaNodeCount() : 1;
+
+  // Primero los bloques libres (el nodo preferido, los de su nivel y
+  // después los demás) y solo entonces la compactación, en el mismo orden
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < nodes; i++) {
+      int n = numaFallbackNode(node, i);
+      BuddyAllocator *pool = &nodePools[n];
+      if (order > pool->maxOrder ||
+          (pass == 1 && (order == 0 || pool->freeFrames < (1 << order))))
+        continue;
+      if (pass == 1)
+        compactMemoryLocked(n, currentTime);
+      int frame = buddyAlloc(pool, order);
+      if (frame != NO_FRAME) {
+        numaRecordAllocation(node, n);
+        return frame;
+      }
+    }
+  }
+  return NO_FRAME;
+}
+
+int compactMemory(SimTime currentTime) {
+  int moved = 0;
+  pthread_mutex_lock(&memoryMutex);
+  for (int n = 0; n < numaNodeCount(); n++)
+    moved += compactMemoryLocked(n, currentTime);
+  pthread_mutex_unlock(&memoryMutex);
+  return moved;
+}
+
+int freeFramesOnNode(int node) {
+  pthread_mutex_lock(&memoryMutex);
+  int freeFrames = nodePools[node].freeFrames;
+  pthread_mutex_unlock(&memoryMutex);
+  return freeFrames;
+}
+
+void processNodeFrames(const Process *process, int *frames) {
+  int sharedPages =
+      process->sharedRegion != NULL ? process->sharedRegion->totalPages : 0;
+  pthread_mutex_lock(&memoryMutex);
+
+  for (int n = 0; n < numaNodeCount(); n++)
+    frames[n] = 0;
+  for (int i = 0; i < process->totalPages + sharedPages; i++) {
+    const Page *page = i < process->totalPages
+                           ? &process->pages[i]
+                           : &process->sharedPages[i - process->totalPages];
+    if (page->inMemory)
+      frames[numaNodeOfFrame(page->frameIndex)] +=
+          1 << PAGE_SIZE_ORDER(page->sizeClass);
+  }
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+void displayPageSizeStatistics() {
+  static const char *sizeNames[NUM_PAGE_SIZES] = {"4 KiB", "2 MiB", "1 GiB"};
+  char buffer[256];
+
+  pthread_mutex_lock(&memoryMutex);
+  logMessage("Estadísticas por tamaño de página:");
+  for (int c = 0; c < NUM_PAGE_SIZES; c++) {
+    snprintf(buffer, sizeof(buffer),
+             "Páginas de %s: %ld fallos, %ld cargas imposibles", sizeNames[c],
+             pageFaults[c], allocationFailures[c]);
+    logMessage(buffer);
+  }
+
+  // Fragmentación: fracción de memoria libre fuera del mayor bloque libre
+  int largestOrder = largestFreeOrder();
+  int largestBlock = largestOrder >= 0 ? 1 << largestOrder : 0;
+  int freeFrames = totalFreeFrames();
+  double fragmentation =
+      freeFrames > 0 ? 1.0 - (double)largestBlock / freeFrames : 0.0;
+  snprintf(buffer, sizeof(buffer),
+           "Marcos libres: %d, bloque libre máximo: %d marcos, "
+           "fragmentación %.2f",
+           freeFrames, largestBlock, fragmentation);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Compactaciones: %ld, páginas migradas: %ld", compactions,
+           migratedPages);
+  logMessage(buffer);
+  pthread_mutex_unlock(&memoryMutex);
+
+  snprintf(buffer, sizeof(buffer), "Alcance del TLB: %lu KiB",
+           tlbReach() / 1024);
+  logMessage(buffer);
+}
+
+int allocateKernelBlock(int order, FrameUse use, SimTime currentTime) {
+  char buffer[256];
+  pthread_mutex_lock(&memoryMutex);
+
+  if (order < 0 || order > maxPoolOrder() || use == FRAME_USER ||
+      use == FRAME_CACHE) {
+    pthread_mutex_unlock(&memoryMutex);
+    return NO_FRAME;
+  }
+
+  // Las reservas del núcleo prefieren el nodo de la CPU activa y desalojan
+  // páginas de usuario y de la caché por LRU global
+  int node = numaProcessNode(NULL);
+  int frame = allocateBlock(node, true, order, currentTime);
+  while (frame == NO_FRAME &&
+         reclaimFrame(NO_FRAME, NUMA_ANY_NODE, NULL, currentTime))
+    frame = allocateBlock(node, true, order, currentTime);
+  if (frame == NO_FRAME) {
+    pthread_mutex_unlock(&memoryMutex);
+    return NO_FRAME;
+  }
+
+  for (int i = frame; i < frame + (1 << order); i++) {
+    physicalMemory[i].occupyingPage = NULL;
+    physicalMemory[i].headFrame = frame;
+    physicalMemory[i].lastUsedTime = currentTime;
+  }
+  physicalMemory[frame].order = order;
+  physicalMemory[frame].use = use;
+
+  snprintf(buffer, sizeof(buffer),
+           "Reserva %s: %d marcos contiguos desde el marco %d (Tiempo: %lld)",
+           use == FRAME_DMA     ? "DMA"
+           : use == FRAME_ZSWAP ? "de zswap"
+                                : "del núcleo",
+           1 << order, frame,
+           currentTime);
+  logMessage(buffer);
+  pthread_mutex_unlock(&memoryMutex);
+  return frame;
+}
+
+void freeKernelBlock(int frame) {
+  pthread_mutex_lock(&memoryMutex);
+  if (frame >= 0 && frame < NUM_FRAMES &&
+      physicalMemory[frame].headFrame == frame &&
+      physicalMemory[frame].use != FRAME_USER &&
+      physicalMemory[frame].use != FRAME_CACHE)
+    releaseBlock(frame, physicalMemory[frame].lastUsedTime);
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+int allocateCacheFrame(Page *page, SimTime currentTime) {
+  int evicted = 0;
+  pthread_mutex_lock(&memoryMutex);
+
+  // Los marcos de la caché no pertenecen a ningún proceso ni entran en las
+  // listas LRU de la memoria anónima
+  int frame = placePage(page, NO_FRAME, currentTime, &evicted);
+  if (frame != NO_FRAME) {
+    occupyBlock(frame, page, currentTime);
+    physicalMemory[frame].use = FRAME_CACHE;
+    page->readyTime = currentTime;
+  }
+  pthread_mutex_unlock(&memoryMutex);
+  return frame;
+}
+
+void touchCacheFrame(int frame, SimTime currentTime) {
+  pthread_mutex_lock(&memoryMutex);
+  if (frame >= 0 && frame < NUM_FRAMES &&
+      physicalMemory[frame].use == FRAME_CACHE)
+    physicalMemory[frame].lastUsedTime = currentTime;
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+void freeCacheFrame(int frame) {
+  pthread_mutex_lock(&memoryMutex);
+  // La caché se vacía al terminar: el historial lo registra en su último
+  // tiempo
+  if (frame >= 0 && frame < NUM_FRAMES &&
+      physicalMemory[frame].headFrame == frame &&
+      physicalMemory[frame].use == FRAME_CACHE)
+    releaseBlock(frame, physicalMemory[frame].lastUsedTime);
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+bool saveMemoryState(CheckpointFrame *frames, CheckpointFrameSet *sets,
+                     CheckpointMemory *state,
+                     int (*pageIndex)(const Page *),
+                     int (*processIndex)(const Process *)) {
+  bool complete = true;
+  pthread_mutex_lock(&memoryMutex);
+
+  for (int i = 0; i < NUM_FRAMES; i++) {
+    const MemoryFrame *f = &physicalMemory[i];
+    CheckpointFrame *record = &frames[i];
+    int head = f->headFrame;
+
+    // La caché de archivos y el almacén comprimido no se guardan: sus
+    // marcos quedan libres
+    if (head != NO_FRAME && (physicalMemory[head].use == FRAME_CACHE ||
+                             physicalMemory[head].use == FRAME_ZSWAP))
+      f = NULL;
+    record->occupyingPage = f != NULL && f->occupyingPage != NULL
+                                ? pageIndex(f->occupyingPage)
+                                : CHECKPOINT_NONE;
+    if (f != NULL && f->occupyingPage != NULL &&
+        record->occupyingPage == CHECKPOINT_NONE)
+      complete = false;
+    record->mapCount = f != NULL ? f->mapCount : 0;
+    record->prefetchSource = f != NULL ? f->prefetchSource : NO_PREFETCH;
+    record->lastUsedTime = f != NULL ? f->lastUsedTime : -1;
+    record->headFrame = f != NULL ? f->headFrame : NO_FRAME;
+    record->order = f != NULL ? f->order : 0;
+    record->use = f != NULL ? (int)f->use : FRAME_USER;
+    record->ownerSet = f != NULL ? f->ownerSet : NO_FRAME;
+    record->prevFrame = f != NULL ? f->prevFrame : NO_FRAME;
+    record->nextFrame = f != NULL ? f->nextFrame : NO_FRAME;
+    record->prevGlobal = f != NULL ? f->prevGlobal : NO_FRAME;
+    record->nextGlobal = f != NULL ? f->nextGlobal : NO_FRAME;
+  }
+
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    const ProcessFrameSet *s = &frameSets[i];
+    sets[i].process = s->process != NULL ? processIndex(s->process)
+                                         : CHECKPOINT_NONE;
+    if (s->process != NULL && sets[i].process == CHECKPOINT_NONE)
+      complete = false;
+    sets[i].quota = s->quota;
+    sets[i].residentFrames = s->residentFrames;
+    sets[i].lruHead = s->lruHead;
+    sets[i].lruTail = s->lruTail;
+  }
+
+  memset(state, 0, sizeof(*state));
+  state->allocationMode = allocationMode;
+  state->globalLruHead = globalLruHead;
+  state->globalLruTail = globalLruTail;
+  memcpy(state->pageFaults, pageFaults, sizeof(pageFaults));
+  memcpy(state->allocationFailures, allocationFailures,
+         sizeof(allocationFailures));
+  state->compactions = compactions;
+  state->migratedPages = migratedPages;
+  state->copyOnWriteFaults = copyOnWriteFaults;
+  state->sharedFaults = sharedFaults;
+  pthread_mutex_unlock(&memoryMutex);
+  return complete;
+}
+
+// Un índice de marco guardado es válido si es nulo o está en rango
+static bool validFrameLink(int frame) {
+  return frame == NO_FRAME || (frame >= 0 && frame < NUM_FRAMES);
+}
+
+// El mapa inverso de un marco restaurado debe tener mapCount páginas, todas
+// (y sus anclas) residentes en él
+static bool validSharers(int frame, const MemoryFrame *f) {
+  int sharers = 0;
+  for (const Page *page = f->occupyingPage; page != NULL;
+       page = page->nextSharer) {
+    if (++sharers > f->mapCount || !page->inMemory ||
+        page->frameIndex != frame ||
+        (page->sharedAnchor != NULL &&
+         (!page->sharedAnchor->inMemory ||
+          page->sharedAnchor->frameIndex != frame)))
+      return false;
+  }
+  return sharers == f->mapCount;
+}
+
+// Una página restaurada residente debe estar en el mapa inverso de su
+// bloque o ser el ancla de las que lo están
+static bool validResidentPage(const Page *page, const MemoryFrame *frames) {
+  if (page->inMemory != (page->frameIndex != NO_FRAME))
+    return false;
+  if (!page->inMemory)
+    return true;
+  const Page *sharer = frames[page->frameIndex].occupyingPage;
+  if (sharer != NULL && sharer->sharedAnchor == page)
+    return true;
+  while (sharer != NULL && sharer != page)
+    sharer = sharer->nextSharer;
+  return sharer != NULL;
+}
+
+bool restoreMemoryState(const CheckpointFrame *frames,
+                        const CheckpointFrameSet *sets,
+                        const CheckpointMemory *state, Page *(*pageAt)(int),
+                        Process *(*processAt)(int)) {
+  // Todo se reconstruye aparte y solo sustituye al estado actual si el
+  // checkpoint es válido por completo
+  MemoryFrame *restored = malloc(NUM_FRAMES * sizeof(MemoryFrame));
+  ProcessFrameSet restoredSets[MAX_PROCESSES];
+  BuddyAllocator pools[MAX_NUMA_NODES];
+  int poolCount = 0;
+  bool valid = restored != NULL && validFrameLink(state->globalLruHead) &&
+               validFrameLink(state->globalLruTail);
+  pthread_mutex_lock(&memoryMutex);
+
+  for (int n = 0; n < numaNodeCount() && valid; n++) {
+    valid = buddyInit(&pools[n], nodePools[n].baseFrame,
+                      nodePools[n].numFrames);
+    poolCount += valid;
+  }
+
+  for (int i = 0; i < MAX_PROCESSES && valid; i++) {
+    ProcessFrameSet *s = &restoredSets[i];
+    s->process = sets[i].process != CHECKPOINT_NONE
+                     ? processAt(sets[i].process)
+                     : NULL;
+    s->quota = sets[i].quota;
+    s->residentFrames = sets[i].residentFrames;
+    s->lruHead = sets[i].lruHead;
+    s->lruTail = sets[i].lruTail;
+    valid = (sets[i].process == CHECKPOINT_NONE ||
+             (s->process != NULL && s->process->state != TERMINATED)) &&
+            validFrameLink(s->lruHead) && validFrameLink(s->lruTail);
+  }
+
+  for (int i = 0; i < NUM_FRAMES && valid; i++) {
+    const CheckpointFrame *record = &frames[i];
+    MemoryFrame *f = &restored[i];
+    f->occupyingPage = record->occupyingPage != CHECKPOINT_NONE
+                           ? pageAt(record->occupyingPage)
+                           : NULL;
+    f->mapCount = record->mapCount;
+    f->prefetchSource = record->prefetchSource;
+    f->lastUsedTime = record->lastUsedTime;
+    f->headFrame = record->headFrame;
+    f->order = record->order;
+    f->use = (FrameUse)record->use;
+    f->ownerSet = record->ownerSet;
+    f->prevFrame = record->prevFrame;
+    f->nextFrame = record->nextFrame;
+    f->prevGlobal = record->prevGlobal;
+    f->nextGlobal = record->nextGlobal;
+    f->lruSequence = 0;
+    valid = (record->occupyingPage == CHECKPOINT_NONE ||
+             f->occupyingPage != NULL) &&
+            validFrameLink(f->headFrame) && validFrameLink(f->prevFrame) &&
+            validFrameLink(f->nextFrame) && validFrameLink(f->prevGlobal) &&
+            validFrameLink(f->nextGlobal) &&
+            (f->ownerSet == NO_FRAME ||
+             (f->ownerSet >= 0 && f->ownerSet < MAX_PROCESSES &&
+              restoredSets[f->ownerSet].process != NULL)) &&
+            f->use >= FRAME_USER && f->use <= FRAME_DMA &&
+            (f->prefetchSource == NO_PREFETCH ||
+             (f->prefetchSource >= 0 &&
+              f->prefetchSource < NUM_PREFETCH_SOURCES)) &&
+            (f->occupyingPage == NULL ||
+             (f->headFrame == i && f->use == FRAME_USER)) &&
+            validSharers(i, f);
+
+    // Los bloques ocupados se retiran del asignador buddy de su nodo
+    if (valid && f->headFrame == i)
+      valid = buddyReserve(&pools[numaNodeOfFrame(i)], i, f->order) &&
+              (f->use != FRAME_USER || f->occupyingPage != NULL);
+  }
+
+  // Cada página residente debe estar en el mapa inverso de su marco (pageAt
+  // devuelve NULL tras la última)
+  const Page *page;
+  for (int p = 0; valid && (page = pageAt(p)) != NULL; p++)
+    valid = validResidentPage(page, restored);
+
+  if (valid) {
+    memcpy(physicalMemory, restored, NUM_FRAMES * sizeof(MemoryFrame));
+    memcpy(frameSets, restoredSets, sizeof(frameSets));
+    // El índice del OOM killer pasa a los conjuntos restaurados
+    oomResetIndex();
+    for (int i = 0; i < MAX_PROCESSES; i++) {
+      if (frameSets[i].process == NULL)
+        continue;
+      oomRestoreProcess(i, frameSets[i].process);
+      oomUpdateResident(i, frameSets[i].residentFrames);
+    }
+    for (int n = 0; n < poolCount; n++) {
+      buddyDestroy(&nodePools[n]);
+      nodePools[n] = pools[n];
+    }
+    allocationMode = (FrameAllocationMode)state->allocationMode;
+    globalLruHead = state->globalLruHead;
+    globalLruTail = state->globalLruTail;
+    // El orden de enlace no se guarda: es la posición en la lista global
+    lruSequence = 0;
+    for (int frame = globalLruHead, steps = 0;
+         frame != NO_FRAME && steps < NUM_FRAMES;
+         frame = physicalMemory[frame].nextGlobal, steps++)
+      physicalMemory[frame].lruSequence = ++lruSequence;
+    memcpy(pageFaults, state->pageFaults, sizeof(pageFaults));
+    memcpy(allocationFailures, state->allocationFailures,
+           sizeof(allocationFailures));
+    compactions = state->compactions;
+    migratedPages = state->migratedPages;
+    copyOnWriteFaults = state->copyOnWriteFaults;
+    sharedFaults = state->sharedFaults;
+  } else {
+    for (int n = 0; n < poolCount; n++)
+      buddyDestroy(&pools[n]);
+  }
+  pthread_mutex_unlock(&memoryMutex);
+  free(restored);
+  return valid;
+}
+
+// Orden de referencia para el índice: páginas de 2 MiB o el mayor posible
+static int fragmentationOrder() {
+  return maxPoolOrder() < PAGE_SIZE_ORDER(PAGE_SIZE_2M)
+             ? maxPoolOrder()
+             : PAGE_SIZE_ORDER(PAGE_SIZE_2M);
+}
+
+void recordFragmentationSample(SimTime currentTime) {
+  pthread_mutex_lock(&memoryMutex);
+  FragmentationSample *sample =
+      &fragmentationHistory[fragmentationSamples % FRAGMENTATION_HISTORY];
+  sample->time = currentTime;
+  sample->freeFrames = totalFreeFrames();
+  sample->largestFreeOrder = largestFreeOrder();
+  sample->unusableIndex = unusableIndex(fragmentationOrder());
+  fragmentationSamples++;
+  pthread_mutex_unlock(&memoryMutex);
+}
+
+void displayBuddyStatistics() {
+  char buffer[256];
+  pthread_mutex_lock(&memoryMutex);
+
+  // Totales de los asignadores de todos los nodos
+  logMessage("Asignador buddy por orden:");
+  long splits = 0, merges = 0;
+  for (int n = 0; n < numaNodeCount(); n++) {
+    splits += nodePools[n].splits;
+    merges += nodePools[n].merges;
+  }
+  for (int order = 0; order <= maxPoolOrder(); order++) {
+    int freeBlocks = 0;
+    long allocations = 0, frees = 0, failures = 0;
+    for (int n = 0; n < numaNodeCount(); n++) {
+      freeBlocks += nodePools[n].freeBlocks[order];
+      allocations += nodePools[n].allocations[order];
+      frees += nodePools[n].frees[order];
+      failures += nodePools[n].failures[order];
+    }
+    snprintf(buffer, sizeof(buffer),
+             "Orden %d (%d marcos): %d bloques libres, %ld reservas, %ld "
+             "liberaciones, %ld fallidas, índice inutilizable %.2f",
+             order, 1 << order, freeBlocks, allocations, frees, failures,
+             unusableIndex(order));
+    logMessage(buffer);
+  }
+  snprintf(buffer, sizeof(buffer), "Divisiones: %ld, fusiones: %ld", splits,
+           merges);
+  logMessage(buffer);
+
+  // Evolución del índice de fragmentación (muestras más recientes)
+  int first = fragmentationSamples > FRAGMENTATION_HISTORY
+                  ? fragmentationSamples - FRAGMENTATION_HISTORY
+                  : 0;
+  snprintf(buffer, sizeof(buffer),
+           "Fragmentación externa (orden %d) en el tiempo:",
+           fragmentationOrder());
+  logMessage(buffer);
+  for (int i = first; i < fragmentationSamples; i++) {
+    FragmentationSample *sample =
+        &fragmentationHistory[i % FRAGMENTATION_HISTORY];
+    snprintf(buffer, sizeof(buffer),
+             "Tiempo %lld: %d marcos libres, bloque máximo de orden %d, índice "
+             "%.2f",
+             sample->time, sample->freeFrames, sample->largestFreeOrder,
+             sample->unusableIndex);
+    logMessage(buffer);
+  }
+  pthread_mutex_unlock(&memoryMutex);
+}
@@ -0,0 +1,311 @@
+#include "mrc.h"
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Nodo del árbol de la pila LRU: una página con el tiempo de su última
+// referencia; el árbol (un treap ordenado por ese tiempo) cuenta en
+// O(log n) cuántas páginas distintas se referenciaron después
+typedef struct {
+  int key;           // Página (identificador de la página ancla)
+  long time;         // Tiempo lógico de su última referencia
+  unsigned priority; // Prioridad del treap (montículo)
+  int left;          // Subárbol de tiempos menores
+  int right;         // Subárbol de tiempos mayores
+  int size;          // Nodos del subárbol
+} StackNode;
+
+#define NO_NODE -1
+
+// Pila de Mattson de un flujo de referencias
+typedef struct {
+  MrcStatistics stats;
+  StackNode *nodes;  // Un nodo por página distinta
+  int nodeCount;
+  int nodeCapacity;
+  int *slots;        // Tabla hash de página a nodo (NO_NODE si vacía)
+  int slotCapacity;  // Potencia de dos
+  int root;          // Raíz del treap
+  long clock;        // Referencias muestreadas del flujo
+} StackTracker;
+
+static bool enabled = false;
+static double samplingRate = MRC_EXACT_RATE;
+static unsigned long samplingThreshold = MRC_SHARDS_MODULUS;
+static StackTracker globalTracker;
+static StackTracker processTrackers[MRC_MAX_PROCESSES];
+static int trackerCount = 0;
+
+// Mezcla de 32 bits (finalizador de murmur3) para el hash y las
+// prioridades
+static unsigned mix(unsigned long value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdUL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53UL;
+  value ^= value >> 33;
+  return (unsigned)value;
+}
+
+static void resetTracker(StackTracker *tracker, int processId) {
+  free(tracker->nodes);
+  free(tracker->slots);
+  memset(tracker, 0, sizeof(StackTracker));
+  tracker->stats.processId = processId;
+  tracker->root = NO_NODE;
+}
+
+static int nodeSize(const StackTracker *tracker, int node) {
+  return node == NO_NODE ? 0 : tracker->nodes[node].size;
+}
+
+static void updateSize(StackTracker *tracker, int node) {
+  StackNode *n = &tracker->nodes[node];
+  n->size = 1 + nodeSize(tracker, n->left) + nodeSize(tracker, n->right);
+}
+
+// Separar los nodos con tiempo menor que time (*left) del resto (*right)
+static void split(StackTracker *tracker, int node, long time, int *left,
+                  int *right) {
+  if (node == NO_NODE) {
+    *left = *right = NO_NODE;
+    return;
+  }
+  StackNode *n = &tracker->nodes[node];
+  if (n->time < time) {
+    split(tracker, n->right, time, &n->right, right);
+    *left = node;
+  } else {
+    split(tracker, n->left, time, left, &n->left);
+    *right = node;
+  }
+  updateSize(tracker, node);
+}
+
+// Unir dos treaps en los que todos los tiempos de left preceden a right
+static int merge(StackTracker *tracker, int left, int right) {
+  if (left == NO_NODE)
+    return right;
+  if (right == NO_NODE)
+    return left;
+  if (tracker->nodes[left].priority > tracker->nodes[right].priority) {
+    tracker->nodes[left].right =
+        merge(tracker, tracker->nodes[left].right, right);
+    updateSize(tracker, left);
+    return left;
+  }
+  tracker->nodes[right].left = merge(tracker, left, tracker->nodes[right].left);
+  updateSize(tracker, right);
+  return right;
+}
+
+// Páginas referenciadas después de time
+static int countAfter(const StackTracker *tracker, long time) {
+  int count = 0;
+  int node = tracker->root;
+  while (node != NO_NODE) {
+    const StackNode *n = &tracker->nodes[node];
+    if (n->time > time) {
+      count += 1 + nodeSize(tracker, n->right);
+      node = n->left;
+    } else {
+      node = n->right;
+    }
+  }
+  return count;
+}
+
+// Hueco de la tabla hash de una página (ocupado por ella o vacío)
+static int *findSlot(StackTracker *tracker, int key) {
+  unsigned mask = (unsigned)tracker->slotCapacity - 1;
+  unsigned slot = mix((unsigned long)key) & mask;
+  while (tracker->slots[slot] != NO_NODE &&
+         tracker->nodes[tracker->slots[slot]].key != key)
+    slot = (slot + 1) & mask;
+  return &tracker->slots[slot];
+}
+
+// Reservar un nodo para una página nueva; la tabla hash se mantiene por
+// debajo de la mitad de ocupación
+static int addNode(StackTracker *tracker, int key) {
+  if (tracker->nodeCount == tracker->nodeCapacity) {
+    int capacity = tracker->nodeCapacity > 0 ? 2 * tracker->nodeCapacity : 64;
+    StackNode *nodes = realloc(tracker->nodes, capacity * sizeof(StackNode));
+    if (nodes == NULL)
+      return NO_NODE;
+    tracker->nodes = nodes;
+    tracker->nodeCapacity = capacity;
+  }
+  if (2 * (tracker->nodeCount + 1) > tracker->slotCapacity) {
+    int capacity = tracker->slotCapacity > 0 ? 2 * tracker->slotCapacity : 128;
+    int *slots = malloc(capacity * sizeof(int));
+    if (slots == NULL)
+      return NO_NODE;
+    for (int i = 0; i < capacity; i++)
+      slots[i] = NO_NODE;
+    free(tracker->slots);
+    tracker->slots = slots;
+    tracker->slotCapacity = capacity;
+    for (int i = 0; i < tracker->nodeCount; i++)
+      *findSlot(tracker, tracker->nodes[i].key) = i;
+  }
+  int node = tracker->nodeCount++;
+  tracker->nodes[node].key = key;
+  *findSlot(tracker, key) = node;
+  return node;
+}
+
+// Intervalo del histograma de una distancia (>= 1)
+static int distanceBucket(long distance) {
+  int bucket = 0;
+  while (distance > 1 && bucket < MRC_DISTANCE_BUCKETS - 1) {
+    distance >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+// Referencia de una página muestreada: su distancia de pila es el número
+// de páginas distintas referenciadas desde su uso anterior más uno
+static void trackReference(StackTracker *tracker, int key) {
+  MrcStatistics *stats = &tracker->stats;
+  int node = tracker->slotCapacity > 0 ? *findSlot(tracker, key) : NO_NODE;
+  stats->sampled++;
+  tracker->clock++;
+
+  if (node != NO_NODE) {
+    long time = tracker->nodes[node].time;
+    int left, middle, right;
+    // SHARDS: cada página muestreada representa 1 / tasa páginas
+    long distance =
+        (long)((countAfter(tracker, time) + 1) / samplingRate + 0.5);
+    split(tracker, tracker->root, time, &left, &right);
+    split(tracker, right, time + 1, &middle, &right);
+    tracker->root = merge(tracker, left, right);
+    stats->histogram[distanceBucket(distance)]++;
+    if (distance <= MRC_CURVE_FRAMES)
+      stats->shortDistances[distance - 1]++;
+  } else {
+    stats->coldMisses++;
+    node = addNode(tracker, key);
+    if (node == NO_NODE)
+      return;
+  }
+
+  StackNode *n = &tracker->nodes[node];
+  n->time = tracker->clock;
+  n->priority = mix((unsigned long)tracker->clock);
+  n->left = n->right = NO_NODE;
+  n->size = 1;
+  tracker->root = merge(tracker, tracker->root, node);
+}
+
+bool configureMrc(double rate) {
+  if (!(rate > 0.0) || rate > 1.0)
+    return false;
+  resetTracker(&globalTracker, -1);
+  for (int i = 0; i < trackerCount; i++)
+    resetTracker(&processTrackers[i], -1);
+  trackerCount = 0;
+  samplingRate = rate;
+  samplingThreshold = (unsigned long)(rate * MRC_SHARDS_MODULUS);
+  enabled = true;
+  return true;
+}
+
+// Flujo de un proceso (-1: el global); NULL si no tiene ni caben más
+static StackTracker *findTracker(int processId, bool create) {
+  if (processId < 0)
+    return &globalTracker;
+  for (int i = 0; i < trackerCount; i++) {
+    if (processTrackers[i].stats.processId == processId)
+      return &processTrackers[i];
+  }
+  if (!create || trackerCount == MRC_MAX_PROCESSES)
+    return NULL;
+  StackTracker *tracker = &processTrackers[trackerCount++];
+  resetTracker(tracker, processId);
+  return tracker;
+}
+
+void mrcRecordReference(int processId, const Page *page) {
+  if (!enabled)
+    return;
+  int key = page->sharedAnchor != NULL ? page->sharedAnchor->id : page->id;
+  StackTracker *tracker = findTracker(processId, true);
+  globalTracker.stats.references++;
+  if (tracker != NULL)
+    tracker->stats.references++;
+
+  // Muestreo espacial: la misma página entra o no en todos los flujos
+  if (mix((unsigned long)key) % MRC_SHARDS_MODULUS >= samplingThreshold)
+    return;
+  trackReference(&globalTracker, key);
+  if (tracker != NULL)
+    trackReference(tracker, key);
+}
+
+// Tasa de fallos de las estadísticas de un flujo
+static double missRatio(const MrcStatistics *stats, int frames) {
+  if (stats->sampled == 0 || frames < 1 || frames > MRC_CURVE_FRAMES)
+    return -1.0;
+  long hits = 0;
+  for (int d = 0; d < frames; d++)
+    hits += stats->shortDistances[d];
+  return (double)(stats->sampled - hits) / stats->sampled;
+}
+
+double mrcMissRatio(int processId, int frames) {
+  StackTracker *tracker = findTracker(processId, false);
+  return tracker != NULL ? missRatio(&tracker->stats, frames) : -1.0;
+}
+
+MrcStatistics getMrcStatistics(int processId) {
+  StackTracker *tracker = findTracker(processId, false);
+  MrcStatistics empty = {processId, 0, 0, 0, {0}, {0}};
+  return tracker != NULL ? tracker->stats : empty;
+}
+
+// Mostrar el resumen, el histograma y la curva de un flujo
+static void displayStream(const MrcStatistics *stats) {
+  char label[32], buffer[256];
+  if (stats->processId < 0)
+    snprintf(label, sizeof(label), "global");
+  else
+    snprintf(label, sizeof(label), "Proceso %d", stats->processId);
+
+  snprintf(buffer, sizeof(buffer),
+           "MRC %s: %ld referencias, %ld muestreadas (tasa %.3f), %ld "
+           "fallos fríos",
+           label, stats->references, stats->sampled, samplingRate,
+           stats->coldMisses);
+  logMessage(buffer);
+
+  int last = MRC_DISTANCE_BUCKETS - 1;
+  while (last > 0 && stats->histogram[last] == 0)
+    last--;
+  int length = snprintf(buffer, sizeof(buffer),
+                        "MRC %s: distancias de reuso (desde:referencias)",
+                        label);
+  for (int b = 0; b <= last && length < (int)sizeof(buffer); b++)
+    length += snprintf(buffer + length, sizeof(buffer) - length, " %ld:%ld",
+                       1L << b, stats->histogram[b]);
+  logMessage(buffer);
+
+  length = snprintf(buffer, sizeof(buffer),
+                    "MRC %s: tasa de fallos por marcos", label);
+  for (int frames = 1;
+       frames <= MRC_CURVE_FRAMES && length < (int)sizeof(buffer); frames++)
+    length += snprintf(buffer + length, sizeof(buffer) - length, " %d:%.2f",
+                       frames, missRatio(stats, frames));
+  logMessage(buffer);
+}
+
+void displayMrcStatistics() {
+  if (!enabled || globalTracker.stats.references == 0)
+    return;
+  displayStream(&globalTracker.stats);
+  for (int i = 0; i < trackerCount; i++)
+    displayStream(&processTrackers[i].stats);
+}
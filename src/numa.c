@@ -0,0 +1,328 @@
+#include "numa.h"
+#include "memory.h"
+#include <stdio.h>
+#include <string.h>
+
+// Topología y estado de la planificación NUMA
+static NumaNode nodes[MAX_NUMA_NODES];
+static int nodeCount = 0;
+static int totalCpus = 0;
+static int cpuProcesses[MAX_NUMA_CPUS]; // Procesos asignados a cada CPU
+static int activeCpu = 0;               // CPU del último quantum
+static int localLatency = NUMA_LOCAL_LATENCY;
+static int remoteLatency = NUMA_REMOTE_LATENCY;
+static int slowLatency = NUMA_SLOW_LATENCY;
+static int migrationCost = NUMA_MIGRATION_COST;
+static bool balancingEnabled = NUMA_BALANCING;
+static NumaStatistics numaStats;
+
+bool configureNumaTopology(int numNodes, int cpusPerNode, int local,
+                           int remote, int cost, bool balancing) {
+  if (numNodes < 1 || numNodes > MAX_NUMA_NODES || numNodes > NUM_FRAMES ||
+      cpusPerNode < 1 || numNodes * cpusPerNode > MAX_NUMA_CPUS ||
+      local < 0 || remote < local || cost < 0)
+    return false;
+
+  // Cada nodo recibe un rango contiguo de marcos (el último, el resto)
+  memset(nodes, 0, sizeof(nodes));
+  for (int n = 0; n < numNodes; n++) {
+    nodes[n].firstFrame = n * (NUM_FRAMES / numNodes);
+    nodes[n].numFrames = n < numNodes - 1
+                             ? NUM_FRAMES / numNodes
+                             : NUM_FRAMES - nodes[n].firstFrame;
+    nodes[n].firstCpu = n * cpusPerNode;
+    nodes[n].numCpus = cpusPerNode;
+  }
+  nodeCount = numNodes;
+  totalCpus = numNodes * cpusPerNode;
+  slowLatency = NUMA_SLOW_LATENCY;
+  memset(cpuProcesses, 0, sizeof(cpuProcesses));
+  activeCpu = 0;
+  localLatency = local;
+  remoteLatency = remote;
+  migrationCost = cost;
+  balancingEnabled = balancing;
+  memset(&numaStats, 0, sizeof(numaStats));
+  return true;
+}
+
+// Aplicar la topología por defecto si no se configuró ninguna
+static void ensureTopology() {
+  if (nodeCount == 0)
+    configureNumaTopology(NUMA_NODES, NUMA_CPUS_PER_NODE, NUMA_LOCAL_LATENCY,
+                          NUMA_REMOTE_LATENCY, NUMA_MIGRATION_COST,
+                          NUMA_BALANCING);
+}
+
+bool configureSlowTier(int frames, int latency) {
+  ensureTopology();
+  NumaNode *last = &nodes[nodeCount - 1];
+  if (nodeCount == MAX_NUMA_NODES || last->tier == MEMORY_TIER_SLOW ||
+      frames < 1 || frames >= last->numFrames || latency < localLatency)
+    return false;
+
+  // El nodo lento toma los marcos finales del último nodo
+  NumaNode *slow = &nodes[nodeCount++];
+  last->numFrames -= frames;
+  memset(slow, 0, sizeof(NumaNode));
+  slow->firstFrame = last->firstFrame + last->numFrames;
+  slow->numFrames = frames;
+  slow->firstCpu = totalCpus;
+  slow->tier = MEMORY_TIER_SLOW;
+  slowLatency = latency;
+  return true;
+}
+
+int numaNodeCount() {
+  ensureTopology();
+  return nodeCount;
+}
+
+int numaCpuCount() {
+  ensureTopology();
+  return totalCpus;
+}
+
+MemoryTier numaNodeTier(int node) {
+  ensureTopology();
+  return nodes[node].tier;
+}
+
+int numaFallbackNode(int node, int i) {
+  ensureTopology();
+  MemoryTier tier = nodes[node].tier;
+  int same = 0;
+  for (int n = 0; n < nodeCount; n++)
+    same += nodes[n].tier == tier;
+  // Rotar desde node entre los nodos de su nivel y seguir por los demás
+  int rank = i < same ? i : i - same;
+  for (int k = 0; k < nodeCount; k++) {
+    int n = (node + k) % nodeCount;
+    if ((nodes[n].tier == tier) == (i < same) && rank-- == 0)
+      return n;
+  }
+  return node;
+}
+
+void numaNodeFrames(int node, int *firstFrame, int *numFrames) {
+  ensureTopology();
+  *firstFrame = nodes[node].firstFrame;
+  *numFrames = nodes[node].numFrames;
+}
+
+int numaNodeOfFrame(int frame) {
+  ensureTopology();
+  int node = nodeCount - 1;
+  while (node > 0 && frame < nodes[node].firstFrame)
+    node--;
+  return node;
+}
+
+// Nodo de una CPU
+static int nodeOfCpu(int cpu) {
+  int node = nodeCount - 1;
+  while (node > 0 && cpu < nodes[node].firstCpu)
+    node--;
+  return node;
+}
+
+int numaProcessNode(const Process *process) {
+  ensureTopology();
+  return nodeOfCpu(process != NULL && process->cpu != NO_CPU ? process->cpu
+                                                              : activeCpu);
+}
+
+// Nodo de la política bind, acotado a la topología configurada
+static int boundNode(const Process *process) {
+  return process->numaNode >= 0 && process->numaNode < nodeCount
+             ? process->numaNode
+             : 0;
+}
+
+int numaPlacementNode(const Process *process, unsigned long pageNumber,
+                      bool *fallback) {
+  ensureTopology();
+  *fallback = true;
+  if (process == NULL)
+    return nodeOfCpu(activeCpu);
+
+  switch (process->numaPolicy) {
+  case NUMA_POLICY_INTERLEAVE:
+    return (int)(pageNumber % (unsigned long)nodeCount);
+  case NUMA_POLICY_BIND:
+    *fallback = false;
+    return boundNode(process);
+  default:
+    return numaProcessNode(process);
+  }
+}
+
+bool numaBalancingAllowed(const Process *process) {
+  // Las páginas repartidas o ligadas a un nodo están donde la política
+  // quiere
+  return balancingEnabled && nodeCount > 1 &&
+         process->numaPolicy == NUMA_POLICY_FIRST_TOUCH;
+}
+
+void numaRecordAccess(int cpuNode, int memoryNode) {
+  if (cpuNode == memoryNode) {
+    nodes[cpuNode].localAccesses++;
+    numaStats.accessLatency += localLatency;
+  } else {
+    nodes[cpuNode].remoteAccesses++;
+    numaStats.accessLatency += nodes[memoryNode].tier == MEMORY_TIER_SLOW
+                                   ? slowLatency
+                                   : remoteLatency;
+  }
+  numaStats.accesses++;
+}
+
+void numaRecordAllocation(int preferredNode, int actualNode) {
+  if (preferredNode == actualNode)
+    nodes[actualNode].localAllocations++;
+  else
+    nodes[preferredNode].foreignAllocations++;
+}
+
+void numaRecordMigration(int fromNode, int toNode) {
+  nodes[fromNode].pagesMigratedOut++;
+  nodes[toNode].pagesMigratedIn++;
+  numaStats.pageMigrations++;
+}
+
+// CPU con menos procesos asignados de un nodo (NUMA_ANY_NODE: de todos)
+static int leastLoadedCpu(int node) {
+  int first = node == NUMA_ANY_NODE ? 0 : nodes[node].firstCpu;
+  int count = node == NUMA_ANY_NODE ? totalCpus : nodes[node].numCpus;
+  int best = first;
+
+  for (int cpu = first + 1; cpu < first + count; cpu++) {
+    if (cpuProcesses[cpu] < cpuProcesses[best])
+      best = cpu;
+  }
+  return best;
+}
+
+// Nodo donde debería ejecutarse el proceso: el de la política bind o,
+// con balanceo, el que guarda claramente la mayor parte de su memoria (la
+// memoria repartida no atrae al proceso a ningún nodo)
+static int preferredNode(const Process *process, int currentNode) {
+  int frames[MAX_NUMA_NODES];
+  int best = currentNode;
+
+  if (process->numaPolicy == NUMA_POLICY_BIND)
+    return nodes[boundNode(process)].numCpus > 0 ? boundNode(process)
+                                                 : currentNode;
+  if (!numaBalancingAllowed(process))
+    return currentNode;
+
+  // Exigir el doble de marcos evita que el proceso rebote entre nodos; la
+  // memoria lenta no tiene CPUs que ofrecerle
+  processNodeFrames(process, frames);
+  for (int n = 0; n < nodeCount; n++) {
+    if (nodes[n].numCpus > 0 && frames[n] > frames[best])
+      best = n;
+  }
+  return frames[best] > 2 * frames[currentNode] ? best : currentNode;
+}
+
+int numaScheduleProcess(Process *process, SimTime currentTime) {
+  char buffer[256];
+  ensureTopology();
+
+  // Primer quantum: la CPU menos cargada (del nodo ligado si lo hay y
+  // tiene CPUs)
+  if (process->cpu == NO_CPU) {
+    bool bound = process->numaPolicy == NUMA_POLICY_BIND &&
+                 nodes[boundNode(process)].numCpus > 0;
+    process->cpu =
+        leastLoadedCpu(bound ? boundNode(process) : NUMA_ANY_NODE);
+    cpuProcesses[process->cpu]++;
+    activeCpu = process->cpu;
+    return 0;
+  }
+
+  // Afinidad: el proceso sigue en su CPU salvo que deba cambiar de nodo
+  int fromNode = nodeOfCpu(process->cpu);
+  int toNode = preferredNode(process, fromNode);
+  if (toNode == fromNode) {
+    activeCpu = process->cpu;
+    return 0;
+  }
+
+  int fromCpu = process->cpu;
+  cpuProcesses[fromCpu]--;
+  process->cpu = leastLoadedCpu(toNode);
+  cpuProcesses[process->cpu]++;
+  activeCpu = process->cpu;
+  numaStats.taskMigrations++;
+  numaStats.migrationTime += migrationCost;
+
+  snprintf(buffer, sizeof(buffer),
+           "NUMA: Proceso %d migrado de la CPU %d (nodo %d) a la CPU %d "
+           "(nodo %d), coste %d (Tiempo: %lld)",
+           process->id, fromCpu, fromNode, process->cpu, toNode,
+           migrationCost, currentTime);
+  logMessage(buffer);
+  return migrationCost;
+}
+
+void numaReleaseProcess(Process *process) {
+  if (process->cpu != NO_CPU && process->cpu < totalCpus)
+    cpuProcesses[process->cpu]--;
+  process->cpu = NO_CPU;
+}
+
+void numaRestoreCpu(Process *process, int cpu) {
+  ensureTopology();
+  process->cpu = cpu >= 0 && cpu < totalCpus ? cpu : NO_CPU;
+  if (process->cpu != NO_CPU)
+    cpuProcesses[process->cpu]++;
+}
+
+NumaStatistics getNumaStatistics() { return numaStats; }
+
+void displayNumaStatistics() {
+  char buffer[256];
+  ensureTopology();
+
+  snprintf(buffer, sizeof(buffer),
+           "NUMA: %d nodos, %d CPUs, latencia local %d ns, remota %d ns",
+           nodeCount, totalCpus, localLatency, remoteLatency);
+  logMessage(buffer);
+  for (int n = 0; n < nodeCount; n++) {
+    NumaNode *node = &nodes[n];
+    long accesses = node->localAccesses + node->remoteAccesses;
+    if (node->tier == MEMORY_TIER_SLOW)
+      snprintf(buffer, sizeof(buffer),
+               "Nodo %d: marcos %d-%d (%d libres), memoria lenta sin CPUs, "
+               "latencia %d ns",
+               n, node->firstFrame, node->firstFrame + node->numFrames - 1,
+               freeFramesOnNode(n), slowLatency);
+    else
+      snprintf(buffer, sizeof(buffer),
+               "Nodo %d: marcos %d-%d (%d libres), CPUs %d-%d, %ld accesos "
+               "locales, %ld remotos (localidad %.2f)",
+               n, node->firstFrame, node->firstFrame + node->numFrames - 1,
+               freeFramesOnNode(n), node->firstCpu,
+               node->firstCpu + node->numCpus - 1, node->localAccesses,
+               node->remoteAccesses,
+               accesses > 0 ? (double)node->localAccesses / accesses : 0.0);
+    logMessage(buffer);
+    snprintf(buffer, sizeof(buffer),
+             "Nodo %d: %ld bloques ubicados, %ld desviados a otro nodo, %ld "
+             "páginas migradas hacia el nodo, %ld desde el nodo",
+             n, node->localAllocations, node->foreignAllocations,
+             node->pagesMigratedIn, node->pagesMigratedOut);
+    logMessage(buffer);
+  }
+  snprintf(buffer, sizeof(buffer),
+           "NUMA: latencia media %.1f ns, %ld páginas migradas, %ld cambios "
+           "de nodo de procesos (tiempo perdido %lld)",
+           numaStats.accesses > 0
+               ? (double)numaStats.accessLatency / numaStats.accesses
+               : 0.0,
+           numaStats.pageMigrations, numaStats.taskMigrations,
+           numaStats.migrationTime);
+  logMessage(buffer);
+}
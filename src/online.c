@@ -0,0 +1,692 @@
+#include "online.h"
+#include "memory.h"
+#include "numa.h"
+#include "scheduler.h"
+#include "simclock.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Mensaje recibido por un hilo de lectura
+typedef enum {
+  ONLINE_LINE = 0, // Una línea JSON
+  ONLINE_CLOSE = 1 // El cliente cerró la conexión
+} OnlineMessageKind;
+
+typedef struct OnlineMessage {
+  struct OnlineMessage *_Atomic next; // Siguiente mensaje de la cola
+  OnlineMessageKind kind;
+  int replyFd;                   // Descriptor para responder al cliente
+  char line[ONLINE_LINE_LENGTH]; // Contenido (ONLINE_LINE)
+} OnlineMessage;
+
+// Hilo de lectura de un cliente
+typedef struct {
+  int readFd;           // Descriptor del que lee
+  int replyFd;          // Descriptor de respuesta
+  pthread_t thread;     // Hilo lector
+  bool used;            // El hueco tiene un hilo creado
+  atomic_bool finished; // El hilo terminó (se puede reutilizar el hueco)
+} OnlineReader;
+
+// Proceso admitido en línea y su demanda total (para la espera)
+typedef struct {
+  Process *process;
+  int replyFd;   // Cliente que lo envió (-1 si ya se desconectó)
+  SimTime cpuDemand; // CPU total pedida
+  SimTime ioDemand;  // E/S total pedida
+} OnlineProcess;
+
+// Cola MPSC intrusiva (Vyukov): los productores encadenan con un único
+// intercambio atómico sobre la cabeza y el consumidor avanza por la cola
+// sin bloqueos; el nodo stub evita el caso de la cola vacía
+static OnlineMessage stub;
+static OnlineMessage *_Atomic queueHead = &stub; // Último mensaje encolado
+static OnlineMessage *queueTail = &stub;         // Siguiente a consumir
+
+static OnlineReader readers[ONLINE_MAX_CLIENTS];
+static pthread_t listenerThread;
+static int listenFd = -1;
+static char socketFile[sizeof(((struct sockaddr_un *)0)->sun_path)];
+static atomic_int openReaders = 0; // Hilos que aún pueden encolar
+static atomic_bool stopping = false;
+static bool sessionActive = false;
+static bool endRequested = false;
+static OnlineProcess admitted[MAX_PROCESSES];
+static int admittedCount = 0;
+static OnlineStatistics onlineStats;
+
+// Encolar un mensaje (cualquier hilo)
+static void pushMessage(OnlineMessage *message) {
+  atomic_store(&message->next, NULL);
+  OnlineMessage *previous = atomic_exchange(&queueHead, message);
+  atomic_store(&previous->next, message);
+}
+
+// Desencolar un mensaje (solo el bucle de eventos); NULL si la cola está
+// vacía o un productor aún no terminó de encadenar el suyo
+static OnlineMessage *popMessage() {
+  OnlineMessage *tail = queueTail;
+  OnlineMessage *next = atomic_load(&tail->next);
+
+  if (tail == &stub) {
+    if (next == NULL)
+      return NULL;
+    queueTail = next;
+    tail = next;
+    next = atomic_load(&tail->next);
+  }
+  if (next != NULL) {
+    queueTail = next;
+    return tail;
+  }
+  if (tail != atomic_load(&queueHead))
+    return NULL;
+
+  // Último mensaje: reencolar el stub para poder soltarlo
+  pushMessage(&stub);
+  next = atomic_load(&tail->next);
+  if (next == NULL)
+    return NULL;
+  queueTail = next;
+  return tail;
+}
+
+// Hay mensajes encolados (solo el bucle de eventos)
+static bool messagesPending() {
+  return queueTail != &stub || atomic_load(&stub.next) != NULL;
+}
+
+static void pushLine(int replyFd, OnlineMessageKind kind, const char *line) {
+  OnlineMessage *message = malloc(sizeof(OnlineMessage));
+  if (message == NULL)
+    return;
+  message->kind = kind;
+  message->replyFd = replyFd;
+  snprintf(message->line, sizeof(message->line), "%s", line);
+  pushMessage(message);
+}
+
+// Leer líneas de un cliente hasta que cierre o se detenga el modo en línea
+static void *readerMain(void *argument) {
+  OnlineReader *reader = argument;
+  char line[ONLINE_LINE_LENGTH];
+  size_t length = 0;
+
+  while (!atomic_load(&stopping)) {
+    struct pollfd descriptor = {reader->readFd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, ONLINE_POLL_MS);
+    if (ready < 0 && errno != EINTR)
+      break;
+    if (ready <= 0)
+      continue;
+
+    char chunk[256];
+    ssize_t received = read(reader->readFd, chunk, sizeof(chunk));
+    if (received <= 0)
+      break;
+    for (ssize_t i = 0; i < received; i++) {
+      if (chunk[i] == '\n') {
+        line[length] = '\0';
+        if (length > 0)
+          pushLine(reader->replyFd, ONLINE_LINE, line);
+        length = 0;
+      } else if (length < sizeof(line) - 1) {
+        line[length++] = chunk[i]; // Las líneas largas se truncan
+      }
+    }
+  }
+  if (length > 0) {
+    line[length] = '\0';
+    pushLine(reader->replyFd, ONLINE_LINE, line);
+  }
+  if (reader->readFd != STDIN_FILENO)
+    close(reader->readFd);
+  pushLine(reader->replyFd, ONLINE_CLOSE, "");
+  atomic_fetch_sub(&openReaders, 1);
+  atomic_store(&reader->finished, true);
+  return NULL;
+}
+
+// Hueco libre para un lector (recoge los hilos ya terminados)
+static OnlineReader *freeReader() {
+  for (int i = 0; i < ONLINE_MAX_CLIENTS; i++) {
+    OnlineReader *reader = &readers[i];
+    if (reader->used && atomic_load(&reader->finished)) {
+      pthread_join(reader->thread, NULL);
+      reader->used = false;
+    }
+    if (!reader->used)
+      return reader;
+  }
+  return NULL;
+}
+
+static bool startReader(OnlineReader *reader, int readFd, int replyFd) {
+  reader->readFd = readFd;
+  reader->replyFd = replyFd;
+  atomic_store(&reader->finished, false);
+  atomic_fetch_add(&openReaders, 1);
+  reader->used =
+      pthread_create(&reader->thread, NULL, readerMain, reader) == 0;
+  if (!reader->used)
+    atomic_fetch_sub(&openReaders, 1);
+  return reader->used;
+}
+
+// Aceptar conexiones al socket; cada cliente tiene su propio lector
+static void *listenerMain(void *argument) {
+  (void)argument;
+  while (!atomic_load(&stopping)) {
+    struct pollfd descriptor = {listenFd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, ONLINE_POLL_MS);
+    if (ready < 0 && errno != EINTR)
+      break;
+    if (ready <= 0)
+      continue;
+
+    int client = accept(listenFd, NULL, NULL);
+    if (client < 0)
+      continue;
+    // El lector usa una copia del descriptor; el original se cierra al
+    // consumir su ONLINE_CLOSE, cuando ya no quedan respuestas pendientes
+    OnlineReader *reader = freeReader();
+    int readFd = reader != NULL ? dup(client) : -1;
+    if (readFd < 0 || !startReader(reader, readFd, client)) {
+      static const char busy[] =
+          "{\"event\":\"error\",\"message\":\"demasiados clientes\"}\n";
+      send(client, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+      if (readFd >= 0)
+        close(readFd);
+      close(client);
+    }
+  }
+  atomic_fetch_sub(&openReaders, 1);
+  return NULL;
+}
+
+bool startOnlineIngest(const char *socketPath) {
+  if (sessionActive)
+    return false;
+  atomic_store(&stub.next, NULL);
+  atomic_store(&queueHead, &stub);
+  queueTail = &stub;
+  memset(readers, 0, sizeof(readers));
+  memset(&onlineStats, 0, sizeof(onlineStats));
+  admittedCount = 0;
+  endRequested = false;
+  atomic_store(&stopping, false);
+  atomic_store(&openReaders, 0);
+
+  if (socketPath == NULL) {
+    // Entrada estándar: las respuestas van a la salida estándar
+    sessionActive = startReader(&readers[0], STDIN_FILENO, STDOUT_FILENO);
+    return sessionActive;
+  }
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(socketPath) >= sizeof(address.sun_path))
+    return false;
+  strcpy(address.sun_path, socketPath);
+  listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(socketPath);
+  if (listenFd < 0 ||
+      bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+      listen(listenFd, ONLINE_MAX_CLIENTS) != 0) {
+    if (listenFd >= 0)
+      close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  snprintf(socketFile, sizeof(socketFile), "%s", socketPath);
+
+  // El hilo que acepta conexiones mantiene el flujo abierto hasta "end"
+  atomic_store(&openReaders, 1);
+  if (pthread_create(&listenerThread, NULL, listenerMain, NULL) != 0) {
+    close(listenFd);
+    unlink(socketFile);
+    listenFd = -1;
+    return false;
+  }
+  sessionActive = true;
+  return true;
+}
+
+// Responder a un cliente con una línea JSON
+static void reply(int replyFd, const char *json) {
+  if (replyFd == STDOUT_FILENO) {
+    printf("%s\n", json);
+    fflush(stdout);
+  } else if (replyFd >= 0) {
+    char line[ONLINE_LINE_LENGTH + 1];
+    int length = snprintf(line, sizeof(line), "%s\n", json);
+    send(replyFd, line, length, MSG_NOSIGNAL);
+  }
+}
+
+static void replyError(int replyFd, const char *message) {
+  char json[ONLINE_LINE_LENGTH];
+  snprintf(json, sizeof(json), "{\"event\":\"error\",\"message\":\"%s\"}",
+           message);
+  reply(replyFd, json);
+}
+
+// Valor de una clave de un objeto JSON plano (NULL si no aparece)
+static const char *jsonValue(const char *line, const char *key) {
+  char pattern[32];
+  snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+  const char *value = strstr(line, pattern);
+  if (value == NULL)
+    return NULL;
+  value += strlen(pattern);
+  value += strspn(value, " \t");
+  if (*value != ':')
+    return NULL;
+  value++;
+  return value + strspn(value, " \t");
+}
+
+static bool jsonInt(const char *line, const char *key, long long *number) {
+  const char *value = jsonValue(line, key);
+  char *end;
+  if (value == NULL)
+    return false;
+  *number = strtoll(value, &end, 10);
+  return end != value;
+}
+
+static bool jsonString(const char *line, const char *key, char *text,
+                       size_t size) {
+  const char *value = jsonValue(line, key);
+  size_t length = 0;
+  if (value == NULL || *value != '"')
+    return false;
+  for (value++; *value != '\0' && *value != '"' && length + 1 < size; value++)
+    text[length++] = *value;
+  text[length] = '\0';
+  return *value == '"';
+}
+
+// Leer un arreglo de tiempos; devuelve sus elementos, 0 si la clave no
+// aparece o -1 si está mal formado o tiene más de max elementos
+static int jsonIntArray(const char *line, const char *key, SimTime *numbers,
+                        int max) {
+  const char *value = jsonValue(line, key);
+  int count = 0;
+  if (value == NULL)
+    return 0;
+  if (*value != '[')
+    return -1;
+  value++;
+  while (true) {
+    value += strspn(value, " \t");
+    if (*value == ']')
+      return count;
+    char *end;
+    long long number = strtoll(value, &end, 10);
+    if (end == value || count == max)
+      return -1;
+    numbers[count++] = number;
+    value = end + strspn(end, " \t");
+    if (*value == ',')
+      value++;
+    else if (*value != ']')
+      return -1;
+  }
+}
+
+// CPU que le queda a un proceso
+static SimTime remainingCpu(const Process *process) {
+  SimTime remaining = 0;
+  for (int b = process->burstIndex; b < process->totalBursts; b++)
+    remaining += process->cpuBurstTimes[b] > 0 ? process->cpuBurstTimes[b] : 0;
+  return remaining;
+}
+
+// Proyección con reparto de CPU (sin E/S): la espera es una vuelta de Round
+// Robin por los demás procesos activos y la finalización suma, de cada uno,
+// la CPU que consumirá mientras el proceso agota la suya
+static void project(const char *event, const Process *target, SimTime demand,
+                    SimTime currentTime, char *json, size_t size) {
+  Process **queue = getProcessQueue();
+  int count = *getProcessCount();
+  int active = 0, demandPages = 0, freeFrames = 0;
+  SimTime wait = 0, completion = currentTime + demand;
+
+  for (int i = 0; i < count; i++) {
+    const Process *process = queue[i];
+    if (process->state == TERMINATED)
+      continue;
+    active++;
+    demandPages += process->totalPages +
+                   (process->sharedRegion != NULL
+                        ? process->sharedRegion->totalPages
+                        : 0);
+    if (process == target)
+      continue;
+    SimTime slice = process->cpuBurstTimes[process->burstIndex];
+    SimTime remaining = remainingCpu(process);
+    wait += slice < QUANTUM ? slice : QUANTUM;
+    completion += remaining < demand ? remaining : demand;
+  }
+  // Un proceso que ya recibió CPU no espera su primer quantum
+  if (target != NULL && target->cpu != NO_CPU)
+    wait = 0;
+  for (int n = 0; n < numaNodeCount(); n++)
+    freeFrames += freeFramesOnNode(n);
+
+  int written = snprintf(json, size, "{\"event\":\"%s\",\"time\":%lld",
+                         event, currentTime);
+  if (target != NULL)
+    written += snprintf(json + written, size - written, ",\"id\":%d",
+                        target->id);
+  snprintf(json + written, size - written,
+           ",\"active\":%d,\"wait\":%lld,\"completion\":%lld,"
+           "\"free_frames\":%d,\"demand_pages\":%d,\"pressure\":%.2f}",
+           active, wait, completion, freeFrames, demandPages,
+           (double)demandPages / NUM_FRAMES);
+}
+
+static OnlineProcess *findAdmitted(const Process *process) {
+  for (int i = 0; i < admittedCount; i++) {
+    if (admitted[i].process == process)
+      return &admitted[i];
+  }
+  return NULL;
+}
+
+static Process *findQueued(int id) {
+  Process **queue = getProcessQueue();
+  for (int i = 0; i < *getProcessCount(); i++) {
+    if (queue[i]->id == id && queue[i]->state != TERMINATED)
+      return queue[i];
+  }
+  return NULL;
+}
+
+static void answerQuery(const char *line, int replyFd, SimTime currentTime) {
+  char json[ONLINE_LINE_LENGTH];
+  SimTime cpu[ONLINE_MAX_BURSTS];
+  long long id;
+
+  onlineStats.queries++;
+  if (jsonInt(line, "id", &id)) {
+    Process *process = findQueued((int)id);
+    if (process == NULL) {
+      replyError(replyFd, "proceso desconocido o terminado");
+      return;
+    }
+    project("projection", process, remainingCpu(process), currentTime, json,
+            sizeof(json));
+  } else {
+    int bursts = jsonIntArray(line, "cpu", cpu, ONLINE_MAX_BURSTS);
+    SimTime demand = bursts > 0 ? 0 : QUANTUM;
+    for (int b = 0; b < bursts; b++)
+      demand += cpu[b] > 0 ? cpu[b] : 0;
+    if (bursts < 0) {
+      replyError(replyFd, "ráfagas de CPU inválidas");
+      return;
+    }
+    project("projection", NULL, demand, currentTime, json, sizeof(json));
+  }
+  reply(replyFd, json);
+}
+
+// Validar una llegada y crear su proceso; NULL (con el motivo) si no es
+// válida
+static Process *createArrival(const char *line, SimTime currentTime,
+                              const char **reason, SimTime *ioDemand) {
+  SimTime cpu[ONLINE_MAX_BURSTS], io[ONLINE_MAX_BURSTS];
+  long long id, start = currentTime, priority = INTERACTIVE_PRIORITY;
+  long long pages = 1, written = 0;
+  int cpuBursts = jsonIntArray(line, "cpu", cpu, ONLINE_MAX_BURSTS);
+  int ioBursts = jsonIntArray(line, "io", io, ONLINE_MAX_BURSTS);
+
+  jsonInt(line, "start", &start);
+  jsonInt(line, "priority", &priority);
+  jsonInt(line, "pages", &pages);
+  jsonInt(line, "written", &written);
+  *reason = NULL;
+  if (!jsonInt(line, "id", &id) || id < 0)
+    *reason = "falta el identificador";
+  else if (findQueued((int)id) != NULL)
+    *reason = "identificador en uso";
+  else if (cpuBursts <= 0 || (ioBursts != 0 && ioBursts != cpuBursts - 1))
+    *reason = "ráfagas inválidas (cpu: n, io: n-1)";
+  else if (priority < REAL_TIME_PRIORITY || priority > BACKGROUND_PRIORITY)
+    *reason = "prioridad inválida";
+  else if (pages < 1 || pages > NUM_FRAMES * 64 || written < 0 ||
+           written > pages)
+    *reason = "páginas inválidas";
+  for (int b = 0; *reason == NULL && b < cpuBursts; b++) {
+    if (cpu[b] <= 0 || (b < ioBursts && io[b] < 0))
+      *reason = "ráfagas inválidas (cpu: n, io: n-1)";
+  }
+  if (*reason != NULL)
+    return NULL;
+
+  Process *process = calloc(1, sizeof(Process));
+  if (process == NULL)
+    return NULL;
+  process->id = (int)id;
+  process->startTime = start > currentTime ? start : currentTime;
+  process->priority = (ProcessPriority)priority;
+  process->totalPages = (int)pages;
+  process->memorySize = (int)pages * PAGE_SIZE;
+  process->writtenPages = (int)written;
+  process->totalBursts = cpuBursts;
+  process->cpuBurstTimes = malloc(cpuBursts * sizeof(SimTime));
+  process->ioBurstTimes = calloc(cpuBursts, sizeof(SimTime));
+  process->ownsBursts = true;
+  process->state = READY;
+  pthread_mutex_init(&process->processMutex, NULL);
+  if (process->cpuBurstTimes == NULL || process->ioBurstTimes == NULL ||
+      !initializeProcessPages(process)) {
+    releaseProcessPages(process);
+    free(process);
+    *reason = "sin memoria";
+    return NULL;
+  }
+  *ioDemand = 0;
+  for (int b = 0; b < cpuBursts; b++) {
+    process->cpuBurstTimes[b] = cpu[b];
+    if (b < ioBursts) {
+      process->ioBurstTimes[b] = io[b];
+      *ioDemand += io[b];
+    }
+  }
+  return process;
+}
+
+// Admitir una llegada; devuelve 1 si el proceso entró en la cola
+static int admitArrival(const char *line, int replyFd, SimTime currentTime) {
+  char buffer[256], json[ONLINE_LINE_LENGTH];
+  const char *reason;
+  SimTime ioDemand = 0;
+  Process *process = createArrival(line, currentTime, &reason, &ioDemand);
+
+  if (process != NULL && (admittedCount == MAX_PROCESSES ||
+                          addProcessToQueue(process) < 0)) {
+    releaseProcessPages(process);
+    free(process);
+    process = NULL;
+    reason = "cola de procesos llena";
+  }
+  if (process == NULL) {
+    onlineStats.rejected++;
+    replyError(replyFd, reason != NULL ? reason : "sin memoria");
+    return 0;
+  }
+
+  OnlineProcess *entry = &admitted[admittedCount++];
+  entry->process = process;
+  entry->replyFd = replyFd;
+  entry->cpuDemand = remainingCpu(process);
+  entry->ioDemand = ioDemand;
+  onlineStats.arrivals++;
+  snprintf(buffer, sizeof(buffer),
+           "En línea: Proceso %d admitido para el tiempo %lld (%d ráfagas, %d "
+           "páginas, Tiempo: %lld)",
+           process->id, process->startTime, process->totalBursts,
+           process->totalPages, currentTime);
+  logMessage(buffer);
+
+  // La respuesta incluye ya su proyección
+  project("admitted", process, entry->cpuDemand, currentTime, json,
+          sizeof(json));
+  reply(replyFd, json);
+  return 1;
+}
+
+// Atender un mensaje; devuelve los procesos admitidos
+static int handleMessage(const OnlineMessage *message, SimTime currentTime) {
+  char type[16];
+
+  // Al cerrarse la entrada estándar la salida sigue abierta; un socket
+  // cerrado deja sin destino las métricas pendientes de su cliente
+  if (message->kind == ONLINE_CLOSE) {
+    if (message->replyFd == STDOUT_FILENO)
+      return 0;
+    for (int i = 0; i < admittedCount; i++) {
+      if (admitted[i].replyFd == message->replyFd)
+        admitted[i].replyFd = -1;
+    }
+    close(message->replyFd);
+    return 0;
+  }
+
+  onlineStats.messages++;
+  if (!jsonString(message->line, "type", type, sizeof(type))) {
+    replyError(message->replyFd, "mensaje sin tipo");
+    return 0;
+  }
+  if (strcmp(type, "arrival") == 0)
+    return admitArrival(message->line, message->replyFd, currentTime);
+  if (strcmp(type, "query") == 0) {
+    answerQuery(message->line, message->replyFd, currentTime);
+  } else if (strcmp(type, "end") == 0) {
+    endRequested = true;
+    logMessage("En línea: fin del flujo de llegadas");
+  } else {
+    replyError(message->replyFd, "tipo de mensaje desconocido");
+  }
+  return 0;
+}
+
+bool onlineStreamOpen() {
+  return sessionActive && !endRequested &&
+         (atomic_load(&openReaders) > 0 || messagesPending());
+}
+
+int onlineIngest(SimTime currentTime, bool wait) {
+  int admittedNow = 0;
+  while (sessionActive && !endRequested) {
+    OnlineMessage *message = popMessage();
+    if (message == NULL) {
+      // Sin procesos activos el reloj no avanza hasta la siguiente llegada
+      if (!wait || admittedNow > 0 || !onlineStreamOpen())
+        break;
+      usleep(ONLINE_IDLE_WAIT_US);
+      continue;
+    }
+    // En modo sincronizado cada mensaje llega en el tick de pared actual
+    admittedNow += handleMessage(message, simclockSync(currentTime));
+    free(message);
+  }
+  return admittedNow;
+}
+
+void onlineProcessCompleted(Process *process, SimTime currentTime) {
+  char buffer[256], json[ONLINE_LINE_LENGTH];
+  OnlineProcess *entry = findAdmitted(process);
+  if (entry == NULL)
+    return;
+
+  // La espera es lo que no explican ni la CPU ni la E/S pedidas
+  process->turnaroundTime = currentTime - process->startTime;
+  process->waitTime =
+      process->turnaroundTime - entry->cpuDemand - entry->ioDemand;
+  if (process->waitTime < 0)
+    process->waitTime = 0;
+  onlineStats.completed++;
+  accumulateTime(&onlineStats.turnaround, process->turnaroundTime);
+  accumulateTime(&onlineStats.wait, process->waitTime);
+
+  snprintf(buffer, sizeof(buffer),
+           "En línea: Proceso %d completado (retorno %lld, espera %lld, "
+           "respuesta %lld)",
+           process->id, process->turnaroundTime, process->waitTime,
+           process->responseTime);
+  logMessage(buffer);
+  snprintf(json, sizeof(json),
+           "{\"event\":\"completed\",\"id\":%d,\"time\":%lld,"
+           "\"turnaround\":%lld,\"wait\":%lld,\"response\":%lld}",
+           process->id, currentTime, process->turnaroundTime,
+           process->waitTime, process->responseTime);
+  reply(entry->replyFd, json);
+}
+
+bool onlineReleaseProcess(Process *process) {
+  OnlineProcess *entry = findAdmitted(process);
+  if (entry == NULL)
+    return false;
+  *entry = admitted[--admittedCount];
+  releaseProcessPages(process);
+  pthread_mutex_destroy(&process->processMutex);
+  free(process);
+  return true;
+}
+
+void stopOnlineIngest() {
+  if (!sessionActive)
+    return;
+  atomic_store(&stopping, true);
+  if (listenFd >= 0) {
+    pthread_join(listenerThread, NULL);
+    close(listenFd);
+    unlink(socketFile);
+    listenFd = -1;
+  }
+  for (int i = 0; i < ONLINE_MAX_CLIENTS; i++) {
+    if (readers[i].used)
+      pthread_join(readers[i].thread, NULL);
+    readers[i].used = false;
+  }
+
+  // Descartar lo que quedó sin consumir (cerrando las conexiones)
+  endRequested = false;
+  OnlineMessage *message;
+  while ((message = popMessage()) != NULL) {
+    if (message->kind == ONLINE_CLOSE)
+      handleMessage(message, getSchedulerClock());
+    free(message);
+  }
+  admittedCount = 0;
+  sessionActive = false;
+}
+
+OnlineStatistics getOnlineStatistics() { return onlineStats; }
+
+void displayOnlineStatistics() {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "En línea: %ld mensajes, %ld procesos admitidos, %ld rechazados, "
+           "%ld consultas",
+           onlineStats.messages, onlineStats.arrivals, onlineStats.rejected,
+           onlineStats.queries);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "En línea: %ld completados, retorno medio %.1f, espera media %.1f",
+           onlineStats.completed, accumulatorMean(&onlineStats.turnaround),
+           accumulatorMean(&onlineStats.wait));
+  logMessage(buffer);
+}
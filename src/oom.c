@@ -0,0 +1,218 @@
+#include "oom.h"
+#include "memory.h"
+#include "swap.h"
+#include <stdio.h>
+#include <string.h>
+
+// Proceso registrado en el índice de víctimas (por conjunto de marcos)
+typedef struct {
+  Process *process;    // Proceso (NULL si el conjunto está libre)
+  long committedPages; // Páginas que comprometió al registrarse
+  long score;          // Puntuación OOM (0: no elegible)
+  int heapIndex;       // Posición en el montículo de puntuaciones
+} OomEntry;
+
+static bool configured = false;
+static OvercommitPolicy policy = OOM_DEFAULT_POLICY;
+static int overcommitRatio = OOM_DEFAULT_RATIO;
+static bool killer = false;
+static OomEntry entries[MAX_PROCESSES];
+static int heap[MAX_PROCESSES]; // Montículo de máximos por puntuación
+static int heapSize = 0;
+static Process *victims[MAX_PROCESSES]; // Eliminados sin retirar
+static int victimCount = 0;
+static OomStatistics oomStats;
+
+bool configureOom(OvercommitPolicy newPolicy, int ratio, bool enableKiller) {
+  if (newPolicy < OVERCOMMIT_HEURISTIC || newPolicy > OVERCOMMIT_NEVER ||
+      ratio < 0)
+    return false;
+  policy = newPolicy;
+  overcommitRatio = ratio;
+  killer = enableKiller;
+  configured = true;
+  memset(entries, 0, sizeof(entries));
+  heapSize = victimCount = 0;
+  memset(&oomStats, 0, sizeof(oomStats));
+  return true;
+}
+
+bool oomKillerEnabled() { return killer; }
+
+// Puntuación de un proceso: la fracción de la RAM que ocupa (sobre
+// OOM_SCORE_SCALE), más su prioridad y su ajuste
+static long oomScore(const Process *process, int residentFrames) {
+  if (residentFrames == 0 || process->realTime != NULL ||
+      process->oomScoreAdj <= OOM_SCORE_ADJ_MIN)
+    return 0;
+  long score = (long)residentFrames * OOM_SCORE_SCALE / NUM_FRAMES +
+               (long)process->priority * OOM_PRIORITY_POINTS +
+               process->oomScoreAdj;
+  return score > 0 ? score : 1;
+}
+
+// Orden del montículo: mayor puntuación y, a igualdad, menor identificador
+static bool heapBefore(int a, int b) {
+  if (entries[a].score != entries[b].score)
+    return entries[a].score > entries[b].score;
+  return entries[a].process->id < entries[b].process->id;
+}
+
+static void heapPlace(int index, int set) {
+  heap[index] = set;
+  entries[set].heapIndex = index;
+}
+
+static void siftUp(int index) {
+  int set = heap[index];
+  while (index > 0 && heapBefore(set, heap[(index - 1) / 2])) {
+    heapPlace(index, heap[(index - 1) / 2]);
+    index = (index - 1) / 2;
+  }
+  heapPlace(index, set);
+}
+
+static void siftDown(int index) {
+  int set = heap[index];
+  for (;;) {
+    int child = 2 * index + 1;
+    if (child >= heapSize)
+      break;
+    if (child + 1 < heapSize && heapBefore(heap[child + 1], heap[child]))
+      child++;
+    if (!heapBefore(heap[child], set))
+      break;
+    heapPlace(index, heap[child]);
+    index = child;
+  }
+  heapPlace(index, set);
+}
+
+// Indica si la política admite comprometer pages páginas más (*limit es
+// el límite que se aplicó)
+static bool commitAllowed(long pages, long *limit) {
+  switch (policy) {
+  case OVERCOMMIT_NEVER:
+    *limit = (long)NUM_FRAMES * overcommitRatio / 100 + swapSlotCount();
+    return oomStats.committedPages + pages <= *limit;
+  case OVERCOMMIT_HEURISTIC:
+    // Solo se rechaza una petición que por sí sola no cabe
+    *limit = NUM_FRAMES + swapSlotCount();
+    return pages <= *limit;
+  default:
+    return true;
+  }
+}
+
+// Páginas que compromete un proceso
+static long commitPages(const Process *process) {
+  return (process->memorySize + PAGE_SIZE - 1) / PAGE_SIZE;
+}
+
+bool oomCommitProcess(int set, Process *process) {
+  char buffer[256];
+  long pages = commitPages(process);
+  long limit;
+
+  if (!commitAllowed(pages, &limit)) {
+    oomStats.refused++;
+    snprintf(buffer, sizeof(buffer),
+             "Overcommit: Proceso %d rechazado, compromete %ld páginas "
+             "(límite %ld, comprometidas %ld)",
+             process->id, pages, limit, oomStats.committedPages);
+    logMessage(buffer);
+    return false;
+  }
+  oomStats.committedPages += pages;
+  if (oomStats.committedPages > oomStats.maxCommittedPages)
+    oomStats.maxCommittedPages = oomStats.committedPages;
+
+  OomEntry *entry = &entries[set];
+  entry->process = process;
+  entry->committedPages = pages;
+  entry->score = 0;
+  heap[heapSize] = set;
+  siftUp(heapSize++);
+  return true;
+}
+
+void oomReleaseProcess(int set) {
+  OomEntry *entry = &entries[set];
+  if (entry->process == NULL)
+    return;
+  oomStats.committedPages -= entry->committedPages;
+  // El último del montículo ocupa su hueco y se recoloca
+  int index = entry->heapIndex;
+  int moved = heap[--heapSize];
+  if (index < heapSize) {
+    heapPlace(index, moved);
+    siftUp(index);
+    siftDown(entries[moved].heapIndex);
+  }
+  entry->process = NULL;
+}
+
+void oomResetIndex() {
+  memset(entries, 0, sizeof(entries));
+  heapSize = 0;
+  oomStats.committedPages = 0;
+}
+
+void oomRestoreProcess(int set, Process *process) {
+  OomEntry *entry = &entries[set];
+  entry->process = process;
+  entry->committedPages = commitPages(process);
+  entry->score = 0;
+  oomStats.committedPages += entry->committedPages;
+  if (oomStats.committedPages > oomStats.maxCommittedPages)
+    oomStats.maxCommittedPages = oomStats.committedPages;
+  heap[heapSize] = set;
+  siftUp(heapSize++);
+}
+
+void oomUpdateResident(int set, int residentFrames) {
+  OomEntry *entry = &entries[set];
+  if (entry->process == NULL)
+    return;
+  long score = oomScore(entry->process, residentFrames);
+  if (score == entry->score)
+    return;
+  entry->score = score;
+  siftUp(entry->heapIndex);
+  siftDown(entry->heapIndex);
+}
+
+int oomSelectVictim(long *score) {
+  if (heapSize == 0 || entries[heap[0]].score == 0)
+    return NO_FRAME;
+  *score = entries[heap[0]].score;
+  return heap[0];
+}
+
+void oomRecordKill(Process *victim, int frames) {
+  oomStats.kills++;
+  oomStats.killedFrames += frames;
+  if (victimCount < MAX_PROCESSES)
+    victims[victimCount++] = victim;
+}
+
+Process *oomTakeVictim() {
+  return victimCount > 0 ? victims[--victimCount] : NULL;
+}
+
+OomStatistics getOomStatistics() { return oomStats; }
+
+void displayOomStatistics() {
+  char buffer[256];
+  static const char *policyNames[] = {"heurística", "siempre", "nunca"};
+  if (!configured)
+    return;
+
+  snprintf(buffer, sizeof(buffer),
+           "OOM: política de compromiso %s, máximo %ld páginas "
+           "comprometidas, %ld procesos rechazados, %ld eliminados (%ld "
+           "marcos liberados)",
+           policyNames[policy], oomStats.maxCommittedPages, oomStats.refused,
+           oomStats.kills, oomStats.killedFrames);
+  logMessage(buffer);
+}
@@ -0,0 +1,286 @@
+#include "pagecache.h"
+#include "iodevice.h"
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Estado de la caché de páginas: índice por (archivo, página) y listas
+// LRU activa e inactiva (cabeza = más reciente)
+static CachePage *buckets[PAGE_CACHE_BUCKETS];
+static CachePage *activeHead = NULL, *activeTail = NULL;
+static CachePage *inactiveHead = NULL, *inactiveTail = NULL;
+static int activePages = 0;
+static int inactivePages = 0;
+static int dirtyPages = 0;
+static PageCacheStatistics cacheStats;
+
+// Cubeta del índice para una página de un archivo
+static CachePage **bucketOf(int fileId, long index) {
+  unsigned long hash = (unsigned long)fileId * 2654435761UL + (unsigned long)index;
+  return &buckets[hash % PAGE_CACHE_BUCKETS];
+}
+
+static CachePage *lookupPage(int fileId, long index) {
+  for (CachePage *cp = *bucketOf(fileId, index); cp != NULL; cp = cp->hashNext) {
+    if (cp->fileId == fileId && cp->index == index)
+      return cp;
+  }
+  return NULL;
+}
+
+static void removeFromIndex(CachePage *cp) {
+  CachePage **link = bucketOf(cp->fileId, cp->index);
+  while (*link != cp)
+    link = &(*link)->hashNext;
+  *link = cp->hashNext;
+  cp->hashNext = NULL;
+}
+
+// Sacar una página de su lista (activa o inactiva)
+static void listRemove(CachePage *cp) {
+  CachePage **head = cp->active ? &activeHead : &inactiveHead;
+  CachePage **tail = cp->active ? &activeTail : &inactiveTail;
+
+  if (cp->prev != NULL)
+    cp->prev->next = cp->next;
+  else
+    *head = cp->next;
+  if (cp->next != NULL)
+    cp->next->prev = cp->prev;
+  else
+    *tail = cp->prev;
+  cp->prev = cp->next = NULL;
+  if (cp->active)
+    activePages--;
+  else
+    inactivePages--;
+}
+
+// Insertar una página como la más reciente de una lista
+static void listPushHead(CachePage *cp, bool active) {
+  CachePage **head = active ? &activeHead : &inactiveHead;
+  CachePage **tail = active ? &activeTail : &inactiveTail;
+
+  cp->active = active;
+  cp->prev = NULL;
+  cp->next = *head;
+  if (*head != NULL)
+    (*head)->prev = cp;
+  else
+    *tail = cp;
+  *head = cp;
+  if (active)
+    activePages++;
+  else
+    inactivePages++;
+}
+
+// Mantener la lista activa acotada: las activas más antiguas vuelven a la
+// inactiva y deberán accederse otra vez para promocionar
+static void balanceLists() {
+  while (activeTail != NULL &&
+         activePages > inactivePages * PAGE_CACHE_ACTIVE_RATIO) {
+    CachePage *cp = activeTail;
+    listRemove(cp);
+    listPushHead(cp, false);
+    cacheStats.demotions++;
+  }
+}
+
+// Incorporar a la caché una página de archivo que no estaba; NULL si no
+// hay marco disponible
+static CachePage *insertPage(int fileId, long index, SimTime currentTime) {
+  CachePage *cp = malloc(sizeof(CachePage));
+  if (cp == NULL)
+    return NULL;
+
+  initializePage(&cp->page, PAGE_CACHE_OWNER, (unsigned long)index * PAGE_SIZE,
+                 PAGE_SIZE_4K);
+  cp->fileId = fileId;
+  cp->index = index;
+  cp->dirtyTime = 0;
+  cp->prev = cp->next = cp->hashNext = NULL;
+  if (allocateCacheFrame(&cp->page, currentTime) == NO_FRAME) {
+    free(cp);
+    return NULL;
+  }
+
+  // Las páginas nuevas entran en la lista inactiva
+  CachePage **bucket = bucketOf(fileId, index);
+  cp->hashNext = *bucket;
+  *bucket = cp;
+  listPushHead(cp, false);
+  return cp;
+}
+
+// Encolar la escritura diferida de una página en el dispositivo de su
+// archivo (sin proceso bloqueado)
+static void writePageBack(const CachePage *cp, SimTime currentTime) {
+  submitIoRequest(ioDeviceForFile(cp->fileId), NULL,
+                  ioSector(cp->fileId, cp->index), IO_PAGE_WRITE_TIME, true,
+                  currentTime);
+}
+
+SimTime pageCacheAccess(const FileRequest *request, int processId,
+                        SimTime ioTime, SimTime currentTime,
+                        int *devicePages) {
+  char buffer[256];
+  int pages = 0, hits = 0, misses = 0;
+
+  *devicePages = 0;
+  if (request->length <= 0)
+    return ioTime;
+
+  long first = request->offset / PAGE_SIZE;
+  long last = (request->offset + request->length - 1) / PAGE_SIZE;
+  for (long index = first; index <= last; index++) {
+    CachePage *cp = lookupPage(request->fileId, index);
+    pages++;
+    if (cp != NULL) {
+      // Segundo acceso: la página pasa (o vuelve) a la cabeza de la activa
+      hits++;
+      cacheStats.hits++;
+      touchCacheFrame(cp->page.frameIndex, currentTime);
+      if (!cp->active)
+        cacheStats.promotions++;
+      listRemove(cp);
+      listPushHead(cp, true);
+    } else {
+      // Las lecturas van al archivo; las escrituras solo reservan la página
+      if (!request->write) {
+        misses++;
+        cacheStats.misses++;
+      }
+      cp = insertPage(request->fileId, index, currentTime);
+      if (cp == NULL) {
+        cacheStats.allocationFails++;
+        continue;
+      }
+    }
+
+    if (request->write) {
+      cacheStats.writes++;
+      if (!cp->page.dirty) {
+        cp->page.dirty = true;
+        cp->dirtyTime = currentTime;
+        dirtyPages++;
+      }
+    }
+  }
+  balanceLists();
+
+  // La espera se reduce en proporción a las páginas que no hubo que leer
+  SimTime effective = ioTime * misses / pages;
+  if (effective < PAGE_CACHE_HIT_COST)
+    effective = PAGE_CACHE_HIT_COST < ioTime ? PAGE_CACHE_HIT_COST : ioTime;
+  cacheStats.savedIoTime += ioTime - effective;
+  *devicePages = misses;
+
+  snprintf(buffer, sizeof(buffer),
+           "Caché de páginas: Proceso %d %s %d páginas del archivo %d (%d "
+           "aciertos, %d leídas), E/S %lld de %lld",
+           processId, request->write ? "escribe" : "lee", pages,
+           request->fileId, hits, misses, effective, ioTime);
+  logMessage(buffer);
+  return effective;
+}
+
+void pageCacheWriteBack(SimTime currentTime) {
+  char buffer[256];
+  int written = 0;
+
+  if (dirtyPages == 0)
+    return;
+  for (int list = 0; list < 2; list++) {
+    for (CachePage *cp = list == 0 ? activeHead : inactiveHead; cp != NULL;
+         cp = cp->next) {
+      if (cp->page.dirty &&
+          currentTime - cp->dirtyTime >= PAGE_CACHE_DIRTY_EXPIRE) {
+        cp->page.dirty = false;
+        dirtyPages--;
+        written++;
+        writePageBack(cp, currentTime);
+      }
+    }
+  }
+  if (written == 0)
+    return;
+
+  cacheStats.flushedPages += written;
+  snprintf(buffer, sizeof(buffer),
+           "Caché de páginas: %d páginas sucias escritas por expiración "
+           "(Tiempo: %lld)",
+           written, currentTime);
+  logMessage(buffer);
+}
+
+Page *pageCacheReclaimCandidate() {
+  if (inactiveTail != NULL)
+    return &inactiveTail->page;
+  return activeTail != NULL ? &activeTail->page : NULL;
+}
+
+void pageCacheEvicted(Page *page, SimTime currentTime) {
+  char buffer[256];
+  CachePage *cp = (CachePage *)page;
+
+  listRemove(cp);
+  removeFromIndex(cp);
+  cacheStats.evictions++;
+  if (cp->page.dirty) {
+    dirtyPages--;
+    cacheStats.reclaimWrites++;
+    writePageBack(cp, currentTime);
+    snprintf(buffer, sizeof(buffer),
+             "Caché de páginas: página %ld del archivo %d escrita al "
+             "recuperarla (Tiempo: %lld)",
+             cp->index, cp->fileId, currentTime);
+    logMessage(buffer);
+  }
+  free(cp);
+}
+
+void dropPageCache() {
+  for (int list = 0; list < 2; list++) {
+    CachePage *cp = list == 0 ? activeHead : inactiveHead;
+    while (cp != NULL) {
+      CachePage *next = cp->next;
+      if (cp->page.dirty)
+        cacheStats.flushedPages++;
+      freeCacheFrame(cp->page.frameIndex);
+      free(cp);
+      cp = next;
+    }
+  }
+  memset(buckets, 0, sizeof(buckets));
+  activeHead = activeTail = inactiveHead = inactiveTail = NULL;
+  activePages = inactivePages = dirtyPages = 0;
+}
+
+PageCacheStatistics getPageCacheStatistics() { return cacheStats; }
+
+void displayPageCacheStatistics() {
+  char buffer[256];
+  long lookups = cacheStats.hits + cacheStats.misses;
+
+  snprintf(buffer, sizeof(buffer),
+           "Caché de páginas: %d marcos (%d activas, %d inactivas), %d sucias",
+           activePages + inactivePages, activePages, inactivePages,
+           dirtyPages);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Aciertos %ld, lecturas %ld (tasa de aciertos %.2f), escrituras "
+           "%ld, E/S ahorrada %lld",
+           cacheStats.hits, cacheStats.misses,
+           lookups > 0 ? (double)cacheStats.hits / lookups : 0.0,
+           cacheStats.writes, cacheStats.savedIoTime);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Promociones %ld, degradaciones %ld, recuperadas %ld (%ld sucias), "
+           "escritas por expiración %ld, sin marco %ld",
+           cacheStats.promotions, cacheStats.demotions, cacheStats.evictions,
+           cacheStats.reclaimWrites, cacheStats.flushedPages,
+           cacheStats.allocationFails);
+  logMessage(buffer);
+}
@@ -0,0 +1,106 @@
+#include "pagetable.h"
+#include <stdlib.h>
+
+// Índice dentro del nodo del nivel indicado (0 = raíz)
+static int levelIndex(const PageTable *table, unsigned long virtualAddress,
+                      int level) {
+  int shift = PAGE_OFFSET_BITS + PAGE_TABLE_BITS * (table->levels - 1 - level);
+  return (int)((virtualAddress >> shift) & (PAGE_TABLE_ENTRIES - 1));
+}
+
+PageTable *createPageTable(int levels) {
+  if (levels < MIN_PAGE_TABLE_LEVELS || levels > MAX_PAGE_TABLE_LEVELS)
+    return NULL;
+
+  PageTable *table = malloc(sizeof(PageTable));
+  if (table == NULL)
+    return NULL;
+  table->root = calloc(1, sizeof(PageTableNode));
+  if (table->root == NULL) {
+    free(table);
+    return NULL;
+  }
+  table->levels = levels;
+  table->tableNodes = 1;
+  table->mappedPages = 0;
+  return table;
+}
+
+// Indica si una entrada del nodo es una hoja (página mapeada)
+static bool isLeaf(const PageTableNode *node, int index) {
+  return (node->leafMask[index / 64] >> (index % 64)) & 1;
+}
+
+// Liberar recursivamente los nodos intermedios
+static void destroyNode(PageTableNode *node, int level, int levels) {
+  if (level < levels - 1) {
+    for (int i = 0; i < PAGE_TABLE_ENTRIES; i++) {
+      if (node->entries[i] != NULL && !isLeaf(node, i))
+        destroyNode(node->entries[i], level + 1, levels);
+    }
+  }
+  free(node);
+}
+
+void destroyPageTable(PageTable *table) {
+  if (table == NULL)
+    return;
+  destroyNode(table->root, 0, table->levels);
+  free(table);
+}
+
+bool mapPage(PageTable *table, unsigned long virtualAddress, Page *page) {
+  PageTableNode *node = table->root;
+
+  // Las páginas grandes terminan el recorrido antes del último nivel
+  int leafLevel = table->levels - 1 - (int)page->sizeClass;
+  if (leafLevel < 1)
+    return false;
+
+  // Crear los nodos intermedios que falten
+  for (int level = 0; level < leafLevel; level++) {
+    int index = levelIndex(table, virtualAddress, level);
+    if (isLeaf(node, index))
+      return false;
+    if (node->entries[index] == NULL) {
+      node->entries[index] = calloc(1, sizeof(PageTableNode));
+      if (node->entries[index] == NULL)
+        return false;
+      table->tableNodes++;
+    }
+    node = node->entries[index];
+  }
+
+  int index = levelIndex(table, virtualAddress, leafLevel);
+  if (node->entries[index] != NULL && !isLeaf(node, index))
+    return false;
+  if (node->entries[index] == NULL)
+    table->mappedPages++;
+  node->entries[index] = page;
+  node->leafMask[index / 64] |= (uint64_t)1 << (index % 64);
+  return true;
+}
+
+Page *walkPageTable(PageTable *table, unsigned long virtualAddress,
+                    int *levelsVisited) {
+  PageTableNode *node = table->root;
+  int visited = 0;
+
+  for (int level = 0; level < table->levels; level++) {
+    int index = levelIndex(table, virtualAddress, level);
+    void *entry = node->entries[index];
+    visited++;
+    if (entry == NULL || isLeaf(node, index)) {
+      if (levelsVisited != NULL)
+        *levelsVisited = visited;
+      return entry;
+    }
+    node = entry;
+  }
+  return NULL;
+}
+
+unsigned long virtualPageNumber(unsigned long virtualAddress,
+                                PageSizeClass sizeClass) {
+  return virtualAddress >> (PAGE_OFFSET_BITS + PAGE_TABLE_BITS * sizeClass);
+}
@@ -0,0 +1,199 @@
+#include "prefetch.h"
+#include "memory.h"
+#include <stdio.h>
+#include <string.h>
+
+// Transición aprendida del flujo de fallos (tabla de correspondencia
+// directa)
+typedef struct {
+  bool valid;
+  int processId;
+  unsigned long vpn;  // Página que falló
+  unsigned long next; // Página que falló a continuación
+} MarkovEntry;
+
+// Estado del motor de precarga
+static bool prefetchEnabled = PREFETCH_ENABLED;
+static int maxPrefetchWindow = PREFETCH_MAX_WINDOW;
+static bool markovEnabled = PREFETCH_MARKOV;
+static PrefetchStream streams[MAX_PROCESSES];
+static bool streamsReady = false;
+static MarkovEntry markovTable[PREFETCH_MARKOV_ENTRIES];
+static PrefetchStatistics prefetchStats;
+
+bool configurePrefetcher(bool enabled, int maxWindow, bool markov) {
+  if (maxWindow < PREFETCH_MIN_WINDOW || maxWindow > PREFETCH_MAX_WINDOW)
+    return false;
+
+  prefetchEnabled = enabled;
+  maxPrefetchWindow = maxWindow;
+  markovEnabled = markov;
+  for (int i = 0; i < MAX_PROCESSES; i++)
+    streams[i].processId = -1;
+  streamsReady = true;
+  memset(markovTable, 0, sizeof(markovTable));
+  memset(&prefetchStats, 0, sizeof(prefetchStats));
+  return true;
+}
+
+// Flujo de un proceso, creándolo si hace falta (NULL si no quedan libres)
+static PrefetchStream *findStream(int processId, bool create) {
+  PrefetchStream *freeStream = NULL;
+
+  if (!streamsReady)
+    configurePrefetcher(PREFETCH_ENABLED, PREFETCH_MAX_WINDOW,
+                        PREFETCH_MARKOV);
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    if (streams[i].processId == processId)
+      return &streams[i];
+    if (freeStream == NULL && streams[i].processId < 0)
+      freeStream = &streams[i];
+  }
+  if (!create || freeStream == NULL)
+    return NULL;
+  memset(freeStream, 0, sizeof(PrefetchStream));
+  freeStream->processId = processId;
+  freeStream->window = PREFETCH_MIN_WINDOW;
+  return freeStream;
+}
+
+// Entrada de la tabla de Markov para una página de un proceso
+static MarkovEntry *markovEntry(int processId, unsigned long vpn) {
+  unsigned long hash = vpn * 2654435761UL + (unsigned long)processId * 40503UL;
+  return &markovTable[hash % PREFETCH_MARKOV_ENTRIES];
+}
+
+// Añadir un candidato si no está ya propuesto
+static int addCandidate(PrefetchCandidate *candidates, int count, int max,
+                        unsigned long vpn, unsigned long size,
+                        PrefetchSource source) {
+  if (count >= max)
+    return count;
+  for (int i = 0; i < count; i++) {
+    if (candidates[i].virtualAddress == vpn * size)
+      return count;
+  }
+  candidates[count].virtualAddress = vpn * size;
+  candidates[count].source = source;
+  return count + 1;
+}
+
+int prefetchPredict(int processId, unsigned long virtualAddress,
+                    unsigned long size, PrefetchCandidate *candidates,
+                    int max) {
+  PrefetchStream *stream = findStream(processId, true);
+  unsigned long vpn = virtualAddress / size;
+  int count = 0;
+
+  prefetchStats.faults++;
+  if (!prefetchEnabled || stream == NULL)
+    return 0;
+
+  // Un fallo justo después de la ventana anterior continúa el flujo
+  // secuencial y duplica la ventana; cualquier otro salto la reinicia
+  long stride = stream->valid ? (long)(vpn - stream->lastVpn) : 1;
+  bool sequential = stride >= 1 && stride <= stream->window + 1;
+  if (stream->valid && sequential) {
+    stream->window *= 2;
+    if (stream->window > maxPrefetchWindow)
+      stream->window = maxPrefetchWindow;
+  } else if (stream->valid) {
+    stream->window = PREFETCH_MIN_WINDOW;
+  }
+  if (stream->window > prefetchStats.maxWindow)
+    prefetchStats.maxWindow = stream->window;
+
+  // Salto constante (no secuencial) confirmado en varios fallos seguidos
+  if (stream->valid && !sequential && stride == stream->lastStride)
+    stream->strideHits++;
+  else
+    stream->strideHits = 0;
+
+  if (sequential) {
+    for (int k = 1; k <= stream->window; k++)
+      count = addCandidate(candidates, count, max, vpn + k, size,
+                           PREFETCH_SEQUENTIAL);
+  } else if (stream->strideHits >= PREFETCH_STRIDE_CONFIRM) {
+    int degree = stream->strideHits < maxPrefetchWindow ? stream->strideHits
+                                                        : maxPrefetchWindow;
+    for (int k = 1; k <= degree; k++) {
+      long target = (long)vpn + stride * k;
+      if (target < 0)
+        break;
+      count = addCandidate(candidates, count, max, (unsigned long)target,
+                           size, PREFETCH_STRIDE);
+    }
+  }
+
+  // Markov: aprender la transición anterior y predecir el sucesor
+  if (markovEnabled) {
+    if (stream->valid) {
+      MarkovEntry *previous = markovEntry(processId, stream->lastVpn);
+      previous->valid = true;
+      previous->processId = processId;
+      previous->vpn = stream->lastVpn;
+      previous->next = vpn;
+    }
+    MarkovEntry *entry = markovEntry(processId, vpn);
+    if (entry->valid && entry->processId == processId && entry->vpn == vpn &&
+        entry->next != vpn)
+      count = addCandidate(candidates, count, max, entry->next, size,
+                           PREFETCH_MARKOV_NEXT);
+  }
+
+  stream->valid = true;
+  stream->lastVpn = vpn;
+  stream->lastStride = stride;
+  return count;
+}
+
+void prefetchRecordIssued(PrefetchSource source) {
+  prefetchStats.issued[source]++;
+}
+
+void prefetchRecordHit(PrefetchSource source) { prefetchStats.hits[source]++; }
+
+void prefetchRecordWaste(int processId, PrefetchSource source,
+                         long frameTicks) {
+  PrefetchStream *stream = findStream(processId, false);
+
+  prefetchStats.wasted[source]++;
+  prefetchStats.wastedCost[source] += frameTicks;
+
+  // La precarga secuencial que no se usa reduce la ventana a la mitad
+  if (stream != NULL && source == PREFETCH_SEQUENTIAL) {
+    stream->window /= 2;
+    if (stream->window < PREFETCH_MIN_WINDOW)
+      stream->window = PREFETCH_MIN_WINDOW;
+  }
+}
+
+void prefetchForgetProcess(int processId) {
+  PrefetchStream *stream = findStream(processId, false);
+  if (stream != NULL)
+    stream->processId = -1;
+}
+
+PrefetchStatistics getPrefetchStatistics() { return prefetchStats; }
+
+void displayPrefetchStatistics() {
+  static const char *sourceNames[NUM_PREFETCH_SOURCES] = {
+      "secuencial", "por salto", "de Markov"};
+  char buffer[256];
+
+  snprintf(buffer, sizeof(buffer),
+           "Precarga: %ld fallos observados, ventana máxima %d",
+           prefetchStats.faults, prefetchStats.maxWindow);
+  logMessage(buffer);
+  for (int s = 0; s < NUM_PREFETCH_SOURCES; s++) {
+    long issued = prefetchStats.issued[s];
+    snprintf(buffer, sizeof(buffer),
+             "Precarga %s: %ld páginas, %ld usadas, %ld desperdiciadas "
+             "(precisión %.2f, coste %ld marcos x tiempo)",
+             sourceNames[s], issued, prefetchStats.hits[s],
+             prefetchStats.wasted[s],
+             issued > 0 ? (double)prefetchStats.hits[s] / issued : 0.0,
+             prefetchStats.wastedCost[s]);
+    logMessage(buffer);
+  }
+}
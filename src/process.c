@@ -1,5 +1,196 @@
 #include "process.h"
+#include "cgroup.h"
+#include "memory.h"
+#include "pagetable.h"
+#include "swap.h"
 #include <stdlib.h>
+#include <string.h>
 
-// Aquí podrían ir funciones adicionales de manejo de procesos
-// Por ahora, la implementación está en el main.c
+// Siguiente identificador global de página (único entre procesos)
+static int nextPageId = 0;
+
+void initializePage(Page *page, int processId, unsigned long virtualAddress,
+                    PageSizeClass sizeClass) {
+  page->id = nextPageId++;
+  page->active = true;
+  page->processId = processId;
+  page->lastAccessTime = -1;
+  page->inMemory = false;
+  page->virtualAddress = virtualAddress;
+  page->frameIndex = NO_FRAME;
+  page->sizeClass = sizeClass;
+  page->dirty = false;
+  page->swapSlot = NO_SWAP_SLOT;
+  page->zswapEntry = NO_ZSWAP_ENTRY;
+  page->readyTime = 0;
+  page->readAhead = false;
+  page->copyOnWrite = false;
+  page->nextSharer = NULL;
+  page->sharedAnchor = NULL;
+  page->accessNode = NO_FRAME;
+  page->remoteAccesses = 0;
+}
+
+int nextPageIdentifier() { return nextPageId; }
+
+void resumePageIds(int nextId) { nextPageId = nextId; }
+
+bool initializeProcessPages(Process *process) {
+  process->pages = malloc(process->totalPages * sizeof(Page));
+  process->pageTable = createPageTable(PAGE_TABLE_LEVELS);
+  if (process->pages == NULL || process->pageTable == NULL) {
+    releaseProcessPages(process);
+    return false;
+  }
+
+  // Inicializar las páginas y mapearlas de forma contigua, alineando cada
+  // una a su tamaño
+  unsigned long virtualAddress = PROCESS_VIRTUAL_BASE;
+  for (int i = 0; i < process->totalPages; i++) {
+    Page *page = &process->pages[i];
+    PageSizeClass sizeClass = process->pageSizeClasses != NULL
+                                  ? process->pageSizeClasses[i]
+                                  : PAGE_SIZE_4K;
+    unsigned long size = PAGE_SIZE_BYTES(sizeClass);
+    virtualAddress = (virtualAddress + size - 1) & ~(size - 1);
+    initializePage(page, process->id, virtualAddress, sizeClass);
+    virtualAddress += size;
+    if (!mapPage(process->pageTable, page->virtualAddress, page)) {
+      releaseProcessPages(process);
+      return false;
+    }
+  }
+  return true;
+}
+
+void releaseProcessPages(Process *process) {
+  destroyPageTable(process->pageTable);
+  free(process->pages);
+  free(process->sharedPages);
+  if (process->ownsBursts) {
+    free(process->cpuBurstTimes);
+    free(process->ioBurstTimes);
+    process->cpuBurstTimes = process->ioBurstTimes = NULL;
+    process->ownsBursts = false;
+  }
+  if (process->ownsLayout) {
+    free((void *)process->pageSizeClasses);
+    free((void *)process->ioRequests);
+    process->pageSizeClasses = NULL;
+    process->ioRequests = NULL;
+    process->ownsLayout = false;
+  }
+  process->pageTable = NULL;
+  process->pages = NULL;
+  process->sharedPages = NULL;
+  process->sharedRegion = NULL;
+}
+
+Process *forkProcess(Process *parent, int childId, SimTime currentTime) {
+  int remaining = parent->totalBursts - parent->burstIndex;
+  if (parent->state == TERMINATED || remaining <= 0)
+    return NULL;
+
+  Process *child = calloc(1, sizeof(Process));
+  if (child == NULL)
+    return NULL;
+
+  // El hijo continúa desde la ráfaga actual del padre
+  child->cpuBurstTimes = malloc(remaining * sizeof(SimTime));
+  child->ioBurstTimes = malloc(remaining * sizeof(SimTime));
+  child->ownsBursts = true;
+  if (child->cpuBurstTimes == NULL || child->ioBurstTimes == NULL) {
+    releaseProcessPages(child);
+    free(child);
+    return NULL;
+  }
+  memcpy(child->cpuBurstTimes, parent->cpuBurstTimes + parent->burstIndex,
+         remaining * sizeof(SimTime));
+  if (remaining > 1)
+    memcpy(child->ioBurstTimes, parent->ioBurstTimes + parent->burstIndex,
+           (remaining - 1) * sizeof(SimTime));
+
+  child->id = childId;
+  child->startTime = currentTime;
+  child->priority = parent->priority;
+  child->memorySize = parent->memorySize;
+  child->totalPages = parent->totalPages;
+  child->pageSizeClasses = parent->pageSizeClasses;
+  child->totalBursts = remaining;
+  child->burstIndex = 0;
+  child->writtenPages = parent->writtenPages;
+  child->numaPolicy = parent->numaPolicy;
+  child->numaNode = parent->numaNode;
+  child->cpu = NO_CPU;
+  child->ioRequests = parent->ioRequests != NULL
+                          ? parent->ioRequests + parent->burstIndex
+                          : NULL;
+  child->state = READY;
+  pthread_mutex_init(&child->processMutex, NULL);
+
+  // Mismo espacio de direcciones: páginas en las mismas direcciones
+  // virtuales, compartidas con el padre hasta que alguno escriba
+  if (!initializeProcessPages(child) ||
+      (parent->sharedRegion != NULL &&
+       !attachSharedRegion(child, parent->sharedRegion))) {
+    releaseProcessPages(child);
+    free(child);
+    return NULL;
+  }
+  shareForkedPages(parent, child);
+  if (parent->group != NULL)
+    attachProcessToGroup(child, parent->group);
+  return child;
+}
+
+SharedRegion *createSharedRegion(int id, int totalPages) {
+  SharedRegion *region = malloc(sizeof(SharedRegion));
+  if (region == NULL)
+    return NULL;
+  region->pages = malloc(totalPages * sizeof(Page));
+  if (region->pages == NULL) {
+    free(region);
+    return NULL;
+  }
+  region->id = id;
+  region->totalPages = totalPages;
+  for (int i = 0; i < totalPages; i++)
+    initializePage(&region->pages[i], SHARED_REGION_OWNER,
+                   SHARED_REGION_BASE + (unsigned long)i * PAGE_SIZE,
+                   PAGE_SIZE_4K);
+  return region;
+}
+
+void destroySharedRegion(SharedRegion *region) {
+  if (region == NULL)
+    return;
+  for (int i = 0; i < region->totalPages; i++)
+    swapFreeSlot(&region->pages[i]);
+  free(region->pages);
+  free(region);
+}
+
+bool attachSharedRegion(Process *process, SharedRegion *region) {
+  if (process->sharedRegion != NULL || process->pageTable == NULL)
+    return false;
+  process->sharedPages = malloc(region->totalPages * sizeof(Page));
+  if (process->sharedPages == NULL)
+    return false;
+
+  // Cada proceso tiene sus propias páginas, enlazadas a las anclas del
+  // segmento; se mapean sobre el marco común en su primer fallo
+  process->sharedRegion = region;
+  for (int i = 0; i < region->totalPages; i++) {
+    Page *page = &process->sharedPages[i];
+    initializePage(page, process->id, region->pages[i].virtualAddress,
+                   PAGE_SIZE_4K);
+    page->sharedAnchor = &region->pages[i];
+    if (!mapPage(process->pageTable, page->virtualAddress, page)) {
+      free(process->sharedPages);
+      process->sharedPages = NULL;
+      process->sharedRegion = NULL;
+      return false;
+    }
+  }
+  return true;
+}
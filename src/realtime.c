@@ -0,0 +1,358 @@
+#include "realtime.h"
+#include "memory.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Montículo binario de tareas: el de trabajos activos se ordena por plazo
+// absoluto (EDF) o por periodo (rate-monotonic); el de activaciones, por
+// el instante de la siguiente
+typedef struct {
+  RealTimeTask *items[MAX_REALTIME_TASKS];
+  int size;
+  bool byRelease; // Ordenado por activación
+} TaskHeap;
+
+static RealTimeTask tasks[MAX_REALTIME_TASKS];
+static int taskCount = 0;
+static RealTimePolicy policy = REALTIME_DEFAULT_POLICY;
+static TaskHeap ready = {.byRelease = false};
+static TaskHeap releases = {.byRelease = true};
+static RealTimeStatistics realTimeStats;
+
+static const char *policyName(RealTimePolicy kind) {
+  return kind == REALTIME_RATE_MONOTONIC ? "rate-monotonic" : "EDF";
+}
+
+void configureRealTime(RealTimePolicy kind) {
+  policy = kind;
+  memset(tasks, 0, sizeof(tasks));
+  taskCount = 0;
+  ready.size = releases.size = 0;
+  memset(&realTimeStats, 0, sizeof(realTimeStats));
+}
+
+// Prioridad fija de rate-monotonic: menor periodo, luego menor plazo
+static bool rateMonotonicFirst(const RealTimeTask *a, const RealTimeTask *b) {
+  if (a->period != b->period)
+    return a->period < b->period;
+  if (a->deadline != b->deadline)
+    return a->deadline < b->deadline;
+  return a->processId < b->processId;
+}
+
+static bool precedes(const TaskHeap *heap, const RealTimeTask *a,
+                     const RealTimeTask *b) {
+  if (heap->byRelease) {
+    if (a->release != b->release)
+      return a->release < b->release;
+  } else if (policy == REALTIME_RATE_MONOTONIC) {
+    return rateMonotonicFirst(a, b);
+  } else if (a->absoluteDeadline != b->absoluteDeadline) {
+    return a->absoluteDeadline < b->absoluteDeadline;
+  }
+  return a->processId < b->processId;
+}
+
+static void heapPlace(TaskHeap *heap, int index, RealTimeTask *task) {
+  heap->items[index] = task;
+  if (heap->byRelease)
+    task->releaseIndex = index;
+  else
+    task->readyIndex = index;
+}
+
+// Recolocar el elemento de index subiendo o bajando por el montículo
+static void heapFix(TaskHeap *heap, int index) {
+  RealTimeTask *task = heap->items[index];
+
+  while (index > 0 && precedes(heap, task, heap->items[(index - 1) / 2])) {
+    heapPlace(heap, index, heap->items[(index - 1) / 2]);
+    index = (index - 1) / 2;
+  }
+  for (;;) {
+    int child = 2 * index + 1;
+    if (child >= heap->size)
+      break;
+    if (child + 1 < heap->size &&
+        precedes(heap, heap->items[child + 1], heap->items[child]))
+      child++;
+    if (!precedes(heap, heap->items[child], task))
+      break;
+    heapPlace(heap, index, heap->items[child]);
+    index = child;
+  }
+  heapPlace(heap, index, task);
+}
+
+static void heapPush(TaskHeap *heap, RealTimeTask *task) {
+  heap->items[heap->size++] = task;
+  heapFix(heap, heap->size - 1);
+}
+
+static void heapRemove(TaskHeap *heap, int index) {
+  RealTimeTask *last = heap->items[--heap->size];
+  if (index < heap->size) {
+    heap->items[index] = last;
+    heapFix(heap, index);
+  }
+}
+
+// Test de densidad de EDF: suficiente con plazos restringidos y exacto si
+// los plazos coinciden con los periodos
+static bool edfSchedulable(RealTimeTask **set, int count, double *load) {
+  *load = 0.0;
+  for (int i = 0; i < count; i++) {
+    SimTime window =
+        set[i]->deadline < set[i]->period ? set[i]->deadline : set[i]->period;
+    *load += (double)set[i]->wcet / window;
+  }
+  return *load <= 1.0;
+}
+
+// Cota de Liu y Layland y, si no basta o hay plazos menores que el
+// periodo, análisis del tiempo de respuesta: R = C + sum(ceil(R / Tj) * Cj)
+// sobre las tareas más prioritarias, que debe converger sin pasar el plazo
+static bool rateMonotonicSchedulable(RealTimeTask **set, int count,
+                                     double *load, const char **test) {
+  bool implicit = true;
+  *load = 0.0;
+  for (int i = 0; i < count; i++) {
+    *load += (double)set[i]->wcet / set[i]->period;
+    implicit = implicit && set[i]->deadline >= set[i]->period;
+  }
+  *test = "cota de Liu y Layland";
+  if (implicit && *load <= count * (pow(2.0, 1.0 / count) - 1.0))
+    return true;
+
+  *test = "tiempo de respuesta";
+  for (int i = 0; i < count; i++) {
+    SimTime limit =
+        set[i]->deadline < set[i]->period ? set[i]->deadline : set[i]->period;
+    SimTime response = set[i]->wcet;
+    bool converged = false;
+    for (int k = 0; k < REALTIME_RTA_ITERATIONS && response <= limit; k++) {
+      SimTime next = set[i]->wcet;
+      for (int j = 0; j < count; j++) {
+        if (j != i && rateMonotonicFirst(set[j], set[i]))
+          next += (response + set[j]->period - 1) / set[j]->period *
+                  set[j]->wcet;
+      }
+      if (next == response) {
+        converged = true;
+        break;
+      }
+      response = next;
+    }
+    if (!converged || response > limit)
+      return false;
+  }
+  return true;
+}
+
+bool admitRealTimeTask(Process *process, SimTime period, SimTime deadline,
+                       SimTime wcet, bool sporadic) {
+  char buffer[256];
+  RealTimeTask *set[MAX_REALTIME_TASKS];
+  int count = 0;
+  double load;
+  const char *test = "densidad";
+
+  if (process == NULL || process->realTime != NULL ||
+      process->totalBursts < 1 || period <= 0 || deadline <= 0 ||
+      wcet <= 0 || taskCount == MAX_REALTIME_TASKS)
+    return false;
+
+  // Candidata en el siguiente hueco, junto a las tareas sin terminar
+  RealTimeTask *task = &tasks[taskCount];
+  memset(task, 0, sizeof(*task));
+  task->process = process;
+  task->processId = process->id;
+  task->period = period;
+  task->deadline = deadline;
+  task->wcet = wcet;
+  task->sporadic = sporadic;
+  task->release = process->startTime;
+  task->readyIndex = task->releaseIndex = -1;
+  for (int i = 0; i < taskCount; i++) {
+    if (tasks[i].process != NULL)
+      set[count++] = &tasks[i];
+  }
+  set[count++] = task;
+
+  bool schedulable = policy == REALTIME_RATE_MONOTONIC
+                         ? rateMonotonicSchedulable(set, count, &load, &test)
+                         : edfSchedulable(set, count, &load);
+  if (!schedulable) {
+    realTimeStats.rejected++;
+    snprintf(buffer, sizeof(buffer),
+             "Tiempo real: tarea %d rechazada (periodo %lld, plazo %lld, "
+             "WCET %lld): carga %.3f no planificable con %s según el test "
+             "de %s",
+             process->id, period, deadline, wcet, load, policyName(policy),
+             test);
+    logMessage(buffer);
+    return false;
+  }
+
+  taskCount++;
+  realTimeStats.admitted++;
+  process->realTime = task;
+  process->priority = REAL_TIME_PRIORITY;
+  heapPush(&releases, task);
+  snprintf(buffer, sizeof(buffer),
+           "Tiempo real: tarea %d admitida (%s, periodo %lld, plazo %lld, "
+           "WCET %lld): carga %.3f con %s según el test de %s",
+           process->id, sporadic ? "esporádica" : "periódica", period,
+           deadline, wcet, load, policyName(policy), test);
+  logMessage(buffer);
+  return true;
+}
+
+// Activar los trabajos cuya activación llegó: su plazo se cuenta desde la
+// activación nominal aunque el trabajo anterior terminara tarde
+static void activateReleases(SimTime currentTime) {
+  char buffer[256];
+
+  while (releases.size > 0 && releases.items[0]->release <= currentTime) {
+    RealTimeTask *task = releases.items[0];
+    Process *process = task->process;
+    heapRemove(&releases, 0);
+
+    task->absoluteDeadline = task->release + task->deadline;
+    task->remaining = process->cpuBurstTimes[process->burstIndex];
+    task->jobs++;
+    realTimeStats.jobs++;
+    process->state = READY;
+    if (task->remaining > task->wcet) {
+      task->overruns++;
+      snprintf(buffer, sizeof(buffer),
+               "Tiempo real: el trabajo %ld de la tarea %d pide %lld de CPU, "
+               "más que su WCET %lld",
+               task->jobs, task->processId, task->remaining, task->wcet);
+      logMessage(buffer);
+    }
+    heapPush(&ready, task);
+  }
+}
+
+RealTimeTask *realTimeNext(SimTime currentTime) {
+  RealTimeTask *skipped[MAX_REALTIME_TASKS];
+  RealTimeTask *chosen = NULL;
+  int count = 0;
+
+  activateReleases(currentTime);
+
+  // Los trabajos bloqueados esperando swap ceden la CPU al siguiente
+  while (ready.size > 0) {
+    RealTimeTask *task = ready.items[0];
+    if (task->process->blockedUntil <= currentTime) {
+      chosen = task;
+      break;
+    }
+    skipped[count++] = task;
+    heapRemove(&ready, 0);
+  }
+  for (int i = 0; i < count; i++)
+    heapPush(&ready, skipped[i]);
+  return chosen;
+}
+
+SimTime realTimeNextEvent(SimTime currentTime) {
+  SimTime next = releases.size > 0 ? releases.items[0]->release : -1;
+
+  for (int i = 0; i < ready.size; i++) {
+    SimTime wakeup = ready.items[i]->process->blockedUntil;
+    if (wakeup > currentTime && (next < 0 || wakeup < next))
+      next = wakeup;
+  }
+  return next;
+}
+
+SimTime realTimeSlice(const RealTimeTask *task, SimTime currentTime) {
+  SimTime next = realTimeNextEvent(currentTime);
+
+  if (next > currentTime && next - currentTime < task->remaining)
+    return next - currentTime;
+  return task->remaining > 0 ? task->remaining : 0;
+}
+
+SimTime realTimePreempt(SimTime currentTime, SimTime executionTime) {
+  SimTime next = realTimeNextEvent(currentTime);
+
+  if (next < 0 || next - currentTime >= executionTime)
+    return executionTime;
+  // Un quantum avanza al menos un tick aunque la activación ya llegara
+  realTimeStats.preemptions++;
+  return next > currentTime ? next - currentTime : 1;
+}
+
+bool realTimeCharge(RealTimeTask *task, SimTime ran, SimTime currentTime) {
+  char buffer[256];
+  Process *process = task->process;
+
+  task->remaining -= ran;
+  if (task->remaining > 0)
+    return false;
+
+  // Trabajo terminado: respuesta desde su activación y retraso respecto
+  // a su plazo
+  SimTime response = currentTime - task->release;
+  SimTime lateness = currentTime - task->absoluteDeadline;
+  heapRemove(&ready, task->readyIndex);
+  task->readyIndex = -1;
+  task->completedJobs++;
+  if (response > task->worstResponse)
+    task->worstResponse = response;
+  if (lateness > task->worstLateness)
+    task->worstLateness = lateness;
+  if (lateness > 0) {
+    task->missedDeadlines++;
+    realTimeStats.missedDeadlines++;
+    snprintf(buffer, sizeof(buffer),
+             "Tiempo real: la tarea %d terminó el trabajo %ld en %lld, %lld "
+             "después de su plazo %lld",
+             task->processId, task->completedJobs, currentTime, lateness,
+             task->absoluteDeadline);
+    logMessage(buffer);
+  }
+
+  process->burstIndex++;
+  if (process->burstIndex >= process->totalBursts) {
+    task->process = NULL;
+    return true;
+  }
+  task->release += task->period;
+  if (task->sporadic)
+    task->release += process->ioBurstTimes[process->burstIndex - 1];
+  process->state = WAITING;
+  heapPush(&releases, task);
+  return false;
+}
+
+RealTimeStatistics getRealTimeStatistics() { return realTimeStats; }
+
+void displayRealTimeStatistics() {
+  char buffer[256];
+  if (taskCount == 0 && realTimeStats.rejected == 0)
+    return;
+
+  snprintf(buffer, sizeof(buffer),
+           "Tiempo real (%s): %ld tareas admitidas, %ld rechazadas, %ld "
+           "trabajos, %ld plazos incumplidos, %ld quantums expropiados",
+           policyName(policy), realTimeStats.admitted, realTimeStats.rejected,
+           realTimeStats.jobs, realTimeStats.missedDeadlines,
+           realTimeStats.preemptions);
+  logMessage(buffer);
+  for (int i = 0; i < taskCount; i++) {
+    RealTimeTask *task = &tasks[i];
+    snprintf(buffer, sizeof(buffer),
+             "Tarea %d: %ld/%ld trabajos, %ld plazos incumplidos, %ld "
+             "excesos de WCET, respuesta máxima %lld (plazo %lld), retraso "
+             "máximo %lld",
+             task->processId, task->completedJobs, task->jobs,
+             task->missedDeadlines, task->overruns, task->worstResponse,
+             task->deadline, task->worstLateness);
+    logMessage(buffer);
+  }
+}
@@ -0,0 +1,130 @@
+#include "reclaim.h"
+#include "memory.h"
+#include "numa.h"
+#include <stdio.h>
+#include <string.h>
+
+// Estado del demonio de reclamación (estilo kswapd)
+static int lowWatermark = 0; // 0: demonio desactivado
+static int highWatermark = 0;
+static int reclaimBatch = RECLAIM_BATCH;
+static SimTime directCost = 0;
+static bool configured = false;
+static bool awake = false;
+static SimTime lastTurn = -1; // Instante del último turno del demonio
+static ReclaimStatistics reclaimStats;
+
+bool configureReclaim(int low, int high, int batch, SimTime cost) {
+  if (low < 0 || high < low || high > NUM_FRAMES || batch <= 0 || cost < 0)
+    return false;
+  lowWatermark = low;
+  highWatermark = high;
+  reclaimBatch = batch;
+  directCost = cost;
+  configured = true;
+  awake = false;
+  lastTurn = -1;
+  memset(&reclaimStats, 0, sizeof(reclaimStats));
+  return true;
+}
+
+// Marcos libres entre todos los nodos
+static int freeFrames() {
+  int frames = 0;
+  for (int n = 0; n < numaNodeCount(); n++)
+    frames += freeFramesOnNode(n);
+  return frames;
+}
+
+void runBackgroundReclaim(SimTime currentTime) {
+  char buffer[256];
+  // Un turno por instante simulado, aunque el planificador pase varias
+  // veces por el mismo
+  if (lowWatermark == 0 || currentTime == lastTurn)
+    return;
+  lastTurn = currentTime;
+
+  int available = freeFrames();
+  if (!awake) {
+    if (available >= lowWatermark)
+      return;
+    awake = true;
+    reclaimStats.wakeups++;
+    snprintf(buffer, sizeof(buffer),
+             "kswapd: despierta con %d marcos libres (marcas %d/%d, Tiempo: "
+             "%lld)",
+             available, lowWatermark, highWatermark, currentTime);
+    logMessage(buffer);
+  }
+
+  // Cada turno recupera un lote; lo que falta queda para el siguiente
+  for (int i = 0; i < reclaimBatch && available < highWatermark; i++) {
+    if (!reclaimLruBlock(currentTime))
+      break;
+    reclaimStats.backgroundFrames++;
+    available = freeFrames();
+  }
+  if (available >= highWatermark) {
+    awake = false;
+    snprintf(buffer, sizeof(buffer),
+             "kswapd: duerme con %d marcos libres (Tiempo: %lld)", available,
+             currentTime);
+    logMessage(buffer);
+  }
+}
+
+SimTime directReclaimDelay(int evictedBlocks) {
+  return evictedBlocks * directCost;
+}
+
+// Intervalo del histograma de una latencia
+static int latencyBucket(SimTime latency) {
+  int bucket = 0;
+  while (latency > 0 && bucket < RECLAIM_LATENCY_BUCKETS - 1) {
+    latency >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void reclaimRecordFault(int evictedBlocks, SimTime latency) {
+  ReclaimPath path = evictedBlocks > 0 ? RECLAIM_DIRECT : RECLAIM_FAST_PATH;
+  reclaimStats.directFrames += evictedBlocks;
+  reclaimStats.faults[path]++;
+  reclaimStats.latency[path][latencyBucket(latency)]++;
+  accumulateTime(&reclaimStats.latencyTime[path], latency);
+  if (latency > reclaimStats.maxLatency[path])
+    reclaimStats.maxLatency[path] = latency;
+}
+
+ReclaimStatistics getReclaimStatistics() { return reclaimStats; }
+
+void displayReclaimStatistics() {
+  static const char *pathNames[] = {"bloque libre", "reclamación directa"};
+  char buffer[256];
+  if (!configured)
+    return;
+
+  snprintf(buffer, sizeof(buffer),
+           "Reclamación: kswapd despertó %ld veces y recuperó %ld bloques; "
+           "%ld bloques desalojados dentro de fallos",
+           reclaimStats.wakeups, reclaimStats.backgroundFrames,
+           reclaimStats.directFrames);
+  logMessage(buffer);
+  for (int path = 0; path < NUM_RECLAIM_PATHS; path++) {
+    int length = snprintf(
+        buffer, sizeof(buffer),
+        "Fallos por %s: %ld, latencia media %.2f, máxima %lld; "
+        "histograma (desde:fallos)",
+        pathNames[path], reclaimStats.faults[path],
+        accumulatorMean(&reclaimStats.latencyTime[path]),
+        reclaimStats.maxLatency[path]);
+    for (int b = 0; b < RECLAIM_LATENCY_BUCKETS &&
+                    length < (int)sizeof(buffer);
+         b++)
+      length += snprintf(buffer + length, sizeof(buffer) - length,
+                         " %d:%ld", b > 0 ? 1 << (b - 1) : 0,
+                         reclaimStats.latency[path][b]);
+    logMessage(buffer);
+  }
+}
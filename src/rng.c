@@ -0,0 +1,31 @@
+#include "rng.h"
+
+static unsigned long long simulationSeed = SIMULATION_SEED;
+
+void setSimulationSeed(unsigned long long seed) { simulationSeed = seed; }
+
+unsigned long long getSimulationSeed() { return simulationSeed; }
+
+// Paso de splitmix64: avanza el estado y mezcla sus bits
+static unsigned long long splitmix64(unsigned long long *state) {
+  unsigned long long z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+void rngSeed(RngStream *stream, unsigned long long streamId) {
+  // Mezclar la semilla global con el flujo para que flujos vecinos no
+  // compartan subsecuencias
+  unsigned long long mix = simulationSeed ^ (streamId * 0xd1b54a32d192ed03ULL);
+  stream->state = splitmix64(&mix);
+}
+
+unsigned int rngNext(RngStream *stream) {
+  return (unsigned int)(splitmix64(&stream->state) >> 32);
+}
+
+double rngUniform(RngStream *stream) {
+  // 53 bits de mantisa: exacto e idéntico en cualquier plataforma IEEE 754
+  return (splitmix64(&stream->state) >> 11) * (1.0 / 9007199254740992.0);
+}
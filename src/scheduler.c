@@ -1,92 +1,437 @@
 #include "scheduler.h"
+#include "cgroup.h"
+#include "checkpoint.h"
+#include "framelog.h"
+#include "history.h"
+#include "iodevice.h"
 #include "memory.h"
+#include "mrc.h"
+#include "numa.h"
+#include "oom.h"
+#include "online.h"
+#include "pagecache.h"
+#include "prefetch.h"
+#include "realtime.h"
+#include "reclaim.h"
+#include "simclock.h"
+#include "swap.h"
+#include "tiering.h"
+#include "tlb.h"
+#include "zswap.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 static Process *processQueue[MAX_PROCESSES];
 static int processCount = 0;
+static SimTime currentTime = 0;     // Reloj simulado (se guarda en los
+                                    // checkpoints)
+static SimTime checkpointTime = -1; // Tiempo del checkpoint pedido
+static const char *checkpointPath = NULL;
 
 int addProcessToQueue(Process *process) {
   if (processCount < MAX_PROCESSES) {
+    process->cpu = NO_CPU; // Se le asigna CPU en su primer quantum
+    // La política de compromiso de memoria puede rechazarlo
+    if (registerProcessMemory(process) == NO_FRAME)
+      return -1;
     processQueue[processCount++] = process;
     return processCount - 1;
   }
   return -1;
 }
 
+SimTime getSchedulerClock() { return currentTime; }
+
+void setSchedulerClock(SimTime time) { currentTime = time; }
+
+void requestCheckpoint(SimTime time, const char *path) {
+  checkpointTime = time;
+  checkpointPath = path;
+}
+
+// Avanzar el reloj simulado; el reloj de la simulación decide si el avance
+// es inmediato (por lotes) o sigue al reloj de pared (sincronizado)
+static void advanceClock(SimTime time, bool idle) {
+  if (time > currentTime)
+    currentTime = idle ? simclockSkip(currentTime, time)
+                       : simclockAdvance(currentTime, time);
+}
+
+// Cargar al reloj el trabajo de memoria hecho fuera de los quantums: la
+// CPU que el almacén comprimido dedicó a comprimir y descomprimir páginas
+// y las migraciones entre niveles de memoria
+static void chargeMemoryWork() {
+  advanceClock(currentTime + zswapTakeCpuTime() + tierTakeMigrationTime(),
+               false);
+}
+
+// Acceder a las páginas del proceso durante su quantum (las primeras
+// writtenPages se escriben y el segmento compartido solo se lee); si
+// vuelve de una espera de swap sus accesos ya se resolvieron. Devuelve
+// false si queda bloqueado hasta que terminen sus lecturas de swap o si el
+// OOM killer lo eliminó
+static bool loadProcessPages(Process *process) {
+  SimTime pagesReadyAt = currentTime;
+  int sharedPages =
+      process->sharedRegion != NULL ? process->sharedRegion->totalPages : 0;
+  for (int p = 0; p < process->totalPages + sharedPages &&
+                  !process->pagesLoaded && process->state != TERMINATED;
+       p++) {
+    bool write = p < process->writtenPages;
+    const Page *target = p < process->totalPages
+                             ? &process->pages[p]
+                             : &process->sharedPages[p - process->totalPages];
+    Page *page = translateAddress(process, target->virtualAddress, write,
+                                  currentTime);
+    if (page != NULL)
+      mrcRecordReference(process->id, page);
+    if (page != NULL && !page->inMemory) {
+      // Registrar el estado de los marcos (solo los cambios, salvo en las
+      // instantáneas completas)
+      recordFrameSnapshot(currentTime);
+      handlePageFault(page, currentTime);
+
+      // Reintentar el acceso tras el fallo (llena el TLB)
+      translateAddress(process, page->virtualAddress, write, currentTime);
+    }
+    if (page != NULL && page->readyTime > pagesReadyAt)
+      pagesReadyAt = page->readyTime;
+  }
+  process->pagesLoaded = false;
+  chargeMemoryWork();
+
+  // El OOM killer lo eligió como víctima durante sus fallos
+  if (process->state == TERMINATED)
+    return false;
+  if (pagesReadyAt <= currentTime)
+    return true;
+  char buffer[256];
+  process->state = WAITING;
+  process->blockedUntil = pagesReadyAt;
+  process->pagesLoaded = true;
+  snprintf(buffer, sizeof(buffer),
+           "Proceso %d bloqueado esperando swap hasta %lld", process->id,
+           pagesReadyAt);
+  logMessage(buffer);
+  return false;
+}
+
+// Registrar en el historial el estado de cada proceso que ya llegó (running
+// es el que tiene la CPU) y la longitud de la cola de listos
+static void recordHistory(const Process *running) {
+  if (!historyEnabled())
+    return;
+  int ready = 0;
+  for (int i = 0; i < processCount; i++) {
+    const Process *process = processQueue[i];
+    if (process->startTime > currentTime)
+      continue;
+    int state = READY;
+    if (process->state == TERMINATED)
+      state = TERMINATED;
+    else if (process == running)
+      state = RUNNING;
+    else if (process->blockedUntil > currentTime ||
+             (process->realTime != NULL && process->state == WAITING))
+      state = WAITING;
+    else
+      ready++;
+    historyRecord(HISTORY_PROCESS, currentTime, process->id, state,
+                  process->cpu);
+  }
+  historyRecord(HISTORY_QUEUE, currentTime, 0, ready, 0);
+}
+
+// Retirar un proceso terminado y liberar su memoria, su CPU y su grupo
+static void retireProcess(Process *process, int *activeProcesses) {
+  process->state = TERMINATED;
+  process->turnaroundTime = currentTime - process->startTime;
+  (*activeProcesses)--;
+  releaseProcessMemory(process, currentTime);
+  numaReleaseProcess(process);
+  detachProcessFromGroup(process);
+  onlineProcessCompleted(process, currentTime);
+  recordHistory(NULL);
+}
+
+// Terminar un proceso que completó su última ráfaga
+static void completeProcess(Process *process, int *activeProcesses) {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "Proceso %d completado en tiempo %lld",
+           process->id, currentTime);
+  logMessage(buffer);
+  retireProcess(process, activeProcesses);
+}
+
+// Retirar los procesos que eliminó el OOM killer (su memoria ya se liberó);
+// su E/S pendiente termina sin despertarlos
+static void reapOomVictims(int *activeProcesses) {
+  Process *victim;
+  while ((victim = oomTakeVictim()) != NULL) {
+    ioForgetProcess(victim);
+    retireProcess(victim, activeProcesses);
+  }
+}
+
+// Ejecutar los trabajos de tiempo real activos hasta que no quede ninguno
+// listo: cada tramo termina en la siguiente activación, que puede traer un
+// trabajo más prioritario. Devuelve true si se ejecutó alguno
+static bool runRealTime(int *activeProcesses) {
+  RealTimeTask *task;
+  bool ran = false;
+
+  while ((task = realTimeNext(currentTime)) != NULL) {
+    Process *process = task->process;
+    ran = true;
+    swapAdvance(currentTime);
+    ioAdvance(currentTime);
+    pageCacheWriteBack(currentTime);
+    runBackgroundReclaim(currentTime);
+    chargeMemoryWork();
+
+    if (process->cpu == NO_CPU)
+      process->responseTime = currentTime - process->startTime;
+    advanceClock(currentTime + numaScheduleProcess(process, currentTime),
+                 false);
+    SimTime slice = realTimeSlice(task, currentTime);
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer),
+             "Tiempo %lld: Cambiando a tarea de tiempo real %d (plazo %lld, "
+             "tramo %lld)",
+             currentTime, process->id, task->absoluteDeadline, slice);
+    logMessage(buffer);
+    process->state = RUNNING;
+    recordHistory(process);
+    recordFragmentationSample(currentTime);
+    tlbContextSwitch(process->id);
+    bool loaded = loadProcessPages(process);
+    reapOomVictims(activeProcesses);
+    if (!loaded)
+      continue;
+
+    advanceClock(currentTime + slice, false);
+    if (realTimeCharge(task, slice, currentTime))
+      completeProcess(process, activeProcesses);
+  }
+  return ran;
+}
+
+// Avanzar el reloj sin trabajo de Round Robin hasta time atendiendo por el
+// camino las activaciones de tiempo real
+static void idleUntil(SimTime time, int *activeProcesses) {
+  while (currentTime < time) {
+    SimTime event = realTimeNextEvent(currentTime);
+    advanceClock(event > currentTime && event < time ? event : time, true);
+    runRealTime(activeProcesses);
+  }
+}
+
 void advancedRoundRobinScheduler() {
-  int currentTime = 0;
-  int activeProcesses = processCount;
+  // Tras restaurar un checkpoint la simulación sigue desde su reloj con
+  // los procesos que aún no terminaron
+  int activeProcesses = 0;
+  for (int i = 0; i < processCount; i++) {
+    if (processQueue[i]->state != TERMINATED)
+      activeProcesses++;
+  }
   logMessage("Iniciando Round Robin Scheduler con Quantum");
+  displayFrameQuotas();
+
+  while (activeProcesses > 0 || onlineStreamOpen()) {
+    bool dispatched = false;
+    SimTime nextWakeup = -1;
+    recordHistory(NULL);
+
+    // Incorporar las llegadas del modo en línea; sin procesos activos se
+    // espera a la siguiente. En modo sincronizado el tiempo de pared que
+    // pasó esperándolas también es tiempo simulado
+    if (onlineStreamOpen()) {
+      activeProcesses += onlineIngest(currentTime, activeProcesses == 0);
+      advanceClock(simclockSync(currentTime), true);
+    }
+
+    // Guardar el checkpoint pedido entre dos pasadas por la cola
+    if (checkpointPath != NULL && currentTime >= checkpointTime) {
+      saveCheckpoint(checkpointPath);
+      checkpointPath = NULL;
+    }
+
+    // La clase de tiempo real se adelanta siempre a Round Robin
+    dispatched = runRealTime(&activeProcesses);
 
-  while (activeProcesses > 0) {
     for (int i = 0; i < processCount; i++) {
       Process *currentProcess = processQueue[i];
 
-      // Saltar procesos ya terminados
-      if (currentProcess->state == TERMINATED)
+      // Saltar procesos ya terminados y las tareas de tiempo real, que no
+      // reciben quantums de Round Robin
+      if (currentProcess->state == TERMINATED ||
+          currentProcess->realTime != NULL)
         continue;
 
       // Verificar si el proceso ya puede comenzar
       if (currentTime < currentProcess->startTime) {
-        currentTime = currentProcess->startTime;
+        idleUntil(currentProcess->startTime, &activeProcesses);
+      }
+
+      // Atender las activaciones de tiempo real pendientes
+      if (runRealTime(&activeProcesses))
+        dispatched = true;
+
+      // Retirar las operaciones de swap y de E/S ya completadas, escribir
+      // las páginas sucias de la caché que expiraron y dar su turno al
+      // demonio de reclamación
+      swapAdvance(currentTime);
+      ioAdvance(currentTime);
+      pageCacheWriteBack(currentTime);
+      runBackgroundReclaim(currentTime);
+      chargeMemoryWork();
+
+      // Saltar procesos bloqueados esperando la lectura de sus páginas o su
+      // E/S; las esperas se solapan con la ejecución de los demás
+      if (currentProcess->blockedUntil > currentTime) {
+        if (nextWakeup < 0 || currentProcess->blockedUntil < nextWakeup)
+          nextWakeup = currentProcess->blockedUntil;
+        continue;
       }
 
-      // Calcular tiempo de ejecución en este quantum
-      int executionTime =
-          (currentProcess->cpuBurstTimes[currentProcess->burstIndex] < QUANTUM)
+      // Saltar procesos cuyo grupo agotó su cuota de CPU del periodo
+      SimTime throttledUntil = groupThrottledUntil(currentProcess, currentTime);
+      if (throttledUntil > currentTime) {
+        if (nextWakeup < 0 || throttledUntil < nextWakeup)
+          nextWakeup = throttledUntil;
+        continue;
+      }
+      dispatched = true;
+
+      // Su primer quantum fija el tiempo de respuesta
+      if (currentProcess->cpu == NO_CPU)
+        currentProcess->responseTime = currentTime - currentProcess->startTime;
+
+      // Elegir su CPU por afinidad; cambiar de nodo cuesta tiempo
+      advanceClock(currentTime + numaScheduleProcess(currentProcess, currentTime),
+                   false);
+
+      // Calcular tiempo de ejecución en este quantum (el peso y la cuota
+      // de su grupo lo ajustan)
+      SimTime quantum = groupQuantum(currentProcess, QUANTUM, currentTime);
+      SimTime executionTime =
+          (currentProcess->cpuBurstTimes[currentProcess->burstIndex] < quantum)
               ? currentProcess->cpuBurstTimes[currentProcess->burstIndex]
-              : QUANTUM;
+              : quantum;
+
+      // Una activación de tiempo real expropia el resto del quantum
+      executionTime = realTimePreempt(currentTime, executionTime);
 
       // Información de cambio de contexto
       char buffer[256];
       snprintf(buffer, sizeof(buffer),
-               "Tiempo %d: Cambiando a Proceso %d (Quantum %d)", currentTime,
-               currentProcess->id, executionTime);
+               "Tiempo %lld: Cambiando a Proceso %d (Quantum %lld)",
+               currentTime, currentProcess->id, executionTime);
       logMessage(buffer);
 
       // Simular ejecución del proceso
       currentProcess->state = RUNNING;
+      recordHistory(currentProcess);
 
-      // Simular acceso de páginas durante la ejecución
-      for (int p = 0; p < currentProcess->totalPages; p++) {
-        if (!currentProcess->pages[p].inMemory) {
-          // Mostrar estado de los marcos al final de cada ciclo
-          displayMemoryFrames(currentTime);
-          handlePageFault(&currentProcess->pages[p], currentTime);
-        }
-      }
+      // Muestrear la fragmentación externa de la memoria física
+      recordFragmentationSample(currentTime);
+
+      // Cambiar el espacio de direcciones activo en el TLB
+      tlbContextSwitch(currentProcess->id);
+
+      // Simular acceso de páginas durante la ejecución; si alguna llega
+      // desde swap el proceso espera bloqueado
+      bool loaded = loadProcessPages(currentProcess);
+      reapOomVictims(&activeProcesses);
+      if (!loaded)
+        continue;
 
       currentProcess->cpuBurstTimes[currentProcess->burstIndex] -=
           executionTime;
-      currentTime += executionTime;
+      groupChargeCpu(currentProcess, executionTime, currentTime);
+      advanceClock(currentTime + executionTime, false);
 
       // Verificar si la ráfaga de CPU ha terminado
       if (currentProcess->cpuBurstTimes[currentProcess->burstIndex] <= 0) {
         // Pasar a la siguiente ráfaga o terminar
         currentProcess->burstIndex++;
         if (currentProcess->burstIndex >= currentProcess->totalBursts) {
-          currentProcess->state = TERMINATED;
-          activeProcesses--;
-          snprintf(buffer, sizeof(buffer), "Proceso %d completado en tiempo %d",
-                   currentProcess->id, currentTime);
-          logMessage(buffer);
+          completeProcess(currentProcess, &activeProcesses);
         } else {
-          // Simular tiempo de E/S
-          int ioTime =
+          // Simular la E/S: si la ráfaga accede a un archivo, los aciertos en
+          // la caché de páginas la acortan; lo que queda se encola en un
+          // dispositivo y el proceso espera bloqueado a que termine
+          SimTime ioTime =
               currentProcess->ioBurstTimes[currentProcess->burstIndex - 1];
+          const FileRequest *request =
+              currentProcess->ioRequests != NULL
+                  ? &currentProcess->ioRequests[currentProcess->burstIndex - 1]
+                  : NULL;
+          int devicePages = 1;
+          if (request != NULL)
+            ioTime = pageCacheAccess(request, currentProcess->id, ioTime,
+                                     currentTime, &devicePages);
           currentProcess->state = WAITING;
           snprintf(buffer, sizeof(buffer),
-                   "Proceso %d esperando E/S por %d tiempo", currentProcess->id,
-                   ioTime);
+                   "Proceso %d esperando E/S por %lld tiempo",
+                   currentProcess->id, ioTime);
           logMessage(buffer);
-          currentTime += ioTime;
+          if (devicePages > 0) {
+            int device =
+                request != NULL ? ioDeviceForFile(request->fileId) : 0;
+            long sector =
+                request != NULL
+                    ? ioSector(request->fileId, request->offset / PAGE_SIZE)
+                    : ioSector(-currentProcess->id, 0);
+            submitIoRequest(device, currentProcess, sector, ioTime,
+                            request != NULL && request->write, currentTime);
+          } else {
+            // Todo se sirvió desde la caché: solo la copia en memoria
+            currentProcess->blockedUntil = currentTime + ioTime;
+          }
         }
       }
     }
+
+    // Si todos los procesos esperan (swap o E/S), avanzar hasta el primero
+    // que quede libre o hasta la siguiente finalización de E/S
+    SimTime ioEvent = ioNextCompletion();
+    if (ioEvent > currentTime && (nextWakeup < 0 || ioEvent < nextWakeup))
+      nextWakeup = ioEvent;
+    SimTime realTimeEvent = realTimeNextEvent(currentTime);
+    if (realTimeEvent > currentTime &&
+        (nextWakeup < 0 || realTimeEvent < nextWakeup))
+      nextWakeup = realTimeEvent;
+    if (!dispatched && nextWakeup > currentTime)
+      advanceClock(nextWakeup, true);
+
+    // Los procesos admitidos en línea que terminaron dejan su hueco
+    int kept = 0;
+    for (int i = 0; i < processCount; i++) {
+      if (processQueue[i]->state != TERMINATED ||
+          !onlineReleaseProcess(processQueue[i]))
+        processQueue[kept++] = processQueue[i];
+    }
+    processCount = kept;
   }
+  recordHistory(NULL);
   logMessage("Round Robin Scheduler finalizado");
+  displayTlbStatistics();
+  displaySwapStatistics();
+  displayPrefetchStatistics();
+  displayPageCacheStatistics();
+  displayIoStatistics();
+  displayNumaStatistics();
+  displayRealTimeStatistics();
+  displayReclaimStatistics();
+  displayZswapStatistics();
+  displayTierStatistics();
+  displayMrcStatistics();
+  displayResourceGroupStatistics();
+  displayOomStatistics();
+  displayFrameLogStatistics();
 }
 
 Process **getProcessQueue() { return processQueue; }
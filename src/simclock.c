@@ -0,0 +1,136 @@
+#include "simclock.h"
+#include "memory.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static ClockMode clockMode = CLOCK_MODE_BATCH;
+static double ticksPerSecond = SIMCLOCK_TICKS_PER_SECOND;
+static struct timespec wallStart;  // Configuración del reloj
+static struct timespec wallAnchor; // Instante de pared del tick ancla
+static SimTime tickAnchor = 0;
+static bool anchored = false;
+static bool started = false;
+static ClockStatistics clockStats;
+
+static double secondsBetween(const struct timespec *from,
+                             const struct timespec *to) {
+  return (to->tv_sec - from->tv_sec) + (to->tv_nsec - from->tv_nsec) / 1e9;
+}
+
+bool configureSimulationClock(ClockMode mode, double rate) {
+  if (mode == CLOCK_MODE_PACED && !(rate > 0.0))
+    return false;
+  clockMode = mode;
+  ticksPerSecond = rate;
+  anchored = false;
+  memset(&clockStats, 0, sizeof(clockStats));
+  clock_gettime(CLOCK_MONOTONIC, &wallStart);
+  started = true;
+  return true;
+}
+
+ClockMode simclockMode() { return clockMode; }
+
+// Esperar hasta el instante de pared del tick indicado
+static void pace(SimTime from, SimTime to) {
+  struct timespec now, target;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  if (!anchored) {
+    wallAnchor = now;
+    tickAnchor = from;
+    anchored = true;
+  }
+
+  double offset = (to - tickAnchor) / ticksPerSecond;
+  long seconds = (long)offset;
+  target.tv_sec = wallAnchor.tv_sec + seconds;
+  target.tv_nsec =
+      wallAnchor.tv_nsec + (long)((offset - seconds) * 1e9 + 0.5);
+  while (target.tv_nsec >= 1000000000L) {
+    target.tv_sec++;
+    target.tv_nsec -= 1000000000L;
+  }
+
+  double ahead = secondsBetween(&now, &target);
+  if (ahead <= 0.0) {
+    // La simulación va por detrás del reloj de pared: no se recupera
+    // durmiendo menos después, solo se registra el retraso
+    // (menos de un tick de retraso no cuenta)
+    SimTime lag = (SimTime)(-ahead * ticksPerSecond);
+    if (lag > 0)
+      clockStats.lateAdvances++;
+    if (lag > clockStats.maxLagTicks)
+      clockStats.maxLagTicks = lag;
+    return;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL) ==
+         EINTR)
+    ;
+  clockStats.sleptSeconds += ahead;
+}
+
+SimTime simclockAdvance(SimTime from, SimTime to) {
+  if (to <= from)
+    return from;
+  clockStats.busyTicks += to - from;
+  clockStats.advances++;
+  if (clockMode == CLOCK_MODE_PACED)
+    pace(from, to);
+  return to;
+}
+
+SimTime simclockSkip(SimTime from, SimTime to) {
+  if (to <= from)
+    return from;
+  clockStats.idleTicks += to - from;
+  clockStats.advances++;
+  if (clockMode == CLOCK_MODE_PACED)
+    pace(from, to);
+  return to;
+}
+
+SimTime simclockSync(SimTime time) {
+  if (clockMode != CLOCK_MODE_PACED || !anchored)
+    return time;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  SimTime tick = tickAnchor + (SimTime)(secondsBetween(&wallAnchor, &now) *
+                                        ticksPerSecond);
+  return tick > time ? tick : time;
+}
+
+double simclockWallSeconds() {
+  struct timespec now;
+  if (!started) {
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+    started = true;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return secondsBetween(&wallStart, &now);
+}
+
+ClockStatistics getClockStatistics() { return clockStats; }
+
+void displayClockStatistics() {
+  double wall = simclockWallSeconds();
+  long events = eventLogLength();
+
+  if (clockMode == CLOCK_MODE_PACED)
+    printf("Reloj: sincronizado a %.1f ticks/s, %lld ticks ocupados, %lld "
+           "inactivos, %.3f s dormidos, %ld avances tardíos (retraso máximo "
+           "%lld ticks)\n",
+           ticksPerSecond, clockStats.busyTicks, clockStats.idleTicks,
+           clockStats.sleptSeconds, clockStats.lateAdvances,
+           clockStats.maxLagTicks);
+  else
+    printf("Reloj: por lotes, %lld ticks ocupados, %lld inactivos "
+           "saltados\n",
+           clockStats.busyTicks, clockStats.idleTicks);
+  printf("Reloj: %ld eventos en %.3f s de pared (%.0f eventos/s, %.0f "
+         "ticks/s)\n",
+         events, wall, wall > 0.0 ? events / wall : 0.0,
+         wall > 0.0 ? (clockStats.busyTicks + clockStats.idleTicks) / wall
+                    : 0.0);
+}
@@ -0,0 +1,30 @@
+#include "simtime.h"
+
+SimTime simTimeAdd(SimTime a, SimTime b) {
+  SimTime sum;
+  if (__builtin_add_overflow(a, b, &sum))
+    return b > 0 ? SIM_TIME_MAX : -SIM_TIME_MAX;
+  return sum;
+}
+
+SimTime simTimeFromNanoseconds(long long nanoseconds) {
+  return nanoseconds / SIM_TICK_NS;
+}
+
+double simTimeToSeconds(SimTime ticks) {
+  return (double)ticks * SIM_TICK_NS / 1e9;
+}
+
+void accumulateTime(TimeAccumulator *accumulator, SimTime sample) {
+  SimTime sum = simTimeAdd(accumulator->sum, sample);
+  if (sum == SIM_TIME_MAX || sum == -SIM_TIME_MAX)
+    accumulator->saturated = true;
+  accumulator->sum = sum;
+  accumulator->count++;
+}
+
+double accumulatorMean(const TimeAccumulator *accumulator) {
+  return accumulator->count > 0
+             ? (double)accumulator->sum / accumulator->count
+             : 0.0;
+}
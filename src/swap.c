@@ -0,0 +1,219 @@
+#include "swap.h"
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Estado del dispositivo de swap simulado
+static Page **slotOwner = NULL; // Página almacenada en cada slot
+static int *slotRefs = NULL;    // Páginas que comparten cada slot (fork)
+static int swapSlots = 0;
+static int swapLatency = SWAP_LATENCY;
+static int swapBandwidth = SWAP_BANDWIDTH;
+static int readAheadCluster = SWAP_READAHEAD_CLUSTER;
+static int slotCursor = 0; // Siguiente slot a probar (asignación rotatoria)
+static SimTime busyUntil = 0; // El dispositivo atiende en orden FIFO
+static SwapRequest queue[SWAP_QUEUE_DEPTH];
+static int queueHead = 0;
+static int queueLength = 0;
+static SwapStatistics swapStats;
+
+bool configureSwapDevice(int slots, int latency, int bandwidth, int cluster) {
+  if (slots <= 0 || latency < 0 || bandwidth <= 0 || cluster <= 0)
+    return false;
+
+  Page **owners = calloc(slots, sizeof(Page *));
+  int *refs = calloc(slots, sizeof(int));
+  if (owners == NULL || refs == NULL) {
+    free(owners);
+    free(refs);
+    return false;
+  }
+
+  free(slotOwner);
+  free(slotRefs);
+  slotOwner = owners;
+  slotRefs = refs;
+  swapSlots = slots;
+  swapLatency = latency;
+  swapBandwidth = bandwidth;
+  readAheadCluster = cluster;
+  slotCursor = 0;
+  busyUntil = 0;
+  queueHead = queueLength = 0;
+  memset(&swapStats, 0, sizeof(swapStats));
+  return true;
+}
+
+// Asignar un slot libre; los slots consecutivos favorecen la lectura
+// anticipada de páginas desalojadas juntas
+static int allocateSlot(Page *page) {
+  if (slotOwner == NULL)
+    configureSwapDevice(SWAP_SLOTS, SWAP_LATENCY, SWAP_BANDWIDTH,
+                        SWAP_READAHEAD_CLUSTER);
+
+  for (int i = 0; i < swapSlots; i++) {
+    int slot = (slotCursor + i) % swapSlots;
+    if (slotRefs[slot] == 0) {
+      slotOwner[slot] = page;
+      slotRefs[slot] = 1;
+      slotCursor = (slot + 1) % swapSlots;
+      return slot;
+    }
+  }
+  return NO_SWAP_SLOT;
+}
+
+// Encolar una operación y calcular su finalización en el dispositivo
+static SimTime submitRequest(SwapOperation operation, int slot, int pages,
+                             SimTime currentTime) {
+  SimTime start = busyUntil > currentTime ? busyUntil : currentTime;
+  int transfer = (pages + swapBandwidth - 1) / swapBandwidth;
+  SimTime completeTime = start + swapLatency + transfer;
+
+  swapAdvance(currentTime);
+  if (queueLength == SWAP_QUEUE_DEPTH) {
+    // Cola llena: la operación más antigua ya no se registra
+    queueHead = (queueHead + 1) % SWAP_QUEUE_DEPTH;
+    queueLength--;
+  }
+  SwapRequest *request = &queue[(queueHead + queueLength) % SWAP_QUEUE_DEPTH];
+  request->operation = operation;
+  request->slot = slot;
+  request->pages = pages;
+  request->submitTime = currentTime;
+  request->completeTime = completeTime;
+  queueLength++;
+  if (queueLength > swapStats.maxQueueDepth)
+    swapStats.maxQueueDepth = queueLength;
+
+  accumulateTime(&swapStats.queueDelay, start - currentTime);
+  if (operation == SWAP_WRITE)
+    swapStats.writeBackTime += completeTime - start;
+  busyUntil = completeTime;
+  return completeTime;
+}
+
+SimTime swapWriteBack(Page *page, SimTime currentTime) {
+  // Un slot compartido tras un fork conserva el contenido de los demás
+  if (page->swapSlot != NO_SWAP_SLOT && slotRefs[page->swapSlot] > 1)
+    swapFreeSlot(page);
+  if (page->swapSlot == NO_SWAP_SLOT)
+    page->swapSlot = allocateSlot(page);
+  if (page->swapSlot == NO_SWAP_SLOT) {
+    swapStats.slotExhausted++;
+    return -1;
+  }
+
+  int pages = 1 << PAGE_SIZE_ORDER(page->sizeClass);
+  SimTime completeTime =
+      submitRequest(SWAP_WRITE, page->swapSlot, pages, currentTime);
+  page->dirty = false;
+  swapStats.writes++;
+  swapStats.pagesWritten += pages;
+  return completeTime;
+}
+
+SimTime swapReadPage(Page *page, Page **readAhead, int *readAheadCount,
+                     SimTime currentTime) {
+  int found = 0;
+
+  // Reunir las páginas fuera de memoria de la ventana alineada del slot
+  if (readAhead != NULL && readAheadCount != NULL) {
+    int first = page->swapSlot - page->swapSlot % readAheadCluster;
+    for (int slot = first;
+         slot < first + readAheadCluster && slot < swapSlots &&
+         found < *readAheadCount;
+         slot++) {
+      Page *neighbour = slotOwner[slot];
+      if (neighbour != NULL && neighbour != page && !neighbour->inMemory &&
+          neighbour->sizeClass == PAGE_SIZE_4K &&
+          neighbour->processId != SHARED_REGION_OWNER &&
+          neighbour->zswapEntry == NO_ZSWAP_ENTRY)
+        readAhead[found++] = neighbour;
+    }
+    *readAheadCount = found;
+  }
+
+  int pages = (1 << PAGE_SIZE_ORDER(page->sizeClass)) + found;
+  SimTime completeTime =
+      submitRequest(SWAP_READ, page->swapSlot, pages, currentTime);
+  swapStats.reads++;
+  swapStats.pagesRead += pages;
+  swapStats.readAheadPages += found;
+  return completeTime;
+}
+
+void swapShareSlot(Page *page, int slot) {
+  if (slot == NO_SWAP_SLOT || slotRefs == NULL || slotRefs[slot] == 0)
+    return;
+  slotRefs[slot]++;
+  page->swapSlot = slot;
+}
+
+void swapFreeSlot(Page *page) {
+  int slot = page->swapSlot;
+  if (slot != NO_SWAP_SLOT && slotRefs != NULL && slotRefs[slot] > 0) {
+    slotRefs[slot]--;
+    // Sin su dueño el slot sigue ocupado, pero ya no se lee por anticipado
+    if (slotRefs[slot] == 0 || slotOwner[slot] == page)
+      slotOwner[slot] = NULL;
+  }
+  page->swapSlot = NO_SWAP_SLOT;
+}
+
+bool swapRestoreSlot(Page *page, int slot) {
+  if (slotOwner == NULL)
+    configureSwapDevice(SWAP_SLOTS, SWAP_LATENCY, SWAP_BANDWIDTH,
+                        SWAP_READAHEAD_CLUSTER);
+  page->swapSlot = NO_SWAP_SLOT;
+  if (slot == NO_SWAP_SLOT)
+    return true;
+  if (slot < 0 || slot >= swapSlots)
+    return false;
+  if (slotRefs[slot]++ == 0)
+    slotOwner[slot] = page;
+  page->swapSlot = slot;
+  return true;
+}
+
+void swapAdvance(SimTime currentTime) {
+  while (queueLength > 0 && queue[queueHead].completeTime <= currentTime) {
+    queueHead = (queueHead + 1) % SWAP_QUEUE_DEPTH;
+    queueLength--;
+  }
+}
+
+void swapRecordReadAhead(bool used) {
+  if (used)
+    swapStats.readAheadHits++;
+  else
+    swapStats.readAheadWasted++;
+}
+
+SimTime swapBusyUntil() { return busyUntil; }
+
+int swapSlotCount() { return swapSlots; }
+
+SwapStatistics getSwapStatistics() { return swapStats; }
+
+void displaySwapStatistics() {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Swap: %ld lecturas (%ld páginas), %ld escrituras (%ld páginas), "
+           "%ld slots agotados",
+           swapStats.reads, swapStats.pagesRead, swapStats.writes,
+           swapStats.pagesWritten, swapStats.slotExhausted);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Lectura anticipada: %ld páginas, %ld usadas, %ld desperdiciadas",
+           swapStats.readAheadPages, swapStats.readAheadHits,
+           swapStats.readAheadWasted);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Cola del dispositivo: espera acumulada %lld, tiempo en escrituras "
+           "%lld, profundidad máxima %d",
+           swapStats.queueDelay.sum, swapStats.writeBackTime,
+           swapStats.maxQueueDepth);
+  logMessage(buffer);
+}
@@ -0,0 +1,135 @@
+#include "tiering.h"
+#include "memory.h"
+#include <stdio.h>
+#include <string.h>
+
+// Estado de la promoción y degradación entre niveles de memoria
+static bool enabled = false;
+static int sampleRate = TIER_SAMPLE_RATE;
+static SimTime hotWindow = TIER_HOT_WINDOW;
+static int promoteThreshold = TIER_PROMOTE_THRESHOLD;
+static int migrationBudget = TIER_MIGRATION_BUDGET;
+static SimTime migrationWindow = TIER_MIGRATION_WINDOW;
+static SimTime migrationCost = TIER_MIGRATION_COST;
+static long slowAccessCount = 0;   // Accesos lentos vistos (para muestrear)
+static SimTime windowStart = 0;    // Inicio de la ventana de migración
+static int windowMigrations = 0;   // Páginas migradas en la ventana
+static SimTime pendingTime = 0;    // Tiempo de migración sin cargar al reloj
+static TierProcessStatistics processStats[TIER_MAX_PROCESSES];
+static TierStatistics tierStats;
+
+bool configureTiering(int rate, SimTime window, int threshold, int budget,
+                      SimTime budgetWindow, SimTime cost) {
+  if (rate < 1 || window < 0 || threshold < 1 || budget < 1 ||
+      budgetWindow < 1 || cost < 0)
+    return false;
+  sampleRate = rate;
+  hotWindow = window;
+  promoteThreshold = threshold;
+  migrationBudget = budget;
+  migrationWindow = budgetWindow;
+  migrationCost = cost;
+  enabled = true;
+  slowAccessCount = 0;
+  windowStart = 0;
+  windowMigrations = 0;
+  pendingTime = 0;
+  for (int i = 0; i < TIER_MAX_PROCESSES; i++)
+    processStats[i] = (TierProcessStatistics){-1, 0, 0};
+  memset(&tierStats, 0, sizeof(tierStats));
+  return true;
+}
+
+bool tieringEnabled() { return enabled; }
+
+// Entrada de estadísticas de un proceso (NULL si la tabla está llena)
+static TierProcessStatistics *processEntry(int processId) {
+  for (int i = 0; i < TIER_MAX_PROCESSES; i++) {
+    if (processStats[i].processId == processId)
+      return &processStats[i];
+    if (processStats[i].processId < 0) {
+      processStats[i].processId = processId;
+      return &processStats[i];
+    }
+  }
+  return NULL;
+}
+
+bool tierRecordAccess(int processId, bool slow, SimTime sinceLastUse,
+                      int *hotSamples) {
+  if (!enabled)
+    return false;
+  TierProcessStatistics *entry = processEntry(processId);
+  if (entry != NULL) {
+    if (slow)
+      entry->slowAccesses++;
+    else
+      entry->fastAccesses++;
+  }
+  if (!slow || slowAccessCount++ % sampleRate != 0)
+    return false;
+
+  // Una muestra caliente es un reuso dentro de la ventana; una fría
+  // reinicia la cuenta de la página
+  tierStats.samples++;
+  if (sinceLastUse > hotWindow) {
+    *hotSamples = 0;
+    return false;
+  }
+  tierStats.hotSamples++;
+  return ++*hotSamples >= promoteThreshold;
+}
+
+bool tierMigrationAllowed(SimTime currentTime) {
+  if (currentTime - windowStart >= migrationWindow) {
+    windowStart = currentTime - (currentTime - windowStart) % migrationWindow;
+    windowMigrations = 0;
+  }
+  if (windowMigrations < migrationBudget)
+    return true;
+  tierStats.throttled++;
+  return false;
+}
+
+void tierRecordMigration(bool promotion) {
+  if (promotion)
+    tierStats.promotions++;
+  else
+    tierStats.demotions++;
+  windowMigrations++;
+  pendingTime += migrationCost;
+  tierStats.migrationTime += migrationCost;
+}
+
+SimTime tierTakeMigrationTime() {
+  SimTime time = pendingTime;
+  pendingTime = 0;
+  return time;
+}
+
+TierStatistics getTierStatistics() { return tierStats; }
+
+void displayTierStatistics() {
+  char buffer[256];
+  if (!enabled)
+    return;
+
+  snprintf(buffer, sizeof(buffer),
+           "Niveles: %ld muestras (%ld calientes), %ld páginas promovidas, "
+           "%ld degradadas, %ld migraciones aplazadas, tiempo de migración "
+           "%lld",
+           tierStats.samples, tierStats.hotSamples, tierStats.promotions,
+           tierStats.demotions, tierStats.throttled, tierStats.migrationTime);
+  logMessage(buffer);
+  for (int i = 0; i < TIER_MAX_PROCESSES && processStats[i].processId >= 0;
+       i++) {
+    const TierProcessStatistics *entry = &processStats[i];
+    long accesses = entry->fastAccesses + entry->slowAccesses;
+    snprintf(buffer, sizeof(buffer),
+             "Niveles: Proceso %d, %ld accesos, %ld a memoria lenta "
+             "(fracción rápida %.2f)",
+             entry->processId, accesses, entry->slowAccesses,
+             accesses > 0 ? (double)entry->fastAccesses / accesses : 0.0);
+    logMessage(buffer);
+  }
+}
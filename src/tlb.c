@@ -0,0 +1,165 @@
+#include "tlb.h"
+#include "memory.h"
+#include "pagetable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Estado del TLB simulado
+static TlbEntry *tlbEntries = NULL;
+static int tlbSets = 0;
+static int tlbWays = 0;
+static bool tlbUseAsid = TLB_USE_ASID;
+static int currentAsid = -1;
+static unsigned long tlbClock = 0;
+static TlbStatistics tlbStats;
+
+bool initializeTlb(int sets, int ways, bool useAsid) {
+  // El número de conjuntos debe ser potencia de 2 para indexar con máscara
+  if (sets <= 0 || ways <= 0 || (sets & (sets - 1)) != 0)
+    return false;
+
+  TlbEntry *entries = calloc((size_t)sets * ways, sizeof(TlbEntry));
+  if (entries == NULL)
+    return false;
+
+  free(tlbEntries);
+  tlbEntries = entries;
+  tlbSets = sets;
+  tlbWays = ways;
+  tlbUseAsid = useAsid;
+  currentAsid = -1;
+  tlbClock = 0;
+  memset(&tlbStats, 0, sizeof(tlbStats));
+  return true;
+}
+
+// Primera entrada del conjunto que corresponde a la página virtual
+static TlbEntry *tlbSet(unsigned long vpn) {
+  return &tlbEntries[(vpn & (unsigned long)(tlbSets - 1)) * tlbWays];
+}
+
+// Buscar la entrada de una página virtual de un tamaño concreto
+static TlbEntry *findEntry(int asid, unsigned long vpn,
+                           PageSizeClass sizeClass) {
+  TlbEntry *set = tlbSet(vpn);
+  for (int w = 0; w < tlbWays; w++) {
+    if (set[w].valid && set[w].asid == asid && set[w].vpn == vpn &&
+        set[w].sizeClass == sizeClass)
+      return &set[w];
+  }
+  return NULL;
+}
+
+Page *tlbLookup(int asid, unsigned long virtualAddress) {
+  if (tlbEntries == NULL)
+    initializeTlb(TLB_SETS, TLB_WAYS, TLB_USE_ASID);
+
+  // Probar cada tamaño de página, como un TLB unificado multi-tamaño
+  for (int c = 0; c < NUM_PAGE_SIZES; c++) {
+    TlbEntry *entry =
+        findEntry(asid, virtualPageNumber(virtualAddress, c), c);
+    if (entry != NULL) {
+      entry->lastUsed = ++tlbClock;
+      tlbStats.hits++;
+      return entry->page;
+    }
+  }
+  tlbStats.misses++;
+  return NULL;
+}
+
+void tlbInsert(int asid, Page *page) {
+  if (tlbEntries == NULL)
+    initializeTlb(TLB_SETS, TLB_WAYS, TLB_USE_ASID);
+
+  unsigned long vpn = virtualPageNumber(page->virtualAddress, page->sizeClass);
+  TlbEntry *set = tlbSet(vpn);
+  TlbEntry *victim = &set[0];
+
+  // Preferir una entrada inválida; si no hay, la menos recientemente usada
+  for (int w = 0; w < tlbWays; w++) {
+    if (!set[w].valid) {
+      victim = &set[w];
+      break;
+    }
+    if (set[w].lastUsed < victim->lastUsed)
+      victim = &set[w];
+  }
+  victim->valid = true;
+  victim->asid = asid;
+  victim->vpn = vpn;
+  victim->sizeClass = page->sizeClass;
+  victim->page = page;
+  victim->lastUsed = ++tlbClock;
+}
+
+void tlbInvalidate(int asid, const Page *page) {
+  if (tlbEntries == NULL)
+    return;
+
+  TlbEntry *entry = findEntry(
+      asid, virtualPageNumber(page->virtualAddress, page->sizeClass),
+      page->sizeClass);
+  if (entry != NULL) {
+    entry->valid = false;
+    tlbStats.invalidations++;
+  }
+}
+
+void tlbFlushAsid(int asid) {
+  for (int i = 0; i < tlbSets * tlbWays; i++) {
+    if (tlbEntries[i].valid && tlbEntries[i].asid == asid)
+      tlbEntries[i].valid = false;
+  }
+}
+
+void tlbContextSwitch(int asid) {
+  if (asid == currentAsid)
+    return;
+  currentAsid = asid;
+
+  // Sin ASID las traducciones del proceso anterior no son válidas
+  if (!tlbUseAsid && tlbEntries != NULL) {
+    for (int i = 0; i < tlbSets * tlbWays; i++)
+      tlbEntries[i].valid = false;
+    tlbStats.flushes++;
+  }
+}
+
+void tlbRecordWalk(int levelsVisited) {
+  tlbStats.walks++;
+  tlbStats.walkCost += (long)levelsVisited * PAGE_WALK_LEVEL_COST;
+}
+
+unsigned long tlbReach() {
+  unsigned long reach = 0;
+  for (int i = 0; i < tlbSets * tlbWays; i++) {
+    if (tlbEntries[i].valid)
+      reach += PAGE_SIZE_BYTES(tlbEntries[i].sizeClass);
+  }
+  return reach;
+}
+
+TlbStatistics getTlbStatistics() { return tlbStats; }
+
+void displayTlbStatistics() {
+  char buffer[256];
+  long lookups = tlbStats.hits + tlbStats.misses;
+  double hitRate = lookups > 0 ? 100.0 * tlbStats.hits / lookups : 0.0;
+  double avgWalk =
+      tlbStats.walks > 0 ? (double)tlbStats.walkCost / tlbStats.walks : 0.0;
+
+  snprintf(buffer, sizeof(buffer),
+           "TLB (%d conjuntos x %d vías, %s): %ld aciertos, %ld fallos, "
+           "tasa de aciertos %.2f%%",
+           tlbSets, tlbWays, tlbUseAsid ? "con ASID" : "vaciado en cambio",
+           tlbStats.hits, tlbStats.misses, hitRate);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "Recorridos de tabla: %ld, coste total %ld, coste medio %.2f, "
+           "vaciados %ld, invalidaciones %ld",
+           tlbStats.walks, tlbStats.walkCost, avgWalk, tlbStats.flushes,
+           tlbStats.invalidations);
+  logMessage(buffer);
+}
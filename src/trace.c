@@ -0,0 +1,756 @@
+#include "trace.h"
+#include "memory.h"
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Tipos de evento de la traza
+typedef enum {
+  TRACE_EVENT_SWITCH, // Cambio de contexto de pid a nextPid
+  TRACE_EVENT_WAKEUP, // pid despierta
+  TRACE_EVENT_SAMPLE  // Muestra de /proc/pid/stat
+} TraceEventKind;
+
+// Evento analizado de una línea
+typedef struct {
+  double time;           // Segundos de la traza
+  long order;            // Posición en el archivo (desempate estable)
+  long cpuTicks;         // Muestra: utime + stime (USER_HZ)
+  long ioTicks;          // Muestra: delayacct_blkio_ticks
+  long rss;              // Muestra: páginas residentes
+  int pid;               // Tarea que sale, despierta o se muestrea
+  int nextPid;           // Tarea que entra (cambio de contexto)
+  int priority;          // Prioridad del núcleo de pid
+  int nextPriority;      // Prioridad del núcleo de nextPid
+  TraceEventKind kind;
+  bool sleeps;           // pid sale de la CPU a dormir (no expropiada)
+  bool hasIoTicks;       // Muestra: la línea llega al campo 42
+  char comm[TRACE_COMM_LENGTH];
+  char nextComm[TRACE_COMM_LENGTH];
+} TraceEvent;
+
+// Fragmento del archivo analizado por un hilo
+typedef struct {
+  const char *begin;
+  const char *end;
+  bool procStat;      // Formato de muestras de /proc
+  TraceEvent *events; // Eventos del fragmento en orden de archivo
+  long count;
+  long capacity;
+  long lines;
+  long skipped;
+  bool failed;        // Sin memoria
+} TraceChunk;
+
+// Estado de una tarea mientras se recorren los eventos
+typedef struct {
+  TraceTask task;
+  double cpuSeconds;  // CPU de la ráfaga en curso
+  double ioSeconds;   // Espera en curso
+  double runStart;    // Entrada en la CPU (si running)
+  double sleepStart;  // Inicio de la espera (si sleeping)
+  double firstRun;    // Primera ejecución (< 0: aún no)
+  long lastCpuTicks;  // Muestra anterior (< 0: ninguna)
+  long lastIoTicks;
+  int capacity;       // Capacidad de las listas de ráfagas
+  bool running;
+  bool sleeping;
+} TaskBuilder;
+
+// Copiar una línea (acotada) con terminador
+static void copyLine(const char *begin, const char *end, char *line) {
+  size_t length = end - begin;
+  if (length >= TRACE_MAX_LINE)
+    length = TRACE_MAX_LINE - 1;
+  memcpy(line, begin, length);
+  line[length] = '\0';
+}
+
+// Copiar un nombre de tarea de [begin, end)
+static void copyComm(char *comm, const char *begin, const char *end) {
+  size_t length = end > begin ? (size_t)(end - begin) : 0;
+  if (length >= TRACE_COMM_LENGTH)
+    length = TRACE_COMM_LENGTH - 1;
+  memcpy(comm, begin, length);
+  comm[length] = '\0';
+}
+
+// Una tarea deja la CPU durmiendo salvo con estado R (expropiada)
+static bool sleepingState(const char *state) {
+  while (*state == ' ')
+    state++;
+  return *state != '\0' && *state != 'R';
+}
+
+// Tarea en formato compacto de perf ("comm:pid [prio]"), hasta end
+static bool parseCompactTask(const char *begin, const char *end, char *comm,
+                             int *pid, int *priority) {
+  const char *bracket = strstr(begin, " [");
+  if (bracket == NULL || (end != NULL && bracket > end))
+    return false;
+  const char *colon = bracket;
+  while (colon > begin && *colon != ':')
+    colon--;
+  if (*colon != ':')
+    return false;
+  while (*begin == ' ')
+    begin++;
+  copyComm(comm, begin, colon);
+  *pid = atoi(colon + 1);
+  *priority = atoi(bracket + 2);
+  return true;
+}
+
+// Analizar una línea sched_switch / sched_wakeup de ftrace o perf
+static bool parseSchedLine(const char *line, TraceEvent *event) {
+  const char *name = strstr(line, "sched_switch:");
+  event->kind = TRACE_EVENT_SWITCH;
+  if (name == NULL) {
+    name = strstr(line, "sched_wakeup");
+    event->kind = TRACE_EVENT_WAKEUP;
+  }
+  if (name == NULL)
+    return false;
+  const char *args = strchr(name, ':');
+  if (args == NULL)
+    return false;
+  args++;
+
+  // El tiempo es el campo que acaba en ':' antes del nombre del evento
+  // (con el prefijo "sched:" de perf)
+  const char *mark = name;
+  if (mark - line >= 6 && strncmp(mark - 6, "sched:", 6) == 0)
+    mark -= 6;
+  while (mark > line && mark[-1] == ' ')
+    mark--;
+  if (mark == line || mark[-1] != ':')
+    return false;
+  const char *stampEnd = mark - 1;
+  const char *stamp = stampEnd;
+  while (stamp > line && stamp[-1] != ' ')
+    stamp--;
+  char *parsed;
+  event->time = strtod(stamp, &parsed);
+  if (parsed != stampEnd)
+    return false;
+
+  if (event->kind == TRACE_EVENT_WAKEUP) {
+    const char *comm = strstr(args, "comm=");
+    const char *pid = strstr(args, " pid=");
+    if (comm != NULL && pid != NULL) {
+      const char *prio = strstr(pid, " prio=");
+      copyComm(event->comm, comm + 5, pid);
+      event->pid = atoi(pid + 5);
+      event->priority = prio != NULL ? atoi(prio + 6) : 120;
+      return true;
+    }
+    return parseCompactTask(args, NULL, event->comm, &event->pid,
+                            &event->priority);
+  }
+
+  const char *prevComm = strstr(args, "prev_comm=");
+  const char *prevPid = strstr(args, " prev_pid=");
+  const char *prevPrio = strstr(args, " prev_prio=");
+  const char *prevState = strstr(args, " prev_state=");
+  const char *nextComm = strstr(args, " next_comm=");
+  const char *nextPid = strstr(args, " next_pid=");
+  const char *nextPrio = strstr(args, " next_prio=");
+  if (prevComm != NULL && prevPid != NULL && prevState != NULL &&
+      nextComm != NULL && nextPid != NULL) {
+    copyComm(event->comm, prevComm + 10, prevPid);
+    event->pid = atoi(prevPid + 10);
+    event->priority = prevPrio != NULL ? atoi(prevPrio + 11) : 120;
+    event->sleeps = sleepingState(prevState + 12);
+    copyComm(event->nextComm, nextComm + 11, nextPid);
+    event->nextPid = atoi(nextPid + 10);
+    event->nextPriority = nextPrio != NULL ? atoi(nextPrio + 11) : 120;
+    return true;
+  }
+
+  // Formato compacto: "prev:pid [prio] ESTADO ==> next:pid [prio]"
+  const char *arrow = strstr(args, " ==> ");
+  if (arrow == NULL ||
+      !parseCompactTask(args, arrow, event->comm, &event->pid,
+                        &event->priority) ||
+      !parseCompactTask(arrow + 5, NULL, event->nextComm, &event->nextPid,
+                        &event->nextPriority))
+    return false;
+  const char *state = strstr(args, "] ");
+  event->sleeps = state != NULL && state < arrow && sleepingState(state + 2);
+  return true;
+}
+
+// Analizar una muestra "TIEMPO pid (comm) estado ..." de /proc/pid/stat
+static bool parseStatLine(const char *line, TraceEvent *event) {
+  char *cursor;
+  event->kind = TRACE_EVENT_SAMPLE;
+  event->time = strtod(line, &cursor);
+  if (cursor == line)
+    return false;
+  event->pid = (int)strtol(cursor, &cursor, 10);
+  const char *open = strchr(cursor, '(');
+  const char *close = strrchr(cursor, ')');
+  if (open == NULL || close == NULL || close < open)
+    return false;
+  copyComm(event->comm, open + 1, close);
+
+  // Campos numéricos desde el 4 (ppid); el 3 es el estado
+  cursor = (char *)close + 1;
+  while (*cursor == ' ')
+    cursor++;
+  if (*cursor == '\0')
+    return false;
+  cursor++;
+  long utime = 0, stime = 0, priority = 20;
+  event->rss = 0;
+  event->ioTicks = 0;
+  int field = 4;
+  for (; field <= 42; field++) {
+    char *next;
+    long value = strtol(cursor, &next, 10);
+    if (next == cursor)
+      break;
+    cursor = next;
+    if (field == 14)
+      utime = value;
+    else if (field == 15)
+      stime = value;
+    else if (field == 18)
+      priority = value;
+    else if (field == 24)
+      event->rss = value;
+    else if (field == 42)
+      event->ioTicks = value;
+  }
+
+  // Una línea cortada antes de stime no es una muestra: tomarla como 0
+  // falsearía la base de la siguiente
+  if (field <= 15)
+    return false;
+  event->hasIoTicks = field > 42;
+  event->cpuTicks = utime + stime;
+  // priority es 20 + nice para las tareas normales (prio 120 + nice)
+  event->priority = 100 + (int)priority;
+  return true;
+}
+
+// Línea con datos (ni vacía ni comentario)
+static bool dataLine(const char *line) {
+  while (*line == ' ' || *line == '\t' || *line == '\r')
+    line++;
+  return *line != '\0' && *line != '#';
+}
+
+// Analizar las líneas de un fragmento (hilo del análisis paralelo)
+static void *parseChunk(void *argument) {
+  TraceChunk *chunk = argument;
+  char line[TRACE_MAX_LINE];
+  const char *cursor = chunk->begin;
+
+  while (cursor < chunk->end) {
+    const char *newline = memchr(cursor, '\n', chunk->end - cursor);
+    const char *lineEnd = newline != NULL ? newline : chunk->end;
+    copyLine(cursor, lineEnd, line);
+    cursor = lineEnd + 1;
+    chunk->lines++;
+    if (!dataLine(line))
+      continue;
+
+    if (chunk->count == chunk->capacity) {
+      long capacity = chunk->capacity > 0 ? 2 * chunk->capacity : 4096;
+      TraceEvent *events =
+          realloc(chunk->events, capacity * sizeof(TraceEvent));
+      if (events == NULL) {
+        chunk->failed = true;
+        return NULL;
+      }
+      chunk->events = events;
+      chunk->capacity = capacity;
+    }
+    TraceEvent *event = &chunk->events[chunk->count];
+    memset(event, 0, sizeof(TraceEvent));
+    if (chunk->procStat ? parseStatLine(line, event)
+                        : parseSchedLine(line, event))
+      chunk->count++;
+    else
+      chunk->skipped++;
+  }
+  return NULL;
+}
+
+// Detectar el formato por la primera línea con datos
+static TraceFormat detectFormat(const char *data, size_t size) {
+  char line[TRACE_MAX_LINE];
+  const char *cursor = data, *end = data + size;
+
+  while (cursor < end) {
+    const char *newline = memchr(cursor, '\n', end - cursor);
+    const char *lineEnd = newline != NULL ? newline : end;
+    copyLine(cursor, lineEnd, line);
+    cursor = lineEnd + 1;
+    if (!dataLine(line))
+      continue;
+    if (strstr(line, "sched:sched_") != NULL)
+      return TRACE_FORMAT_PERF_SCHED;
+    if (strstr(line, "sched_") != NULL)
+      return TRACE_FORMAT_FTRACE;
+    return TRACE_FORMAT_PROC_STAT;
+  }
+  return TRACE_FORMAT_AUTO;
+}
+
+// Orden de los eventos: por tiempo y, a igualdad, por posición
+static int compareEvents(const void *a, const void *b) {
+  const TraceEvent *x = a, *y = b;
+  if (x->time != y->time)
+    return x->time < y->time ? -1 : 1;
+  return (x->order > y->order) - (x->order < y->order);
+}
+
+// Tabla de tareas indexada por PID (direccionamiento abierto)
+typedef struct {
+  TaskBuilder *builders;
+  int count;
+  int capacity;
+  int *slots;      // Índice en builders (-1 si vacío)
+  int slotCapacity; // Potencia de dos, al menos el doble de count
+} TaskTable;
+
+static int *findTaskSlot(TaskTable *table, int pid) {
+  unsigned mask = (unsigned)table->slotCapacity - 1;
+  unsigned slot = ((unsigned)pid * 2654435761u) & mask;
+  while (table->slots[slot] >= 0 &&
+         table->builders[table->slots[slot]].task.pid != pid)
+    slot = (slot + 1) & mask;
+  return &table->slots[slot];
+}
+
+// Tarea de un PID, creada en su primer evento; NULL si no hay memoria
+static TaskBuilder *taskFor(TaskTable *table, int pid, const char *comm,
+                            int priority) {
+  if (2 * (table->count + 1) > table->slotCapacity) {
+    int capacity = table->slotCapacity > 0 ? 2 * table->slotCapacity : 256;
+    int *slots = malloc(capacity * sizeof(int));
+    if (slots == NULL)
+      return NULL;
+    for (int i = 0; i < capacity; i++)
+      slots[i] = -1;
+    free(table->slots);
+    table->slots = slots;
+    table->slotCapacity = capacity;
+    for (int i = 0; i < table->count; i++)
+      *findTaskSlot(table, table->builders[i].task.pid) = i;
+  }
+  int *slot = findTaskSlot(table, pid);
+  if (*slot >= 0)
+    return &table->builders[*slot];
+
+  if (table->count == table->capacity) {
+    int capacity = table->capacity > 0 ? 2 * table->capacity : 64;
+    TaskBuilder *builders =
+        realloc(table->builders, capacity * sizeof(TaskBuilder));
+    if (builders == NULL)
+      return NULL;
+    table->builders = builders;
+    table->capacity = capacity;
+  }
+  TaskBuilder *builder = &table->builders[table->count];
+  memset(builder, 0, sizeof(TaskBuilder));
+  builder->task.pid = pid;
+  snprintf(builder->task.comm, sizeof(builder->task.comm), "%s", comm);
+  builder->task.kernelPriority = priority;
+  builder->firstRun = -1.0;
+  builder->lastCpuTicks = builder->lastIoTicks = -1;
+  *slot = table->count++;
+  return builder;
+}
+
+// Convertir segundos de la traza en ticks (al menos uno)
+static SimTime toTicks(double seconds, double ticksPerSecond) {
+  SimTime ticks = (SimTime)llround(seconds * ticksPerSecond);
+  return ticks > 0 ? ticks : 1;
+}
+
+// Añadir una ráfaga (de CPU o de E/S) a la tarea
+static bool pushBurst(TaskBuilder *builder, bool cpu, double seconds,
+                      double ticksPerSecond) {
+  TraceTask *task = &builder->task;
+  if (task->totalBursts == builder->capacity) {
+    int capacity = builder->capacity > 0 ? 2 * builder->capacity : 8;
+    SimTime *cpuBursts =
+        realloc(task->cpuBursts, capacity * sizeof(SimTime));
+    if (cpuBursts == NULL)
+      return false;
+    task->cpuBursts = cpuBursts;
+    SimTime *ioBursts = realloc(task->ioBursts, capacity * sizeof(SimTime));
+    if (ioBursts == NULL)
+      return false;
+    task->ioBursts = ioBursts;
+    builder->capacity = capacity;
+  }
+  if (cpu)
+    task->cpuBursts[task->totalBursts++] = toTicks(seconds, ticksPerSecond);
+  else
+    task->ioBursts[task->totalBursts - 1] = toTicks(seconds, ticksPerSecond);
+  return true;
+}
+
+// La tarea consumió CPU: la espera pendiente (si sigue a una ráfaga) se
+// cierra como E/S
+static bool taskRan(TaskBuilder *builder, double seconds,
+                    double ticksPerSecond) {
+  if (builder->ioSeconds > 0.0 && builder->task.totalBursts > 0 &&
+      !pushBurst(builder, false, builder->ioSeconds, ticksPerSecond))
+    return false;
+  builder->ioSeconds = 0.0;
+  builder->cpuSeconds += seconds;
+  return true;
+}
+
+// La tarea esperó E/S: la ráfaga de CPU en curso se cierra
+static bool taskWaited(TaskBuilder *builder, double seconds,
+                       double ticksPerSecond) {
+  if (builder->cpuSeconds > 0.0 &&
+      !pushBurst(builder, true, builder->cpuSeconds, ticksPerSecond))
+    return false;
+  builder->cpuSeconds = 0.0;
+  builder->ioSeconds += seconds;
+  return true;
+}
+
+// Aplicar un evento a las tareas que afecta
+static bool applyEvent(TaskTable *table, const TraceEvent *event,
+                       double ticksPerSecond) {
+  TaskBuilder *builder;
+  double t = event->time;
+
+  switch (event->kind) {
+  case TRACE_EVENT_SAMPLE: {
+    builder = taskFor(table, event->pid, event->comm, event->priority);
+    if (builder == NULL)
+      return false;
+    long rss = event->rss < TRACE_MAX_PAGES ? event->rss : TRACE_MAX_PAGES;
+    if (rss > builder->task.pages)
+      builder->task.pages = (int)rss;
+    if (builder->lastCpuTicks >= 0) {
+      long cpu = event->cpuTicks - builder->lastCpuTicks;
+      long io = event->ioTicks - builder->lastIoTicks;
+      if (cpu > 0 && builder->firstRun < 0.0)
+        builder->firstRun = t;
+      // En un intervalo con ambas, la CPU precede a la espera
+      if (cpu > 0 &&
+          !taskRan(builder, (double)cpu / TRACE_PROC_HZ, ticksPerSecond))
+        return false;
+      if (io > 0 &&
+          !taskWaited(builder, (double)io / TRACE_PROC_HZ, ticksPerSecond))
+        return false;
+    }
+    builder->lastCpuTicks = event->cpuTicks;
+    builder->lastIoTicks = event->ioTicks;
+    return true;
+  }
+  case TRACE_EVENT_WAKEUP:
+    builder = taskFor(table, event->pid, event->comm, event->priority);
+    if (builder == NULL)
+      return false;
+    if (builder->sleeping) {
+      builder->sleeping = false;
+      return taskWaited(builder, t - builder->sleepStart, ticksPerSecond);
+    }
+    return true;
+  case TRACE_EVENT_SWITCH:
+    // La tarea inactiva (PID 0) no es una carga
+    if (event->pid != 0) {
+      builder = taskFor(table, event->pid, event->comm, event->priority);
+      if (builder == NULL)
+        return false;
+      if (builder->running) {
+        builder->running = false;
+        if (!taskRan(builder, t - builder->runStart, ticksPerSecond))
+          return false;
+      }
+      if (event->sleeps) {
+        builder->sleeping = true;
+        builder->sleepStart = t;
+      }
+    }
+    if (event->nextPid != 0) {
+      builder = taskFor(table, event->nextPid, event->nextComm,
+                        event->nextPriority);
+      if (builder == NULL)
+        return false;
+      // Sin su sched_wakeup, la espera termina al volver a la CPU
+      if (builder->sleeping) {
+        builder->sleeping = false;
+        if (!taskWaited(builder, t - builder->sleepStart, ticksPerSecond))
+          return false;
+      }
+      builder->running = true;
+      builder->runStart = t;
+      if (builder->firstRun < 0.0)
+        builder->firstRun = t;
+    }
+    return true;
+  }
+  return false;
+}
+
+// Cerrar las tareas al final de la traza y conservar las que ejecutaron
+static bool finishTasks(TaskTable *table, double endTime, double startTime,
+                        double ticksPerSecond, TraceWorkload *workload) {
+  workload->tasks = malloc((table->count > 0 ? table->count : 1) *
+                           sizeof(TraceTask));
+  if (workload->tasks == NULL)
+    return false;
+  for (int i = 0; i < table->count; i++) {
+    TaskBuilder *builder = &table->builders[i];
+    if (builder->running &&
+        !taskRan(builder, endTime - builder->runStart, ticksPerSecond))
+      return false;
+    if (builder->cpuSeconds > 0.0 &&
+        !pushBurst(builder, true, builder->cpuSeconds, ticksPerSecond))
+      return false;
+    TraceTask *task = &builder->task;
+    if (task->totalBursts == 0) {
+      free(task->cpuBursts);
+      free(task->ioBursts);
+      continue;
+    }
+    task->startTime =
+        (SimTime)llround((builder->firstRun - startTime) * ticksPerSecond);
+    if (task->pages <= 0)
+      task->pages = TRACE_DEFAULT_PAGES;
+    workload->tasks[workload->taskCount++] = *task;
+  }
+  return true;
+}
+
+// Liberar las listas de las tareas aún en construcción
+static void releaseBuilders(TaskTable *table) {
+  for (int i = 0; i < table->count; i++) {
+    free(table->builders[i].task.cpuBursts);
+    free(table->builders[i].task.ioBursts);
+  }
+}
+
+// Convertir los eventos ordenados en tareas con ráfagas
+static bool buildTasks(TraceEvent *events, long count, double ticksPerSecond,
+                       TraceWorkload *workload) {
+  TaskTable table = {NULL, 0, 0, NULL, 0};
+  bool built = true;
+  for (long i = 0; i < count && built; i++)
+    built = applyEvent(&table, &events[i], ticksPerSecond);
+  if (built)
+    built = finishTasks(&table, events[count - 1].time, events[0].time,
+                        ticksPerSecond, workload);
+  if (!built) {
+    releaseBuilders(&table);
+    free(workload->tasks);
+    workload->tasks = NULL;
+    workload->taskCount = 0;
+  }
+  free(table.builders);
+  free(table.slots);
+  return built;
+}
+
+// Analizar los fragmentos en paralelo y juntar sus eventos en orden de
+// archivo; NULL si falta memoria o no hay eventos
+static TraceEvent *parseChunks(const char *data, size_t size, bool procStat,
+                               int threads, TraceWorkload *workload,
+                               long *count) {
+  long maxChunks = (long)(size / TRACE_MIN_CHUNK) + 1;
+  int chunkCount = threads < maxChunks ? threads : (int)maxChunks;
+  TraceChunk *chunks = calloc(chunkCount, sizeof(TraceChunk));
+  pthread_t *workers = calloc(chunkCount, sizeof(pthread_t));
+  TraceEvent *events = NULL;
+  if (chunks == NULL || workers == NULL) {
+    free(chunks);
+    free(workers);
+    return NULL;
+  }
+
+  // Cortar en fin de línea: cada fragmento empieza tras un '\n'
+  const char *end = data + size;
+  for (int c = 0; c < chunkCount; c++) {
+    const char *begin = c == 0 ? data : chunks[c - 1].end;
+    const char *cut = c == chunkCount - 1
+                          ? end
+                          : data + (size_t)((double)size * (c + 1) /
+                                            chunkCount);
+    if (cut < begin)
+      cut = begin;
+    if (cut < end) {
+      const char *newline = memchr(cut, '\n', end - cut);
+      cut = newline != NULL ? newline + 1 : end;
+    }
+    chunks[c].begin = begin;
+    chunks[c].end = cut;
+    chunks[c].procStat = procStat;
+  }
+  int started = 0;
+  for (int c = 1; c < chunkCount; c++) {
+    if (pthread_create(&workers[c], NULL, parseChunk, &chunks[c]) != 0)
+      break;
+    started = c;
+  }
+  parseChunk(&chunks[0]);
+  for (int c = 1; c <= started; c++)
+    pthread_join(workers[c], NULL);
+  // Un hilo que no se pudo crear se analiza aquí
+  for (int c = started + 1; c < chunkCount; c++)
+    parseChunk(&chunks[c]);
+
+  bool failed = false;
+  long total = 0;
+  for (int c = 0; c < chunkCount; c++) {
+    failed = failed || chunks[c].failed;
+    total += chunks[c].count;
+    workload->lines += chunks[c].lines;
+    workload->skipped += chunks[c].skipped;
+  }
+  if (!failed && total > 0)
+    events = malloc(total * sizeof(TraceEvent));
+  *count = 0;
+  for (int c = 0; c < chunkCount; c++) {
+    if (events != NULL) {
+      memcpy(events + *count, chunks[c].events,
+             chunks[c].count * sizeof(TraceEvent));
+      *count += chunks[c].count;
+    }
+    free(chunks[c].events);
+  }
+  workload->chunks = chunkCount;
+  free(chunks);
+  free(workers);
+
+  // Con la contabilidad de blkio (alguna muestra llega al campo 42), las
+  // muestras cortadas antes de él tampoco se reconocen
+  bool blkio = false;
+  for (long i = 0; procStat && events != NULL && i < *count; i++)
+    blkio = blkio || events[i].hasIoTicks;
+  long kept = 0;
+  for (long i = 0; blkio && i < *count; i++) {
+    if (events[i].hasIoTicks)
+      events[kept++] = events[i];
+  }
+  if (blkio) {
+    workload->skipped += *count - kept;
+    *count = kept;
+  }
+  return events;
+}
+
+bool importTrace(const char *path, TraceFormat format, double ticksPerSecond,
+                 int threads, TraceWorkload *workload) {
+  char buffer[256];
+  static const char *formatNames[] = {"automático", "ftrace", "perf sched",
+                                      "/proc/stat"};
+  memset(workload, 0, sizeof(TraceWorkload));
+  if (!(ticksPerSecond > 0.0) || threads < 1)
+    return false;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return false;
+  }
+  size_t size = (size_t)info.st_size;
+  const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+  madvise((void *)data, size, MADV_SEQUENTIAL);
+
+  if (format == TRACE_FORMAT_AUTO)
+    format = detectFormat(data, size);
+  long count = 0;
+  TraceEvent *events =
+      format == TRACE_FORMAT_AUTO
+          ? NULL
+          : parseChunks(data, size, format == TRACE_FORMAT_PROC_STAT,
+                        threads, workload, &count);
+  munmap((void *)data, size);
+  workload->format = format;
+  if (events == NULL)
+    return false;
+
+  // Los búferes por CPU de ftrace pueden intercalar tiempos
+  for (long i = 0; i < count; i++)
+    events[i].order = i;
+  qsort(events, count, sizeof(TraceEvent), compareEvents);
+  workload->events = count;
+  bool built = buildTasks(events, count, ticksPerSecond, workload);
+  free(events);
+  if (!built)
+    return false;
+
+  snprintf(buffer, sizeof(buffer),
+           "Traza %s (%s): %ld líneas, %ld eventos, %ld sin reconocer, %d "
+           "tareas",
+           path, formatNames[format], workload->lines, workload->events,
+           workload->skipped, workload->taskCount);
+  logMessage(buffer);
+  return true;
+}
+
+// Prioridad del simulador de una prioridad del núcleo
+static ProcessPriority schedulerPriority(int kernelPriority) {
+  if (kernelPriority < 120)
+    return SYSTEM_PRIORITY;
+  return kernelPriority == 120 ? INTERACTIVE_PRIORITY : BACKGROUND_PRIORITY;
+}
+
+Process *traceTaskProcess(const TraceTask *task, int id) {
+  Process *process = calloc(1, sizeof(Process));
+  if (process == NULL)
+    return NULL;
+  process->cpuBurstTimes = malloc(task->totalBursts * sizeof(SimTime));
+  process->ioBurstTimes = malloc(task->totalBursts * sizeof(SimTime));
+  process->ownsBursts = true;
+  if (process->cpuBurstTimes == NULL || process->ioBurstTimes == NULL) {
+    releaseProcessPages(process);
+    free(process);
+    return NULL;
+  }
+  memcpy(process->cpuBurstTimes, task->cpuBursts,
+         task->totalBursts * sizeof(SimTime));
+  if (task->totalBursts > 1)
+    memcpy(process->ioBurstTimes, task->ioBursts,
+           (task->totalBursts - 1) * sizeof(SimTime));
+
+  process->id = id;
+  process->startTime = task->startTime;
+  process->priority = schedulerPriority(task->kernelPriority);
+  process->totalBursts = task->totalBursts;
+  process->totalPages = task->pages;
+  process->memorySize = task->pages * PAGE_SIZE;
+  process->writtenPages = 1;
+  process->state = READY;
+  pthread_mutex_init(&process->processMutex, NULL);
+  if (!initializeProcessPages(process)) {
+    releaseProcessPages(process);
+    free(process);
+    return NULL;
+  }
+  return process;
+}
+
+void releaseTraceWorkload(TraceWorkload *workload) {
+  for (int i = 0; i < workload->taskCount; i++) {
+    free(workload->tasks[i].cpuBursts);
+    free(workload->tasks[i].ioBursts);
+  }
+  free(workload->tasks);
+  workload->tasks = NULL;
+  workload->taskCount = 0;
+}
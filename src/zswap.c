@@ -0,0 +1,269 @@
+#include "zswap.h"
+#include "memory.h"
+#include "rng.h"
+#include "swap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Entrada del almacén: una página comprimida en la lista LRU
+typedef struct {
+  Page *page; // Página guardada (NULL si la entrada está libre)
+  int size;   // Bytes que ocupa comprimida
+  int prev;   // Anterior (más antigua) en la lista LRU
+  int next;   // Siguiente en la lista LRU o en la lista libre
+} ZswapEntry;
+
+// Distribución de ratios por defecto: una parte de las páginas no se
+// comprime y la mayoría se reduce a la mitad o a un tercio
+static const ZswapRatioClass defaultRatios[] = {
+    {1.0, 0.1}, {2.0, 0.3}, {3.0, 0.4}, {4.0, 0.2}};
+
+static ZswapEntry *entries = NULL;
+static int entryCount = 0;
+static int freeEntry = NO_ZSWAP_ENTRY; // Cabeza de la lista libre
+static int lruHead = NO_ZSWAP_ENTRY;   // Página guardada hace más tiempo
+static int lruTail = NO_ZSWAP_ENTRY;
+static int poolFrameList[NUM_FRAMES]; // Marcos reservados para el almacén
+static int poolFrames = 0;
+static long usedBytes = 0;
+static ZswapRatioClass ratios[ZSWAP_MAX_RATIO_CLASSES];
+static int ratioCount = 0;
+static double ratioWeight = 0.0; // Suma de los pesos de las clases
+static SimTime compressCost = ZSWAP_COMPRESS_COST;
+static SimTime decompressCost = ZSWAP_DECOMPRESS_COST;
+static SimTime pendingCpuTime = 0;
+static RngStream ratioRng;
+static ZswapStatistics zswapStats;
+
+// Menor tamaño de una página comprimida
+#define ZSWAP_MIN_ENTRY_SIZE ((int)(PAGE_SIZE / ZSWAP_MAX_RATIO))
+
+static void unlinkEntry(int index) {
+  ZswapEntry *entry = &entries[index];
+  if (entry->prev != NO_ZSWAP_ENTRY)
+    entries[entry->prev].next = entry->next;
+  else
+    lruHead = entry->next;
+  if (entry->next != NO_ZSWAP_ENTRY)
+    entries[entry->next].prev = entry->prev;
+  else
+    lruTail = entry->prev;
+}
+
+// Retirar una página del almacén y devolver su entrada a la lista libre
+static void releaseEntry(int index) {
+  ZswapEntry *entry = &entries[index];
+  unlinkEntry(index);
+  usedBytes -= entry->size;
+  entry->page->zswapEntry = NO_ZSWAP_ENTRY;
+  entry->page = NULL;
+  entry->next = freeEntry;
+  freeEntry = index;
+}
+
+// Expulsar a swap la página más antigua del almacén; solo se escribe si
+// su copia en swap no está al día
+static void writeBackOldest(SimTime currentTime) {
+  char buffer[256];
+  Page *page = entries[lruHead].page;
+
+  releaseEntry(lruHead);
+  zswapStats.writebacks++;
+  if (!page->dirty && page->swapSlot != NO_SWAP_SLOT)
+    return;
+  SimTime doneTime = swapWriteBack(page, currentTime);
+  if (doneTime < 0)
+    return;
+  snprintf(buffer, sizeof(buffer),
+           "zswap: página %d devuelta a swap en el slot %d (termina en %lld)",
+           page->id, page->swapSlot, doneTime);
+  logMessage(buffer);
+}
+
+bool configureZswap(int frames, const ZswapRatioClass *classes, int count,
+                    SimTime compress, SimTime decompress,
+                    SimTime currentTime) {
+  char buffer[256];
+  if (classes == NULL) {
+    classes = defaultRatios;
+    count = sizeof(defaultRatios) / sizeof(defaultRatios[0]);
+  }
+  if (frames < 0 || frames >= NUM_FRAMES || count < 1 ||
+      count > ZSWAP_MAX_RATIO_CLASSES || compress < 0 || decompress < 0)
+    return false;
+  double weight = 0.0;
+  for (int i = 0; i < count; i++) {
+    if (classes[i].ratio < 1.0 || classes[i].weight < 0.0)
+      return false;
+    weight += classes[i].weight;
+  }
+  if (!(weight > 0.0))
+    return false;
+
+  // Vaciar el almacén anterior y devolver sus marcos
+  while (lruHead != NO_ZSWAP_ENTRY)
+    writeBackOldest(currentTime);
+  for (int i = 0; i < poolFrames; i++)
+    freeKernelBlock(poolFrameList[i]);
+  free(entries);
+  entries = NULL;
+  entryCount = poolFrames = 0;
+  usedBytes = 0;
+  freeEntry = lruHead = lruTail = NO_ZSWAP_ENTRY;
+
+  memcpy(ratios, classes, count * sizeof(ZswapRatioClass));
+  ratioCount = count;
+  ratioWeight = weight;
+  compressCost = compress;
+  decompressCost = decompress;
+  pendingCpuTime = 0;
+  rngSeed(&ratioRng, ZSWAP_RNG_STREAM);
+  memset(&zswapStats, 0, sizeof(zswapStats));
+  if (frames == 0)
+    return true;
+
+  // El almacén ocupa marcos fijos de la memoria física
+  entryCount = frames * FRAME_SIZE / ZSWAP_MIN_ENTRY_SIZE;
+  entries = calloc(entryCount, sizeof(ZswapEntry));
+  if (entries == NULL) {
+    entryCount = 0;
+    return false;
+  }
+  for (int i = 0; i < entryCount; i++)
+    entries[i].next = i + 1 < entryCount ? i + 1 : NO_ZSWAP_ENTRY;
+  freeEntry = 0;
+  while (poolFrames < frames) {
+    int frame = allocateKernelBlock(0, FRAME_ZSWAP, currentTime);
+    if (frame == NO_FRAME)
+      break;
+    poolFrameList[poolFrames++] = frame;
+  }
+  snprintf(buffer, sizeof(buffer),
+           "zswap: almacén comprimido de %d marcos (%d KiB)", poolFrames,
+           poolFrames * FRAME_SIZE / 1024);
+  logMessage(buffer);
+  return poolFrames == frames;
+}
+
+// Sortear el tamaño comprimido de una página según la distribución
+static int compressedSize(double *ratio) {
+  double u = rngUniform(&ratioRng) * ratioWeight;
+  int c = 0;
+  while (c < ratioCount - 1 && u >= ratios[c].weight) {
+    u -= ratios[c].weight;
+    c++;
+  }
+  *ratio = ratios[c].ratio < ZSWAP_MAX_RATIO ? ratios[c].ratio
+                                              : ZSWAP_MAX_RATIO;
+  return (int)(PAGE_SIZE / *ratio + 0.5);
+}
+
+bool zswapStore(Page *page, SimTime currentTime) {
+  char buffer[256];
+  double ratio;
+  if (poolFrames == 0)
+    return false;
+
+  // Comprimir cuesta CPU aunque el resultado no compense guardarlo
+  int size = compressedSize(&ratio);
+  pendingCpuTime += compressCost;
+  zswapStats.cpuTime += compressCost;
+  if (ratio < ZSWAP_REJECT_RATIO) {
+    zswapStats.rejected++;
+    return false;
+  }
+
+  while (lruHead != NO_ZSWAP_ENTRY &&
+         (usedBytes + size > (long)poolFrames * FRAME_SIZE ||
+          freeEntry == NO_ZSWAP_ENTRY))
+    writeBackOldest(currentTime);
+
+  int index = freeEntry;
+  ZswapEntry *entry = &entries[index];
+  freeEntry = entry->next;
+  entry->page = page;
+  entry->size = size;
+  entry->prev = lruTail;
+  entry->next = NO_ZSWAP_ENTRY;
+  if (lruTail != NO_ZSWAP_ENTRY)
+    entries[lruTail].next = index;
+  else
+    lruHead = index;
+  lruTail = index;
+  page->zswapEntry = index;
+  usedBytes += size;
+  if (usedBytes > zswapStats.maxUsedBytes)
+    zswapStats.maxUsedBytes = usedBytes;
+  zswapStats.stores++;
+  zswapStats.storedBytes += size;
+  zswapStats.originalBytes += PAGE_SIZE;
+
+  snprintf(buffer, sizeof(buffer),
+           "zswap: página %d comprimida a %d bytes (ratio %.1f, almacén "
+           "%ld/%d bytes, Tiempo: %lld)",
+           page->id, size, ratio, usedBytes, poolFrames * FRAME_SIZE,
+           currentTime);
+  logMessage(buffer);
+  return true;
+}
+
+bool zswapLoad(Page *page, SimTime currentTime) {
+  char buffer[256];
+  if (page->zswapEntry == NO_ZSWAP_ENTRY) {
+    if (poolFrames > 0 && page->swapSlot != NO_SWAP_SLOT)
+      zswapStats.swapLoads++;
+    return false;
+  }
+
+  releaseEntry(page->zswapEntry);
+  pendingCpuTime += decompressCost;
+  zswapStats.cpuTime += decompressCost;
+  zswapStats.loads++;
+  snprintf(buffer, sizeof(buffer),
+           "zswap: página %d descomprimida (Tiempo: %lld)", page->id,
+           currentTime);
+  logMessage(buffer);
+  return true;
+}
+
+void zswapInvalidate(Page *page) {
+  if (page->zswapEntry == NO_ZSWAP_ENTRY)
+    return;
+  releaseEntry(page->zswapEntry);
+  zswapStats.invalidated++;
+}
+
+SimTime zswapTakeCpuTime() {
+  SimTime cpuTime = pendingCpuTime;
+  pendingCpuTime = 0;
+  return cpuTime;
+}
+
+ZswapStatistics getZswapStatistics() { return zswapStats; }
+
+void displayZswapStatistics() {
+  char buffer[256];
+  if (poolFrames == 0)
+    return;
+
+  long reads = zswapStats.loads + zswapStats.swapLoads;
+  snprintf(buffer, sizeof(buffer),
+           "zswap: %d marcos, %ld páginas guardadas (ratio efectivo %.2f, "
+           "ocupación máxima %ld bytes), %ld incompresibles, %ld devueltas "
+           "a swap, %ld descartadas",
+           poolFrames, zswapStats.stores,
+           zswapStats.storedBytes > 0
+               ? (double)zswapStats.originalBytes / zswapStats.storedBytes
+               : 0.0,
+           zswapStats.maxUsedBytes, zswapStats.rejected,
+           zswapStats.writebacks, zswapStats.invalidated);
+  logMessage(buffer);
+  snprintf(buffer, sizeof(buffer),
+           "zswap: %ld lecturas servidas desde el almacén y %ld desde swap "
+           "(tasa de aciertos %.2f), CPU de compresión %lld",
+           zswapStats.loads, zswapStats.swapLoads,
+           reads > 0 ? (double)zswapStats.loads / reads : 0.0,
+           zswapStats.cpuTime);
+  logMessage(buffer);
+}
@@ -0,0 +1,95 @@
+#include "iodevice.h"
+#include "memory.h"
+#include "numa.h"
+#include "prefetch.h"
+#include "process.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "simclock.h"
+#include "swap.h"
+#include "tlb.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Banco de pruebas del reloj: una carga larga con E/S, fallos de página y
+// huecos sin procesos entre grupos de llegadas. Por lotes mide los eventos
+// por segundo de pared; con un ritmo, cuánto se desvía el reloj de pared
+// del simulado. El registro va a la salida estándar y el informe a la de
+// errores. Uso: benchmark [RÁFAGAS] [TICKS_POR_SEGUNDO]
+
+#define BENCH_PROCESSES MAX_PROCESSES
+#define BENCH_BURSTS 400
+#define BENCH_GROUP_GAP 5000 // Hueco entre la llegada de cada mitad
+
+int main(int argc, char *argv[]) {
+  int bursts = argc > 1 ? atoi(argv[1]) : BENCH_BURSTS;
+  double rate = argc > 2 ? atof(argv[2]) : 0.0;
+  ClockMode mode = rate > 0.0 ? CLOCK_MODE_PACED : CLOCK_MODE_BATCH;
+  Process *processes[BENCH_PROCESSES];
+  RngStream rng;
+
+  if (bursts <= 0 || !configureSimulationClock(mode, rate)) {
+    fprintf(stderr, "Uso: %s [RÁFAGAS] [TICKS_POR_SEGUNDO]\n", argv[0]);
+    return 1;
+  }
+  configureNumaTopology(2, NUMA_CPUS_PER_NODE, NUMA_LOCAL_LATENCY,
+                        NUMA_REMOTE_LATENCY, NUMA_MIGRATION_COST,
+                        NUMA_BALANCING);
+  initializeMemorySystem();
+  initializeTlb(TLB_SETS, TLB_WAYS, TLB_USE_ASID);
+  configureSwapDevice(SWAP_SLOTS, SWAP_LATENCY, SWAP_BANDWIDTH,
+                      SWAP_READAHEAD_CLUSTER);
+  resetIoDevices();
+  addIoDevice("disco0", IO_SCHED_MQ_DEADLINE, IO_DEFAULT_QUEUE_DEPTH,
+              IO_DEFAULT_LATENCY, IO_DEFAULT_SPEED, IO_SERVICE_UNIFORM, 1);
+  configurePrefetcher(PREFETCH_ENABLED, PREFETCH_MAX_WINDOW, PREFETCH_MARKOV);
+
+  rngSeed(&rng, 39);
+  for (int i = 0; i < BENCH_PROCESSES; i++) {
+    Process *p = calloc(1, sizeof(Process));
+    p->id = i + 1;
+    p->startTime = i < BENCH_PROCESSES / 2 ? i : BENCH_GROUP_GAP + i;
+    p->priority = (ProcessPriority)(i % 4);
+    p->totalBursts = bursts;
+    p->cpuBurstTimes = malloc(bursts * sizeof(SimTime));
+    p->ioBurstTimes = malloc(bursts * sizeof(SimTime));
+    p->ownsBursts = true;
+    for (int b = 0; b < bursts; b++) {
+      p->cpuBurstTimes[b] = 5 + rngNext(&rng) % 40;
+      p->ioBurstTimes[b] = 10 + rngNext(&rng) % 50;
+    }
+    p->totalPages = 2 + i % 5;
+    p->memorySize = p->totalPages * PAGE_SIZE;
+    p->writtenPages = i % 3;
+    p->state = READY;
+    initializeProcessPages(p);
+    processes[i] = p;
+    addProcessToQueue(p);
+  }
+
+  double start = simclockWallSeconds();
+  advancedRoundRobinScheduler();
+  double wall = simclockWallSeconds() - start;
+  resetIoDevices();
+
+  ClockStatistics stats = getClockStatistics();
+  SimTime ticks = stats.busyTicks + stats.idleTicks;
+  long events = eventLogLength();
+  fprintf(stderr,
+          "Banco del reloj (%s): %ld eventos, %lld ticks (%lld inactivos) en "
+          "%.3f s de pared: %.0f eventos/s\n",
+          mode == CLOCK_MODE_PACED ? "sincronizado" : "por lotes", events,
+          ticks, stats.idleTicks, wall, wall > 0.0 ? events / wall : 0.0);
+  if (mode == CLOCK_MODE_PACED)
+    fprintf(stderr,
+            "Esperado %.3f s a %.1f ticks/s (desvío %+.3f s, %ld avances "
+            "tardíos, retraso máximo %lld ticks)\n",
+            ticks / rate, rate, wall - ticks / rate, stats.lateAdvances,
+            stats.maxLagTicks);
+
+  for (int i = 0; i < BENCH_PROCESSES; i++) {
+    releaseProcessPages(processes[i]);
+    free(processes[i]);
+  }
+  return 0;
+}
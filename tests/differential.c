@@ -0,0 +1,1193 @@
+#include "buddy.h"
+#include "cgroup.h"
+#include "checkpoint.h"
+#include "framelog.h"
+#include "history.h"
+#include "memory.h"
+#include "mrc.h"
+#include "numa.h"
+#include "oom.h"
+#include "prefetch.h"
+#include "process.h"
+#include "realtime.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "swap.h"
+#include "trace.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Pruebas diferenciales: las estructuras rápidas del simulador deben
+// decidir exactamente lo mismo que una implementación de referencia por
+// recorrido lineal ante secuencias pseudoaleatorias de operaciones (el
+// registro del simulador va a la salida estándar y los resultados a la de
+// errores)
+
+#define BUDDY_OPERATIONS 4000
+#define BUDDY_MAX_BLOCKS 512
+#define LRU_PAGES 24
+#define LRU_ACCESSES 3000
+#define MRC_PAGES 200
+#define MRC_REFERENCES 20000
+#define TRACE_TASKS 6
+#define TRACE_TASK_BURSTS 2000
+#define HISTORY_CHANGES 20000
+#define HISTORY_QUERIES 2000
+#define FRAMELOG_SNAPSHOTS 3000
+#define FRAMELOG_QUERIES 2000
+#define CHECKPOINT_BURSTS 3
+
+static int failures = 0;
+
+static void check(bool condition, const char *test, int step,
+                  const char *what) {
+  if (!condition) {
+    fprintf(stderr, "FALLO %s (paso %d): %s\n", test, step, what);
+    failures++;
+  }
+}
+
+// Referencia: mapa de marcos libres recorrido linealmente
+static bool referenceBlockFree(const bool *used, int frame, int order) {
+  for (int i = frame; i < frame + (1 << order); i++) {
+    if (used[i])
+      return false;
+  }
+  return true;
+}
+
+// Menor marco alineado de un bloque libre de 2^order marcos (-1 si no hay)
+static int referenceFindBlock(const bool *used, int numFrames, int order) {
+  for (int frame = 0; frame + (1 << order) <= numFrames;
+       frame += 1 << order) {
+    if (referenceBlockFree(used, frame, order))
+      return frame;
+  }
+  return -1;
+}
+
+static int referenceFreeFrames(const bool *used, int numFrames) {
+  int freeFrames = 0;
+  for (int i = 0; i < numFrames; i++)
+    freeFrames += !used[i];
+  return freeFrames;
+}
+
+// Asignador buddy frente al mapa de referencia: una reserva debe fallar
+// solo si no queda ningún bloque alineado libre, el bloque devuelto debe
+// estar libre y alineado, y los contadores deben coincidir
+static void testBuddy(int numFrames, unsigned long long stream) {
+  BuddyAllocator buddy;
+  bool *used = calloc(numFrames, sizeof(bool));
+  int blockFrame[BUDDY_MAX_BLOCKS], blockOrder[BUDDY_MAX_BLOCKS];
+  int blocks = 0;
+  RngStream rng;
+  char test[64];
+
+  snprintf(test, sizeof(test), "buddy de %d marcos", numFrames);
+  rngSeed(&rng, stream);
+  if (used == NULL || !buddyInit(&buddy, 0, numFrames)) {
+    check(false, test, 0, "no se pudo inicializar");
+    free(used);
+    return;
+  }
+
+  for (int step = 0; step < BUDDY_OPERATIONS; step++) {
+    bool allocate = blocks == 0 ||
+                    (blocks < BUDDY_MAX_BLOCKS && rngNext(&rng) % 100 < 55);
+    if (allocate) {
+      int order = rngNext(&rng) % (buddy.maxOrder + 1);
+      int expected = referenceFindBlock(used, numFrames, order);
+      int frame = buddyAlloc(&buddy, order);
+      check((frame < 0) == (expected < 0), test, step,
+            "la reserva no coincide con la referencia");
+      if (frame >= 0) {
+        check((frame & ((1 << order) - 1)) == 0 &&
+                  frame + (1 << order) <= numFrames &&
+                  referenceBlockFree(used, frame, order),
+              test, step, "bloque desalineado o ya ocupado");
+        for (int i = frame; i < frame + (1 << order); i++)
+          used[i] = true;
+        blockFrame[blocks] = frame;
+        blockOrder[blocks++] = order;
+      }
+    } else {
+      int victim = rngNext(&rng) % blocks;
+      buddyFree(&buddy, blockFrame[victim], blockOrder[victim]);
+      for (int i = blockFrame[victim];
+           i < blockFrame[victim] + (1 << blockOrder[victim]); i++)
+        used[i] = false;
+      blockFrame[victim] = blockFrame[--blocks];
+      blockOrder[victim] = blockOrder[blocks];
+    }
+
+    int largest = -1;
+    for (int order = 0; order <= buddy.maxOrder; order++) {
+      if (referenceFindBlock(used, numFrames, order) >= 0)
+        largest = order;
+    }
+    check(buddy.freeFrames == referenceFreeFrames(used, numFrames), test,
+          step, "marcos libres distintos");
+    check(buddyLargestFreeOrder(&buddy) == largest, test, step,
+          "mayor bloque libre distinto");
+  }
+  buddyDestroy(&buddy);
+  free(used);
+}
+
+// Listas LRU del sistema de memoria frente a selectPageForReplacement, que
+// busca linealmente el marco con el menor tiempo de uso: con reemplazo
+// global, sin precarga y con accesos de solo lectura (sin E/S de swap que
+// bloquee páginas), cada fallo con la memoria llena debe desalojar el mismo
+// marco que elige la búsqueda lineal
+static void testLru() {
+  const char *test = "LRU global";
+  MemoryFrame *memory = getPhysicalMemory();
+  RngStream rng;
+  Process *p = calloc(1, sizeof(Process));
+
+  initializeMemorySystem();
+  configurePrefetcher(false, PREFETCH_MAX_WINDOW, false);
+  configureSwapDevice(SWAP_SLOTS, SWAP_LATENCY, SWAP_BANDWIDTH,
+                      SWAP_READAHEAD_CLUSTER);
+  setFrameAllocationMode(FRAME_ALLOCATION_GLOBAL);
+  rngSeed(&rng, 1);
+  p->id = 1;
+  p->totalPages = LRU_PAGES;
+  p->memorySize = LRU_PAGES * PAGE_SIZE;
+  initializeProcessPages(p);
+  registerProcessMemory(p);
+
+  // Cada acceso en un tiempo distinto evita empates en la búsqueda lineal
+  for (int step = 1; step <= LRU_ACCESSES; step++) {
+    // Localidad: la mitad de los accesos van a las primeras páginas
+    int limit = rngNext(&rng) % 2 ? LRU_PAGES : NUM_FRAMES / 2;
+    Page *page = &p->pages[rngNext(&rng) % limit];
+    translateAddress(p, page->virtualAddress, false, step);
+    if (page->inMemory)
+      continue;
+
+    bool full = true;
+    for (int i = 0; i < NUM_FRAMES; i++)
+      full = full && memory[i].headFrame != NO_FRAME;
+    int expected = full ? selectPageForReplacement() : NO_FRAME;
+    Page *evicted = full ? memory[expected].occupyingPage : NULL;
+
+    check(handlePageFault(page, step), test, step, "fallo no atendido");
+    translateAddress(p, page->virtualAddress, false, step);
+    if (full)
+      check(evicted != NULL && !evicted->inMemory &&
+                page->frameIndex == expected,
+            test, step, "víctima distinta de la búsqueda lineal");
+  }
+  releaseProcessMemory(p, LRU_ACCESSES + 1);
+  releaseProcessPages(p);
+  free(p);
+}
+
+// Referencia: pila LRU en un arreglo; la distancia de una página es su
+// posición (desde 1) antes de llevarla a la cima, 0 si es la primera vez
+static int referenceStackDistance(int *stack, int *depth, int key) {
+  int position = 0;
+  while (position < *depth && stack[position] != key)
+    position++;
+  int distance = position < *depth ? position + 1 : 0;
+  if (position == *depth)
+    (*depth)++;
+  for (; position > 0; position--)
+    stack[position] = stack[position - 1];
+  stack[0] = key;
+  return distance;
+}
+
+// Pila de Mattson en un árbol frente a la pila lineal: con muestreo
+// completo las distancias cortas y los fallos fríos del flujo global y de
+// cada proceso deben coincidir exactamente
+static void testMrc() {
+  const char *test = "Curva de fallos";
+  static int globalStack[MRC_PAGES], processStack[2][MRC_PAGES];
+  long cold[3] = {0}, distances[3][MRC_CURVE_FRAMES] = {{0}};
+  int depth[3] = {0};
+  Page pages[MRC_PAGES];
+  RngStream rng;
+
+  configureMrc(MRC_EXACT_RATE);
+  rngSeed(&rng, 2);
+  for (int i = 0; i < MRC_PAGES; i++)
+    initializePage(&pages[i], i % 2 + 1, PROCESS_VIRTUAL_BASE + i * PAGE_SIZE,
+                   PAGE_SIZE_4K);
+  for (int step = 0; step < MRC_REFERENCES; step++) {
+    // Un conjunto de trabajo pequeño con saltos ocasionales a todo el rango
+    int limit = rngNext(&rng) % 4 ? MRC_CURVE_FRAMES : MRC_PAGES;
+    Page *page = &pages[rngNext(&rng) % limit];
+    int process = page->processId;
+    mrcRecordReference(process, page);
+    int d[3] = {
+        referenceStackDistance(globalStack, &depth[0], page->id),
+        referenceStackDistance(processStack[process - 1], &depth[process],
+                               page->id)};
+    for (int s = 0; s < 2; s++) {
+      int stream = s == 0 ? 0 : process;
+      if (d[s] == 0)
+        cold[stream]++;
+      else if (d[s] <= MRC_CURVE_FRAMES)
+        distances[stream][d[s] - 1]++;
+    }
+  }
+
+  for (int stream = 0; stream < 3; stream++) {
+    MrcStatistics stats = getMrcStatistics(stream == 0 ? -1 : stream);
+    check(stats.coldMisses == cold[stream], test, stream,
+          "fallos fríos distintos");
+    for (int f = 0; f < MRC_CURVE_FRAMES; f++)
+      check(stats.shortDistances[f] == distances[stream][f], test, stream,
+            "distancia de pila distinta");
+  }
+}
+
+// Traza sintética de ftrace: cada tarea en su propia CPU alterna con la
+// tarea inactiva, a veces expropiada (R, sin E/S) y a veces dormida (S)
+// hasta un sched_wakeup seguido de una latencia de planificación; las
+// líneas de cada tarea van juntas, de modo que el archivo no está ordenado
+// por tiempo y los fragmentos cortan las tareas
+static void writeSyntheticTrace(FILE *file, SimTime cpu[][TRACE_TASK_BURSTS],
+                                SimTime io[][TRACE_TASK_BURSTS]) {
+  RngStream rng;
+  rngSeed(&rng, 5);
+  fprintf(file, "# tracer: nop\n#\n");
+  for (int task = 0; task < TRACE_TASKS; task++) {
+    int pid = 1000 + task;
+    long t = 7000000000L + task * 3000L; // Microsegundos
+    const char *prev = "swapper";
+    int prevPid = 0;
+    for (int b = 0; b < TRACE_TASK_BURSTS; b++) {
+      long burst = 0;
+      const char *exitState;
+      do {
+        // Un tramo en la CPU (en milisegundos enteros) y su salida
+        long run = 1000L * (1 + (long)(rngNext(&rng) % 9));
+        fprintf(file,
+                "  %s-%d [%03d] d..2. %ld.%06ld: sched_switch: prev_comm=%s "
+                "prev_pid=%d prev_prio=120 prev_state=R ==> next_comm=t%d "
+                "next_pid=%d next_prio=%d\n",
+                prev, prevPid, task, t / 1000000, t % 1000000, prev, prevPid,
+                task, pid, 110 + task);
+        t += run;
+        burst += run;
+        exitState = rngNext(&rng) % 3 == 0 ? "R+" : "S";
+        if (b == TRACE_TASK_BURSTS - 1)
+          exitState = "S";
+        fprintf(file,
+                "  t%d-%d [%03d] d..2. %ld.%06ld: sched_switch: prev_comm=t%d "
+                "prev_pid=%d prev_prio=%d prev_state=%s ==> "
+                "next_comm=swapper/%d next_pid=0 next_prio=120\n",
+                task, pid, task, t / 1000000, t % 1000000, task, pid,
+                110 + task, exitState, task);
+        prev = "swapper";
+        if (exitState[0] == 'R')
+          t += 1 + (long)(rngNext(&rng) % 5000); // Espera en la cola
+      } while (exitState[0] == 'R');
+      cpu[task][b] = burst / 1000;
+      if (b == TRACE_TASK_BURSTS - 1)
+        break;
+
+      long wait = 1000L * (1 + (long)(rngNext(&rng) % 20));
+      t += wait;
+      io[task][b] = wait / 1000;
+      fprintf(file,
+              "  <idle>-0 [%03d] d.h5. %ld.%06ld: sched_wakeup: comm=t%d "
+              "pid=%d prio=%d target_cpu=%03d\n",
+              task, t / 1000000, t % 1000000, task, pid, 110 + task, task);
+      t += (long)(rngNext(&rng) % 800); // Latencia hasta ejecutarse
+    }
+  }
+}
+
+// Importación de trazas: las ráfagas deben coincidir con las generadas y
+// el análisis por fragmentos en paralelo con el de un solo hilo
+static void testTraceImport() {
+  const char *test = "trace";
+  static SimTime cpu[TRACE_TASKS][TRACE_TASK_BURSTS];
+  static SimTime io[TRACE_TASKS][TRACE_TASK_BURSTS];
+  char path[] = "/tmp/differential-traceXXXXXX";
+  int fd = mkstemp(path);
+  FILE *file = fd >= 0 ? fdopen(fd, "w") : NULL;
+  if (file == NULL) {
+    check(false, test, 0, "no se pudo crear la traza");
+    return;
+  }
+  writeSyntheticTrace(file, cpu, io);
+  fclose(file);
+
+  TraceWorkload serial, parallel;
+  bool imported = importTrace(path, TRACE_FORMAT_AUTO, 1000.0, 1, &serial);
+  check(imported, test, 0, "no se pudo importar con un hilo");
+  if (!imported) {
+    unlink(path);
+    return;
+  }
+  imported = importTrace(path, TRACE_FORMAT_AUTO, 1000.0, 4, &parallel);
+  unlink(path);
+  check(imported, test, 0, "no se pudo importar con cuatro hilos");
+  if (!imported) {
+    releaseTraceWorkload(&serial);
+    return;
+  }
+
+  check(serial.format == TRACE_FORMAT_FTRACE && parallel.chunks > 1, test,
+        0, "formato o fragmentos inesperados");
+  check(serial.taskCount == TRACE_TASKS &&
+            parallel.taskCount == TRACE_TASKS &&
+            serial.events == parallel.events && serial.skipped == 0,
+        test, 0, "tareas o eventos distintos");
+  for (int task = 0; task < serial.taskCount && task < TRACE_TASKS;
+       task++) {
+    const TraceTask *a = &serial.tasks[task], *b = &parallel.tasks[task];
+    check(a->pid == 1000 + task && a->startTime == 3 * task &&
+              a->kernelPriority == 110 + task &&
+              a->totalBursts == TRACE_TASK_BURSTS &&
+              b->totalBursts == a->totalBursts &&
+              b->startTime == a->startTime,
+          test, task, "tarea distinta de la generada");
+    if (a->totalBursts != TRACE_TASK_BURSTS ||
+        b->totalBursts != TRACE_TASK_BURSTS)
+      continue;
+    for (int i = 0; i < TRACE_TASK_BURSTS; i++) {
+      check(a->cpuBursts[i] == cpu[task][i] &&
+                b->cpuBursts[i] == cpu[task][i],
+            test, i, "ráfaga de CPU distinta");
+      if (i < TRACE_TASK_BURSTS - 1)
+        check(a->ioBursts[i] == io[task][i] && b->ioBursts[i] == io[task][i],
+              test, i, "ráfaga de E/S distinta");
+    }
+  }
+  releaseTraceWorkload(&serial);
+  releaseTraceWorkload(&parallel);
+}
+
+// Cambio registrado en el historial
+typedef struct {
+  HistorySeries series;
+  SimTime time;
+  int key;
+  int value;
+  int detail;
+} ReferenceChange;
+
+// Referencia: el último cambio de una clave no posterior a time, buscado
+// recorriendo todos los registrados (-1 si no hay)
+static long referenceValueAt(const ReferenceChange *changes, long count,
+                             HistorySeries series, int key, SimTime time) {
+  long found = -1;
+  for (long i = 0; i < count && changes[i].time <= time; i++) {
+    if (changes[i].series == series && changes[i].key == key)
+      found = i;
+  }
+  return found;
+}
+
+// Referencia: inicios de los intervalos de una clave (el último cambio de
+// cada tiempo, sin repetir el valor anterior) en starts, y su cambio en
+// rows; devuelve cuántos hay
+static long referenceIntervals(const ReferenceChange *changes, long count,
+                               HistorySeries series, int key,
+                               SimTime *starts, long *rows) {
+  long intervals = 0;
+  for (long i = 0; i < count; i++) {
+    const ReferenceChange *c = &changes[i];
+    if (c->series != series || c->key != key)
+      continue;
+    if (intervals > 0 && starts[intervals - 1] == c->time)
+      intervals--;
+    if (intervals > 0 && changes[rows[intervals - 1]].value == c->value &&
+        changes[rows[intervals - 1]].detail == c->detail)
+      continue;
+    starts[intervals] = c->time;
+    rows[intervals++] = i;
+  }
+  return intervals;
+}
+
+// Historial: las consultas por búsqueda binaria sobre el índice de
+// intervalos deben dar lo mismo que recorrer todos los cambios registrados
+// (con cambios repetidos y varios en el mismo tiempo)
+static void testHistory() {
+  const char *test = "history";
+  static ReferenceChange changes[HISTORY_CHANGES];
+  static SimTime starts[HISTORY_CHANGES];
+  static long rows[HISTORY_CHANGES];
+  static const int processKeys[] = {1, 2, 3, 7, 1000000};
+  char path[] = "/tmp/differential-historyXXXXXX";
+  int fd = mkstemp(path);
+  RngStream rng;
+  rngSeed(&rng, 6);
+  if (fd < 0) {
+    check(false, test, 0, "no se pudo crear el archivo");
+    return;
+  }
+  close(fd);
+
+  startHistory();
+  SimTime time = 0;
+  for (long i = 0; i < HISTORY_CHANGES; i++) {
+    ReferenceChange *c = &changes[i];
+    time += rngNext(&rng) % 3;
+    c->series = (HistorySeries)(rngNext(&rng) % HISTORY_SERIES);
+    c->time = time;
+    c->key = c->series == HISTORY_FRAME     ? (int)(rngNext(&rng) % 16)
+             : c->series == HISTORY_PROCESS ? processKeys[rngNext(&rng) % 5]
+                                            : 0;
+    c->value = (int)(rngNext(&rng) % 3) - 1;
+    c->detail = (int)(rngNext(&rng) % 2);
+    historyRecord(c->series, c->time, c->key, c->value, c->detail);
+  }
+  HistoryStore store;
+  bool opened = saveHistory(path) && openHistory(path, &store);
+  unlink(path);
+  check(opened, test, 0, "no se pudo guardar o abrir");
+  if (!opened)
+    return;
+
+  for (int q = 0; q < HISTORY_QUERIES; q++) {
+    HistorySeries series = (HistorySeries)(rngNext(&rng) % HISTORY_SERIES);
+    int key = series == HISTORY_FRAME     ? (int)(rngNext(&rng) % 17)
+              : series == HISTORY_PROCESS ? processKeys[rngNext(&rng) % 5]
+                                          : 0;
+    SimTime from = (SimTime)(rngNext(&rng) % (time + 20)) - 10;
+    SimTime to = from + (SimTime)(rngNext(&rng) % 200);
+
+    // Consulta puntual
+    long expected = referenceValueAt(changes, HISTORY_CHANGES, series, key,
+                                     from);
+    const HistoryInterval *interval =
+        historyValueAt(&store, series, key, from);
+    check((interval == NULL) == (expected < 0), test, q,
+          "consulta puntual con o sin valor distinta");
+    if (interval != NULL && expected >= 0)
+      check(store.values[interval->row] == changes[expected].value &&
+                store.details[interval->row] == changes[expected].detail &&
+                interval->start <= from &&
+                (interval->end == HISTORY_OPEN_END || interval->end > from),
+            test, q, "consulta puntual distinta");
+
+    // Consulta de rango: los intervalos que se solapan con [from, to]
+    long total = referenceIntervals(changes, HISTORY_CHANGES, series, key,
+                                    starts, rows);
+    long first = 0;
+    while (first + 1 < total && starts[first + 1] <= from)
+      first++;
+    long last = first;
+    while (last < total && starts[last] <= to)
+      last++;
+    long count;
+    const HistoryInterval *intervals =
+        historyIntervals(&store, series, key, from, to, &count);
+    check(count == last - first, test, q, "rango con otro número");
+    for (long i = 0; i < count && count == last - first; i++)
+      check(intervals[i].start == starts[first + i] &&
+                store.values[intervals[i].row] ==
+                    changes[rows[first + i]].value &&
+                (first + i + 1 < total
+                     ? intervals[i].end == starts[first + i + 1]
+                     : intervals[i].end == HISTORY_OPEN_END),
+            test, q, "intervalo del rango distinto");
+
+    // Primera fila de un tiempo por el directorio de particiones
+    long row = 0;
+    while (row < store.header->rowCount && store.times[row] < from)
+      row++;
+    check(historyFirstRow(&store, from) == row, test, q,
+          "primera fila distinta");
+  }
+  check(store.header->partitionCount > 1, test, 0,
+        "el historial no ocupa varias particiones");
+
+  // Un rango del índice que solo cabe al desbordar la suma debe rechazarse
+  char *copy = malloc(store.size);
+  if (copy != NULL) {
+    memcpy(copy, store.data, store.size);
+    HistoryKey *key = (HistoryKey *)(copy + store.header->keyIndexOffset);
+    key->firstInterval = LONG_MAX;
+    key->intervalCount = 1;
+    FILE *file = fopen(path, "wb");
+    bool written = file != NULL && fwrite(copy, store.size, 1, file) == 1;
+    if (file != NULL)
+      fclose(file);
+    HistoryStore corrupted;
+    check(written && !openHistory(path, &corrupted), test, 0,
+          "índice desbordado aceptado");
+    unlink(path);
+    free(copy);
+  }
+  closeHistory(&store);
+}
+
+// Indica si dos marcos tienen el mismo estado visible
+static bool sameFrameState(const FrameState *a, const FrameState *b) {
+  return a->lastUsedTime == b->lastUsedTime && a->headFrame == b->headFrame &&
+         a->use == b->use && a->pageId == b->pageId &&
+         a->processId == b->processId && a->mapCount == b->mapCount;
+}
+
+// Registro de marcos: la tabla reconstruida desde la instantánea completa
+// anterior y los cambios codificados debe ser la misma que se registró
+// (con varias instantáneas en el mismo tiempo, algunas sin cambios, y
+// campos que crecen o decrecen mucho)
+static void testFrameLog() {
+  const char *test = "framelog";
+  static FrameState tables[FRAMELOG_SNAPSHOTS][NUM_FRAMES];
+  static SimTime times[FRAMELOG_SNAPSHOTS];
+  FrameState decoded[NUM_FRAMES];
+  char path[] = "/tmp/differential-framelogXXXXXX";
+  int fd = mkstemp(path);
+  RngStream rng;
+  rngSeed(&rng, 7);
+  if (fd < 0) {
+    check(false, test, 0, "no se pudo crear el archivo");
+    return;
+  }
+  close(fd);
+
+  startFrameLog();
+  for (int i = 0; i < NUM_FRAMES; i++)
+    tables[0][i] = (FrameState){-1, NO_FRAME, FRAME_USER, -1, 0, 0};
+  SimTime time = 0;
+  for (int s = 0; s < FRAMELOG_SNAPSHOTS; s++) {
+    if (s > 0)
+      memcpy(tables[s], tables[s - 1], sizeof(tables[s]));
+    time += rngNext(&rng) % 3;
+    times[s] = time;
+    for (int c = (int)(rngNext(&rng) % 4); c > 0; c--) {
+      FrameState *state = &tables[s][rngNext(&rng) % NUM_FRAMES];
+      switch (rngNext(&rng) % 4) {
+      case 0:
+        *state = (FrameState){-1, NO_FRAME, FRAME_USER, -1, 0, 0};
+        break;
+      case 1:
+        state->lastUsedTime = rngNext(&rng) % 2 ? time : -1;
+        break;
+      case 2:
+        state->headFrame = (int)(rngNext(&rng) % NUM_FRAMES);
+        state->use = (int)(rngNext(&rng) % 5);
+        state->mapCount = (int)(rngNext(&rng) % 4);
+        break;
+      default:
+        state->pageId = (int)(rngNext(&rng) % 2000000) - 1000000;
+        state->processId = (int)(rngNext(&rng) % 100);
+        break;
+      }
+    }
+    frameLogRecord(times[s], tables[s]);
+  }
+  FrameLogView view;
+  bool opened = saveFrameLog(path) && openFrameLog(path, &view);
+  unlink(path);
+  check(opened, test, 0, "no se pudo guardar o abrir");
+  if (!opened)
+    return;
+  check(view.header->keyframeCount ==
+            (FRAMELOG_SNAPSHOTS + FRAMELOG_KEYFRAME_INTERVAL - 1) /
+                FRAMELOG_KEYFRAME_INTERVAL,
+        test, 0, "número de instantáneas completas distinto");
+
+  for (int q = 0; q < FRAMELOG_QUERIES; q++) {
+    SimTime at = (SimTime)(rngNext(&rng) % (time + 20)) - 10;
+
+    // Referencia: la última instantánea no posterior a at
+    long expected = -1;
+    while (expected + 1 < FRAMELOG_SNAPSHOTS && times[expected + 1] <= at)
+      expected++;
+    long snapshot = frameLogStateAt(&view, at, decoded);
+    check(snapshot == expected, test, q, "instantánea distinta");
+    bool same = true;
+    for (int i = 0; i < NUM_FRAMES && snapshot >= 0 && snapshot == expected;
+         i++)
+      same = same && sameFrameState(&decoded[i], &tables[expected][i]);
+    check(same, test, q, "tabla reconstruida distinta");
+  }
+  closeFrameLog(&view);
+
+  // Flujos dañados de 4 marcos con una sola instantánea completa: las
+  // distancias que se salen de la tabla (también las que darían la vuelta
+  // a un índice negativo) deben rechazarse sin tocar fuera de states
+  static const unsigned char malformed[][20] = {
+      {FRAMELOG_KEYFRAME, 0, 1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0x01, FRAMELOG_FIELD_MAP_COUNT, 2},
+      {FRAMELOG_KEYFRAME, 0, 1, 4, FRAMELOG_FIELD_MAP_COUNT, 2},
+      {FRAMELOG_KEYFRAME, 0, 2, 2, 0, 1, 0},
+      {FRAMELOG_KEYFRAME, 0, 2, 0, 0, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff,
+       0xff, 0xff, 0xff, 0x01, FRAMELOG_FIELD_MAP_COUNT, 2},
+  };
+  int cases = sizeof(malformed) / sizeof(malformed[0]);
+  for (int c = 0; c < cases; c++) {
+    struct MalformedFrameLog {
+      FrameLogHeader header;
+      FrameLogKeyframe keyframe;
+      unsigned char stream[20];
+    } file;
+    memset(&file, 0, sizeof(file));
+    memcpy(file.header.magic, FRAMELOG_MAGIC, sizeof(file.header.magic));
+    file.header.version = FRAMELOG_VERSION;
+    file.header.numFrames = 4;
+    file.header.snapshotCount = file.header.keyframeCount = 1;
+    file.header.streamBytes = sizeof(file.stream);
+    file.header.keyframeOffset = offsetof(struct MalformedFrameLog, keyframe);
+    file.header.streamOffset = offsetof(struct MalformedFrameLog, stream);
+    memcpy(file.stream, malformed[c], sizeof(file.stream));
+    FILE *out = fopen(path, "wb");
+    bool written = out != NULL && fwrite(&file, sizeof(file), 1, out) == 1;
+    if (out != NULL)
+      fclose(out);
+    FrameState *states = malloc(4 * sizeof(FrameState));
+    opened = written && states != NULL && openFrameLog(path, &view);
+    check(written && states != NULL, test, c, "no se pudo escribir");
+    check(!opened || frameLogStateAt(&view, 0, states) < 0, test, c,
+          "flujo dañado aceptado");
+    if (opened)
+      closeFrameLog(&view);
+    free(states);
+  }
+  unlink(path);
+}
+
+// Vaciar la cola de procesos y la memoria (como al arrancar el simulador)
+static void releaseCheckpointQueue() {
+  Process **queue = getProcessQueue();
+  for (int i = 0; i < *getProcessCount(); i++) {
+    releaseProcessMemory(queue[i], 0);
+    releaseProcessPages(queue[i]);
+    free(queue[i]);
+  }
+  *getProcessCount() = 0;
+  releaseCheckpointRegions();
+  initializeMemorySystem();
+}
+
+// Escribir en path el checkpoint data con el entero de la posición offset
+// cambiado y restaurarlo
+static bool restoreCorrupted(const char *path, const char *data, long size,
+                             long offset, int value) {
+  char *copy = malloc(size);
+  memcpy(copy, data, size);
+  memcpy(copy + offset, &value, sizeof(value));
+  FILE *file = fopen(path, "wb");
+  bool written = file != NULL && fwrite(copy, size, 1, file) == 1;
+  if (file != NULL)
+    fclose(file);
+  free(copy);
+  return written && restoreCheckpoint(path);
+}
+
+// Proceso de dos páginas en su segunda ráfaga de CPU
+static Process *checkpointProcess(int id) {
+  Process *p = calloc(1, sizeof(Process));
+  SimTime *cpu = malloc(CHECKPOINT_BURSTS * sizeof(SimTime));
+  SimTime *io = malloc(CHECKPOINT_BURSTS * sizeof(SimTime));
+  for (int b = 0; b < CHECKPOINT_BURSTS; b++)
+    cpu[b] = io[b] = 10;
+  p->id = id;
+  p->cpuBurstTimes = cpu;
+  p->ioBurstTimes = io;
+  p->ownsBursts = true;
+  p->totalBursts = CHECKPOINT_BURSTS;
+  p->burstIndex = 1;
+  p->totalPages = 2;
+  p->memorySize = 2 * PAGE_SIZE;
+  p->state = READY;
+  initializeProcessPages(p);
+  return p;
+}
+
+// Marcos libres de todos los nodos
+static int freeFrames() {
+  int frames = 0;
+  for (int n = 0; n < numaNodeCount(); n++)
+    frames += freeFramesOnNode(n);
+  return frames;
+}
+
+// Checkpoint con el marco de su página cargada (la primera) incoherente
+// con las páginas: se rechaza sin tocar la tabla de marcos ni los
+// asignadores
+static void testInconsistentFrames(const char *path, const char *data,
+                                   long size) {
+  const char *test = "checkpoint";
+  const CheckpointHeader *header = (const CheckpointHeader *)data;
+  const CheckpointPage *pages = (const void *)(data + header->pageOffset);
+  long frame = header->frameOffset +
+               pages[0].frameIndex * (long)sizeof(CheckpointFrame);
+  long second = header->pageOffset + (long)sizeof(CheckpointPage);
+  const struct {
+    long offset;
+    int value;
+    const char *what;
+  } inconsistencies[] = {
+      {frame + offsetof(CheckpointFrame, prefetchSource),
+       NUM_PREFETCH_SOURCES, "predictor de precarga"},
+      {frame + offsetof(CheckpointFrame, mapCount), 0, "marco sin páginas"},
+      {frame + offsetof(CheckpointFrame, mapCount), 2, "páginas del marco"},
+      {frame + offsetof(CheckpointFrame, ownerSet), MAX_PROCESSES - 1,
+       "conjunto sin proceso"},
+      {second + offsetof(CheckpointPage, frameIndex), pages[0].frameIndex,
+       "página fuera del mapa inverso"},
+      {header->pageOffset + offsetof(CheckpointPage, frameIndex), NO_FRAME,
+       "página residente sin marco"},
+  };
+  FrameState *before = malloc(NUM_FRAMES * sizeof(FrameState));
+  FrameState *after = malloc(NUM_FRAMES * sizeof(FrameState));
+
+  int n = sizeof(inconsistencies) / sizeof(inconsistencies[0]);
+  for (int c = 0; c < n; c++) {
+    captureFrameStates(before);
+    int freeBefore = freeFrames();
+    bool restored = restoreCorrupted(path, data, size,
+                                     inconsistencies[c].offset,
+                                     inconsistencies[c].value);
+    captureFrameStates(after);
+    check(!restored && freeFrames() == freeBefore &&
+              memcmp(before, after, NUM_FRAMES * sizeof(FrameState)) == 0,
+          test, c + 1, inconsistencies[c].what);
+    releaseCheckpointQueue();
+  }
+  free(before);
+  free(after);
+}
+
+// Checkpoint: un proceso con la ráfaga actual, un enumerado, la CPU o un
+// rango de sus secciones fuera de límites debe rechazarse sin crear ningún
+// proceso, y un marco incoherente con sus páginas sin tocar la tabla de
+// marcos ni los asignadores (el mismo archivo sin cambiar se restaura)
+static void testCorruptCheckpoint() {
+  const char *test = "checkpoint";
+  static const struct {
+    size_t field;
+    int value;
+    const char *what;
+  } corruptions[] = {
+      {offsetof(CheckpointProcess, burstIndex), -1, "ráfaga negativa"},
+      {offsetof(CheckpointProcess, burstIndex), CHECKPOINT_BURSTS,
+       "ráfaga agotada sin terminar"},
+      {offsetof(CheckpointProcess, burstIndex), CHECKPOINT_BURSTS + 1,
+       "ráfaga tras la última"},
+      {offsetof(CheckpointProcess, state), TERMINATED + 1, "estado"},
+      {offsetof(CheckpointProcess, state), -1, "estado negativo"},
+      {offsetof(CheckpointProcess, priority), BACKGROUND_PRIORITY + 1,
+       "prioridad"},
+      {offsetof(CheckpointProcess, numaPolicy), NUMA_POLICY_BIND + 1,
+       "política NUMA"},
+      {offsetof(CheckpointProcess, cpu), 1 << 20, "CPU"},
+      {offsetof(CheckpointProcess, cpu), -2, "CPU negativa"},
+      {offsetof(CheckpointProcess, oomScoreAdj), OOM_SCORE_ADJ_MAX + 1,
+       "ajuste OOM"},
+      {offsetof(CheckpointProcess, firstPage), INT_MAX,
+       "páginas que desbordan la suma"},
+      {offsetof(CheckpointProcess, firstBurst), INT_MAX,
+       "ráfagas que desbordan la suma"},
+      {offsetof(CheckpointProcess, firstRequest), INT_MAX,
+       "peticiones que desbordan la suma"},
+  };
+  char path[] = "/tmp/differential-checkpointXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    check(false, test, 0, "no se pudo crear el archivo");
+    return;
+  }
+  close(fd);
+
+  // Un proceso en su segunda ráfaga con una página cargada
+  initializeMemorySystem();
+  Process *p = checkpointProcess(1);
+  bool saved = addProcessToQueue(p) >= 0 &&
+               handlePageFault(&p->pages[0], 0) && saveCheckpoint(path);
+  if (saved) {
+    releaseCheckpointQueue();
+  } else {
+    releaseProcessPages(p);
+    free(p);
+  }
+  check(saved, test, 0, "no se pudo guardar");
+
+  FILE *file = fopen(path, "rb");
+  long size = 0;
+  char *data = NULL;
+  if (saved && file != NULL && fseek(file, 0, SEEK_END) == 0 &&
+      (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0 &&
+      (data = malloc(size)) != NULL && fread(data, size, 1, file) != 1) {
+    free(data);
+    data = NULL;
+  }
+  if (file != NULL)
+    fclose(file);
+  check(!saved || data != NULL, test, 0, "no se pudo leer");
+
+  const CheckpointHeader *header = (const CheckpointHeader *)data;
+  int n = sizeof(corruptions) / sizeof(corruptions[0]);
+  for (int c = 0; data != NULL && c < n; c++) {
+    bool restored = restoreCorrupted(
+        path, data, size, header->processOffset + corruptions[c].field,
+        corruptions[c].value);
+    check(!restored && *getProcessCount() == 0, test, c + 1,
+          corruptions[c].what);
+    releaseCheckpointQueue();
+  }
+
+  if (data != NULL) {
+    testInconsistentFrames(path, data, size);
+    check(restoreCorrupted(path, data, size,
+                           header->processOffset +
+                               offsetof(CheckpointProcess, burstIndex),
+                           1) &&
+              *getProcessCount() == 1,
+          test, 0, "el checkpoint sin dañar no se restaura");
+    releaseCheckpointQueue();
+  }
+  free(data);
+  unlink(path);
+}
+
+// Checkpoint con un proceso terminado y otro con ajuste OOM y una página
+// cargada: al restaurarlo el terminado no compromete memoria y el índice
+// de víctimas elige el mismo conjunto con la misma puntuación. Un proceso
+// con grupo de recursos no se guarda
+static void testCheckpointOom() {
+  const char *test = "checkpoint-oom";
+  char path[] = "/tmp/differential-oomXXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    check(false, test, 0, "no se pudo crear el archivo");
+    return;
+  }
+  close(fd);
+
+  initializeMemorySystem();
+  configureOom(OVERCOMMIT_HEURISTIC, OOM_DEFAULT_RATIO, true);
+  Process *finished = checkpointProcess(1);
+  Process *running = checkpointProcess(2);
+  running->oomScoreAdj = 300;
+  bool queued = addProcessToQueue(finished) >= 0;
+  finished->state = TERMINATED;
+  finished->burstIndex = CHECKPOINT_BURSTS;
+  releaseProcessMemory(finished, 0);
+  queued = addProcessToQueue(running) >= 0 && queued;
+  if (!queued) {
+    releaseCheckpointQueue();
+    check(false, test, 0, "no se pudo encolar");
+    return;
+  }
+  handlePageFault(&running->pages[0], 0);
+  long score = 0;
+  int victim = oomSelectVictim(&score);
+  long committed = getOomStatistics().committedPages;
+  bool saved = saveCheckpoint(path);
+  releaseCheckpointQueue();
+  check(saved && victim != NO_FRAME, test, 0, "no se pudo guardar");
+
+  configureOom(OVERCOMMIT_HEURISTIC, OOM_DEFAULT_RATIO, true);
+  long restoredScore = 0;
+  bool restored = saved && restoreCheckpoint(path);
+  check(restored && *getProcessCount() == 2, test, 1, "no se restaura");
+  check(!restored || getProcessQueue()[1]->oomScoreAdj == 300, test, 2,
+        "ajuste OOM");
+  check(!restored || getOomStatistics().committedPages == committed, test,
+        3, "memoria comprometida");
+  check(!restored || (oomSelectVictim(&restoredScore) == victim &&
+                      restoredScore == score),
+        test, 4, "víctima del OOM killer");
+  releaseCheckpointQueue();
+
+  // El grupo no se guarda: el checkpoint se rechaza
+  ResourceGroup *group = createResourceGroup(
+      "grupo", NULL, GROUP_DEFAULT_WEIGHT, GROUP_NO_QUOTA,
+      GROUP_DEFAULT_PERIOD, GROUP_NO_MEMORY_LIMIT);
+  Process *grouped = checkpointProcess(3);
+  attachProcessToGroup(grouped, group);
+  if (addProcessToQueue(grouped) >= 0) {
+    check(!saveCheckpoint(path), test, 5, "proceso con grupo guardado");
+  } else {
+    releaseProcessPages(grouped);
+    free(grouped);
+  }
+  releaseCheckpointQueue();
+  resetResourceGroups();
+  configureOom(OOM_DEFAULT_POLICY, OOM_DEFAULT_RATIO, false);
+  unlink(path);
+}
+
+// Proceso de tiempo real con una ráfaga de CPU (la demanda real) por
+// trabajo
+static Process *realTimeProcess(int id, const SimTime *jobs, int count) {
+  Process *p = calloc(1, sizeof(Process));
+  p->id = id;
+  p->cpuBurstTimes = malloc(count * sizeof(SimTime));
+  p->ioBurstTimes = calloc(count, sizeof(SimTime));
+  memcpy(p->cpuBurstTimes, jobs, count * sizeof(SimTime));
+  p->totalBursts = count;
+  p->state = READY;
+  return p;
+}
+
+static void freeRealTimeProcess(Process *p) {
+  free(p->cpuBurstTimes);
+  free(p->ioBurstTimes);
+  free(p);
+}
+
+// Ejecutar la clase de tiempo real sola hasta que no queden trabajos;
+// devuelve el instante en que termina el último
+static SimTime runRealTime() {
+  SimTime now = 0;
+  for (;;) {
+    RealTimeTask *task = realTimeNext(now);
+    if (task == NULL) {
+      SimTime next = realTimeNextEvent(now);
+      if (next < 0)
+        return now;
+      now = next;
+      continue;
+    }
+    SimTime slice = realTimeSlice(task, now);
+    now += slice;
+    realTimeCharge(task, slice, now);
+  }
+}
+
+// Admitir en una clase vacía las tareas (periodo, plazo, WCET) de set y
+// devolver cuántas se aceptaron, parando en la primera rechazada
+static int admitTaskSet(RealTimePolicy policy, const SimTime (*set)[3],
+                        int count, Process **processes) {
+  configureRealTime(policy);
+  int admitted = 0;
+  for (int i = 0; i < count; i++) {
+    SimTime job = set[i][2];
+    processes[i] = realTimeProcess(i + 1, &job, 1);
+  }
+  while (admitted < count &&
+         admitRealTimeTask(processes[admitted], set[admitted][0],
+                           set[admitted][1], set[admitted][2], false))
+    admitted++;
+  for (int i = 0; i < count; i++)
+    freeRealTimeProcess(processes[i]);
+  return admitted;
+}
+
+// Tiempo real: el test de admisión acepta y rechaza conjuntos conocidos
+// (cota de Liu y Layland, análisis del tiempo de respuesta y densidad de
+// EDF) y la ejecución incumple exactamente los plazos esperados
+static void testRealTime() {
+  const char *test = "tiempo real";
+  static const struct {
+    RealTimePolicy policy;
+    SimTime set[3][3]; // Periodo, plazo y WCET de cada tarea
+    int count;
+    int admitted;
+    const char *what;
+  } cases[] = {
+      // U = 0.75, por debajo de la cota de 3 tareas (0.780)
+      {REALTIME_RATE_MONOTONIC, {{10, 10, 3}, {20, 20, 5}, {40, 40, 8}}, 3,
+       3, "cota de Liu y Layland"},
+      // U = 0.82 y 0.84 frente a la cota de 2 tareas (0.828): la segunda
+      // solo la admite el tiempo de respuesta (84 <= 100)
+      {REALTIME_RATE_MONOTONIC, {{100, 100, 41}, {100, 100, 41}}, 2, 2,
+       "por debajo de la cota"},
+      {REALTIME_RATE_MONOTONIC, {{100, 100, 42}, {100, 100, 42}}, 2, 2,
+       "tiempo de respuesta sobre la cota"},
+      // Armónicas con U = 1: R2 = 20 cumple su plazo; una tercera tarea
+      // de WCET 1 lleva R3 a 41 > 40
+      {REALTIME_RATE_MONOTONIC, {{10, 10, 5}, {20, 20, 10}, {40, 40, 1}}, 3,
+       2, "tiempo de respuesta de tareas armónicas"},
+      // U = 0.971: R2 = 8 > 7 con rate-monotonic, pero EDF la admite
+      {REALTIME_RATE_MONOTONIC, {{5, 5, 2}, {7, 7, 4}}, 2, 1,
+       "tiempo de respuesta sobre el plazo"},
+      {REALTIME_EDF, {{5, 5, 2}, {7, 7, 4}}, 2, 2, "EDF hasta U = 1"},
+      // Densidad 2/5 + 2/4 = 0.9; con 3/20 más llega a 1.05
+      {REALTIME_EDF, {{10, 5, 2}, {10, 4, 2}, {20, 20, 3}}, 3, 2,
+       "densidad de EDF con plazos restringidos"},
+      // Plazo restringido: la cota de Liu y Layland no vale y R2 = 4 > 3
+      {REALTIME_RATE_MONOTONIC, {{10, 10, 2}, {20, 3, 2}}, 2, 1,
+       "tiempo de respuesta con plazo restringido"},
+  };
+  Process *processes[3];
+  int n = sizeof(cases) / sizeof(cases[0]);
+  for (int c = 0; c < n; c++) {
+    int admitted = admitTaskSet(cases[c].policy, cases[c].set,
+                                cases[c].count, processes);
+    check(admitted == cases[c].admitted &&
+              getRealTimeStatistics().rejected ==
+                  (admitted < cases[c].count),
+          test, c + 1, cases[c].what);
+  }
+
+  // Ejecución: (T=5, C=2) y (T=7, C=4) con EDF durante su hiperperiodo
+  // no incumplen ningún plazo
+  static const SimTime shortJobs[7] = {2, 2, 2, 2, 2, 2, 2};
+  static const SimTime longJobs[5] = {4, 4, 4, 4, 4};
+  configureRealTime(REALTIME_EDF);
+  Process *a = realTimeProcess(1, shortJobs, 7);
+  Process *b = realTimeProcess(2, longJobs, 5);
+  bool admitted = admitRealTimeTask(a, 5, 5, 2, false) &&
+                  admitRealTimeTask(b, 7, 7, 4, false);
+  SimTime end = admitted ? runRealTime() : 0;
+  check(admitted && end == 34 && getRealTimeStatistics().jobs == 12 &&
+            getRealTimeStatistics().missedDeadlines == 0,
+        test, n + 1, "EDF planificable incumple plazos");
+  freeRealTimeProcess(a);
+  freeRealTimeProcess(b);
+
+  // Rate-monotonic (T=10, C=5) y (T=20, C=10) con U = 1: la segunda
+  // termina justo en su plazo; si el segundo trabajo de la primera pide 6
+  // (más que su WCET) la segunda termina en 21 e incumple su plazo
+  for (int overrun = 0; overrun <= 1; overrun++) {
+    SimTime fastJobs[2] = {5, 5 + overrun};
+    SimTime slowJobs[1] = {10};
+    configureRealTime(REALTIME_RATE_MONOTONIC);
+    a = realTimeProcess(1, fastJobs, 2);
+    b = realTimeProcess(2, slowJobs, 1);
+    admitted = admitRealTimeTask(a, 10, 10, 5, false) &&
+               admitRealTimeTask(b, 20, 20, 10, false);
+    end = admitted ? runRealTime() : 0;
+    RealTimeStatistics stats = getRealTimeStatistics();
+    check(admitted && end == 20 + overrun && stats.jobs == 3 &&
+              stats.missedDeadlines == overrun &&
+              b->realTime->missedDeadlines == overrun &&
+              b->realTime->worstLateness == overrun &&
+              a->realTime->overruns == overrun,
+          test, n + 2 + overrun, "plazos incumplidos por un exceso de WCET");
+    freeRealTimeProcess(a);
+    freeRealTimeProcess(b);
+  }
+  configureRealTime(REALTIME_DEFAULT_POLICY);
+}
+
+// Referencia de la puntuación OOM: la fracción de RAM de las páginas
+// residentes más la prioridad y el ajuste (0 si no es elegible)
+static long referenceOomScore(const Process *p) {
+  int resident = 0;
+  for (int i = 0; i < p->totalPages; i++)
+    resident += p->pages[i].inMemory;
+  if (resident == 0 || p->realTime != NULL ||
+      p->oomScoreAdj <= OOM_SCORE_ADJ_MIN)
+    return 0;
+  long score = (long)resident * OOM_SCORE_SCALE / NUM_FRAMES +
+               (long)p->priority * OOM_PRIORITY_POINTS + p->oomScoreAdj;
+  return score > 0 ? score : 1;
+}
+
+// OOM: la víctima del índice es el proceso de mayor puntuación según la
+// referencia (nunca uno de tiempo real ni uno inmune), y OVERCOMMIT_NEVER
+// rechaza justo los compromisos que superan su límite
+static void testOom() {
+  const char *test = "oom";
+  static const int adjustments[] = {OOM_SCORE_ADJ_MIN, -300, 0, 0, 200,
+                                    OOM_SCORE_ADJ_MAX};
+  RngStream rng;
+  rngSeed(&rng, 6);
+
+  for (int round = 0; round < 200; round++) {
+    initializeMemorySystem();
+    configureOom(OVERCOMMIT_HEURISTIC, OOM_DEFAULT_RATIO, false);
+    configureRealTime(REALTIME_EDF);
+    Process *processes[4];
+    int count = 1 + rngNext(&rng) % 4;
+    for (int i = 0; i < count; i++) {
+      Process *p = checkpointProcess(i + 1);
+      p->priority = rngNext(&rng) % (BACKGROUND_PRIORITY + 1);
+      p->oomScoreAdj = adjustments[rngNext(&rng) % 6];
+      if (rngNext(&rng) % 4 == 0)
+        admitRealTimeTask(p, 100, 100, 1, false);
+      if (addProcessToQueue(p) < 0) {
+        releaseProcessPages(p);
+        free(p);
+        count = i;
+        check(false, test, round, "proceso rechazado");
+        break;
+      }
+      processes[i] = p;
+    }
+    for (int i = 0; i < count; i++) {
+      for (int page = 0; page < processes[i]->totalPages; page++) {
+        if (rngNext(&rng) % 2 == 0)
+          handlePageFault(&processes[i]->pages[page], round);
+      }
+    }
+
+    // Los conjuntos se asignan en orden de registro; a igualdad gana el
+    // menor identificador
+    int expected = NO_FRAME;
+    long best = 0, score = 0;
+    for (int i = 0; i < count; i++) {
+      long candidate = referenceOomScore(processes[i]);
+      if (candidate > best) {
+        best = candidate;
+        expected = i;
+      }
+    }
+    int victim = oomSelectVictim(&score);
+    check(victim == expected && (victim == NO_FRAME || score == best), test,
+          round, "víctima distinta de la referencia");
+    check(victim == NO_FRAME ||
+              (processes[victim]->realTime == NULL &&
+               processes[victim]->oomScoreAdj > OOM_SCORE_ADJ_MIN),
+          test, round, "víctima de tiempo real o inmune");
+    releaseCheckpointQueue();
+  }
+  configureRealTime(REALTIME_DEFAULT_POLICY);
+
+  // OVERCOMMIT_NEVER: swap más la mitad de la RAM; el último proceso pide
+  // una página más de lo que queda y después exactamente lo que queda
+  initializeMemorySystem();
+  configureOom(OVERCOMMIT_NEVER, 50, false);
+  long limit = (long)NUM_FRAMES * 50 / 100 + swapSlotCount();
+  long committed = 0, refused = 0;
+  for (int i = 0; i < MAX_PROCESSES; i++) {
+    long pages = 1 + rngNext(&rng) % (limit / 3);
+    if (i == MAX_PROCESSES - 2)
+      pages = limit - committed + 1;
+    else if (i == MAX_PROCESSES - 1)
+      pages = limit - committed;
+    Process *p = checkpointProcess(i + 1);
+    p->memorySize = (int)(pages * PAGE_SIZE);
+    bool fits = committed + pages <= limit;
+    bool queued = addProcessToQueue(p) >= 0;
+    check(queued == fits, test, i, "compromiso con el límite");
+    if (queued) {
+      committed += pages;
+    } else {
+      refused++;
+      releaseProcessPages(p);
+      free(p);
+    }
+  }
+  OomStatistics stats = getOomStatistics();
+  check(stats.committedPages == committed && stats.refused == refused &&
+            refused > 0 && committed == limit,
+        test, 0, "páginas comprometidas o rechazos");
+  releaseCheckpointQueue();
+  configureOom(OOM_DEFAULT_POLICY, OOM_DEFAULT_RATIO, false);
+}
+
+int main() {
+  testBuddy(8, 1);
+  testBuddy(13, 2);
+  testBuddy(64, 3);
+  testBuddy(100, 4);
+  testLru();
+  testMrc();
+  testTraceImport();
+  testHistory();
+  testFrameLog();
+  testCorruptCheckpoint();
+  testCheckpointOom();
+  testRealTime();
+  testOom();
+
+  if (failures > 0) {
+    fprintf(stderr, "Pruebas diferenciales: %d fallos\n", failures);
+    return 1;
+  }
+  fprintf(stderr, "Pruebas diferenciales: correctas\n");
+  return 0;
+}
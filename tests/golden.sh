@@ -0,0 +1,48 @@
+#!/bin/sh
+# Ejecutar cada comando del corpus de tests/golden.txt y comparar el digest
+# de su registro de eventos con el esperado; con --update se reescriben los
+# digests esperados. Cada línea es "DIGEST COMANDO..." (# inicia un
+# comentario); los comandos se ejecutan en orden desde la raíz del proyecto
+# y $SCHEDULER es el ejecutable del simulador.
+
+SCHEDULER=${SCHEDULER:-./scheduler}
+
+golden=tests/golden.txt
+update=false
+[ "$1" = "--update" ] && update=true
+
+failures=0
+runs=0
+output=$(mktemp)
+while IFS= read -r line; do
+  case "$line" in
+  '' | '#'*)
+    echo "$line" >>"$output"
+    continue
+    ;;
+  esac
+  expected=${line%% *}
+  command=${line#* }
+  actual=$(eval "$command" 2>/dev/null |
+    sed -n 's/^Digest del registro: \([0-9a-f]*\).*/\1/p')
+  runs=$((runs + 1))
+  if [ -z "$actual" ]; then
+    echo "ERROR  $command (sin digest)"
+    failures=$((failures + 1))
+    actual=$expected
+  elif [ "$actual" != "$expected" ] && ! $update; then
+    echo "FALLO  $command (esperado $expected, obtenido $actual)"
+    failures=$((failures + 1))
+  fi
+  echo "$actual $command" >>"$output"
+done <"$golden"
+rm -f tests/golden.ckpt tests/golden.hist tests/golden.frames
+
+if $update; then
+  mv "$output" "$golden"
+  echo "Digests actualizados: $runs ejecuciones"
+else
+  rm -f "$output"
+  echo "Regresión: $((runs - failures)) de $runs ejecuciones coinciden"
+fi
+[ "$failures" -eq 0 ]
@@ -0,0 +1,410 @@
+#include "cgroup.h"
+#include "iodevice.h"
+#include "memory.h"
+#include "numa.h"
+#include "oom.h"
+#include "pagecache.h"
+#include "prefetch.h"
+#include "process.h"
+#include "realtime.h"
+#include "reclaim.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "swap.h"
+#include "tiering.h"
+#include "tlb.h"
+#include "zswap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Corpus de cargas para las pruebas de regresión: cada carga se ejecuta en
+// su propio proceso y termina mostrando el digest de su registro de eventos,
+// que make test compara con tests/golden.txt
+
+#define IO_PROCESSES 8
+#define IO_BURSTS 6
+#define FORK_WORKERS 3
+#define QUOTA_PROCESSES 4
+#define CONTROL_TASKS 4
+#define CONTROL_JOBS 10
+#define BATCH_PROCESSES 3
+#define RECLAIM_PROCESSES 4
+#define ZSWAP_PROCESSES 4
+#define TIER_PROCESSES 4
+#define GROUP_PROCESSES 4
+#define OOM_PROCESSES 5
+#define OOM_KERNEL_FRAMES 4
+
+// Crear un proceso con ráfagas iguales y páginas de 4 KiB
+static Process *createProcess(int id, SimTime startTime,
+                              ProcessPriority priority, SimTime *cpuBursts,
+                              SimTime *ioBursts, int totalBursts,
+                              int totalPages, int writtenPages) {
+  Process *p = calloc(1, sizeof(Process));
+  p->id = id;
+  p->startTime = startTime;
+  p->priority = priority;
+  p->cpuBurstTimes = cpuBursts;
+  p->ioBurstTimes = ioBursts;
+  p->totalBursts = totalBursts;
+  p->memorySize = totalPages * PAGE_SIZE;
+  p->totalPages = totalPages;
+  p->writtenPages = writtenPages;
+  p->state = READY;
+  initializeProcessPages(p);
+  return p;
+}
+
+// Liberar los procesos que quedan en la cola
+static void releaseQueue() {
+  Process **queue = getProcessQueue();
+  for (int i = 0; i < *getProcessCount(); i++) {
+    releaseProcessPages(queue[i]);
+    free(queue[i]);
+  }
+}
+
+// Ocho procesos con E/S de archivo sobre un dispositivo con servicio
+// exponencial, planificado con el algoritmo indicado
+static void ioWorkload(IoSchedulerKind scheduler) {
+  static SimTime cpu[IO_PROCESSES][IO_BURSTS], io[IO_PROCESSES][IO_BURSTS];
+  static FileRequest files[IO_PROCESSES][IO_BURSTS];
+
+  configureSwapDevice(256, SWAP_LATENCY, SWAP_BANDWIDTH,
+                      SWAP_READAHEAD_CLUSTER);
+  resetIoDevices();
+  addIoDevice("disco0", scheduler, 2, 0, IO_DEFAULT_SPEED,
+              IO_SERVICE_EXPONENTIAL, 7);
+  for (int i = 0; i < IO_PROCESSES; i++) {
+    for (int b = 0; b < IO_BURSTS; b++) {
+      cpu[i][b] = 5 + i;
+      io[i][b] = 30 + 5 * i;
+      files[i][b] = (FileRequest){i % 3, (long)b * 3 * PAGE_SIZE,
+                                  3 * PAGE_SIZE, (i + b) % 3 == 0};
+    }
+    Process *p = createProcess(i + 1, 2 * i, (ProcessPriority)(i % 4),
+                               cpu[i], io[i], IO_BURSTS, 3, 1);
+    p->ioRequests = i % 2 ? files[i] : NULL;
+    addProcessToQueue(p);
+  }
+  advancedRoundRobinScheduler();
+  dropPageCache();
+  resetIoDevices();
+  releaseQueue();
+}
+
+// Un proceso con un segmento compartido que se bifurca en varios hijos que
+// comparten sus páginas con copia en escritura
+static void forkWorkload() {
+  static SimTime cpu[] = {50, 30, 40}, io[] = {20, 30};
+
+  configureSwapDevice(64, SWAP_LATENCY, SWAP_BANDWIDTH,
+                      SWAP_READAHEAD_CLUSTER);
+  Process *parent =
+      createProcess(1, 0, SYSTEM_PRIORITY, cpu, io, 3, 4, 2);
+  SharedRegion *region = createSharedRegion(1, 2);
+  attachSharedRegion(parent, region);
+  addProcessToQueue(parent);
+  for (int i = 0; i < parent->totalPages; i++) {
+    unsigned long address = parent->pages[i].virtualAddress;
+    Page *page = translateAddress(parent, address, i < 2, 0);
+    if (!page->inMemory && handlePageFault(page, 0))
+      translateAddress(parent, address, i < 2, 0);
+  }
+  Page *shared = translateAddress(parent, SHARED_REGION_BASE, true, 0);
+  if (!shared->inMemory && handlePageFault(shared, 0))
+    translateAddress(parent, SHARED_REGION_BASE, true, 0);
+  for (int k = 0; k < FORK_WORKERS; k++)
+    addProcessToQueue(forkProcess(parent, 10 + k, 1));
+  advancedRoundRobinScheduler();
+  displayProcessMemoryUsage();
+  displayPageSizeStatistics();
+  releaseQueue();
+  destroySharedRegion(region);
+}
+
+// Dos nodos NUMA: balanceo de páginas de un proceso first-touch que cambia
+// de CPU y un proceso ligado a un nodo que agota sus marcos
+static void numaWorkload() {
+  configureNumaTopology(2, 2, NUMA_LOCAL_LATENCY, NUMA_REMOTE_LATENCY,
+                        NUMA_MIGRATION_COST, true);
+  initializeMemorySystem();
+  Process *p = createProcess(1, 0, SYSTEM_PRIORITY, NULL, NULL, 0, 4, 0);
+  Process *q = createProcess(2, 0, SYSTEM_PRIORITY, NULL, NULL, 0, 6, 0);
+  p->cpu = 0;
+  registerProcessMemory(p);
+  for (int t = 0; t < 4; t++) {
+    for (int i = 0; i < p->totalPages; i++) {
+      unsigned long address = p->pages[i].virtualAddress;
+      if (t == 1)
+        p->cpu = 2; // Una CPU del nodo 1
+      Page *page = translateAddress(p, address, true, t * 10);
+      if (!page->inMemory && handlePageFault(page, t * 10))
+        translateAddress(p, address, true, t * 10);
+    }
+  }
+  q->numaPolicy = NUMA_POLICY_BIND;
+  q->numaNode = 1;
+  q->cpu = 3;
+  registerProcessMemory(q);
+  for (int i = 0; i < q->totalPages; i++) {
+    Page *page = translateAddress(q, q->pages[i].virtualAddress, false, 50);
+    if (!page->inMemory)
+      handlePageFault(page, 50);
+  }
+  compactMemory(60);
+  displayMemoryFrames(60);
+  displayNumaStatistics();
+  releaseProcessMemory(p, 70);
+  releaseProcessMemory(q, 70);
+  releaseProcessPages(p);
+  releaseProcessPages(q);
+  free(p);
+  free(q);
+}
+
+// Cuatro procesos con cuotas de marcos proporcionales a su tamaño
+static void quotaWorkload() {
+  static SimTime cpu[QUOTA_PROCESSES][3] = {
+      {50, 30, 40}, {60, 40, 35}, {45, 25, 55}, {55, 50, 45}};
+  static SimTime io[QUOTA_PROCESSES][3] = {
+      {20, 30, 10}, {25, 20, 15}, {15, 35, 25}, {20, 40, 30}};
+  static const int pages[QUOTA_PROCESSES] = {4, 6, 5, 7};
+
+  setFrameAllocationMode(FRAME_ALLOCATION_PROPORTIONAL);
+  for (int i = 0; i < QUOTA_PROCESSES; i++)
+    addProcessToQueue(createProcess(i + 1, 5 * i, (ProcessPriority)(1 + i % 2),
+                                    cpu[i], io[i], 3, pages[i], 1 + i % 3));
+  advancedRoundRobinScheduler();
+  displayProcessMemoryUsage();
+  releaseQueue();
+}
+
+// Lazos de control de tiempo real (uno de ellos esporádico y otro con un
+// trabajo que excede su WCET) compartiendo la CPU con procesos por lotes;
+// la última tarea no cabe y se queda en Round Robin
+static void realTimeWorkload(RealTimePolicy policy) {
+  static SimTime cpu[CONTROL_TASKS][CONTROL_JOBS];
+  static SimTime io[CONTROL_TASKS][CONTROL_JOBS];
+  static SimTime batchCpu[BATCH_PROCESSES][3], batchIo[BATCH_PROCESSES][3];
+  static const SimTime period[CONTROL_TASKS] = {20, 50, 30, 40};
+  static const SimTime deadline[CONTROL_TASKS] = {20, 40, 30, 40};
+  static const SimTime wcet[CONTROL_TASKS] = {4, 10, 5, 30};
+
+  configureRealTime(policy);
+  for (int t = 0; t < CONTROL_TASKS; t++) {
+    for (int j = 0; j < CONTROL_JOBS; j++) {
+      cpu[t][j] = wcet[t] - (j + t) % 3;
+      io[t][j] = 4 * ((j + t) % 4);
+    }
+  }
+  cpu[0][6] = 6 * wcet[0];
+  for (int t = 0; t < CONTROL_TASKS; t++) {
+    Process *p = createProcess(t + 1, 3 * t, SYSTEM_PRIORITY, cpu[t], io[t],
+                               CONTROL_JOBS, 1, 1);
+    addProcessToQueue(p);
+    admitRealTimeTask(p, period[t], deadline[t], wcet[t], t == 2);
+  }
+  for (int i = 0; i < BATCH_PROCESSES; i++) {
+    for (int b = 0; b < 3; b++) {
+      batchCpu[i][b] = 70 + 15 * i - 10 * b;
+      batchIo[i][b] = 25 + 10 * b;
+    }
+    addProcessToQueue(createProcess(CONTROL_TASKS + i + 1, 10 * i,
+                                    BACKGROUND_PRIORITY, batchCpu[i],
+                                    batchIo[i], 3, 1, 1));
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+// Cuatro procesos cuyas páginas no caben juntas en memoria: solo con
+// reclamación directa o con el demonio recuperando marcos por delante
+static void reclaimWorkload(bool background) {
+  static SimTime cpu[RECLAIM_PROCESSES][4], io[RECLAIM_PROCESSES][4];
+
+  configureReclaim(background ? RECLAIM_LOW_WATERMARK : 0,
+                   background ? RECLAIM_HIGH_WATERMARK : 0, RECLAIM_BATCH,
+                   RECLAIM_DIRECT_COST);
+  for (int i = 0; i < RECLAIM_PROCESSES; i++) {
+    for (int b = 0; b < 4; b++) {
+      cpu[i][b] = 15 + 5 * ((i + b) % 3);
+      io[i][b] = 10 + 5 * i;
+    }
+    addProcessToQueue(createProcess(i + 1, 4 * i, INTERACTIVE_PRIORITY,
+                                    cpu[i], io[i], 4, 3 + i % 2, 1 + i % 2));
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+// Cuatro procesos que escriben más páginas de las que caben en los marcos
+// que deja libres el almacén comprimido: las desalojadas se comprimen y
+// vuelven sin pasar por swap mientras caben en él
+static void zswapWorkload() {
+  static SimTime cpu[ZSWAP_PROCESSES][4], io[ZSWAP_PROCESSES][4];
+
+  configureZswap(ZSWAP_POOL_FRAMES, NULL, 0, ZSWAP_COMPRESS_COST,
+                 ZSWAP_DECOMPRESS_COST, 0);
+  for (int i = 0; i < ZSWAP_PROCESSES; i++) {
+    for (int b = 0; b < 4; b++) {
+      cpu[i][b] = 20 + 5 * ((i + b) % 3);
+      io[i][b] = 10 + 5 * i;
+    }
+    addProcessToQueue(createProcess(i + 1, 3 * i, INTERACTIVE_PRIORITY,
+                                    cpu[i], io[i], 4, 3 + i % 2, 2));
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+// Un nodo de DRAM y otro de memoria lenta: los procesos que llegan tarde
+// desbordan a la memoria lenta, la reclamación degrada las páginas frías y
+// las que se reusan vuelven a la rápida
+static void tieringWorkload() {
+  static SimTime cpu[TIER_PROCESSES][6], io[TIER_PROCESSES][6];
+  static const int pages[TIER_PROCESSES] = {3, 2, 2, 2};
+
+  configureNumaTopology(1, 1, NUMA_LOCAL_LATENCY, NUMA_REMOTE_LATENCY,
+                        NUMA_MIGRATION_COST, true);
+  configureSlowTier(3, NUMA_SLOW_LATENCY);
+  configureTiering(TIER_SAMPLE_RATE, TIER_HOT_WINDOW, TIER_PROMOTE_THRESHOLD,
+                   TIER_MIGRATION_BUDGET, TIER_MIGRATION_WINDOW,
+                   TIER_MIGRATION_COST);
+  initializeMemorySystem();
+  for (int i = 0; i < TIER_PROCESSES; i++) {
+    for (int b = 0; b < 6; b++) {
+      cpu[i][b] = 10 + 5 * ((i + b) % 3);
+      io[i][b] = 5 + 10 * i;
+    }
+    addProcessToQueue(createProcess(i + 1, 40 * i, INTERACTIVE_PRIORITY,
+                                    cpu[i], io[i], 6, pages[i], 1));
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+// Tres procesos en un grupo con cuota de CPU y límite de marcos (dos en un
+// subgrupo con el doble de peso que el tercero) compiten con un proceso
+// sin grupo: el grupo se limita en cada periodo y sus fallos desalojan
+// sus propias páginas
+static void cgroupWorkload() {
+  static SimTime cpu[GROUP_PROCESSES][4], io[GROUP_PROCESSES][4];
+
+  resetResourceGroups();
+  ResourceGroup *batch = createResourceGroup("lotes", NULL,
+                                             GROUP_DEFAULT_WEIGHT, 40,
+                                             GROUP_DEFAULT_PERIOD, 4);
+  ResourceGroup *heavy = createResourceGroup(
+      "pesado", batch, 2 * GROUP_DEFAULT_WEIGHT, GROUP_NO_QUOTA,
+      GROUP_DEFAULT_PERIOD, GROUP_NO_MEMORY_LIMIT);
+  ResourceGroup *light = createResourceGroup(
+      "ligero", batch, GROUP_DEFAULT_WEIGHT, GROUP_NO_QUOTA,
+      GROUP_DEFAULT_PERIOD, GROUP_NO_MEMORY_LIMIT);
+  for (int i = 0; i < GROUP_PROCESSES; i++) {
+    for (int b = 0; b < 4; b++) {
+      cpu[i][b] = 30 + 10 * ((i + b) % 3);
+      io[i][b] = 10 + 5 * i;
+    }
+    Process *p = createProcess(i + 1, 2 * i, INTERACTIVE_PRIORITY, cpu[i],
+                               io[i], 4, 2 + i % 2, 1);
+    if (i < 2)
+      attachProcessToGroup(p, heavy);
+    else if (i == 2)
+      attachProcessToGroup(p, light);
+    addProcessToQueue(p);
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+// Un pico de memoria del núcleo deja cuatro marcos para cuatro procesos que
+// vuelven de swap: cuando todos los marcos esperan su lectura, el OOM
+// killer elimina al de mayor puntuación (el primero es inmune). La
+// política estricta de compromiso rechaza al quinto proceso
+static void oomWorkload() {
+  static SimTime cpu[OOM_PROCESSES][4], io[OOM_PROCESSES][4];
+
+  configureSwapDevice(8, SWAP_LATENCY, SWAP_BANDWIDTH, 1);
+  configureOom(OVERCOMMIT_NEVER, OOM_DEFAULT_RATIO, true);
+  for (int i = 0; i < OOM_KERNEL_FRAMES; i++)
+    allocateKernelBlock(0, FRAME_KERNEL, 0);
+  for (int i = 0; i < OOM_PROCESSES; i++) {
+    for (int b = 0; b < 4; b++) {
+      cpu[i][b] = 15 + 5 * ((i + b) % 3);
+      io[i][b] = 10 + 5 * i;
+    }
+    Process *p = createProcess(i + 1, 3 * i,
+                               i == 3 ? BACKGROUND_PRIORITY
+                                      : INTERACTIVE_PRIORITY,
+                               cpu[i], io[i], 4, i < 4 ? 3 : 2, 3);
+    if (i == 0)
+      p->oomScoreAdj = OOM_SCORE_ADJ_MIN;
+    if (addProcessToQueue(p) < 0) {
+      releaseProcessPages(p);
+      free(p);
+    }
+  }
+  advancedRoundRobinScheduler();
+  releaseQueue();
+}
+
+int main(int argc, char *argv[]) {
+  static const char *ioNames[] = {"io-fifo", "io-deadline", "io-bfq",
+                                  "io-mq-deadline"};
+  const char *name = argc > 1 ? argv[1] : "";
+
+  if (argc > 2)
+    setSimulationSeed(strtoull(argv[2], NULL, 10));
+
+  // Todas las cargas salvo la NUMA y la de niveles usan la topología por
+  // defecto
+  if (strcmp(name, "numa") != 0 && strcmp(name, "tiering") != 0)
+    initializeMemorySystem();
+  initializeTlb(TLB_SETS, TLB_WAYS, TLB_USE_ASID);
+  configurePrefetcher(PREFETCH_ENABLED, PREFETCH_MAX_WINDOW, PREFETCH_MARKOV);
+
+  bool known = true;
+  int kind = 0;
+  while (kind < 4 && strcmp(name, ioNames[kind]) != 0)
+    kind++;
+  if (kind < 4)
+    ioWorkload((IoSchedulerKind)kind);
+  else if (strcmp(name, "fork") == 0)
+    forkWorkload();
+  else if (strcmp(name, "numa") == 0)
+    numaWorkload();
+  else if (strcmp(name, "quotas") == 0)
+    quotaWorkload();
+  else if (strcmp(name, "realtime") == 0)
+    realTimeWorkload(REALTIME_EDF);
+  else if (strcmp(name, "realtime-rm") == 0)
+    realTimeWorkload(REALTIME_RATE_MONOTONIC);
+  else if (strcmp(name, "reclaim-direct") == 0)
+    reclaimWorkload(false);
+  else if (strcmp(name, "reclaim-kswapd") == 0)
+    reclaimWorkload(true);
+  else if (strcmp(name, "zswap") == 0)
+    zswapWorkload();
+  else if (strcmp(name, "tiering") == 0)
+    tieringWorkload();
+  else if (strcmp(name, "cgroups") == 0)
+    cgroupWorkload();
+  else if (strcmp(name, "oom") == 0)
+    oomWorkload();
+  else
+    known = false;
+
+  if (!known) {
+    fprintf(stderr,
+            "Uso: %s CARGA [SEMILLA]\n"
+            "Cargas: io-fifo io-deadline io-bfq io-mq-deadline fork numa "
+            "quotas realtime realtime-rm reclaim-direct reclaim-kswapd "
+            "zswap tiering cgroups oom\n",
+            argv[0]);
+    return 1;
+  }
+  displayEventLogDigest();
+  return 0;
+}